@@ -0,0 +1,83 @@
+/**
+ * Tests that a columnstore index answers full-collection queries whose projection only reads
+ * indexed paths, and that it returns the same documents as a collection scan.
+ * @tags: [
+ *     assumes_unsharded_collection,
+ *     requires_fcv_49,
+ *     requires_find_command,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const isColumnstoreEnabled =
+    assert.commandWorked(db.adminCommand({getParameter: 1, featureFlagColumnstoreIndexes: 1}))
+        .featureFlagColumnstoreIndexes.value;
+if (!isColumnstoreEnabled) {
+    jsTestLog("Skipping test because the columnstore index feature flag is disabled");
+    return;
+}
+
+// Only the classic execution engine can run a column scan.
+const isSBEEnabled =
+    db.adminCommand({getParameter: 1, internalQueryEnableSlotBasedExecutionEngine: 1})
+        .internalQueryEnableSlotBasedExecutionEngine;
+
+const coll = db.columnstore_index;
+coll.drop();
+
+assert.commandWorked(coll.insert([
+    {_id: 0, a: 1, b: {c: 1, d: 2}, e: "x"},
+    {_id: 1, b: [{c: 2}, {c: 3, d: 4}], a: 2},
+    {_id: 2, e: "y"},
+    {_id: 3, a: [1, 2], b: 5},
+]));
+
+// Indexes that a columnstore index cannot be are rejected.
+assert.commandFailedWithCode(coll.createIndex({a: "columnstore", b: 1}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(coll.createIndex({"b.c": "columnstore", "b.d": "columnstore"}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(coll.createIndex({a: "columnstore"}, {unique: true}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(coll.createIndex({a: "columnstore"}, {sparse: true}),
+                             ErrorCodes.CannotCreateIndex);
+
+const keyPattern = {_id: "columnstore", a: "columnstore", "b.c": "columnstore"};
+assert.commandWorked(coll.createIndex(keyPattern));
+
+function assertAnswersLikeACollectionScan(projection, expectColumnScan) {
+    const expected = coll.find({}, projection).hint({$natural: 1}).toArray();
+    assert.sameMembers(coll.find({}, projection).toArray(), expected, tojson(projection));
+
+    const explain = coll.find({}, projection).explain();
+    assert.eq(expectColumnScan && !isSBEEnabled,
+              planHasStage(db, explain, "COLUMN_SCAN"),
+              tojson(explain));
+}
+
+// Field order, missing fields, arrays and the parts of objects under a dotted path are all
+// rebuilt from the columns.
+assertAnswersLikeACollectionScan({_id: 1, a: 1}, true);
+assertAnswersLikeACollectionScan({_id: 0, a: 1}, true);
+assertAnswersLikeACollectionScan({_id: 1, "b.c": 1}, true);
+assertAnswersLikeACollectionScan({_id: 1, a: 1, "b.c": 1}, true);
+
+// Paths outside the index need the documents themselves.
+assertAnswersLikeACollectionScan({_id: 1, e: 1}, false);
+assertAnswersLikeACollectionScan({_id: 1, "b.d": 1}, false);
+assertAnswersLikeACollectionScan({a: 0}, false);
+
+// The index stays correct through writes.
+assert.commandWorked(coll.update({_id: 0}, {$set: {a: 10}, $unset: {b: ""}}));
+assert.commandWorked(coll.remove({_id: 3}));
+assert.commandWorked(coll.insert({a: "z", _id: 4}));
+assertAnswersLikeACollectionScan({_id: 1, a: 1, "b.c": 1}, true);
+
+// A filter can't be answered from the index, and a hint can't force it.
+assert.eq(coll.find({a: 2}, {_id: 1, a: 1}).toArray(), [{_id: 1, a: 2}]);
+assert.throwsWithCode(() => coll.find({a: 2}, {_id: 1, a: 1}).hint(keyPattern).itcount(),
+                      ErrorCodes.NoQueryExecutionPlans);
+})();
@@ -0,0 +1,69 @@
+/**
+ * Tests that a column scan which yields part way through the collection rebuilds every document it
+ * returns after the yield from the new snapshot, rather than mixing in cells read before it.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+load("jstests/libs/fail_point_util.js");
+
+const conn = MongoRunner.runMongod({setParameter: {featureFlagColumnstoreIndexes: true}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.columnstore_index_yield;
+coll.drop();
+
+// Only the classic execution engine can run a column scan.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryEnableSlotBasedExecutionEngine: false}));
+
+const kNumDocs = 20;
+let docs = [];
+for (let i = 0; i < kNumDocs; ++i) {
+    docs.push({_id: i, a: i, b: {c: i}});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(
+    coll.createIndex({_id: "columnstore", a: "columnstore", "b.c": "columnstore"}));
+
+const projection = {
+    _id: 1,
+    a: 1,
+    "b.c": 1
+};
+assert(planHasStage(db, coll.find({}, projection).explain(), "COLUMN_SCAN"));
+
+// Yield after every call to work(), and hang on a yield once a few documents have been returned.
+const originalYieldIterations =
+    assert.commandWorked(db.adminCommand({getParameter: 1, internalQueryExecYieldIterations: 1}))
+        .internalQueryExecYieldIterations;
+assert.commandWorked(db.adminCommand({setParameter: 1, internalQueryExecYieldIterations: 1}));
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryExecYieldPeriodMS: 60 * 60 * 1000}));
+const failPoint = configureFailPoint(
+    db, "setYieldAllLocksHang", {namespace: coll.getFullName()}, {skip: kNumDocs / 2});
+
+const awaitShell = startParallelShell(function() {
+    const results = db.columnstore_index_yield.find({}, {_id: 1, a: 1, "b.c": 1})
+                        .batchSize(100)
+                        .toArray();
+    assert.eq(results.length, 20, tojson(results));
+    // Every document is read in full from either side of the yield.
+    for (const doc of results) {
+        assert.eq(doc.a, doc.b.c, tojson(results));
+    }
+}, conn.port);
+
+failPoint.wait();
+
+// Don't let the update below yield and hang itself.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryExecYieldIterations: originalYieldIterations}));
+assert.commandWorked(coll.updateMany({}, {$inc: {a: kNumDocs, "b.c": kNumDocs}}));
+
+failPoint.off();
+awaitShell();
+
+MongoRunner.stopMongod(conn);
+})();
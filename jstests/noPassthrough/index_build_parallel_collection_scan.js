@@ -0,0 +1,124 @@
+/**
+ * Tests that an index build splits up its collection scan between several threads only when it is
+ * allowed to, that the resulting index is valid, and that the threads stop along with the index
+ * build when it is killed, when its collection is dropped, and that they honor the fail points of
+ * the collection scan.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/fail_point_util.js");
+load("jstests/noPassthrough/libs/index_build.js");
+
+const kNumDocs = 10000;
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        maxIndexBuildCollectionScanThreads: 4,
+        indexBuildParallelCollectionScanMinRecords: 0,
+    }
+});
+assert.neq(null, conn, "mongod was unable to start up");
+const testDB = conn.getDB("test");
+const coll = testDB.index_build_parallel_collection_scan;
+
+function resetCollection(options) {
+    coll.drop();
+    assert.commandWorked(testDB.createCollection(coll.getName(), options || {}));
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < kNumDocs; ++i) {
+        bulk.insert({_id: i, a: i % 100, b: [i, -i]});
+    }
+    assert.commandWorked(bulk.execute());
+}
+
+function setParameter(param) {
+    assert.commandWorked(testDB.adminCommand(Object.assign({setParameter: 1}, param)));
+}
+
+// Log "Index build: scanned collection in parallel".
+let numParallelScans = 0;
+function assertNumParallelScans(expected) {
+    numParallelScans = expected;
+    assert(checkLog.checkContainsWithCountJson(conn, 5130000, {}, numParallelScans),
+           "Expected " + numParallelScans + " collection scans split up between threads");
+}
+
+// The keys generated by every thread end up in the index.
+resetCollection();
+assert.commandWorked(coll.createIndexes([{a: 1}, {b: 1}]));
+checkLog.containsJson(conn, 5130000, {threads: 4});
+assertNumParallelScans(numParallelScans + 1);
+const res = assert.commandWorked(coll.validate({full: true}));
+assert(res.valid, res);
+assert.eq(kNumDocs, res.keysPerIndex.a_1, res);
+assert.eq(2 * kNumDocs - 1, res.keysPerIndex.b_1, res);
+
+// Collections smaller than the minimum, builds limited to a single thread and capped collections
+// are scanned serially.
+resetCollection();
+setParameter({indexBuildParallelCollectionScanMinRecords: kNumDocs + 1});
+assert.commandWorked(coll.createIndex({a: 1}));
+assertNumParallelScans(numParallelScans);
+setParameter({indexBuildParallelCollectionScanMinRecords: 0});
+
+resetCollection();
+setParameter({maxIndexBuildCollectionScanThreads: 1});
+assert.commandWorked(coll.createIndex({a: 1}));
+assertNumParallelScans(numParallelScans);
+setParameter({maxIndexBuildCollectionScanThreads: 4});
+
+resetCollection({capped: true, size: 16 * 1024 * 1024});
+assert.commandWorked(coll.createIndex({a: 1}));
+assertNumParallelScans(numParallelScans);
+
+// The build still hangs on 'hangAfterStartingIndexBuild' once the threads are done.
+resetCollection();
+IndexBuildTest.pauseIndexBuilds(conn);
+let awaitIndexBuild = IndexBuildTest.startIndexBuild(conn, coll.getFullName(), {a: 1});
+try {
+    checkLog.containsWithCount(conn, /"id":5130000,/, numParallelScans + 1);
+    IndexBuildTest.waitForIndexBuildToScanCollection(testDB, coll.getName(), "a_1");
+    IndexBuildTest.assertIndexes(coll, 2, ["_id_"], ["a_1"], {includeBuildUUIDs: true});
+} finally {
+    IndexBuildTest.resumeIndexBuilds(conn);
+}
+awaitIndexBuild();
+assertNumParallelScans(numParallelScans + 1);
+IndexBuildTest.assertIndexes(coll, 2, ["_id_", "a_1"]);
+
+// Killing the build stops a thread which is waiting on a fail point of the collection scan.
+resetCollection();
+let fp = configureFailPoint(
+    conn, "hangIndexBuildDuringCollectionScanPhaseBeforeInsertion", {fieldsToMatch: {_id: 5000}});
+awaitIndexBuild = IndexBuildTest.startIndexBuild(conn, coll.getFullName(), {a: 1});
+try {
+    fp.wait();
+    const opId = IndexBuildTest.waitForIndexBuildToScanCollection(testDB, coll.getName(), "a_1");
+    assert.commandWorked(testDB.killOp(opId));
+    IndexBuildTest.waitForIndexBuildToStop(testDB);
+} finally {
+    fp.off();
+}
+assert.neq(0, awaitIndexBuild({checkExitSuccess: false}));
+IndexBuildTest.assertIndexes(coll, 1, ["_id_"]);
+assertNumParallelScans(numParallelScans);
+
+// Dropping the collection aborts the build while a thread waits on a fail point.
+resetCollection();
+fp = configureFailPoint(
+    conn, "hangIndexBuildDuringCollectionScanPhaseBeforeInsertion", {fieldsToMatch: {_id: 5000}});
+awaitIndexBuild = IndexBuildTest.startIndexBuild(
+    conn, coll.getFullName(), {a: 1}, {}, [ErrorCodes.IndexBuildAborted]);
+try {
+    fp.wait();
+    assert.commandWorked(testDB.runCommand({drop: coll.getName()}));
+} finally {
+    fp.off();
+}
+awaitIndexBuild();
+assert.eq(0, testDB.getCollectionInfos({name: coll.getName()}).length);
+assertNumParallelScans(numParallelScans);
+
+MongoRunner.stopMongod(conn);
+}());
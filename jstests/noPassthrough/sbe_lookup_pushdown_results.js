@@ -0,0 +1,117 @@
+/**
+ * Tests that an equality $lookup pushed down into the slot-based execution engine returns the same
+ * results as the classic $lookup, with either join strategy, for local and foreign values including
+ * nested arrays and regular expressions, and that a foreign collection too large to hash join is
+ * left to the classic $lookup even if disk use is allowed.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {internalQueryEnableSlotBasedExecutionEngine: true}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const local = db.sbe_lookup_pushdown_results_local;
+const foreign = db.sbe_lookup_pushdown_results_foreign;
+local.drop();
+foreign.drop();
+
+const kValues = [
+    1,
+    NumberInt(2),
+    NumberLong(3),
+    4.0,
+    NumberDecimal("5"),
+    "a",
+    "b",
+    /a/,
+    /^b/i,
+    null,
+    {x: 1},
+    [],
+    [1, 2],
+    [[1, 2]],
+    [[]],
+    [null],
+    [2, [3]],
+    [[1], [2]],
+    [/a/, "a"],
+    [[/a/]],
+    [{x: 1}],
+];
+
+let localDocs = [{_id: 0}];
+let foreignDocs = [{_id: 0}];
+kValues.forEach((value, i) => {
+    localDocs.push({_id: i + 1, k: value});
+    foreignDocs.push({_id: i + 1, k: value});
+});
+assert.commandWorked(local.insert(localDocs));
+assert.commandWorked(foreign.insert(foreignDocs));
+
+// Enough unmatched foreign documents for an index probe per local document to be cheaper than
+// reading all of the foreign collection.
+assert.commandWorked(
+    foreign.insert(Array.from({length: 500}, (_, i) => ({_id: 1000 + i, k: "filler" + i}))));
+
+const pipeline = [{$lookup: {from: foreign.getName(), localField: "k", foreignField: "k", as: "m"}}];
+
+function runLookup() {
+    return local.aggregate(pipeline, {allowDiskUse: true})
+        .toArray()
+        .map(doc => Object.assign(doc, {m: doc.m.map(match => match._id).sort((a, b) => a - b)}))
+        .sort((a, b) => a._id - b._id);
+}
+
+function findEqLookup(plan) {
+    if (typeof plan !== "object" || plan === null) {
+        return null;
+    }
+    if (plan.stage === "EQ_LOOKUP") {
+        return plan;
+    }
+    for (let key of Object.keys(plan)) {
+        const eqLookup = findEqLookup(plan[key]);
+        if (eqLookup) {
+            return eqLookup;
+        }
+    }
+    return null;
+}
+
+function eqLookupStrategy() {
+    const eqLookup = findEqLookup(local.explain().aggregate(pipeline, {allowDiskUse: true}));
+    return eqLookup ? eqLookup.strategy : null;
+}
+
+function setParameter(param) {
+    assert.commandWorked(db.adminCommand(Object.assign({setParameter: 1}, param)));
+}
+
+setParameter({internalQuerySlotBasedExecutionLookupPushdown: false});
+assert.eq(null, eqLookupStrategy());
+const expected = runLookup();
+setParameter({internalQuerySlotBasedExecutionLookupPushdown: true});
+
+// Every local document looks up at least one foreign document, so the comparison below covers
+// matches for each of the values.
+expected.forEach(doc => assert.neq(0, doc.m.length, doc));
+
+assert.eq("HashJoin", eqLookupStrategy());
+assert.eq(expected, runLookup());
+
+for (let keyPattern of [{k: 1}, {k: -1}]) {
+    assert.commandWorked(foreign.createIndex(keyPattern));
+    assert.eq("IndexedLoopJoin", eqLookupStrategy(), keyPattern);
+    assert.eq(expected, runLookup(), keyPattern);
+    assert.commandWorked(foreign.dropIndex(keyPattern));
+}
+
+// Without an index, a foreign collection beyond the memory limit of the hash join is joined by the
+// classic $lookup.
+setParameter({internalQuerySlotBasedExecutionHashLookupMaxMemoryBytes: 1});
+assert.eq(null, eqLookupStrategy());
+assert.eq(expected, runLookup());
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,90 @@
+/**
+ * Tests that the worker threads of a collection scan split up by the slot-based execution engine
+ * do not hold on to locks while the query waits for the next getMore, that they go away along with
+ * the query, and that '$_degreeOfParallelism' is only accepted when testing commands are enabled.
+ */
+(function() {
+"use strict";
+
+const kNumDocs = 50000;
+
+function runningProducers(db) {
+    return db.getSiblingDB("admin")
+        .aggregate([
+            {$currentOp: {allUsers: true, idleConnections: false, localOps: true}},
+            {$match: {desc: /^ExchProd/}}
+        ])
+        .toArray();
+}
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        internalQueryEnableSlotBasedExecutionEngine: true,
+        internalQuerySlotBasedExecutionParallelScanMinRecords: 0
+    }
+});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.sbe_parallel_scan_locks;
+coll.drop();
+
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < kNumDocs; ++i) {
+    bulk.insert({_id: i, a: i % 10});
+}
+assert.commandWorked(bulk.execute());
+
+// The first batch leaves the workers waiting for the consumer to free up their buffers.
+let res = assert.commandWorked(db.runCommand(
+    {find: coll.getName(), filter: {a: {$gte: 0}}, batchSize: 10, $_degreeOfParallelism: 4}));
+let cursorId = res.cursor.id;
+let numDocs = res.cursor.firstBatch.length;
+assert.neq(0, cursorId);
+
+// An exclusive lock on the collection is granted while the cursor is idle.
+assert.commandWorked(
+    db.adminCommand({sleep: 1, millis: 10, lock: "w", lockTarget: coll.getFullName()}));
+
+while (cursorId != 0) {
+    res = assert.commandWorked(
+        db.runCommand({getMore: cursorId, collection: coll.getName(), batchSize: 1000}));
+    cursorId = res.cursor.id;
+    numDocs += res.cursor.nextBatch.length;
+}
+assert.eq(kNumDocs, numDocs);
+assert.soon(() => runningProducers(db).length == 0, () => tojson(runningProducers(db)));
+
+// Killing the cursor stops the workers.
+res = assert.commandWorked(
+    db.runCommand({find: coll.getName(), batchSize: 10, $_degreeOfParallelism: 4}));
+assert.neq(0, res.cursor.id);
+assert.commandWorked(db.runCommand({killCursors: coll.getName(), cursors: [res.cursor.id]}));
+assert.soon(() => runningProducers(db).length == 0, () => tojson(runningProducers(db)));
+
+// The workers run out of time along with the query.
+assert.commandWorked(
+    db.adminCommand({configureFailPoint: "maxTimeAlwaysTimeOut", mode: "alwaysOn"}));
+assert.commandFailedWithCode(
+    db.runCommand({find: coll.getName(), maxTimeMS: 60 * 1000, $_degreeOfParallelism: 4}),
+    ErrorCodes.MaxTimeMSExpired);
+assert.commandWorked(db.adminCommand({configureFailPoint: "maxTimeAlwaysTimeOut", mode: "off"}));
+assert.soon(() => runningProducers(db).length == 0, () => tojson(runningProducers(db)));
+
+MongoRunner.stopMongod(conn);
+
+// '$_degreeOfParallelism' is only accepted when testing commands are enabled.
+TestData.enableTestCommands = false;
+const noTestCommandsConn = MongoRunner.runMongod();
+assert.neq(null, noTestCommandsConn, "mongod was unable to start up");
+const noTestCommandsDb = noTestCommandsConn.getDB("test");
+assert.commandWorked(noTestCommandsDb.c.insert({a: 1}));
+assert.commandFailedWithCode(
+    noTestCommandsDb.runCommand({find: "c", $_degreeOfParallelism: 2}),
+    ErrorCodes.InvalidOptions);
+assert.commandFailedWithCode(
+    noTestCommandsDb.runCommand(
+        {aggregate: "c", pipeline: [], cursor: {}, $_degreeOfParallelism: 2}),
+    ErrorCodes.InvalidOptions);
+MongoRunner.stopMongod(noTestCommandsConn);
+TestData.enableTestCommands = true;
+})();
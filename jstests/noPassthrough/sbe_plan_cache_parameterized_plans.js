@@ -0,0 +1,69 @@
+/**
+ * Tests that the slot-based execution plans kept in the plan cache are reused by queries of the
+ * same shape with different constants, and that the reused plans are rebound to the constants of
+ * the filter and to the index bounds of every query.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        internalQueryEnableSlotBasedExecutionEngine: true,
+        internalQuerySlotBasedExecutionPlanCacheMaxEntriesPerCollection: 10
+    }
+});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.sbe_plan_cache_parameterized_plans;
+coll.drop();
+
+assert.commandWorked(coll.insert(Array.from({length: 200}, (_, i) => ({_id: i, a: i, b: i % 10}))));
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1}));
+
+function planCacheSbePlanHits() {
+    return db.serverStatus().metrics.query.planCacheSbePlanHits;
+}
+
+// The range on 'a' is much more selective than the one on 'b', so the index on 'a' always wins.
+function runQuery(low, bMax) {
+    return coll.find({a: {$gte: low, $lt: low + 10}, b: {$lt: bMax}}, {_id: 1})
+        .sort({_id: 1})
+        .toArray()
+        .map(doc => doc._id);
+}
+
+function expectedResults(low, bMax) {
+    const ids = [];
+    for (let i = low; i < low + 10; ++i) {
+        if (i % 10 < bMax) {
+            ids.push(i);
+        }
+    }
+    return ids;
+}
+
+// Create and activate the plan cache entry, then recover a solution from it, which builds the
+// plan that is kept in the cache.
+for (let i = 0; i < 3; ++i) {
+    assert.eq(expectedResults(10, 5), runQuery(10, 5));
+}
+const cachedPlans = coll.getPlanCache().list();
+assert.eq(1, cachedPlans.length, cachedPlans);
+assert(cachedPlans[0].isActive, cachedPlans);
+
+// Every other query of the same shape runs a clone of the cached plan, which must scan the index
+// bounds of that query and apply its own filter constants.
+let hits = planCacheSbePlanHits();
+for (let [low, bMax] of [[50, 5], [120, 3], [185, 8], [10, 5], [0, 10]]) {
+    assert.eq(expectedResults(low, bMax), runQuery(low, bMax), {low: low, bMax: bMax});
+    assert.eq(++hits, planCacheSbePlanHits(), {low: low, bMax: bMax});
+}
+
+// The cached plan is dropped along with the rest of the plan cache.
+coll.getPlanCache().clear();
+assert.eq(expectedResults(60, 5), runQuery(60, 5));
+assert.eq(hits, planCacheSbePlanHits());
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,40 @@
+/**
+ * Tests that an SBE collection scan which reads records in batches reads the records of a batch
+ * which it has not returned yet again after the query is saved and restored between batches of
+ * results, rather than returning them as they were before.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        internalQueryEnableSlotBasedExecutionEngine: true,
+        internalQuerySlotBasedExecutionScanBatchSize: 128,
+    }
+});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.sbe_scan_batch_yield;
+coll.drop();
+
+let docs = [];
+for (let i = 0; i < 20; ++i) {
+    docs.push({_id: i, a: i});
+}
+assert.commandWorked(coll.insert(docs));
+
+// All the documents are read into the scan's first batch, but only five of them are returned by the
+// first batch of results.
+const cursor = coll.find({a: {$gte: 0}}).batchSize(5);
+for (let i = 0; i < 5; ++i) {
+    assert.eq(cursor.next(), {_id: i, a: i});
+}
+
+// The rest of the documents are only returned if they still match when the cursor is resumed.
+assert.commandWorked(coll.updateMany({_id: {$gte: 10}}, {$set: {a: -1}}));
+assert.commandWorked(coll.remove({_id: 7}));
+assert.commandWorked(coll.update({_id: 8}, {$set: {b: 1}}));
+assert.eq(cursor.toArray(), [{_id: 5, a: 5}, {_id: 6, a: 6}, {_id: 8, a: 8, b: 1}, {_id: 9, a: 9}]);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -2,6 +2,9 @@
  *  Tests that initial sync is successfully able to clone the collection and build
  *  index without any orphan index entries even if a WriteConflictException is
  *  thrown while inserting documents into collections.
+ *
+ *  Documents appended through the storage engine's bulk load interface cannot be inserted again,
+ *  so on that path the failpoint fails the initial sync attempt, which is then retried.
  */
 
 const testName = "write_conflict_exception";
@@ -13,22 +16,45 @@ jsTest.log("Starting test");
 replSet.startSet();
 replSet.initiate();
 
-var secondary = replSet.getSecondary();
+const primaryColl = replSet.getPrimary().getDB("test").getCollection(testName);
+assert.commandWorked(primaryColl.insert(Array.from({length: 100}, (_, i) => ({_id: i, a: i}))));
+assert.commandWorked(primaryColl.createIndex({a: 1}));
+replSet.awaitReplication();
 
-// Start and restart secondary with fail point that throws exception enabled.
-jsTest.log("Stopping secondary");
-replSet.stop(secondary);
-jsTest.log("Re-starting secondary ");
-secondary = replSet.start(secondary, {
-    startClean: true,
-    setParameter: {"failpoint.failAfterBulkLoadDocInsert": "{'mode': {'times': 1}}"}
-});
+function runInitialSync(useStorageBulkLoad, expectedLogId) {
+    var secondary = replSet.getSecondary();
 
-// Wait for everything to be synced.
-jsTest.log("Waiting for initial sync to succeed");
-replSet.awaitSecondaryNodes();
+    // Start and restart secondary with fail point that throws exception enabled.
+    jsTest.log("Stopping secondary");
+    replSet.stop(secondary);
+    jsTest.log("Re-starting secondary with collectionBulkLoaderUseStorageBulkLoad: " +
+               useStorageBulkLoad);
+    secondary = replSet.start(secondary, {
+        startClean: true,
+        setParameter: {
+            "failpoint.failAfterBulkLoadDocInsert":
+                tojson({mode: {times: 1}, data: {collectionNS: primaryColl.getFullName()}}),
+            collectionBulkLoaderUseStorageBulkLoad: useStorageBulkLoad,
+        }
+    });
+
+    // Wait for everything to be synced.
+    jsTest.log("Waiting for initial sync to succeed");
+    replSet.awaitSecondaryNodes();
+    checkLog.containsJson(secondary, expectedLogId, {namespace: primaryColl.getFullName()});
+    replSet.checkReplicatedDataHashes();
+}
+
+// "Failpoint failAfterBulkLoadDocInsert enabled. Throwing WriteConflictException".
+runInitialSync(false, 20290);
+
+if (jsTest.options().storageEngine === undefined ||
+    jsTest.options().storageEngine === "wiredTiger") {
+    // "Failpoint failAfterBulkLoadDocInsert enabled. Failing the bulk load".
+    runInitialSync(true, 5130009);
+}
 
 // If the index table contains any entries pointing to invalid document(RecordID), then
 // validateCollections called during replica stopSet will capture the index corruption and throw
 // error.
-replSet.stopSet();
\ No newline at end of file
+replSet.stopSet();
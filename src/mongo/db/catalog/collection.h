@@ -401,6 +401,17 @@ public:
         const BSONObj& doc,
         const OnRecordInsertedFn& onRecordInserted) const = 0;
 
+    /**
+     * Like insertDocumentForBulkLoader(), but appends the document through 'bulkBuilder', which
+     * must have been obtained from this Collection's RecordStore. The record is written outside of
+     * the caller's storage transaction and OpObservers are not notified, so this must only be used
+     * for unreplicated writes to a collection that is dropped if the load fails.
+     */
+    virtual StatusWith<RecordId> appendDocumentForBulkLoader(
+        OperationContext* const opCtx,
+        const BSONObj& doc,
+        RecordStoreBulkBuilder* bulkBuilder) const = 0;
+
     /**
      * Updates the document @ oldLocation with newDoc.
      *
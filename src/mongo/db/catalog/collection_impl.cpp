@@ -133,6 +133,15 @@ Status checkFailCollectionInsertsFailPoint(const NamespaceString& ns, const BSON
     return s;
 }
 
+// Returns whether the failAfterBulkLoadDocInsert failpoint is enabled for a document of 'ns'.
+bool shouldFailAfterBulkLoadDocInsert(const NamespaceString& ns) {
+    return MONGO_unlikely(failAfterBulkLoadDocInsert.shouldFail([&](const BSONObj& data) {
+        // If the failpoint specifies no collection or matches the existing one, fail.
+        const auto collElem = data["collectionNS"];
+        return !collElem || ns.ns() == collElem.str();
+    }));
+}
+
 // Uses the collator factory to convert the BSON representation of a collator to a
 // CollatorInterface. Returns null if the BSONObj is empty. We expect the stored collation to be
 // valid, since it gets validated on collection create.
@@ -631,7 +640,7 @@ Status CollectionImpl::insertDocumentForBulkLoader(
 
     status = onRecordInserted(loc.getValue());
 
-    if (MONGO_unlikely(failAfterBulkLoadDocInsert.shouldFail())) {
+    if (shouldFailAfterBulkLoadDocInsert(_ns)) {
         LOGV2(20290,
               "Failpoint failAfterBulkLoadDocInsert enabled. Throwing "
               "WriteConflictException",
@@ -658,6 +667,39 @@ Status CollectionImpl::insertDocumentForBulkLoader(
     return loc.getStatus();
 }
 
+StatusWith<RecordId> CollectionImpl::appendDocumentForBulkLoader(
+    OperationContext* opCtx, const BSONObj& doc, RecordStoreBulkBuilder* bulkBuilder) const {
+
+    auto status = checkFailCollectionInsertsFailPoint(_ns, doc);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    status = checkValidation(opCtx, doc);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    dassert(opCtx->lockState()->isCollectionLockedForMode(ns(), MODE_IX));
+    invariant(!isCapped());
+
+    auto loc = bulkBuilder->addRecord(doc.objdata(), doc.objsize());
+    if (!loc.isOK()) {
+        return loc;
+    }
+
+    // The appended record cannot be rolled back and inserted again, so rather than throwing a
+    // WriteConflictException the failpoint fails the load.
+    if (shouldFailAfterBulkLoadDocInsert(_ns)) {
+        LOGV2(5130009,
+              "Failpoint failAfterBulkLoadDocInsert enabled. Failing the bulk load",
+              "namespace"_attr = _ns);
+        return {ErrorCodes::WriteConflict,
+                str::stream() << "Failpoint failAfterBulkLoadDocInsert enabled for " << _ns};
+    }
+    return loc;
+}
+
 Status CollectionImpl::_insertDocuments(OperationContext* opCtx,
                                         const std::vector<InsertStatement>::const_iterator begin,
                                         const std::vector<InsertStatement>::const_iterator end,
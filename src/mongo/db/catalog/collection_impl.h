@@ -200,6 +200,11 @@ public:
                                        const BSONObj& doc,
                                        const OnRecordInsertedFn& onRecordInserted) const final;
 
+    StatusWith<RecordId> appendDocumentForBulkLoader(
+        OperationContext* opCtx,
+        const BSONObj& doc,
+        RecordStoreBulkBuilder* bulkBuilder) const final;
+
     /**
      * Updates the document @ oldLocation with newDoc.
      *
@@ -160,6 +160,12 @@ public:
         std::abort();
     }
 
+    StatusWith<RecordId> appendDocumentForBulkLoader(OperationContext* opCtx,
+                                                     const BSONObj& doc,
+                                                     RecordStoreBulkBuilder* bulkBuilder) const {
+        std::abort();
+    }
+
     RecordId updateDocument(OperationContext* opCtx,
                             RecordId oldLocation,
                             const Snapshotted<BSONObj>& oldDoc,
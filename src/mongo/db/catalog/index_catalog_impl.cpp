@@ -661,7 +661,8 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
         }
 
         if ((pluginName != IndexNames::BTREE) && (pluginName != IndexNames::GEO_2DSPHERE) &&
-            (pluginName != IndexNames::HASHED) && (pluginName != IndexNames::WILDCARD)) {
+            (pluginName != IndexNames::HASHED) && (pluginName != IndexNames::WILDCARD) &&
+            (pluginName != IndexNames::COLUMN)) {
             return Status(ErrorCodes::CannotCreateIndex,
                           str::stream()
                               << "Index type '" << pluginName
@@ -671,7 +672,7 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
 
     const bool isSparse = spec["sparse"].trueValue();
 
-    if (pluginName == IndexNames::WILDCARD) {
+    if (pluginName == IndexNames::WILDCARD || pluginName == IndexNames::COLUMN) {
         if (isSparse) {
             return Status(ErrorCodes::CannotCreateIndex,
                           str::stream() << "Index type '" << pluginName
@@ -691,6 +692,14 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
         }
     }
 
+    // A columnstore index must hold every document of the collection, since queries answered from
+    // it never look at the collection itself.
+    if (pluginName == IndexNames::COLUMN && spec.getField("partialFilterExpression")) {
+        return Status(ErrorCodes::CannotCreateIndex,
+                      str::stream() << "Index type '" << pluginName
+                                    << "' does not support the partialFilterExpression option");
+    }
+
     // Create an ExpressionContext, used to parse the match expression and to house the collator for
     // the remaining checks.
     boost::intrusive_ptr<ExpressionContext> expCtx(
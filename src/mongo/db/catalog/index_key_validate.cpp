@@ -50,10 +50,12 @@
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/represent_as.h"
 #include "mongo/util/str.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 namespace index_key_validate {
@@ -137,7 +139,7 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
                                           << static_cast<int>(indexVersion)};
                 }
 
-                if (pluginName == IndexNames::WILDCARD) {
+                if (pluginName == IndexNames::WILDCARD || pluginName == IndexNames::COLUMN) {
                     return {code,
                             str::stream() << "'" << pluginName
                                           << "' index plugin is not allowed with index version v:"
@@ -184,6 +186,14 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
             return Status(code, "wildcard indexes do not allow compounding");
         }
 
+        // A columnstore index lists the paths it stores, so every field must name the plugin.
+        if (pluginName == IndexNames::COLUMN && keyElement.type() != String) {
+            return Status(code,
+                          str::stream() << "The key pattern value for every field of a '"
+                                        << IndexNames::COLUMN << "' index must be '"
+                                        << IndexNames::COLUMN << "'");
+        }
+
         // Ensure that the fields on which we are building the index are valid: a field must not
         // begin with a '$' unless it is part of a wildcard, DBRef or text index, and a field path
         // cannot contain an empty field. If a field cannot be created or updated, it should not be
@@ -234,6 +244,22 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
         }
     }
 
+    // A columnstore index rebuilds documents from one top-level field per column, so no two of its
+    // paths may share their first component.
+    if (pluginName == IndexNames::COLUMN) {
+        StringSet topLevelFields;
+        for (auto&& keyElement : key) {
+            FieldRef keyField(keyElement.fieldNameStringData());
+            if (!topLevelFields.insert(keyField.getPart(0).toString()).second) {
+                return Status(code,
+                              str::stream()
+                                  << "The paths of a '" << IndexNames::COLUMN
+                                  << "' index must not share a top-level field, but '"
+                                  << keyField.getPart(0) << "' appears more than once");
+            }
+        }
+    }
+
     return Status::OK();
 }
 
@@ -311,6 +337,13 @@ StatusWith<BSONObj> validateIndexSpec(
                 return keyPatternValidateStatus;
             }
 
+            if (IndexNames::findPluginName(keyPattern) == IndexNames::COLUMN &&
+                !feature_flags::gColumnstoreIndexes.isEnabled(featureCompatibility)) {
+                return {ErrorCodes::CannotCreateIndex,
+                        str::stream() << "'" << IndexNames::COLUMN
+                                      << "' indexes are not enabled in this version"};
+            }
+
             for (const auto& keyElement : indexSpecElem.Obj()) {
                 if (keyElement.type() == String && keyElement.str().empty()) {
                     return {ErrorCodes::CannotCreateIndex,
@@ -33,6 +33,7 @@
 
 #include "mongo/db/catalog/multi_index_block.h"
 
+#include <algorithm>
 #include <ostream>
 
 #include "mongo/base/error_codes.h"
@@ -49,16 +50,20 @@
 #include "mongo/db/op_observer.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/collection_query_info.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/repl_set_config.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/tenant_migration_committed_info.h"
 #include "mongo/db/repl/tenant_migration_conflict_info.h"
 #include "mongo/db/storage/execution_context.h"
 #include "mongo/db/storage/index_entry_comparison.h"
+#include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/progress_meter.h"
 #include "mongo/util/quick_exit.h"
@@ -75,6 +80,24 @@ MONGO_FAIL_POINT_DEFINE(hangIndexBuildDuringCollectionScanPhaseBeforeInsertion);
 MONGO_FAIL_POINT_DEFINE(hangIndexBuildDuringCollectionScanPhaseAfterInsertion);
 MONGO_FAIL_POINT_DEFINE(leaveIndexBuildUnfinishedForShutdown);
 
+namespace {
+
+// The number of ranges per thread that a parallel collection scan splits the collection into.
+constexpr size_t kParallelScanRangesPerThread = 4;
+
+/**
+ * A range (start, end] of RecordIds scanned by one of the threads of a parallel collection scan.
+ * 'cursor' is positioned on 'start', or unpositioned if the range starts at the beginning of the
+ * collection, and is detached from any OperationContext while not in use. A null 'end' means the
+ * range extends to the end of the collection.
+ */
+struct CollectionScanRange {
+    std::unique_ptr<SeekableRecordCursor> cursor;
+    RecordId end;
+};
+
+}  // namespace
+
 MultiIndexBlock::~MultiIndexBlock() {
     invariant(_buildIsCleanedUp);
 }
@@ -430,14 +453,8 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(
 
     unsigned long long n = 0;
 
-    PlanYieldPolicy::YieldPolicy yieldPolicy;
-    if (isBackgroundBuilding()) {
-        yieldPolicy = PlanYieldPolicy::YieldPolicy::YIELD_AUTO;
-    } else {
-        yieldPolicy = PlanYieldPolicy::YieldPolicy::WRITE_CONFLICT_RETRY_ONLY;
-    }
-    auto exec = collection->makePlanExecutor(
-        opCtx, collection, yieldPolicy, Collection::ScanDirection::kForward, resumeAfterRecordId);
+    const auto numScanThreads =
+        _getNumCollectionScanThreads(opCtx, collection, numRecords, resumeAfterRecordId);
 
     // Hint to the storage engine that this collection scan should not keep data in the cache.
     bool readOnce = useReadOnceCursorsForIndexBuilds.load();
@@ -451,40 +468,67 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(
                   IndexBuildPhase_serializer(_phase).toString());
         _phase = IndexBuildPhaseEnum::kCollectionScan;
 
-        BSONObj objToIndex;
-        RecordId loc;
-        PlanExecutor::ExecState state;
-        while (PlanExecutor::ADVANCED == (state = exec->getNext(&objToIndex, &loc)) ||
-               MONGO_unlikely(hangAfterStartingIndexBuild.shouldFail())) {
-            opCtx->checkForInterrupt();
+        boost::optional<unsigned long long> numScannedInParallel;
+        if (numScanThreads > 1) {
+            numScannedInParallel =
+                _scanCollectionInParallel(opCtx, collection, numScanThreads, &progress);
+        }
+
+        if (numScannedInParallel) {
+            n = *numScannedInParallel;
 
-            if (PlanExecutor::ADVANCED != state) {
-                continue;
+            // Hang once the whole collection has been scanned, as the serial scan does.
+            while (MONGO_unlikely(hangAfterStartingIndexBuild.shouldFail())) {
+                opCtx->sleepFor(Milliseconds(10));
             }
+        } else {
+            PlanYieldPolicy::YieldPolicy yieldPolicy;
+            if (isBackgroundBuilding()) {
+                yieldPolicy = PlanYieldPolicy::YieldPolicy::YIELD_AUTO;
+            } else {
+                yieldPolicy = PlanYieldPolicy::YieldPolicy::WRITE_CONFLICT_RETRY_ONLY;
+            }
+            auto exec = collection->makePlanExecutor(opCtx,
+                                                     collection,
+                                                     yieldPolicy,
+                                                     Collection::ScanDirection::kForward,
+                                                     resumeAfterRecordId);
+
+            BSONObj objToIndex;
+            RecordId loc;
+            PlanExecutor::ExecState state;
+            while (PlanExecutor::ADVANCED == (state = exec->getNext(&objToIndex, &loc)) ||
+                   MONGO_unlikely(hangAfterStartingIndexBuild.shouldFail())) {
+                opCtx->checkForInterrupt();
+
+                if (PlanExecutor::ADVANCED != state) {
+                    continue;
+                }
 
-            progress->setTotalWhileRunning(collection->numRecords(opCtx));
+                progress->setTotalWhileRunning(collection->numRecords(opCtx));
+
+                uassertStatusOK(_failPointHangDuringBuild(
+                    opCtx,
+                    &hangIndexBuildDuringCollectionScanPhaseBeforeInsertion,
+                    "before",
+                    objToIndex,
+                    n));
+
+                // The external sorter is not part of the storage engine and therefore does not
+                // need a WriteUnitOfWork to write keys.
+                uassertStatusOK(_insert(opCtx, objToIndex, loc));
 
-            uassertStatusOK(
                 _failPointHangDuringBuild(opCtx,
-                                          &hangIndexBuildDuringCollectionScanPhaseBeforeInsertion,
-                                          "before",
+                                          &hangIndexBuildDuringCollectionScanPhaseAfterInsertion,
+                                          "after",
                                           objToIndex,
-                                          n));
-
-            // The external sorter is not part of the storage engine and therefore does not need a
-            // WriteUnitOfWork to write keys.
-            uassertStatusOK(_insert(opCtx, objToIndex, loc));
-
-            _failPointHangDuringBuild(opCtx,
-                                      &hangIndexBuildDuringCollectionScanPhaseAfterInsertion,
-                                      "after",
-                                      objToIndex,
-                                      n)
-                .ignore();
-
-            // Go to the next document.
-            progress->hit();
-            n++;
+                                          n)
+                    .ignore();
+
+                // Go to the next document.
+                progress->hit();
+                n++;
+            }
         }
     } catch (DBException& ex) {
         if (ex.isA<ErrorCategory::Interruption>() || ex.isA<ErrorCategory::ShutdownError>() ||
@@ -595,6 +639,318 @@ Status MultiIndexBlock::_insert(OperationContext* opCtx, const BSONObj& doc, con
     return Status::OK();
 }
 
+size_t MultiIndexBlock::_getNumCollectionScanThreads(
+    OperationContext* opCtx,
+    const CollectionPtr& collection,
+    long long numRecords,
+    const boost::optional<RecordId>& resumeAfterRecordId) const {
+    const auto maxThreads = maxIndexBuildCollectionScanThreads.load();
+    if (maxThreads <= 1 || numRecords < indexBuildParallelCollectionScanMinRecords.load()) {
+        return 1;
+    }
+
+    // Only hybrid builds tolerate a collection scan that does not read from a single snapshot.
+    // Resumed builds and capped collections, whose documents may be deleted while they are being
+    // scanned, are scanned serially.
+    if (!isBackgroundBuilding() || resumeAfterRecordId || collection->isCapped() ||
+        opCtx->inMultiDocumentTransaction()) {
+        return 1;
+    }
+
+    // The scanning threads acquire intent locks of their own, which conflict with the strong locks
+    // held by callers that do not allow concurrent writes during the build.
+    auto locker = opCtx->lockState();
+    if (locker->isNoop() || locker->isW() ||
+        locker->isCollectionLockedForMode(collection->ns(), MODE_S)) {
+        return 1;
+    }
+
+    return static_cast<size_t>(maxThreads);
+}
+
+boost::optional<unsigned long long> MultiIndexBlock::_scanCollectionInParallel(
+    OperationContext* opCtx,
+    const CollectionPtr& collection,
+    size_t numThreads,
+    ProgressMeterHolder* progress) {
+    const NamespaceStringOrUUID dbAndUUID(collection->ns().db().toString(), collection->uuid());
+
+    // Split the collection into ranges (start, end] at randomly sampled RecordIds. Sampling more
+    // split points than there are threads lets threads that finish early pick up the remaining
+    // ranges. Each range is represented by a cursor positioned on its start, which is created in
+    // the snapshot the split points were sampled from so that every start exists.
+    std::vector<CollectionScanRange> ranges;
+    writeConflictRetry(opCtx, "splitCollectionForIndexBuild", collection->ns().ns(), [&] {
+        ranges.clear();
+
+        std::set<RecordId> splitPoints;
+        if (auto randomCursor = collection->getRecordStore()->getRandomCursor(opCtx)) {
+            for (size_t i = 0; i < numThreads * kParallelScanRangesPerThread; ++i) {
+                auto record = randomCursor->next();
+                if (!record) {
+                    break;
+                }
+                splitPoints.insert(record->id);
+            }
+        }
+
+        RecordId start;
+        auto addRange = [&](const RecordId& end) {
+            auto cursor = collection->getCursor(opCtx);
+            if (!start.isNull()) {
+                invariant(cursor->seekExact(start));
+            }
+            cursor->save();
+            cursor->detachFromOperationContext();
+            ranges.push_back({std::move(cursor), end});
+            start = end;
+        };
+        for (const auto& splitPoint : splitPoints) {
+            addRange(splitPoint);
+        }
+        addRange(RecordId());
+    });
+
+    // Each thread gets an equal share of the memory budget of every index.
+    struct ScanThreadState {
+        std::vector<std::unique_ptr<IndexAccessMethod::BulkBuilder>> bulks;
+        RecordId lastRecordId;
+    };
+    std::vector<ScanThreadState> threadStates(numThreads);
+    for (auto& threadState : threadStates) {
+        for (const auto& index : _indexes) {
+            threadState.bulks.push_back(index.real->initiateBulk(
+                std::max(_eachIndexBuildMaxMemoryUsageBytes / numThreads, size_t{1}), boost::none));
+        }
+    }
+
+    const auto readSource = opCtx->recoveryUnit()->getTimestampReadSource();
+    const auto readTimestamp = readSource == RecoveryUnit::ReadSource::kProvided
+        ? opCtx->recoveryUnit()->getPointInTimeReadTimestamp(opCtx)
+        : boost::none;
+    const bool readOnce = opCtx->recoveryUnit()->getReadOnce();
+
+    auto mutex = MONGO_MAKE_LATCH("MultiIndexBlock::_scanCollectionInParallel");
+    stdx::condition_variable cv;
+    size_t numThreadsFinished = 0;
+    Status scanStatus = Status::OK();
+    AtomicWord<bool> aborted{false};
+    AtomicWord<size_t> nextRange{0};
+    AtomicWord<unsigned long long> numScanned{0};
+
+    // The OperationContexts of the threads, which are killed when the scan is aborted so that
+    // threads waiting for a lock or on a fail point stop as well.
+    std::vector<OperationContext*> threadOpCtxs;
+    auto abortScan = [&](WithLock, ErrorCodes::Error code) {
+        aborted.store(true);
+        for (auto threadOpCtx : threadOpCtxs) {
+            stdx::lock_guard<Client> clientLock(*threadOpCtx->getClient());
+            threadOpCtx->getServiceContext()->killOperation(clientLock, threadOpCtx, code);
+        }
+    };
+
+    auto scanRanges = [&](ScanThreadState* threadState) {
+        auto threadOpCtx = cc().makeOperationContext();
+        ShouldNotConflictWithSecondaryBatchApplicationBlock noPBWMBlock(
+            threadOpCtx->lockState());
+        threadOpCtx->recoveryUnit()->setTimestampReadSource(readSource, readTimestamp);
+        threadOpCtx->recoveryUnit()->setReadOnce(readOnce);
+        if (opCtx->hasDeadline()) {
+            threadOpCtx->setDeadlineByDate(opCtx->getDeadline(), opCtx->getTimeoutError());
+        }
+
+        {
+            stdx::lock_guard<Latch> lk(mutex);
+            if (aborted.load()) {
+                return;
+            }
+            threadOpCtxs.push_back(threadOpCtx.get());
+        }
+        ON_BLOCK_EXIT([&] {
+            stdx::lock_guard<Latch> lk(mutex);
+            threadOpCtxs.erase(
+                std::find(threadOpCtxs.begin(), threadOpCtxs.end(), threadOpCtx.get()));
+        });
+
+        for (size_t i = nextRange.fetchAndAdd(1); i < ranges.size() && !aborted.load();
+             i = nextRange.fetchAndAdd(1)) {
+            auto& range = ranges[i];
+
+            // Release the locks and the snapshot periodically, as a yielding collection scan
+            // would. The cursor is detached while no locks are held.
+            bool rangeExhausted = false;
+            while (!rangeExhausted && !aborted.load()) {
+                AutoGetCollection autoColl(threadOpCtx.get(), dbAndUUID, MODE_IX);
+                uassert(ErrorCodes::NamespaceNotFound,
+                        str::stream() << "Collection " << dbAndUUID.toString()
+                                      << " was dropped during the collection scan",
+                        autoColl.getCollection());
+
+                range.cursor->reattachToOperationContext(threadOpCtx.get());
+                auto resetCursor = makeGuard([&] { range.cursor.reset(); });
+                range.cursor->restore();
+
+                const int yieldIterations = internalQueryExecYieldIterations.load();
+                for (int iterations = 0; iterations < yieldIterations && !aborted.load();) {
+                    threadOpCtx->checkForInterrupt();
+
+                    boost::optional<Record> record;
+                    try {
+                        record = range.cursor->next();
+                    } catch (const WriteConflictException&) {
+                        range.cursor->save();
+                        threadOpCtx->recoveryUnit()->abandonSnapshot();
+                        range.cursor->restore();
+                        continue;
+                    }
+
+                    if (!record || (!range.end.isNull() && record->id > range.end)) {
+                        rangeExhausted = true;
+                        break;
+                    }
+
+                    const auto doc = record->data.toBson();
+                    const auto iteration = numScanned.fetchAndAdd(1);
+                    uassertStatusOK(_failPointHangDuringBuild(
+                        threadOpCtx.get(),
+                        &hangIndexBuildDuringCollectionScanPhaseBeforeInsertion,
+                        "before",
+                        doc,
+                        iteration));
+
+                    for (size_t j = 0; j < _indexes.size(); ++j) {
+                        if (_indexes[j].filterExpression &&
+                            !_indexes[j].filterExpression->matchesBSON(doc)) {
+                            continue;
+                        }
+                        uassertStatusOK(threadState->bulks[j]->insert(
+                            threadOpCtx.get(), doc, record->id, _indexes[j].options));
+                    }
+
+                    _failPointHangDuringBuild(
+                        threadOpCtx.get(),
+                        &hangIndexBuildDuringCollectionScanPhaseAfterInsertion,
+                        "after",
+                        doc,
+                        iteration)
+                        .ignore();
+
+                    threadState->lastRecordId = std::max(threadState->lastRecordId, record->id);
+                    ++iterations;
+                }
+
+                range.cursor->save();
+                range.cursor->detachFromOperationContext();
+                resetCursor.dismiss();
+                threadOpCtx->recoveryUnit()->abandonSnapshot();
+            }
+            range.cursor.reset();
+        }
+    };
+
+    // Release the locks of the index build while the threads scan, as a yielding collection scan
+    // would, so that the threads do not queue behind operations waiting for a conflicting lock.
+    // Locks which are held recursively cannot be released, and the threads could then wait forever
+    // for a lock queued behind those of the index build, so the collection is scanned serially.
+    collection.yield();
+    Locker::LockSnapshot lockInfo;
+    if (!opCtx->lockState()->saveLockStateAndUnlock(&lockInfo)) {
+        collection.restore();
+        for (auto& range : ranges) {
+            range.cursor->reattachToOperationContext(opCtx);
+        }
+        ranges.clear();
+        return boost::none;
+    }
+    ON_BLOCK_EXIT([&] {
+        UninterruptibleLockGuard noInterrupt(opCtx->lockState());
+        opCtx->lockState()->restoreLockState(opCtx, lockInfo);
+        opCtx->recoveryUnit()->abandonSnapshot();
+        collection.restore();
+    });
+
+    ThreadPool::Options options;
+    options.poolName = "IndexBuildCollectionScan";
+    options.threadNamePrefix = "IndexBuildCollectionScan-";
+    options.minThreads = 0;
+    options.maxThreads = numThreads;
+    options.onCreateThread = [](const std::string& name) { Client::initThread(name); };
+    ThreadPool pool(options);
+    pool.startup();
+    ON_BLOCK_EXIT([&] {
+        // The threads are still running if the wait for them below was interrupted.
+        auto interruptStatus = opCtx->checkForInterruptNoAssert();
+        {
+            stdx::lock_guard<Latch> lk(mutex);
+            abortScan(lk,
+                      interruptStatus.isOK() ? ErrorCodes::IndexBuildAborted
+                                             : interruptStatus.code());
+        }
+        pool.shutdown();
+        pool.join();
+    });
+
+    for (auto& threadState : threadStates) {
+        pool.schedule([&, state = &threadState](Status status) {
+            if (status.isOK()) {
+                try {
+                    scanRanges(state);
+                } catch (...) {
+                    status = exceptionToStatus();
+                }
+            }
+
+            stdx::lock_guard<Latch> lk(mutex);
+            if (!status.isOK() && scanStatus.isOK()) {
+                scanStatus = status;
+                abortScan(lk, ErrorCodes::IndexBuildAborted);
+            }
+            ++numThreadsFinished;
+            cv.notify_all();
+        });
+    }
+
+    unsigned long long numReported = 0;
+    auto reportProgress = [&] {
+        const auto scanned = numScanned.load();
+        progress->hit(static_cast<int>(scanned - numReported));
+        numReported = scanned;
+    };
+
+    {
+        stdx::unique_lock<Latch> lk(mutex);
+        while (!opCtx->waitForConditionOrInterruptFor(
+            cv, lk, Milliseconds(100), [&] { return numThreadsFinished == numThreads; })) {
+            reportProgress();
+        }
+        uassertStatusOK(scanStatus);
+    }
+    reportProgress();
+
+    // All threads have finished successfully, so every record of the collection has been scanned.
+    for (size_t i = 0; i < _indexes.size(); ++i) {
+        for (auto& threadState : threadStates) {
+            _indexes[i].bulk->merge(std::move(threadState.bulks[i]));
+        }
+    }
+    for (const auto& threadState : threadStates) {
+        if (!threadState.lastRecordId.isNull() &&
+            (!_lastRecordIdInserted || threadState.lastRecordId > *_lastRecordIdInserted)) {
+            _lastRecordIdInserted = threadState.lastRecordId;
+        }
+    }
+    _scannedCollectionInParallel = true;
+
+    LOGV2(5130000,
+          "Index build: scanned collection in parallel",
+          "buildUUID"_attr = _buildUUID,
+          "threads"_attr = numThreads,
+          "ranges"_attr = ranges.size(),
+          "totalRecords"_attr = numReported);
+
+    return numReported;
+}
+
 Status MultiIndexBlock::dumpInsertsFromBulk(OperationContext* opCtx,
                                             const CollectionPtr& collection) {
     return dumpInsertsFromBulk(opCtx, collection, nullptr);
@@ -847,8 +1203,15 @@ void MultiIndexBlock::abortWithoutCleanup(OperationContext* opCtx,
             invariant(IndexBuildPhaseEnum::kBulkLoad != _phase, str::stream() << *_buildUUID);
         }
 
-        _writeStateToDisk(opCtx, collection);
-        action = TemporaryRecordStore::FinalizationAction::kKeep;
+        if (_scannedCollectionInParallel && IndexBuildPhaseEnum::kDrainWrites != _phase) {
+            LOGV2(5130001,
+                  "Index build: not resumable because the collection was scanned in parallel",
+                  "buildUUID"_attr = _buildUUID,
+                  "phase"_attr = IndexBuildPhase_serializer(_phase));
+        } else {
+            _writeStateToDisk(opCtx, collection);
+            action = TemporaryRecordStore::FinalizationAction::kKeep;
+        }
     }
 
     for (auto& index : _indexes) {
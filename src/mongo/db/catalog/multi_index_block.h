@@ -60,6 +60,7 @@ class CollectionPtr;
 class MatchExpression;
 class NamespaceString;
 class OperationContext;
+class ProgressMeterHolder;
 
 /**
  * Builds one or more indexes.
@@ -319,6 +320,30 @@ private:
 
     Status _insert(OperationContext* opCtx, const BSONObj& wholeDocument, const RecordId& loc);
 
+    /**
+     * Returns the number of threads the collection scan of insertAllDocumentsInCollection() should
+     * use. Returns 1 if the collection must be scanned serially.
+     */
+    size_t _getNumCollectionScanThreads(OperationContext* opCtx,
+                                        const CollectionPtr& collection,
+                                        long long numRecords,
+                                        const boost::optional<RecordId>& resumeAfterRecordId) const;
+
+    /**
+     * Splits the collection into ranges of RecordIds and scans them on 'numThreads' threads. Each
+     * thread generates keys into its own BulkBuilder per index, which are merged into the
+     * BulkBuilders of '_indexes' once the whole collection has been scanned. The locks held by
+     * 'opCtx' are released while the threads run, and the threads are interrupted along with
+     * 'opCtx'. Returns the number of documents scanned, or boost::none without scanning if the
+     * locks of 'opCtx' cannot be released, in which case the collection must be scanned serially.
+     * Throws if the scan is interrupted or fails, in which case no keys are added to '_indexes'.
+     */
+    boost::optional<unsigned long long> _scanCollectionInParallel(
+        OperationContext* opCtx,
+        const CollectionPtr& collection,
+        size_t numThreads,
+        ProgressMeterHolder* progress);
+
     // Is set during init() and ensures subsequent function calls act on the same Collection.
     boost::optional<UUID> _collectionUUID;
 
@@ -342,6 +367,11 @@ private:
     // or boost::none if nothing has been inserted.
     boost::optional<RecordId> _lastRecordIdInserted;
 
+    // Set to true when the collection scan was done in parallel. The keys of the per-thread
+    // BulkBuilders are held in more than one Sorter file, which the resumable index build state
+    // cannot describe, so the build is no longer resumable after this point.
+    bool _scannedCollectionInParallel = false;
+
     // The current phase of the index build.
     IndexBuildPhaseEnum _phase = IndexBuildPhaseEnum::kInitialized;
 };
@@ -32,9 +32,12 @@
 #include "mongo/db/catalog/multi_index_block.h"
 
 #include "mongo/db/catalog/catalog_test_fixture.h"
+#include "mongo/db/catalog/multi_index_block_gen.h"
 #include "mongo/db/catalog_raii.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/index/index_access_method.h"
 #include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/repl/storage_interface.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -44,11 +47,14 @@ namespace {
  * Unit test for MultiIndexBlock to verify basic functionality.
  */
 class MultiIndexBlockTest : public CatalogTestFixture {
-private:
+public:
+    MultiIndexBlockTest() = default;
+    explicit MultiIndexBlockTest(std::string engine) : CatalogTestFixture(std::move(engine)) {}
+
+protected:
     void setUp() override;
     void tearDown() override;
 
-protected:
     NamespaceString getNSS() const {
         return _nss;
     }
@@ -183,5 +189,130 @@ TEST_F(MultiIndexBlockTest, InitWriteConflictException) {
     indexer->abortIndexBuild(operationContext(), coll, MultiIndexBlock::kNoopOnCleanUpFn);
 }
 
+/**
+ * Runs index builds whose collection scan is split up between several threads. The collection is
+ * stored in WiredTiger, whose random cursors split it into several ranges.
+ */
+class MultiIndexBlockParallelScanTest : public MultiIndexBlockTest {
+public:
+    MultiIndexBlockParallelScanTest() : MultiIndexBlockTest("wiredTiger") {}
+
+protected:
+    static constexpr int kNumDocs = 1000;
+
+    void setUp() override {
+        MultiIndexBlockTest::setUp();
+        _maxThreads = maxIndexBuildCollectionScanThreads.load();
+        _minRecords = indexBuildParallelCollectionScanMinRecords.load();
+        maxIndexBuildCollectionScanThreads.store(4);
+        indexBuildParallelCollectionScanMinRecords.store(0);
+    }
+
+    void tearDown() override {
+        maxIndexBuildCollectionScanThreads.store(_maxThreads);
+        indexBuildParallelCollectionScanMinRecords.store(_minRecords);
+        MultiIndexBlockTest::tearDown();
+    }
+
+    /**
+     * Inserts 'kNumDocs' documents whose field 'a' holds the array [i, -i - 1] and whose field 'b'
+     * holds i, except for the first and the last document, whose field 'b' holds the same value.
+     */
+    void insertDocuments() {
+        std::vector<InsertStatement> docs;
+        for (int i = 0; i < kNumDocs; ++i) {
+            const int b = (i == kNumDocs - 1) ? 0 : i;
+            docs.emplace_back(BSON("_id" << i << "a" << BSON_ARRAY(i << -i - 1) << "b" << b));
+        }
+        ASSERT_OK(storageInterface()->insertDocuments(operationContext(), getNSS(), docs));
+    }
+
+    void initIndexBuild(const BSONObj& keyPattern, bool unique) {
+        AutoGetCollection autoColl(operationContext(), getNSS(), MODE_X);
+        CollectionWriter coll(autoColl);
+
+        auto spec = BSON("key" << keyPattern << "name"
+                               << "index"
+                               << "unique" << unique << "v"
+                               << static_cast<int>(IndexDescriptor::kLatestIndexVersion));
+        WriteUnitOfWork wuow(operationContext());
+        ASSERT_OK(getIndexer()
+                      ->init(operationContext(), coll, {spec}, MultiIndexBlock::kNoopOnInitFn)
+                      .getStatus());
+        wuow.commit();
+    }
+
+    /**
+     * Commits the index build and checks that the index holds 'numKeys' keys.
+     */
+    void commitIndexBuild(long long numKeys, bool isMultikey) {
+        {
+            AutoGetCollection autoColl(operationContext(), getNSS(), MODE_X);
+            CollectionWriter coll(autoColl);
+            WriteUnitOfWork wuow(operationContext());
+            ASSERT_OK(getIndexer()->commit(operationContext(),
+                                           coll.getWritableCollection(),
+                                           MultiIndexBlock::kNoopOnCreateEachFn,
+                                           MultiIndexBlock::kNoopOnCommitFn));
+            wuow.commit();
+        }
+
+        AutoGetCollection autoColl(operationContext(), getNSS(), MODE_IS);
+        auto indexCatalog = autoColl.getCollection()->getIndexCatalog();
+        auto entry = indexCatalog->getEntry(
+            indexCatalog->findIndexByName(operationContext(), "index"));
+        ASSERT_EQ(numKeys,
+                  entry->accessMethod()->getSortedDataInterface()->numEntries(operationContext()));
+        ASSERT_EQ(isMultikey, entry->isMultikey());
+    }
+
+private:
+    int _maxThreads = 0;
+    long long _minRecords = 0;
+};
+
+TEST_F(MultiIndexBlockParallelScanTest, MergesTheKeysOfEveryThread) {
+    insertDocuments();
+    initIndexBuild(BSON("a" << 1), false /* unique */);
+    {
+        AutoGetCollection autoColl(operationContext(), getNSS(), MODE_IX);
+        ASSERT_OK(getIndexer()->insertAllDocumentsInCollection(operationContext(),
+                                                               autoColl.getCollection()));
+        ASSERT_OK(getIndexer()->checkConstraints(operationContext(), autoColl.getCollection()));
+    }
+    commitIndexBuild(2 * kNumDocs, true /* isMultikey */);
+}
+
+TEST_F(MultiIndexBlockParallelScanTest, ScansSeriallyWhenLocksAreHeldRecursively) {
+    insertDocuments();
+    initIndexBuild(BSON("a" << 1), false /* unique */);
+    {
+        // The locks of the index build cannot be released while the threads scan the collection,
+        // so the scan must not be split up between threads which need conflicting locks.
+        AutoGetCollection outerColl(operationContext(), getNSS(), MODE_IX);
+        AutoGetCollection autoColl(operationContext(), getNSS(), MODE_IX);
+        ASSERT_OK(getIndexer()->insertAllDocumentsInCollection(operationContext(),
+                                                               autoColl.getCollection()));
+        ASSERT_OK(getIndexer()->checkConstraints(operationContext(), autoColl.getCollection()));
+    }
+    commitIndexBuild(2 * kNumDocs, true /* isMultikey */);
+}
+
+TEST_F(MultiIndexBlockParallelScanTest, DetectsDuplicateKeysScannedByDifferentThreads) {
+    insertDocuments();
+    initIndexBuild(BSON("b" << 1), true /* unique */);
+
+    AutoGetCollection autoColl(operationContext(), getNSS(), MODE_IX);
+    auto status = getIndexer()->insertAllDocumentsInCollection(operationContext(),
+                                                               autoColl.getCollection());
+    if (status.isOK()) {
+        status = getIndexer()->checkConstraints(operationContext(), autoColl.getCollection());
+    }
+    ASSERT_EQ(ErrorCodes::DuplicateKey, status);
+
+    CollectionWriter coll(autoColl);
+    getIndexer()->abortIndexBuild(operationContext(), coll, MultiIndexBlock::kNoopOnCleanUpFn);
+}
+
 }  // namespace
 }  // namespace mongo
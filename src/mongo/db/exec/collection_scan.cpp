@@ -41,6 +41,7 @@
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/db/storage/oplog_hack.h"
 #include "mongo/logv2/log.h"
@@ -53,6 +54,11 @@ namespace mongo {
 using std::unique_ptr;
 using std::vector;
 
+namespace {
+// Upper bound on the amount of record data buffered by a single read-ahead batch.
+const size_t kReadAheadMaxBytes = 1024 * 1024;
+}  // namespace
+
 // static
 const char* CollectionScan::kStageType = "COLLSCAN";
 
@@ -64,7 +70,9 @@ CollectionScan::CollectionScan(ExpressionContext* expCtx,
     : RequiresCollectionStage(kStageType, expCtx, collection),
       _workingSet(workingSet),
       _filter((filter && !filter->isTriviallyTrue()) ? filter : nullptr),
-      _params(params) {
+      _params(params),
+      _useReadAhead(!params.tailable && !collection->ns().isOplog() &&
+                    internalQueryCollectionScanReadAheadMaxRecords.load() > 1) {
     // Explain reports the direction of the collection scan.
     _specificStats.direction = params.direction;
     _specificStats.minTs = params.minTs;
@@ -185,7 +193,7 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         }
 
         if (!record) {
-            record = _cursor->next();
+            record = _useReadAhead ? nextReadAheadRecord() : _cursor->next();
         }
     } catch (const WriteConflictException&) {
         // Leave us in a state to try again next time.
@@ -217,12 +225,53 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
     WorkingSetID id = _workingSet->allocate();
     WorkingSetMember* member = _workingSet->get(id);
     member->recordId = record->id;
-    member->resetDocument(opCtx()->recoveryUnit()->getSnapshotId(), record->data.releaseToBson());
+    member->resetDocument(_useReadAhead && !_readAheadBatchIsStale
+                              ? _readAheadSnapshotId
+                              : opCtx()->recoveryUnit()->getSnapshotId(),
+                          record->data.releaseToBson());
     _workingSet->transitionToRecordIdAndObj(id);
 
     return returnIfMatches(member, id, out);
 }
 
+boost::optional<Record> CollectionScan::nextReadAheadRecord() {
+    if (_readAheadPosition == _readAheadBatch.size()) {
+        _readAheadBatch.clear();
+        _readAheadPosition = 0;
+        _readAheadBatchIsStale = false;
+
+        // Start with a single record so that scans which stop early, e.g. because of a limit, do
+        // not read more than they need, then grow the batch as the scan keeps asking for more.
+        const size_t maxBatchSize = internalQueryCollectionScanReadAheadMaxRecords.load();
+        _readAheadBatchSize = std::min(std::max(_readAheadBatchSize * 2, size_t(1)), maxBatchSize);
+        _readAheadSnapshotId = opCtx()->recoveryUnit()->getSnapshotId();
+
+        // If this throws a WriteConflictException, the records appended so far stay in the batch
+        // and the cursor remains positioned on the last of them.
+        _cursor->nextBatch(&_readAheadBatch, _readAheadBatchSize, kReadAheadMaxBytes);
+    }
+
+    if (!_readAheadBatchIsStale) {
+        if (_readAheadPosition == _readAheadBatch.size()) {
+            return boost::none;
+        }
+        return _readAheadBatch[_readAheadPosition++];
+    }
+
+    // We yielded since the batch was read, so the records may have been updated or deleted. Read
+    // them again in the current snapshot. The cursor still follows the last record of the batch.
+    while (_readAheadPosition < _readAheadBatch.size()) {
+        const RecordId& id = _readAheadBatch[_readAheadPosition].id;
+        RecordData data;
+        const bool found = collection()->getRecordStore()->findRecord(opCtx(), id, &data);
+        ++_readAheadPosition;
+        if (found) {
+            return Record{id, data.getOwned()};
+        }
+    }
+    return nextReadAheadRecord();
+}
+
 void CollectionScan::setLatestOplogEntryTimestamp(const Record& record) {
     auto tsElem = record.data.toBson()[repl::OpTime::kTimestampFieldName];
     uassert(ErrorCodes::Error(4382100),
@@ -278,6 +327,9 @@ void CollectionScan::doSaveStateRequiresCollection() {
     if (_cursor) {
         _cursor->save();
     }
+    if (_readAheadPosition < _readAheadBatch.size()) {
+        _readAheadBatchIsStale = true;
+    }
 }
 
 void CollectionScan::doRestoreStateRequiresCollection() {
@@ -35,12 +35,12 @@
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/record_id.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/db/storage/snapshot.h"
 #include "mongo/s/resharding/resume_token_gen.h"
 
 namespace mongo {
 
-struct Record;
-class SeekableRecordCursor;
 class WorkingSet;
 class OperationContext;
 
@@ -115,6 +115,14 @@ private:
      */
     void assertMinTsHasNotFallenOffOplog(const Record& record);
 
+    /**
+     * Returns the next record from '_readAheadBatch', refilling the batch from '_cursor' once it
+     * has been consumed. Returns boost::none at EOF. The returned record is valid until the batch
+     * is next refilled. The records left in the batch when we yield are read again from the
+     * collection, and skipped if they were deleted in the meantime.
+     */
+    boost::optional<Record> nextReadAheadRecord();
+
     // WorkingSet is not owned by us.
     WorkingSet* _workingSet;
 
@@ -132,6 +140,21 @@ private:
 
     RecordId _lastSeenId;  // Null if nothing has been returned from _cursor yet.
 
+    // Whether records are read from '_cursor' in batches. Only used for non-tailable scans of
+    // collections other than the oplog, where the cursor position never needs to be re-established
+    // from '_lastSeenId'.
+    const bool _useReadAhead;
+
+    // Records read from '_cursor' but not yet returned. The cursor is positioned on the last record
+    // of the batch. '_readAheadSnapshotId' is the snapshot the batch was read in.
+    // '_readAheadBatchIsStale' is set when we yield while returning records from the batch, after
+    // which their data may no longer match the collection.
+    RecordBatch _readAheadBatch;
+    size_t _readAheadPosition = 0;
+    size_t _readAheadBatchSize = 0;
+    SnapshotId _readAheadSnapshotId;
+    bool _readAheadBatchIsStale = false;
+
     // If _params.shouldTrackLatestOplogTimestamp is set and the collection is the oplog, the latest
     // timestamp seen in the collection.  Otherwise, this is a null timestamp.
     Timestamp _latestOplogEntryTimestamp;
@@ -0,0 +1,230 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/column_scan.h"
+
+#include <algorithm>
+
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/exec/working_set.h"
+#include "mongo/db/field_ref.h"
+#include "mongo/db/index/column_key_generator.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/storage/index_entry_comparison.h"
+
+namespace mongo {
+
+// static
+const char* ColumnScanStage::kStageType = "COLUMN_SCAN";
+
+ColumnScanStage::ColumnScanStage(ExpressionContext* expCtx,
+                                 const CollectionPtr& collection,
+                                 const IndexDescriptor* descriptor,
+                                 std::vector<std::string> fields,
+                                 WorkingSet* workingSet)
+    : RequiresIndexStage(kStageType, expCtx, collection, descriptor, workingSet),
+      _workingSet(workingSet) {
+    _specificStats.indexName = descriptor->indexName();
+    _specificStats.keyPattern = descriptor->keyPattern();
+    _specificStats.fields = std::move(fields);
+
+    // The planner lists the fields in key pattern order, so a single pass finds their columns.
+    size_t column = 0;
+    auto field = _specificStats.fields.begin();
+    for (auto&& keyElem : _specificStats.keyPattern) {
+        if (field != _specificStats.fields.end() && keyElem.fieldNameStringData() == *field) {
+            _columns.push_back(
+                {column, FieldRef(*field).getPart(0).toString(), nullptr, boost::none});
+            ++field;
+        }
+        ++column;
+    }
+    invariant(field == _specificStats.fields.end());
+    invariant(!_columns.empty());
+}
+
+PlanStage::StageState ColumnScanStage::doWork(WorkingSetID* out) {
+    if (_commonStats.isEOF)
+        return PlanStage::IS_EOF;
+
+    const auto keyStringVersion =
+        indexAccessMethod()->getSortedDataInterface()->getKeyStringVersion();
+    const auto ordering = indexAccessMethod()->getSortedDataInterface()->getOrdering();
+
+    // After a yield, every column is positioned afresh on the first document that has not been
+    // returned yet, so that all the cells of a document come from the same snapshot.
+    if (_needsSeek) {
+        for (auto&& col : _columns) {
+            try {
+                if (!col.cursor) {
+                    col.cursor = indexAccessMethod()->newCursor(opCtx());
+                    col.cursor->setEndPosition(ColumnKeyGenerator::makeColumnKeyPrefix(col.column),
+                                               true /* inclusive */);
+                }
+                // Skip past all the cells of the last document returned, if any.
+                const bool fromStart = _lastRecordId.isNull();
+                col.entry = col.cursor->seek(IndexEntryComparison::makeKeyStringFromBSONKeyForSeek(
+                    fromStart ? ColumnKeyGenerator::makeColumnKeyPrefix(col.column)
+                              : ColumnKeyGenerator::makeCellKeyPrefix(col.column, _lastRecordId),
+                    keyStringVersion,
+                    ordering,
+                    true /* forward */,
+                    fromStart /* inclusive */));
+            } catch (const WriteConflictException&) {
+                // Seek every column again after the yield.
+                resetCells();
+                *out = WorkingSet::INVALID_ID;
+                return PlanStage::NEED_YIELD;
+            }
+
+            ++_specificStats.keysExamined;
+        }
+        _needsSeek = false;
+    } else {
+        // Read the next cell of every column.
+        for (auto&& col : _columns) {
+            try {
+                col.entry = col.cursor->next();
+            } catch (const WriteConflictException&) {
+                // The cells read so far are dropped on yield, and every column is seeked again.
+                resetCells();
+                *out = WorkingSet::INVALID_ID;
+                return PlanStage::NEED_YIELD;
+            }
+
+            ++_specificStats.keysExamined;
+        }
+    }
+
+    // Every document has a cell in every column, and all the cursors read the same snapshot, so
+    // the columns end together and agree on the current document.
+    for (auto&& col : _columns) {
+        if (!col.entry) {
+            _commonStats.isEOF = true;
+            return PlanStage::IS_EOF;
+        }
+    }
+    const RecordId recordId = _columns.front().entry->loc;
+    for (auto&& col : _columns) {
+        uassert(5130011,
+                str::stream() << "Columnstore index " << _specificStats.indexName
+                              << " has no cell in column " << col.column << " for record "
+                              << recordId.toString(),
+                col.entry->loc == recordId);
+    }
+
+    // Rebuild the document from the cells that hold a value, in the order of their fields.
+    std::vector<std::pair<ColumnKeyGenerator::Cell, const std::string*>> cells;
+    for (auto&& col : _columns) {
+        auto cell = ColumnKeyGenerator::parseCell(col.entry->key);
+        if (cell.fieldPosition) {
+            cells.emplace_back(std::move(cell), &col.topLevelField);
+        }
+    }
+    std::sort(cells.begin(), cells.end(), [](const auto& lhs, const auto& rhs) {
+        return *lhs.first.fieldPosition < *rhs.first.fieldPosition;
+    });
+    BSONObjBuilder bob;
+    for (auto&& [cell, topLevelField] : cells) {
+        bob.appendAs(cell.value, *topLevelField);
+    }
+
+    WorkingSetID id = _workingSet->allocate();
+    WorkingSetMember* member = _workingSet->get(id);
+    member->recordId = recordId;
+    member->resetDocument(opCtx()->recoveryUnit()->getSnapshotId(), bob.obj());
+    _workingSet->transitionToRecordIdAndObj(id);
+
+    _lastRecordId = recordId;
+    for (auto&& col : _columns) {
+        col.entry = boost::none;
+    }
+
+    *out = id;
+    return PlanStage::ADVANCED;
+}
+
+void ColumnScanStage::resetCells() {
+    for (auto&& col : _columns) {
+        col.entry = boost::none;
+    }
+    _needsSeek = true;
+}
+
+bool ColumnScanStage::isEOF() {
+    return _commonStats.isEOF;
+}
+
+void ColumnScanStage::doSaveStateRequiresIndex() {
+    for (auto&& col : _columns) {
+        if (col.cursor)
+            col.cursor->save();
+    }
+}
+
+void ColumnScanStage::doRestoreStateRequiresIndex() {
+    for (auto&& col : _columns) {
+        if (col.cursor)
+            col.cursor->restore();
+    }
+
+    // The cells read before the yield may belong to a document which has since been updated or
+    // deleted, so the current document is read again from the new snapshot.
+    resetCells();
+}
+
+void ColumnScanStage::doDetachFromOperationContext() {
+    for (auto&& col : _columns) {
+        if (col.cursor)
+            col.cursor->detachFromOperationContext();
+    }
+}
+
+void ColumnScanStage::doReattachToOperationContext() {
+    for (auto&& col : _columns) {
+        if (col.cursor)
+            col.cursor->reattachToOperationContext(opCtx());
+    }
+}
+
+std::unique_ptr<PlanStageStats> ColumnScanStage::getStats() {
+    _commonStats.isEOF = isEOF();
+
+    auto ret = std::make_unique<PlanStageStats>(_commonStats, STAGE_COLUMN_SCAN);
+    ret->specific = std::make_unique<ColumnScanStats>(_specificStats);
+    return ret;
+}
+
+const SpecificStats* ColumnScanStage::getSpecificStats() const {
+    return &_specificStats;
+}
+
+}  // namespace mongo
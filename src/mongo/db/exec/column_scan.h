@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <string>
+#include <vector>
+
+#include "mongo/db/exec/requires_index_stage.h"
+#include "mongo/db/storage/sorted_data_interface.h"
+
+namespace mongo {
+
+class WorkingSet;
+
+/**
+ * Reads some of the columns of a columnstore index side by side, in RecordId order, and rebuilds
+ * from them the part of each document that lies under the columns' paths. Creates a
+ * WorkingSetMember in RID_AND_OBJ state for each document, whose object holds only the top-level
+ * fields of the columns that were read, in their original order. The stages above must therefore
+ * need nothing else from the document, which the query planner guarantees.
+ */
+class ColumnScanStage final : public RequiresIndexStage {
+public:
+    ColumnScanStage(ExpressionContext* expCtx,
+                    const CollectionPtr& collection,
+                    const IndexDescriptor* descriptor,
+                    std::vector<std::string> fields,
+                    WorkingSet* workingSet);
+
+    StageState doWork(WorkingSetID* out) final;
+    bool isEOF() final;
+    void doDetachFromOperationContext() final;
+    void doReattachToOperationContext() final;
+
+    StageType stageType() const final {
+        return STAGE_COLUMN_SCAN;
+    }
+
+    std::unique_ptr<PlanStageStats> getStats() final;
+
+    const SpecificStats* getSpecificStats() const final;
+
+    static const char* kStageType;
+
+protected:
+    void doSaveStateRequiresIndex() final;
+
+    void doRestoreStateRequiresIndex() final;
+
+private:
+    /**
+     * Drops the cells read for the current document, and makes the next call to work() position
+     * every column on the first document which has not been returned yet.
+     */
+    void resetCells();
+
+    /**
+     * The state of the scan over a single column.
+     */
+    struct ColumnCursor {
+        // The position of the column in the index's key pattern.
+        size_t column;
+
+        // The top-level field under which the column's values are stored in the document.
+        std::string topLevelField;
+
+        // Created on the first call to work().
+        std::unique_ptr<SortedDataInterface::Cursor> cursor;
+
+        // The cell of the document currently being rebuilt. Dropped on yield.
+        boost::optional<IndexKeyEntry> entry;
+    };
+
+    // The WorkingSet we annotate with results.  Not owned by us.
+    WorkingSet* _workingSet;
+
+    std::vector<ColumnCursor> _columns;
+
+    // The last document returned, or null if none has been returned yet.
+    RecordId _lastRecordId;
+
+    // Whether the columns must be positioned on the document after '_lastRecordId' rather than
+    // advanced, which is the case at the start of the scan and after every yield.
+    bool _needsSeek = true;
+
+    ColumnScanStats _specificStats;
+};
+
+}  // namespace mongo
@@ -260,6 +260,31 @@ struct CollectionScanStats : public SpecificStats {
     boost::optional<Timestamp> maxTs;
 };
 
+struct ColumnScanStats : public SpecificStats {
+    SpecificStats* clone() const final {
+        ColumnScanStats* specific = new ColumnScanStats(*this);
+        // BSON objects have to be explicitly copied.
+        specific->keyPattern = keyPattern.getOwned();
+        return specific;
+    }
+
+    uint64_t estimateObjectSizeInBytes() const {
+        return container_size_helper::estimateObjectSizeInBytes(
+                   fields, [](const auto& field) { return field.capacity(); }, true) +
+            keyPattern.objsize() + indexName.capacity() + sizeof(*this);
+    }
+
+    std::string indexName;
+
+    BSONObj keyPattern;
+
+    // The indexed paths whose columns the scan reads, in key pattern order.
+    std::vector<std::string> fields;
+
+    // The number of cells read from all of the columns together.
+    size_t keysExamined{0};
+};
+
 struct CountStats : public SpecificStats {
     CountStats() : nCounted(0), nSkipped(0) {}
 
@@ -365,6 +365,7 @@ static stdx::unordered_map<std::string, BuiltinFn> kBuiltinFunctions = {
     {"newObj", BuiltinFn{[](size_t n) { return n % 2 == 0; }, vm::Builtin::newObj, false}},
     {"ksToString", BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::ksToString, false}},
     {"ks", BuiltinFn{[](size_t n) { return n > 2; }, vm::Builtin::newKs, false}},
+    {"joinKeys", BuiltinFn{[](size_t n) { return n == 3; }, vm::Builtin::joinKeys, false}},
     {"abs", BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::abs, false}},
     {"ceil", BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::ceil, false}},
     {"floor", BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::floor, false}},
@@ -423,6 +424,14 @@ static stdx::unordered_map<std::string, BuiltinFn> kBuiltinFunctions = {
     {"shardFilter", BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::shardFilter, false}},
     {"extractSubArray",
      BuiltinFn{[](size_t n) { return n == 2 || n == 3; }, vm::Builtin::extractSubArray, false}},
+    {"aggDoubleDoubleSum",
+     BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::aggDoubleDoubleSum, true}},
+    {"aggMergeDoubleDoubleSums",
+     BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::aggMergeDoubleDoubleSums, true}},
+    {"doubleDoubleSumFinalize",
+     BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::doubleDoubleSumFinalize, false}},
+    {"doubleDoubleAvgFinalize",
+     BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::doubleDoubleAvgFinalize, false}},
 };
 
 /**
@@ -477,6 +486,35 @@ static stdx::unordered_map<std::string, InstrFn> kInstrFunctions = {
 };
 }  // namespace
 
+std::unique_ptr<vm::CodeFragment> EFunction::compileGetFieldImm(CompileCtx& ctx) const {
+    // Looking up a field by a constant name is by far the most common shape of 'getField', so the
+    // name is encoded inline in the instruction rather than pushed on the stack. When the object
+    // comes straight from a slot, it is read from the slot accessor as well.
+    auto fieldNameConst = dynamic_cast<const EConstant*>(_nodes[1].get());
+    if (!fieldNameConst) {
+        return nullptr;
+    }
+    auto [fieldTag, fieldVal] = fieldNameConst->getConstant();
+    if (!value::isString(fieldTag)) {
+        return nullptr;
+    }
+    auto fieldStr = value::getStringView(fieldTag, fieldVal);
+    if (fieldStr.size() > vm::CodeFragment::kMaxImmFieldNameSize) {
+        return nullptr;
+    }
+    StringData fieldName{fieldStr.data(), fieldStr.size()};
+
+    auto code = std::make_unique<vm::CodeFragment>();
+    auto objVar = dynamic_cast<const EVariable*>(_nodes[0].get());
+    if (objVar && !objVar->getFrameId()) {
+        code->appendGetField(ctx.root->getAccessor(ctx, objVar->getSlotId()), fieldName);
+    } else {
+        code->append(_nodes[0]->compile(ctx));
+        code->appendGetField(fieldName);
+    }
+    return code;
+}
+
 std::unique_ptr<vm::CodeFragment> EFunction::compile(CompileCtx& ctx) const {
     if (auto it = kBuiltinFunctions.find(_name); it != kBuiltinFunctions.end()) {
         auto arity = _nodes.size();
@@ -511,6 +549,12 @@ std::unique_ptr<vm::CodeFragment> EFunction::compile(CompileCtx& ctx) const {
                       str::stream()
                           << "function call: " << _name << " has wrong arity: " << _nodes.size());
         }
+        if (_name == "getField") {
+            if (auto code = compileGetFieldImm(ctx)) {
+                return code;
+            }
+        }
+
         auto code = std::make_unique<vm::CodeFragment>();
 
         if (it->second.aggregate) {
@@ -808,6 +852,13 @@ value::SlotId RuntimeEnvironment::getSlot(StringData type) {
     uasserted(4946305, str::stream() << "environment slot is not registered for type: " << type);
 }
 
+boost::optional<value::SlotId> RuntimeEnvironment::getSlotIfExists(StringData type) const {
+    if (auto it = _state->slots.find(type); it != _state->slots.end()) {
+        return it->second.first;
+    }
+    return boost::none;
+}
+
 void RuntimeEnvironment::resetSlot(value::SlotId slot,
                                    value::TypeTags tag,
                                    value::Value val,
@@ -841,6 +892,28 @@ std::unique_ptr<RuntimeEnvironment> RuntimeEnvironment::makeCopy(bool isSmp) {
     return std::unique_ptr<RuntimeEnvironment>(new RuntimeEnvironment(*this));
 }
 
+std::unique_ptr<RuntimeEnvironment> RuntimeEnvironment::makeDeepCopy() const {
+    invariant(!_isSmp);
+
+    auto env = std::make_unique<RuntimeEnvironment>();
+    auto& state = *env->_state;
+    state.slots = _state->slots;
+    state.typeTags = _state->typeTags;
+    state.vals = _state->vals;
+    state.owned = _state->owned;
+    for (size_t idx = 0; idx < state.vals.size(); ++idx) {
+        if (state.owned[idx]) {
+            std::tie(state.typeTags[idx], state.vals[idx]) =
+                value::copyValue(state.typeTags[idx], state.vals[idx]);
+        }
+    }
+
+    for (auto&& [type, slot] : state.slots) {
+        env->emplaceAccessor(slot.first, slot.second);
+    }
+    return env;
+}
+
 void RuntimeEnvironment::debugString(StringBuilder* builder) {
     *builder << "env: { ";
     for (auto&& [type, slot] : _state->slots) {
@@ -92,6 +92,12 @@ public:
      */
     value::SlotId getSlot(StringData type);
 
+    /**
+     * Returns a SlotId registered for the given slot 'type', or boost::none if the slot hasn't
+     * been registered.
+     */
+    boost::optional<value::SlotId> getSlotIfExists(StringData type) const;
+
     /**
      * Store the given value in the specified slot within this runtime environment instance.
      *
@@ -108,6 +114,13 @@ public:
      */
     value::SlotAccessor* getAccessor(value::SlotId slot);
 
+    /**
+     * Returns true if the given SlotId has been registered within this Environment.
+     */
+    bool isSlotRegistered(value::SlotId slot) const {
+        return _accessors.find(slot) != _accessors.end();
+    }
+
     /**
      * Make a copy of his environment. The new environment will have its own set of SlotAccessors
      * pointing to the same shared data holding slot values.
@@ -118,6 +131,14 @@ public:
      */
     std::unique_ptr<RuntimeEnvironment> makeCopy(bool isSmp);
 
+    /**
+     * Makes a copy of this environment which doesn't share the slot values with the original one.
+     * Owned values are copied, while unowned values are still referenced by the new environment.
+     * Slots of the new environment can be modified without affecting this environment, which is
+     * what an SBE plan kept in the plan cache needs when it is cloned for a new query.
+     */
+    std::unique_ptr<RuntimeEnvironment> makeDeepCopy() const;
+
     /**
      * Dumps all the slots currently defined in this environment into the given string builder.
      */
@@ -196,6 +217,10 @@ struct CompileCtx {
     value::SlotAccessor* getAccessor(value::SlotId slot);
     std::shared_ptr<SpoolBuffer> getSpoolBuffer(SpoolId spool);
 
+    bool isEnvironmentSlot(value::SlotId slot) const {
+        return env->isSlotRegistered(slot);
+    }
+
     void pushCorrelated(value::SlotId slot, value::SlotAccessor* accessor);
     void popCorrelated();
 
@@ -326,6 +351,10 @@ public:
 
     std::vector<DebugPrinter::Block> debugPrint() const override;
 
+    std::pair<value::TypeTags, value::Value> getConstant() const {
+        return {_tag, _val};
+    }
+
 private:
     value::TypeTags _tag;
     value::Value _val;
@@ -347,6 +376,14 @@ public:
 
     std::vector<DebugPrinter::Block> debugPrint() const override;
 
+    value::SlotId getSlotId() const {
+        return _var;
+    }
+
+    const boost::optional<FrameId>& getFrameId() const {
+        return _frameId;
+    }
+
 private:
     value::SlotId _var;
     boost::optional<FrameId> _frameId;
@@ -440,6 +477,12 @@ public:
     std::vector<DebugPrinter::Block> debugPrint() const override;
 
 private:
+    /**
+     * Compiles a call to 'getField' with a constant field name into one of the fused getField
+     * instructions. Returns nullptr if the call doesn't have this shape.
+     */
+    std::unique_ptr<vm::CodeFragment> compileGetFieldImm(CompileCtx& ctx) const;
+
     std::string _name;
 };
 
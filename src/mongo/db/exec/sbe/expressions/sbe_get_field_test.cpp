@@ -0,0 +1,143 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/db/exec/sbe/expression_test_base.h"
+
+namespace mongo::sbe {
+
+class SBEGetFieldTest : public EExpressionTestFixture {
+protected:
+    /**
+     * Compiles and runs 'expr', and checks that it returns the 32-bit integer 'expected', or
+     * Nothing if 'expected' is not set.
+     */
+    void runAndAssert(const EExpression& expr, boost::optional<int32_t> expected) {
+        auto compiledExpr = compileExpression(expr);
+        auto [tag, val] = runCompiledExpression(compiledExpr.get());
+        value::ValueGuard guard(tag, val);
+
+        if (expected) {
+            ASSERT_EQ(value::TypeTags::NumberInt32, tag);
+            ASSERT_EQ(*expected, value::bitcastTo<int32_t>(val));
+        } else {
+            ASSERT_EQ(value::TypeTags::Nothing, tag);
+        }
+    }
+
+    static std::unique_ptr<EExpression> makeGetField(std::unique_ptr<EExpression> obj,
+                                                     std::unique_ptr<EExpression> field) {
+        return makeE<EFunction>("getField", makeEs(std::move(obj), std::move(field)));
+    }
+
+    void bindObject(value::ViewOfValueAccessor& accessor, const BSONObj& obj) {
+        accessor.reset(value::TypeTags::bsonObject,
+                       value::bitcastFrom<const char*>(obj.objdata()));
+    }
+};
+
+TEST_F(SBEGetFieldTest, GetFieldFromSlotWithConstantName) {
+    value::ViewOfValueAccessor objAccessor;
+    auto objSlot = bindAccessor(&objAccessor);
+    auto expr = makeGetField(makeE<EVariable>(objSlot), makeE<EConstant>("b"));
+
+    auto obj = BSON("a" << 1 << "b" << 2);
+    bindObject(objAccessor, obj);
+    runAndAssert(*expr, 2);
+
+    auto objWithoutField = BSON("a" << 1);
+    bindObject(objAccessor, objWithoutField);
+    runAndAssert(*expr, boost::none);
+
+    objAccessor.reset(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(1));
+    runAndAssert(*expr, boost::none);
+}
+
+TEST_F(SBEGetFieldTest, GetNestedFieldWithConstantNames) {
+    value::ViewOfValueAccessor objAccessor;
+    auto objSlot = bindAccessor(&objAccessor);
+    auto expr = makeGetField(makeGetField(makeE<EVariable>(objSlot), makeE<EConstant>("a")),
+                             makeE<EConstant>("b"));
+
+    auto obj = BSON("a" << BSON("b" << 3));
+    bindObject(objAccessor, obj);
+    runAndAssert(*expr, 3);
+
+    auto objWithoutField = BSON("a" << BSON("c" << 3));
+    bindObject(objAccessor, objWithoutField);
+    runAndAssert(*expr, boost::none);
+}
+
+TEST_F(SBEGetFieldTest, GetFieldFromLocalVariableWithConstantName) {
+    value::ViewOfValueAccessor objAccessor;
+    auto objSlot = bindAccessor(&objAccessor);
+    FrameId frameId = 10;
+    auto expr =
+        makeE<ELocalBind>(frameId,
+                          makeEs(makeE<EVariable>(objSlot)),
+                          makeGetField(makeE<EVariable>(frameId, 0), makeE<EConstant>("a")));
+
+    auto obj = BSON("a" << 4);
+    bindObject(objAccessor, obj);
+    runAndAssert(*expr, 4);
+}
+
+TEST_F(SBEGetFieldTest, GetFieldWithLongConstantName) {
+    value::ViewOfValueAccessor objAccessor;
+    auto objSlot = bindAccessor(&objAccessor);
+    std::string fieldName(vm::CodeFragment::kMaxImmFieldNameSize + 1, 'a');
+    auto expr = makeGetField(makeE<EVariable>(objSlot), makeE<EConstant>(fieldName));
+
+    auto obj = BSON(fieldName << 5);
+    bindObject(objAccessor, obj);
+    runAndAssert(*expr, 5);
+
+    auto objWithShorterField = BSON(fieldName.substr(1) << 5);
+    bindObject(objAccessor, objWithShorterField);
+    runAndAssert(*expr, boost::none);
+}
+
+TEST_F(SBEGetFieldTest, GetFieldWithNameFromSlot) {
+    value::ViewOfValueAccessor objAccessor;
+    auto objSlot = bindAccessor(&objAccessor);
+    value::OwnedValueAccessor fieldAccessor;
+    auto fieldSlot = bindAccessor(&fieldAccessor);
+    auto expr = makeGetField(makeE<EVariable>(objSlot), makeE<EVariable>(fieldSlot));
+
+    auto obj = BSON("a" << 6 << "b" << 7);
+    bindObject(objAccessor, obj);
+
+    auto [fieldTag, fieldVal] = value::makeNewString("b");
+    fieldAccessor.reset(fieldTag, fieldVal);
+    runAndAssert(*expr, 7);
+
+    fieldAccessor.reset(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(1));
+    runAndAssert(*expr, boost::none);
+}
+
+}  // namespace mongo::sbe
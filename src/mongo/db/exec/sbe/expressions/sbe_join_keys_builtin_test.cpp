@@ -0,0 +1,115 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/db/exec/sbe/expression_test_base.h"
+#include "mongo/db/storage/key_string.h"
+
+namespace mongo::sbe {
+
+class SBEJoinKeysBuiltinTest : public EExpressionTestFixture {
+protected:
+    /**
+     * Computes the join keys of kind 'kind' of the join field "k" of 'doc', and checks that they
+     * are the KeyStrings of the values in 'expected', in order.
+     */
+    void runAndAssertKeys(const BSONObj& doc, vm::JoinKeysKind kind, const BSONArray& expected) {
+        value::ViewOfValueAccessor slotAccessor;
+        auto argSlot = bindAccessor(&slotAccessor);
+        auto joinKeysExpr = makeE<EFunction>(
+            "joinKeys",
+            makeEs(makeE<EVariable>(argSlot),
+                   makeE<EConstant>("k"),
+                   makeE<EConstant>(value::TypeTags::NumberInt32,
+                                    value::bitcastFrom<int32_t>(static_cast<int32_t>(kind)))));
+        auto compiledExpr = compileExpression(*joinKeysExpr);
+
+        slotAccessor.reset(value::TypeTags::bsonObject,
+                           value::bitcastFrom<const char*>(doc.objdata()));
+        auto [tag, val] = runCompiledExpression(compiledExpr.get());
+        value::ValueGuard guard(tag, val);
+
+        ASSERT_EQUALS(value::TypeTags::Array, tag);
+        auto keys = value::getArrayView(val);
+        ASSERT_EQUALS(static_cast<size_t>(expected.nFields()), keys->size()) << doc;
+        size_t idx = 0;
+        for (auto&& elem : expected) {
+            auto [keyTag, keyVal] = keys->getAt(idx++);
+            ASSERT_EQUALS(value::TypeTags::ksValue, keyTag);
+            KeyString::HeapBuilder kb{KeyString::Version::V1};
+            kb.appendBSONElement(elem);
+            ASSERT_EQUALS(0, value::getKeyStringView(keyVal)->compare(kb.release()))
+                << doc << " key " << idx;
+        }
+    }
+};
+
+TEST_F(SBEJoinKeysBuiltinTest, LocalKeysAreTheElementsOfAnArray) {
+    runAndAssertKeys(BSON("k" << 1), vm::JoinKeysKind::kLocal, BSON_ARRAY(1));
+    runAndAssertKeys(BSON("k" << BSON_ARRAY(1 << BSON_ARRAY(2 << 3) << BSONArray())),
+                     vm::JoinKeysKind::kLocal,
+                     BSON_ARRAY(1 << BSON_ARRAY(2 << 3) << BSONArray()));
+}
+
+TEST_F(SBEJoinKeysBuiltinTest, LocalKeyOfMissingFieldOrEmptyArrayIsNull) {
+    runAndAssertKeys(BSON("a" << 1), vm::JoinKeysKind::kLocal, BSON_ARRAY(BSONNULL));
+    runAndAssertKeys(BSON("k" << BSONArray()), vm::JoinKeysKind::kLocal, BSON_ARRAY(BSONNULL));
+}
+
+TEST_F(SBEJoinKeysBuiltinTest, ForeignKeysIncludeTheWholeArray) {
+    runAndAssertKeys(BSON("k" << BSON_ARRAY(1 << BSON_ARRAY(2))),
+                     vm::JoinKeysKind::kForeign,
+                     BSON_ARRAY(BSON_ARRAY(1 << BSON_ARRAY(2)) << 1 << BSON_ARRAY(2)));
+    runAndAssertKeys(
+        BSON("k" << BSONArray()), vm::JoinKeysKind::kForeign, BSON_ARRAY(BSONArray()));
+    runAndAssertKeys(BSON("a" << 1), vm::JoinKeysKind::kForeign, BSON_ARRAY(BSONNULL));
+}
+
+TEST_F(SBEJoinKeysBuiltinTest, IndexProbesIncludeTheFirstElementOfArrayKeys) {
+    runAndAssertKeys(BSON("k" << BSON_ARRAY(1 << BSON_ARRAY(2 << 3) << BSONArray())),
+                     vm::JoinKeysKind::kLocalIndexProbes,
+                     BSON_ARRAY(1 << BSON_ARRAY(2 << 3) << 2 << BSONArray() << BSONUndefined));
+}
+
+TEST_F(SBEJoinKeysBuiltinTest, KeysOfRegexesAndNumbersCompareLikeTheirBsonValues) {
+    runAndAssertKeys(BSON("k" << BSONRegEx("a", "i")),
+                     vm::JoinKeysKind::kLocal,
+                     BSON_ARRAY(BSONRegEx("a", "i")));
+
+    // Numbers of different types and equal values have the same key, which differs from the key of
+    // a string or a regular expression.
+    runAndAssertKeys(BSON("k" << 1.0), vm::JoinKeysKind::kLocal, BSON_ARRAY(1LL));
+    KeyString::HeapBuilder regexKey{KeyString::Version::V1};
+    regexKey.appendBSONElement(BSON("" << BSONRegEx("a")).firstElement());
+    KeyString::HeapBuilder stringKey{KeyString::Version::V1};
+    stringKey.appendBSONElement(BSON("" << "a").firstElement());
+    ASSERT_NOT_EQUALS(0, regexKey.release().compare(stringKey.release()));
+}
+
+}  // namespace mongo::sbe
@@ -910,6 +910,8 @@ void Parser::walkGroup(AstQuery& ast) {
     ast.stage = makeS<HashAggStage>(std::move(ast.nodes[2]->stage),
                                     lookupSlots(std::move(ast.nodes[0]->identifiers)),
                                     lookupSlots(std::move(ast.nodes[1]->projects)),
+                                    std::numeric_limits<std::size_t>::max(),
+                                    true /* allowDiskUse */,
                                     getCurrentPlanNodeId());
 }
 
@@ -922,6 +924,8 @@ void Parser::walkHashJoin(AstQuery& ast) {
                              lookupSlots(ast.nodes[0]->nodes[1]->identifiers),  // outer projections
                              lookupSlots(ast.nodes[1]->nodes[0]->identifiers),  // inner conditions
                              lookupSlots(ast.nodes[1]->nodes[1]->identifiers),  // inner projections
+                             std::numeric_limits<std::size_t>::max(),
+                             true /* allowDiskUse */,
                              getCurrentPlanNodeId());
 }
 
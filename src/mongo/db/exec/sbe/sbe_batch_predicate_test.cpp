@@ -0,0 +1,143 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <limits>
+
+#include "mongo/db/exec/sbe/values/value.h"
+#include "mongo/db/exec/sbe/vm/batch_predicate.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::sbe {
+namespace {
+using Op = vm::BatchPredicate::Op;
+
+void appendValue(vm::BatchColumn& column, value::TypeTags tag, value::Value val) {
+    column.tags.push_back(tag);
+    column.vals.push_back(val);
+}
+
+std::vector<uint32_t> selectAll(const vm::BatchColumn& column) {
+    std::vector<uint32_t> selection;
+    for (uint32_t row = 0; row < column.tags.size(); ++row) {
+        selection.push_back(row);
+    }
+    return selection;
+}
+}  // namespace
+
+TEST(SBEBatchPredicateTest, ComparesValuesOfTheSameType) {
+    vm::BatchColumn column;
+    for (int32_t i = 0; i < 10; ++i) {
+        appendValue(column, value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(i));
+    }
+
+    vm::BatchPredicate predicate;
+    predicate.addTerm(
+        0, Op::greaterEq, value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(3));
+    predicate.addTerm(0, Op::less, value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(7));
+
+    auto selection = selectAll(column);
+    predicate.evaluate({column}, selection);
+    ASSERT(selection == std::vector<uint32_t>({3, 4, 5, 6}));
+}
+
+TEST(SBEBatchPredicateTest, ComparesValuesOfDifferentNumericTypes) {
+    vm::BatchColumn column;
+    appendValue(column, value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(1));
+    appendValue(column, value::TypeTags::NumberDouble, value::bitcastFrom<double>(2.5));
+    appendValue(column, value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(3));
+    appendValue(column, value::TypeTags::NumberDouble, value::bitcastFrom<double>(1.5));
+
+    vm::BatchPredicate predicate;
+    predicate.addTerm(0, Op::greater, value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(2));
+
+    auto selection = selectAll(column);
+    predicate.evaluate({column}, selection);
+    ASSERT(selection == std::vector<uint32_t>({1, 2}));
+}
+
+TEST(SBEBatchPredicateTest, DropsValuesWhichAreNotNumbers) {
+    vm::BatchColumn column;
+    appendValue(column, value::TypeTags::Nothing, 0);
+    appendValue(column, value::TypeTags::Null, 0);
+    appendValue(column, value::TypeTags::Boolean, value::bitcastFrom<bool>(true));
+    appendValue(column, value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(5));
+
+    vm::BatchPredicate predicate;
+    predicate.addTerm(0, Op::eq, value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(5));
+
+    auto selection = selectAll(column);
+    predicate.evaluate({column}, selection);
+    ASSERT(selection == std::vector<uint32_t>({3}));
+}
+
+TEST(SBEBatchPredicateTest, KeepsValuesWhichCannotBeDecided) {
+    auto [arrTag, arrVal] = value::makeNewArray();
+    value::ValueGuard arrGuard{arrTag, arrVal};
+    auto [decTag, decVal] = value::makeCopyDecimal(Decimal128{100});
+    value::ValueGuard decGuard{decTag, decVal};
+
+    vm::BatchColumn column;
+    appendValue(column, arrTag, arrVal);
+    appendValue(column, decTag, decVal);
+    appendValue(column,
+                value::TypeTags::NumberDouble,
+                value::bitcastFrom<double>(std::numeric_limits<double>::quiet_NaN()));
+    appendValue(column,
+                value::TypeTags::NumberInt64,
+                value::bitcastFrom<int64_t>(std::numeric_limits<int64_t>::max()));
+    appendValue(column, value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(100));
+
+    vm::BatchPredicate predicate;
+    predicate.addTerm(0, Op::less, value::TypeTags::NumberDouble, value::bitcastFrom<double>(10));
+
+    auto selection = selectAll(column);
+    predicate.evaluate({column}, selection);
+    ASSERT(selection == std::vector<uint32_t>({0, 1, 2, 3}));
+}
+
+TEST(SBEBatchPredicateTest, EvaluatesTermsOverMultipleColumns) {
+    vm::BatchColumn first;
+    vm::BatchColumn second;
+    for (int64_t i = 0; i < 8; ++i) {
+        appendValue(first, value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(i));
+        appendValue(second, value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(i % 2));
+    }
+
+    vm::BatchPredicate predicate;
+    predicate.addTerm(0, Op::lessEq, value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(5));
+    predicate.addTerm(1, Op::eq, value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(1));
+
+    auto selection = selectAll(first);
+    predicate.evaluate({first, second}, selection);
+    ASSERT(selection == std::vector<uint32_t>({1, 3, 5}));
+}
+}  // namespace mongo::sbe
@@ -0,0 +1,222 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <map>
+
+#include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
+#include "mongo/db/exec/sbe/stages/hash_agg.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/unittest/temp_dir.h"
+
+namespace mongo::sbe {
+/**
+ * This file contains tests for sbe::HashAggStage.
+ */
+class HashAggStageTest : public PlanStageTestFixture {
+public:
+    void setUp() override {
+        PlanStageTestFixture::setUp();
+        // Spill files are written under the dbpath.
+        _originalDbPath = storageGlobalParams.dbpath;
+        storageGlobalParams.dbpath = _tempDir.path();
+    }
+
+    void tearDown() override {
+        storageGlobalParams.dbpath = _originalDbPath;
+        PlanStageTestFixture::tearDown();
+    }
+
+    /**
+     * Groups the (key, value) pairs of 'input' by the key, sums up the values of each group and
+     * returns the sums indexed by the group key.
+     */
+    std::map<int64_t, int64_t> groupAndSum(const BSONArray& input,
+                                           size_t memoryLimit,
+                                           bool allowDiskUse,
+                                           HashAggStats* stats = nullptr) {
+        auto [scanSlots, scanStage] = generateVirtualScanMulti(2, input);
+
+        auto sumSlot = generateSlotId();
+        auto stage = makeS<HashAggStage>(
+            std::move(scanStage),
+            makeSV(scanSlots[0]),
+            makeEM(sumSlot, makeE<EFunction>("sum", makeEs(makeE<EVariable>(scanSlots[1])))),
+            memoryLimit,
+            allowDiskUse,
+            kEmptyPlanNodeId);
+
+        auto ctx = makeCompileCtx();
+        auto resultAccessors = prepareTree(ctx.get(), stage.get(), makeSV(scanSlots[0], sumSlot));
+
+        auto [resultsTag, resultsVal] = getAllResultsMulti(stage.get(), resultAccessors);
+        value::ValueGuard resultsGuard{resultsTag, resultsVal};
+
+        std::map<int64_t, int64_t> sums;
+        auto results = value::getArrayView(resultsVal);
+        for (size_t idx = 0; idx < results->size(); ++idx) {
+            auto row = value::getArrayView(results->getAt(idx).second);
+            auto [keyTag, keyVal] = row->getAt(0);
+            auto [sumTag, sumVal] = row->getAt(1);
+            auto [it, inserted] = sums.emplace(value::numericCast<int64_t>(keyTag, keyVal),
+                                               value::numericCast<int64_t>(sumTag, sumVal));
+            ASSERT_TRUE(inserted);
+        }
+
+        if (stats) {
+            *stats = *static_cast<const HashAggStats*>(stage->getSpecificStats());
+        }
+        return sums;
+    }
+
+    /**
+     * Generates 'numRows' (key, value) pairs over 'numKeys' distinct keys, along with the expected
+     * sums for every key.
+     */
+    std::pair<BSONArray, std::map<int64_t, int64_t>> generateInput(int numRows, int numKeys) {
+        BSONArrayBuilder builder;
+        std::map<int64_t, int64_t> expected;
+        for (int i = 0; i < numRows; ++i) {
+            builder.append(BSON_ARRAY(i % numKeys << i));
+            expected[i % numKeys] += i;
+        }
+        return {builder.arr(), std::move(expected)};
+    }
+
+private:
+    unittest::TempDir _tempDir{"sbe_hash_agg_test"};
+    std::string _originalDbPath;
+};
+
+TEST_F(HashAggStageTest, GroupsInMemoryWithinMemoryLimit) {
+    auto [input, expected] = generateInput(1000, 10);
+
+    HashAggStats stats;
+    auto sums = groupAndSum(input, std::numeric_limits<std::size_t>::max(), false, &stats);
+    ASSERT(sums == expected);
+    ASSERT_EQ(stats.spills, 0U);
+    ASSERT_EQ(stats.spilledRecords, 0U);
+}
+
+TEST_F(HashAggStageTest, SpillsWhenMemoryLimitIsExceeded) {
+    auto [input, expected] = generateInput(1000, 500);
+
+    HashAggStats stats;
+    auto sums = groupAndSum(input, 1024, true, &stats);
+    ASSERT(sums == expected);
+    ASSERT_GT(stats.spills, 0U);
+    ASSERT_GT(stats.spilledRecords, 0U);
+    ASSERT_GT(stats.partitionsProcessed, 0U);
+}
+
+TEST_F(HashAggStageTest, RepartitionsSpilledPartitionsWhichDoNotFitInMemory) {
+    auto [input, expected] = generateInput(200, 200);
+
+    // With no memory to spare, every pass keeps a single group in memory, so most of the spilled
+    // partitions have to be partitioned again.
+    HashAggStats stats;
+    auto sums = groupAndSum(input, 0, true, &stats);
+    ASSERT(sums == expected);
+    ASSERT_GT(stats.spills, SpillPartitioner::kNumPartitions);
+}
+
+TEST_F(HashAggStageTest, FailsWhenMemoryLimitIsExceededWithoutDiskUse) {
+    auto [input, expected] = generateInput(1000, 500);
+
+    ASSERT_THROWS_CODE(groupAndSum(input, 1024, false),
+                       DBException,
+                       ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+
+TEST_F(HashAggStageTest, SpillsEveryNewGroupOnceARowHasBeenSpilled) {
+    // The large value of group 0 exceeds the memory limit, so the first row of group 1 is spilled.
+    // Replacing it with a small value brings the memory usage back under the limit, but the second
+    // row of group 1 must still be spilled, or group 1 would be returned twice.
+    const std::string largeValue(2048, 'b');
+    auto input = BSON_ARRAY(BSON_ARRAY(0 << largeValue) << BSON_ARRAY(1 << "x")
+                                                        << BSON_ARRAY(0 << "a")
+                                                        << BSON_ARRAY(1 << "y"));
+    auto [scanSlots, scanStage] = generateVirtualScanMulti(2, input);
+
+    auto lastSlot = generateSlotId();
+    auto stage = makeS<HashAggStage>(
+        std::move(scanStage),
+        makeSV(scanSlots[0]),
+        makeEM(lastSlot, makeE<EFunction>("last", makeEs(makeE<EVariable>(scanSlots[1])))),
+        1024,
+        true,
+        kEmptyPlanNodeId);
+
+    auto ctx = makeCompileCtx();
+    auto resultAccessors = prepareTree(ctx.get(), stage.get(), makeSV(scanSlots[0], lastSlot));
+    auto [resultsTag, resultsVal] = getAllResultsMulti(stage.get(), resultAccessors);
+    value::ValueGuard resultsGuard{resultsTag, resultsVal};
+
+    std::map<int64_t, std::string> lastValues;
+    auto results = value::getArrayView(resultsVal);
+    for (size_t idx = 0; idx < results->size(); ++idx) {
+        auto row = value::getArrayView(results->getAt(idx).second);
+        auto [keyTag, keyVal] = row->getAt(0);
+        auto [lastTag, lastVal] = row->getAt(1);
+        auto [it, inserted] =
+            lastValues.emplace(value::numericCast<int64_t>(keyTag, keyVal),
+                               std::string{value::getStringView(lastTag, lastVal)});
+        ASSERT_TRUE(inserted);
+    }
+    ASSERT(lastValues == (std::map<int64_t, std::string>{{0, "a"}, {1, "y"}}));
+
+    auto stats = static_cast<const HashAggStats*>(stage->getSpecificStats());
+    ASSERT_EQ(stats->spilledRecords, 2U);
+}
+
+TEST_F(HashAggStageTest, AccountsForTheGrowthOfAccumulatorsInExistingGroups) {
+    // A single group, whose array of values outgrows the memory limit long after the group has
+    // been created.
+    BSONArrayBuilder builder;
+    for (int i = 0; i < 1000; ++i) {
+        builder.append(BSON_ARRAY(0 << i));
+    }
+    auto [scanSlots, scanStage] = generateVirtualScanMulti(2, builder.arr());
+
+    auto pushSlot = generateSlotId();
+    auto stage = makeS<HashAggStage>(
+        std::move(scanStage),
+        makeSV(scanSlots[0]),
+        makeEM(pushSlot, makeE<EFunction>("addToArray", makeEs(makeE<EVariable>(scanSlots[1])))),
+        4096,
+        false,
+        kEmptyPlanNodeId);
+
+    auto ctx = makeCompileCtx();
+    ASSERT_THROWS_CODE(prepareTree(ctx.get(), stage.get(), makeSV(scanSlots[0], pushSlot)),
+                       DBException,
+                       ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+}  // namespace mongo::sbe
@@ -0,0 +1,219 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <set>
+#include <tuple>
+
+#include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
+#include "mongo/db/exec/sbe/stages/hash_join.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/unittest/temp_dir.h"
+
+namespace mongo::sbe {
+/**
+ * This file contains tests for sbe::HashJoinStage.
+ */
+class HashJoinStageTest : public PlanStageTestFixture {
+public:
+    using JoinedRow = std::tuple<int64_t, int64_t, int64_t>;
+
+    void setUp() override {
+        PlanStageTestFixture::setUp();
+        // Spill files are written under the dbpath.
+        _originalDbPath = storageGlobalParams.dbpath;
+        storageGlobalParams.dbpath = _tempDir.path();
+    }
+
+    void tearDown() override {
+        storageGlobalParams.dbpath = _originalDbPath;
+        PlanStageTestFixture::tearDown();
+    }
+
+    /**
+     * Joins the (key, value) pairs of 'outer' and 'inner' on the key and returns the joined
+     * (key, outer value, inner value) rows.
+     */
+    std::multiset<JoinedRow> join(const BSONArray& outer,
+                                  const BSONArray& inner,
+                                  size_t memoryLimit,
+                                  bool allowDiskUse,
+                                  HashJoinStats* stats = nullptr,
+                                  bool canSpill = true) {
+        auto [outerSlots, outerStage] = generateVirtualScanMulti(2, outer);
+        auto [innerSlots, innerStage] = generateVirtualScanMulti(2, inner);
+
+        auto stage = makeS<HashJoinStage>(std::move(outerStage),
+                                          std::move(innerStage),
+                                          makeSV(outerSlots[0]),
+                                          makeSV(outerSlots[1]),
+                                          makeSV(innerSlots[0]),
+                                          makeSV(innerSlots[1]),
+                                          memoryLimit,
+                                          allowDiskUse,
+                                          kEmptyPlanNodeId,
+                                          false /* reuseOuterOnReOpen */,
+                                          canSpill);
+
+        auto ctx = makeCompileCtx();
+        auto resultAccessors = prepareTree(
+            ctx.get(), stage.get(), makeSV(outerSlots[0], outerSlots[1], innerSlots[1]));
+
+        auto [resultsTag, resultsVal] = getAllResultsMulti(stage.get(), resultAccessors);
+        value::ValueGuard resultsGuard{resultsTag, resultsVal};
+
+        std::multiset<JoinedRow> rows;
+        auto results = value::getArrayView(resultsVal);
+        for (size_t idx = 0; idx < results->size(); ++idx) {
+            auto row = value::getArrayView(results->getAt(idx).second);
+            auto get = [&](size_t pos) {
+                auto [tag, val] = row->getAt(pos);
+                return value::numericCast<int64_t>(tag, val);
+            };
+            rows.emplace(get(0), get(1), get(2));
+        }
+
+        if (stats) {
+            *stats = *static_cast<const HashJoinStats*>(stage->getSpecificStats());
+        }
+        return rows;
+    }
+
+    /**
+     * Generates the outer and inner sides of a join along with the expected result of joining
+     * them. Every key has two matching rows on the outer side and one on the inner side, and some
+     * of the rows on either side have no match.
+     */
+    std::tuple<BSONArray, BSONArray, std::multiset<JoinedRow>> generateInput(int numKeys) {
+        BSONArrayBuilder outer;
+        BSONArrayBuilder inner;
+        std::multiset<JoinedRow> expected;
+        for (int key = 0; key < numKeys; ++key) {
+            outer.append(BSON_ARRAY(key << key * 10));
+            outer.append(BSON_ARRAY(key << key * 10 + 1));
+            inner.append(BSON_ARRAY(key << key * 100));
+            expected.emplace(key, key * 10, key * 100);
+            expected.emplace(key, key * 10 + 1, key * 100);
+
+            outer.append(BSON_ARRAY(numKeys + key << 0));
+            inner.append(BSON_ARRAY(-key - 1 << 0));
+        }
+        return {outer.arr(), inner.arr(), std::move(expected)};
+    }
+
+private:
+    unittest::TempDir _tempDir{"sbe_hash_join_test"};
+    std::string _originalDbPath;
+};
+
+TEST_F(HashJoinStageTest, JoinsInMemoryWithinMemoryLimit) {
+    auto [outer, inner, expected] = generateInput(100);
+
+    HashJoinStats stats;
+    auto rows = join(outer, inner, std::numeric_limits<std::size_t>::max(), false, &stats);
+    ASSERT(rows == expected);
+    ASSERT_EQ(stats.spills, 0U);
+}
+
+TEST_F(HashJoinStageTest, SpillsWhenMemoryLimitIsExceeded) {
+    auto [outer, inner, expected] = generateInput(500);
+
+    HashJoinStats stats;
+    auto rows = join(outer, inner, 4 * 1024, true, &stats);
+    ASSERT(rows == expected);
+    ASSERT_GT(stats.spills, 0U);
+    ASSERT_GT(stats.spilledRecords, 0U);
+    ASSERT_GT(stats.partitionsProcessed, 0U);
+}
+
+TEST_F(HashJoinStageTest, RepartitionsSpilledPartitionsWhichDoNotFitInMemory) {
+    auto [outer, inner, expected] = generateInput(500);
+
+    HashJoinStats stats;
+    auto rows = join(outer, inner, 256, true, &stats);
+    ASSERT(rows == expected);
+    ASSERT_GT(stats.spills, 1U);
+}
+
+TEST_F(HashJoinStageTest, FailsWhenMemoryLimitIsExceededWithoutDiskUse) {
+    auto [outer, inner, expected] = generateInput(500);
+
+    ASSERT_THROWS_CODE(join(outer, inner, 4 * 1024, false),
+                       DBException,
+                       ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+
+TEST_F(HashJoinStageTest, FailsWhenMemoryLimitIsExceededAndCannotSpill) {
+    auto [outer, inner, expected] = generateInput(500);
+
+    // Allowing disk use makes no difference if the stage cannot spill.
+    ASSERT_THROWS_CODE(join(outer, inner, 4 * 1024, true, nullptr, false /* canSpill */),
+                       DBException,
+                       ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+
+TEST_F(HashJoinStageTest, ReusesOuterSideOnReOpen) {
+    auto [outer, inner, expected] = generateInput(100);
+    auto [outerSlots, outerStage] = generateVirtualScanMulti(2, outer);
+    auto [innerSlots, innerStage] = generateVirtualScanMulti(2, inner);
+
+    auto stage = makeS<HashJoinStage>(std::move(outerStage),
+                                      std::move(innerStage),
+                                      makeSV(outerSlots[0]),
+                                      makeSV(outerSlots[1]),
+                                      makeSV(innerSlots[0]),
+                                      makeSV(innerSlots[1]),
+                                      std::numeric_limits<std::size_t>::max(),
+                                      false /* allowDiskUse */,
+                                      kEmptyPlanNodeId,
+                                      true /* reuseOuterOnReOpen */);
+
+    auto ctx = makeCompileCtx();
+    auto resultAccessors =
+        prepareTree(ctx.get(), stage.get(), makeSV(outerSlots[0], outerSlots[1], innerSlots[1]));
+
+    for (int run = 0; run < 3; ++run) {
+        if (run > 0) {
+            stage->close();
+            stage->open(true);
+        }
+
+        auto [resultsTag, resultsVal] = getAllResultsMulti(stage.get(), resultAccessors);
+        value::ValueGuard resultsGuard{resultsTag, resultsVal};
+        ASSERT_EQ(value::getArrayView(resultsVal)->size(), expected.size());
+    }
+
+    // The outer side is only read by the first open().
+    auto stats = stage->getStats(false);
+    ASSERT_EQ(stats->common.opens, 3U);
+    ASSERT_EQ(stats->children[0]->common.opens, 1U);
+    ASSERT_EQ(stats->children[1]->common.opens, 3U);
+}
+}  // namespace mongo::sbe
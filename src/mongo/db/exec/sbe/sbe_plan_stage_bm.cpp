@@ -0,0 +1,316 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+/**
+ * This file contains microbenchmarks for sbe::PlanStages. Every benchmark builds a canonical tree
+ * on top of a virtual scan over synthetic in-memory documents, and then repeatedly opens the tree,
+ * drains it and closes it again. The number of input rows processed per second is reported as
+ * 'items_per_second'. When the server is built with tcmalloc, the number of heap allocations per
+ * input row is reported as 'allocsPerRow' as well.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#ifdef MONGO_SBE_BM_COUNT_ALLOCATIONS
+#include <gperftools/malloc_hook.h>
+#endif
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
+#include "mongo/db/exec/sbe/stages/filter.h"
+#include "mongo/db/exec/sbe/stages/hash_agg.h"
+#include "mongo/db/exec/sbe/stages/hash_join.h"
+#include "mongo/db/exec/sbe/stages/sort.h"
+#include "mongo/platform/atomic_word.h"
+
+namespace mongo::sbe {
+namespace {
+#ifdef MONGO_SBE_BM_COUNT_ALLOCATIONS
+AtomicWord<long long> allocationCount{0};
+
+void countAllocation(const void*, size_t) {
+    allocationCount.fetchAndAddRelaxed(1);
+}
+#endif
+
+/**
+ * Counts the heap allocations made over the lifetime of an instance, if the allocator supports it.
+ */
+class AllocationCounter {
+public:
+    AllocationCounter() {
+#ifdef MONGO_SBE_BM_COUNT_ALLOCATIONS
+        _start = allocationCount.load();
+        invariant(MallocHook::AddNewHook(&countAllocation));
+#endif
+    }
+
+    ~AllocationCounter() {
+#ifdef MONGO_SBE_BM_COUNT_ALLOCATIONS
+        MallocHook::RemoveNewHook(&countAllocation);
+#endif
+    }
+
+    /**
+     * Returns the number of allocations made so far, or boost::none if allocations are not
+     * counted.
+     */
+    boost::optional<long long> count() const {
+#ifdef MONGO_SBE_BM_COUNT_ALLOCATIONS
+        return allocationCount.load() - _start;
+#else
+        return boost::none;
+#endif
+    }
+
+private:
+    long long _start{0};
+};
+
+/**
+ * Provides the PlanStageTestFixture helpers to the benchmarks. A new fixture, and with it a new
+ * service context and operation context, is set up every time a benchmark function runs.
+ */
+class PlanStageBenchmarkFixture : public PlanStageTestFixture {
+public:
+    PlanStageBenchmarkFixture() {
+        setUp();
+    }
+
+    ~PlanStageBenchmarkFixture() {
+        tearDown();
+    }
+
+    /**
+     * Prepares the tree rooted at 'root' and reads 'slots' from every row it produces, reopening
+     * the tree for every iteration of 'state'. Each run of the tree is accounted for as processing
+     * 'numInputRows' rows.
+     */
+    void run(benchmark::State& state,
+             std::unique_ptr<PlanStage> root,
+             value::SlotVector slots,
+             size_t numInputRows) {
+        auto ctx = makeCompileCtx();
+        auto accessors = prepareTree(ctx.get(), root.get(), std::move(slots));
+        root->close();
+
+        size_t numOutputRows = 0;
+        AllocationCounter allocations;
+        for (auto keepRunning : state) {
+            root->open(true);
+            while (root->getNext() == PlanState::ADVANCED) {
+                for (auto accessor : accessors) {
+                    benchmark::DoNotOptimize(accessor->getViewOfValue());
+                }
+                ++numOutputRows;
+            }
+            root->close();
+        }
+
+        const auto numRows = state.iterations() * numInputRows;
+        state.SetItemsProcessed(numRows);
+        state.counters["outputRowsPerRun"] =
+            static_cast<double>(numOutputRows) / std::max<size_t>(state.iterations(), 1);
+        if (auto numAllocations = allocations.count()) {
+            state.counters["allocsPerRow"] =
+                static_cast<double>(*numAllocations) / std::max<size_t>(numRows, 1);
+        }
+    }
+
+private:
+    void _doTest() override {}
+};
+
+/**
+ * Builds 'numDocs' documents of the shape {a: <int>, b: <int>, c: <string>, d: [<int>, ...]},
+ * where 'b' takes 'numDistinct' distinct values and 'd' holds 'arraySize' elements.
+ */
+BSONArray makeDocuments(size_t numDocs, size_t numDistinct, size_t arraySize) {
+    BSONArrayBuilder docs;
+    for (size_t i = 0; i < numDocs; ++i) {
+        const int n = static_cast<int>(i);
+        BSONObjBuilder doc(docs.subobjStart());
+        doc.append("a", n);
+        doc.append("b", static_cast<int>(i % numDistinct));
+        doc.append("c", n % 2 ? "odd" : "even");
+        BSONArrayBuilder d(doc.subarrayStart("d"));
+        for (size_t j = 0; j < arraySize; ++j) {
+            d.append(static_cast<int>(j));
+        }
+    }
+    return docs.arr();
+}
+
+std::unique_ptr<EExpression> makeGetField(value::SlotId docSlot, std::string_view field) {
+    return makeE<EFunction>("getField",
+                            makeEs(makeE<EVariable>(docSlot), makeE<EConstant>(field)));
+}
+
+std::unique_ptr<EExpression> makeInt32(int32_t value) {
+    return makeE<EConstant>(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(value));
+}
+
+constexpr size_t kNumDocs = 10000;
+
+void BM_Scan(benchmark::State& state) {
+    PlanStageBenchmarkFixture fixture;
+    auto [docSlot, stage] = fixture.generateVirtualScan(makeDocuments(kNumDocs, 100, 0));
+
+    fixture.run(state, std::move(stage), makeSV(docSlot), kNumDocs);
+}
+
+void BM_Filter(benchmark::State& state) {
+    PlanStageBenchmarkFixture fixture;
+    auto [docSlot, stage] = fixture.generateVirtualScan(makeDocuments(kNumDocs, 100, 0));
+    stage = makeS<FilterStage<false>>(
+        std::move(stage),
+        makeE<EPrimBinary>(EPrimBinary::less, makeGetField(docSlot, "b"), makeInt32(50)),
+        kEmptyPlanNodeId);
+
+    fixture.run(state, std::move(stage), makeSV(docSlot), kNumDocs);
+}
+
+void BM_Project(benchmark::State& state) {
+    PlanStageBenchmarkFixture fixture;
+    auto [docSlot, stage] = fixture.generateVirtualScan(makeDocuments(kNumDocs, 100, 0));
+    auto aSlot = fixture.generateSlotId();
+    auto sumSlot = fixture.generateSlotId();
+    stage = makeProjectStage(std::move(stage),
+                             kEmptyPlanNodeId,
+                             aSlot,
+                             makeGetField(docSlot, "a"),
+                             sumSlot,
+                             makeE<EPrimBinary>(EPrimBinary::add,
+                                                makeGetField(docSlot, "a"),
+                                                makeGetField(docSlot, "b")));
+
+    fixture.run(state, std::move(stage), makeSV(aSlot, sumSlot), kNumDocs);
+}
+
+void BM_HashAgg(benchmark::State& state) {
+    const auto numGroups = static_cast<size_t>(state.range(0));
+    PlanStageBenchmarkFixture fixture;
+    auto [docSlot, stage] = fixture.generateVirtualScan(makeDocuments(kNumDocs, numGroups, 0));
+    auto keySlot = fixture.generateSlotId();
+    stage = makeProjectStage(std::move(stage), kEmptyPlanNodeId, keySlot, makeGetField(docSlot, "b"));
+
+    auto sumSlot = fixture.generateSlotId();
+    value::SlotMap<std::unique_ptr<EExpression>> aggs;
+    aggs.emplace(sumSlot, makeE<EFunction>("sum", makeEs(makeGetField(docSlot, "a"))));
+    stage = makeS<HashAggStage>(std::move(stage),
+                                makeSV(keySlot),
+                                std::move(aggs),
+                                std::numeric_limits<size_t>::max(),
+                                false /* allowDiskUse */,
+                                kEmptyPlanNodeId);
+
+    fixture.run(state, std::move(stage), makeSV(keySlot, sumSlot), kNumDocs);
+}
+
+void BM_HashJoin(benchmark::State& state) {
+    const auto numOuterRows = static_cast<size_t>(state.range(0));
+    PlanStageBenchmarkFixture fixture;
+
+    // Every document of the inner side matches exactly one document of the outer side.
+    auto [outerDocSlot, outerStage] =
+        fixture.generateVirtualScan(makeDocuments(numOuterRows, numOuterRows, 0));
+    auto outerKeySlot = fixture.generateSlotId();
+    outerStage = makeProjectStage(
+        std::move(outerStage), kEmptyPlanNodeId, outerKeySlot, makeGetField(outerDocSlot, "a"));
+
+    auto [innerDocSlot, innerStage] =
+        fixture.generateVirtualScan(makeDocuments(kNumDocs, numOuterRows, 0));
+    auto innerKeySlot = fixture.generateSlotId();
+    innerStage = makeProjectStage(
+        std::move(innerStage), kEmptyPlanNodeId, innerKeySlot, makeGetField(innerDocSlot, "b"));
+
+    auto stage = makeS<HashJoinStage>(std::move(outerStage),
+                                      std::move(innerStage),
+                                      makeSV(outerKeySlot),
+                                      makeSV(outerDocSlot),
+                                      makeSV(innerKeySlot),
+                                      makeSV(innerDocSlot),
+                                      std::numeric_limits<size_t>::max(),
+                                      false /* allowDiskUse */,
+                                      kEmptyPlanNodeId);
+
+    fixture.run(
+        state, std::move(stage), makeSV(outerDocSlot, innerDocSlot), numOuterRows + kNumDocs);
+}
+
+void BM_Sort(benchmark::State& state) {
+    const auto limit = state.range(0) > 0 ? static_cast<size_t>(state.range(0))
+                                          : std::numeric_limits<size_t>::max();
+    PlanStageBenchmarkFixture fixture;
+    auto [docSlot, stage] = fixture.generateVirtualScan(makeDocuments(kNumDocs, 997, 0));
+    auto keySlot = fixture.generateSlotId();
+    stage = makeProjectStage(std::move(stage), kEmptyPlanNodeId, keySlot, makeGetField(docSlot, "b"));
+    stage = makeS<SortStage>(std::move(stage),
+                             makeSV(keySlot),
+                             std::vector<value::SortDirection>{value::SortDirection::Ascending},
+                             makeSV(docSlot),
+                             limit,
+                             std::numeric_limits<size_t>::max(),
+                             false /* allowDiskUse */,
+                             kEmptyPlanNodeId);
+
+    fixture.run(state, std::move(stage), makeSV(keySlot, docSlot), kNumDocs);
+}
+
+void BM_Unwind(benchmark::State& state) {
+    const auto arraySize = static_cast<size_t>(state.range(0));
+    PlanStageBenchmarkFixture fixture;
+    auto [docSlot, stage] = fixture.generateVirtualScan(makeDocuments(kNumDocs, 100, arraySize));
+    auto arraySlot = fixture.generateSlotId();
+    stage =
+        makeProjectStage(std::move(stage), kEmptyPlanNodeId, arraySlot, makeGetField(docSlot, "d"));
+
+    auto elemSlot = fixture.generateSlotId();
+    auto indexSlot = fixture.generateSlotId();
+    stage = makeS<UnwindStage>(std::move(stage),
+                               arraySlot,
+                               elemSlot,
+                               indexSlot,
+                               false /* preserveNullAndEmptyArrays */,
+                               kEmptyPlanNodeId);
+
+    fixture.run(state, std::move(stage), makeSV(elemSlot, indexSlot), kNumDocs);
+}
+
+BENCHMARK(BM_Scan);
+BENCHMARK(BM_Filter);
+BENCHMARK(BM_Project);
+BENCHMARK(BM_HashAgg)->Arg(10)->Arg(1000)->Arg(kNumDocs);
+BENCHMARK(BM_HashJoin)->Arg(100)->Arg(kNumDocs);
+BENCHMARK(BM_Sort)->Arg(0)->Arg(10);
+BENCHMARK(BM_Unwind)->Arg(1)->Arg(10);
+}  // namespace
+}  // namespace mongo::sbe
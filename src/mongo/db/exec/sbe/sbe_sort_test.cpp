@@ -33,6 +33,9 @@
 
 #include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
 #include "mongo/db/exec/sbe/stages/sort.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo::sbe {
 
@@ -69,4 +72,45 @@ TEST_F(SortStageTest, SortNumbersTest) {
     runTestMulti(2, inputTag, inputVal, expectedTag, expectedVal, makeStageFn);
 }
 
+TEST_F(SortStageTest, SortNumbersWithLimitTest) {
+    auto [inputTag, inputVal] = stage_builder::makeValue(
+        BSON_ARRAY(BSON_ARRAY(12LL << "A") << BSON_ARRAY(2.5 << "B") << BSON_ARRAY(7 << "C")
+                                           << BSON_ARRAY(Decimal128(4) << "D")
+                                           << BSON_ARRAY(1 << "E") << BSON_ARRAY(9 << "F")));
+    value::ValueGuard inputGuard{inputTag, inputVal};
+
+    auto [expectedTag, expectedVal] = stage_builder::makeValue(BSON_ARRAY(
+        BSON_ARRAY(12LL << "A") << BSON_ARRAY(9 << "F") << BSON_ARRAY(7 << "C")));
+    value::ValueGuard expectedGuard{expectedTag, expectedVal};
+
+    // With a memory limit of one byte, the top-k heap immediately falls back to a Sorter, which
+    // spills to the configured spill directory.
+    unittest::TempDir tempDir{"sbe_sort_test"};
+    auto originalSpillDirectory = internalQuerySlotBasedExecutionSpillDirectory;
+    internalQuerySlotBasedExecutionSpillDirectory = tempDir.path();
+    ON_BLOCK_EXIT([&] { internalQuerySlotBasedExecutionSpillDirectory = originalSpillDirectory; });
+
+    for (auto memoryLimit : {size_t{204857600}, size_t{1}}) {
+        auto makeStageFn = [memoryLimit](value::SlotVector scanSlots,
+                                         std::unique_ptr<PlanStage> scanStage) {
+            // Create a SortStage that returns the top 3 values of slot0 in descending order.
+            auto sortStage = makeS<SortStage>(
+                std::move(scanStage),
+                makeSV(scanSlots[0]),
+                std::vector<value::SortDirection>{value::SortDirection::Descending},
+                makeSV(scanSlots[1]),
+                3,
+                memoryLimit,
+                true,
+                kEmptyPlanNodeId);
+
+            return std::make_pair(scanSlots, std::move(sortStage));
+        };
+
+        auto [inputCopyTag, inputCopyVal] = value::copyValue(inputTag, inputVal);
+        auto [expectedCopyTag, expectedCopyVal] = value::copyValue(expectedTag, expectedVal);
+        runTestMulti(2, inputCopyTag, inputCopyVal, expectedCopyTag, expectedCopyVal, makeStageFn);
+    }
+}
+
 }  // namespace mongo::sbe
@@ -0,0 +1,153 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/exec/sbe/stages/co_scan.h"
+#include "mongo/db/exec/sbe/values/slot.h"
+#include "mongo/db/exec/sbe/vm/vm.h"
+
+namespace mongo::sbe {
+namespace {
+/**
+ * Builds 'numDocs' documents of the shape {a: <int>, b: <string>, c: {d: <int>}, e: <int>}.
+ */
+std::vector<BSONObj> makeDocuments(size_t numDocs) {
+    std::vector<BSONObj> docs;
+    docs.reserve(numDocs);
+    for (size_t i = 0; i < numDocs; ++i) {
+        const int n = static_cast<int>(i);
+        docs.push_back(BSON("a" << n << "b" << (n % 2 ? "odd" : "even") << "c" << BSON("d" << n % 7)
+                                << "e" << n % 100));
+    }
+    return docs;
+}
+
+std::unique_ptr<EExpression> makeGetField(std::unique_ptr<EExpression> obj,
+                                          std::string_view field) {
+    return makeE<EFunction>("getField", makeEs(std::move(obj), makeE<EConstant>(field)));
+}
+
+std::unique_ptr<EExpression> makeInt32(int32_t value) {
+    return makeE<EConstant>(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(value));
+}
+
+/**
+ * Compiles the predicate returned by 'makePredicate' for a slot holding the input document, and
+ * evaluates it against every document of a batch, the way a FilterStage does for every row.
+ */
+void runPredicateBenchmark(
+    benchmark::State& state,
+    const std::function<std::unique_ptr<EExpression>(value::SlotId)>& makePredicate) {
+    const auto docs = makeDocuments(1000);
+
+    value::SlotIdGenerator slotIdGenerator;
+    CoScanStage emptyStage{kEmptyPlanNodeId};
+    CompileCtx ctx{std::make_unique<RuntimeEnvironment>()};
+    ctx.root = &emptyStage;
+
+    value::ViewOfValueAccessor docAccessor;
+    auto docSlot = slotIdGenerator.generate();
+    ctx.pushCorrelated(docSlot, &docAccessor);
+
+    auto predicate = makePredicate(docSlot);
+    auto code = predicate->compile(ctx);
+    vm::ByteCode vm;
+
+    size_t matched = 0;
+    for (auto keepRunning : state) {
+        for (auto&& doc : docs) {
+            docAccessor.reset(value::TypeTags::bsonObject,
+                              value::bitcastFrom<const char*>(doc.objdata()));
+            matched += vm.runPredicate(code.get());
+        }
+        benchmark::ClobberMemory();
+    }
+    benchmark::DoNotOptimize(matched);
+
+    state.SetItemsProcessed(state.iterations() * docs.size());
+    state.counters["bytecodeBytes"] = code->instrs().size();
+}
+
+void BM_GetFieldCompare(benchmark::State& state) {
+    runPredicateBenchmark(state, [](value::SlotId docSlot) {
+        return makeE<EPrimBinary>(
+            EPrimBinary::less, makeGetField(makeE<EVariable>(docSlot), "a"), makeInt32(500));
+    });
+}
+
+void BM_NestedGetFieldCompare(benchmark::State& state) {
+    runPredicateBenchmark(state, [](value::SlotId docSlot) {
+        return makeE<EPrimBinary>(EPrimBinary::eq,
+                                  makeGetField(makeGetField(makeE<EVariable>(docSlot), "c"), "d"),
+                                  makeInt32(3));
+    });
+}
+
+void BM_ConjunctionOfComparisons(benchmark::State& state) {
+    runPredicateBenchmark(state, [](value::SlotId docSlot) {
+        auto aGreater = makeE<EPrimBinary>(
+            EPrimBinary::greaterEq, makeGetField(makeE<EVariable>(docSlot), "a"), makeInt32(100));
+        auto bEquals = makeE<EPrimBinary>(EPrimBinary::eq,
+                                          makeGetField(makeE<EVariable>(docSlot), "b"),
+                                          makeE<EConstant>("odd"));
+        auto eLess = makeE<EPrimBinary>(
+            EPrimBinary::less, makeGetField(makeE<EVariable>(docSlot), "e"), makeInt32(50));
+        return makeE<EPrimBinary>(
+            EPrimBinary::logicAnd,
+            std::move(aGreater),
+            makeE<EPrimBinary>(EPrimBinary::logicAnd, std::move(bEquals), std::move(eLess)));
+    });
+}
+
+void BM_DisjunctionWithFillEmpty(benchmark::State& state) {
+    runPredicateBenchmark(state, [](value::SlotId docSlot) {
+        auto missingIsFalse = [](std::unique_ptr<EExpression> expr) {
+            auto falseConst =
+                makeE<EConstant>(value::TypeTags::Boolean, value::bitcastFrom<bool>(false));
+            return makeE<EFunction>("fillEmpty", makeEs(std::move(expr), std::move(falseConst)));
+        };
+        auto fMissing = missingIsFalse(makeE<EPrimBinary>(
+            EPrimBinary::eq, makeGetField(makeE<EVariable>(docSlot), "f"), makeInt32(1)));
+        auto eEquals = missingIsFalse(makeE<EPrimBinary>(
+            EPrimBinary::eq, makeGetField(makeE<EVariable>(docSlot), "e"), makeInt32(42)));
+        return makeE<EPrimBinary>(EPrimBinary::logicOr, std::move(fMissing), std::move(eEquals));
+    });
+}
+
+BENCHMARK(BM_GetFieldCompare);
+BENCHMARK(BM_NestedGetFieldCompare);
+BENCHMARK(BM_ConjunctionOfComparisons);
+BENCHMARK(BM_DisjunctionWithFillEmpty);
+}  // namespace
+}  // namespace mongo::sbe
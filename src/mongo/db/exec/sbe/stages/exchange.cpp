@@ -31,8 +31,12 @@
 
 #include "mongo/db/exec/sbe/stages/exchange.h"
 
+#include <algorithm>
+
 #include "mongo/base/init.h"
 #include "mongo/db/client.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo::sbe {
 std::unique_ptr<ThreadPool> s_globalThreadPool;
@@ -68,12 +72,20 @@ void ExchangePipe::close() {
     _cond.notify_all();
 }
 
-std::unique_ptr<ExchangeBuffer> ExchangePipe::getEmptyBuffer() {
+bool ExchangePipe::isClosed() {
     stdx::unique_lock lock(_mutex);
 
-    _cond.wait(lock, [this]() { return _closed || _emptyCount > 0; });
+    return _closed;
+}
 
-    if (_closed) {
+std::unique_ptr<ExchangeBuffer> ExchangePipe::getEmptyBuffer(bool wait) {
+    stdx::unique_lock lock(_mutex);
+
+    if (wait) {
+        _cond.wait(lock, [this]() { return _closed || _emptyCount > 0; });
+    }
+
+    if (_closed || _emptyCount == 0) {
         return nullptr;
     }
 
@@ -82,10 +94,11 @@ std::unique_ptr<ExchangeBuffer> ExchangePipe::getEmptyBuffer() {
     return std::move(_emptyBuffers[_emptyCount]);
 }
 
-std::unique_ptr<ExchangeBuffer> ExchangePipe::getFullBuffer() {
+std::unique_ptr<ExchangeBuffer> ExchangePipe::getFullBuffer(OperationContext* opCtx) {
     stdx::unique_lock lock(_mutex);
 
-    _cond.wait(lock, [this]() { return _closed || _fullCount != _fullPosition; });
+    opCtx->waitForConditionOrInterrupt(
+        _cond, lock, [this]() { return _closed || _fullCount != _fullPosition; });
 
     if (_closed) {
         return nullptr;
@@ -132,12 +145,105 @@ ExchangePipe* ExchangeState::pipe(size_t consumerTid, size_t producerTid) {
     return _consumers[consumerTid]->pipe(producerTid);
 }
 
+void ExchangeState::pauseProducers() {
+    stdx::unique_lock lock(_producersMutex);
+    _producersPaused.store(true);
+
+    // The active producers release their resources at their next yield point.
+    _producersCond.wait(lock, [this]() { return _activeProducers == 0; });
+}
+
+void ExchangeState::resumeProducers() {
+    stdx::unique_lock lock(_producersMutex);
+    _producersPaused.store(false);
+    _producersCond.notify_all();
+}
+
+void ExchangeState::beginProducerActivity(OperationContext* opCtx) {
+    stdx::unique_lock lock(_producersMutex);
+    opCtx->waitForConditionOrInterrupt(
+        _producersCond, lock, [this]() { return !_producersPaused.load(); });
+    ++_activeProducers;
+}
+
+void ExchangeState::endProducerActivity() {
+    stdx::unique_lock lock(_producersMutex);
+    invariant(_activeProducers > 0);
+    --_activeProducers;
+    _producersCond.notify_all();
+}
+
+void ExchangeState::registerProducerOpCtx(OperationContext* opCtx) {
+    stdx::unique_lock lock(_producersMutex);
+    _producerOpCtxs.push_back(opCtx);
+
+    if (_producersKillCode) {
+        stdx::lock_guard<Client> clientLock(*opCtx->getClient());
+        opCtx->getServiceContext()->killOperation(clientLock, opCtx, *_producersKillCode);
+    }
+}
+
+void ExchangeState::unregisterProducerOpCtx(OperationContext* opCtx) {
+    stdx::unique_lock lock(_producersMutex);
+    _producerOpCtxs.erase(std::find(_producerOpCtxs.begin(), _producerOpCtxs.end(), opCtx));
+}
+
+void ExchangeState::killProducers(ErrorCodes::Error killCode) {
+    stdx::unique_lock lock(_producersMutex);
+    if (!_producersKillCode) {
+        _producersKillCode = killCode;
+    }
+
+    for (auto opCtx : _producerOpCtxs) {
+        stdx::lock_guard<Client> clientLock(*opCtx->getClient());
+        opCtx->getServiceContext()->killOperation(clientLock, opCtx, *_producersKillCode);
+    }
+}
+
+/**
+ * Yield policy of the sub-tree run by a producer. Besides yielding periodically, as the plan that
+ * owns the consumers does, it yields as soon as the producers are paused.
+ */
+class ExchangeProducerYieldPolicy final : public PlanYieldPolicy {
+public:
+    ExchangeProducerYieldPolicy(ExchangeProducer* producer, ClockSource* clockSource)
+        : PlanYieldPolicy(YieldPolicy::YIELD_AUTO,
+                          clockSource,
+                          internalQueryExecYieldIterations.load(),
+                          Milliseconds{internalQueryExecYieldPeriodMS.load()}),
+          _producer(producer) {}
+
+    bool shouldYieldOrInterrupt(OperationContext* opCtx) override {
+        return _producer->_state->producersPaused() ||
+            PlanYieldPolicy::shouldYieldOrInterrupt(opCtx);
+    }
+
+private:
+    Status yield(OperationContext* opCtx, std::function<void()> whileYieldingFn) override {
+        try {
+            _producer->releaseResourcesWhile(whileYieldingFn);
+        } catch (...) {
+            return exceptionToStatus();
+        }
+
+        return Status::OK();
+    }
+
+    ExchangeProducer* const _producer;
+};
+
 ExchangeBuffer* ExchangeConsumer::getBuffer(size_t producerId) {
     if (_fullBuffers[producerId]) {
         return _fullBuffers[producerId].get();
     }
 
-    _fullBuffers[producerId] = _pipes[producerId]->getFullBuffer();
+    try {
+        _fullBuffers[producerId] = _pipes[producerId]->getFullBuffer(_opCtx);
+    } catch (const DBException& ex) {
+        // Stop the producers right away rather than when this stage is closed.
+        _state->killProducers(ex.code());
+        throw;
+    }
 
     return _fullBuffers[producerId].get();
 }
@@ -230,32 +336,40 @@ void ExchangeConsumer::open(bool reOpen) {
                     lock, [this]() { return _state->consumerOpen() == _state->numOfConsumers(); });
             }
 
-            // Clone n copies of the subtree for every producer.
+            // Clone n copies of the subtree for every producer. The master subtree is never opened
+            // but stays attached to this consumer so that the plan can still be saved, restored
+            // and explained while the producers are running.
 
             PlanStage* masterSubTree = _children[0].get();
-            masterSubTree->detachFromOperationContext();
 
             for (size_t idx = 0; idx < _state->numOfProducers(); ++idx) {
-                if (idx == 0) {
-                    _state->producerPlans().emplace_back(std::make_unique<ExchangeProducer>(
-                        std::move(_children[0]), _state, _commonStats.nodeId));
-                    // We have moved the child to the producer so clear the children vector.
-                    _children.clear();
-                } else {
-                    _state->producerPlans().emplace_back(std::make_unique<ExchangeProducer>(
-                        masterSubTree->clone(), _state, _commonStats.nodeId));
-                }
+                _state->producerPlans().emplace_back(std::make_unique<ExchangeProducer>(
+                    masterSubTree->clone(), _state, _commonStats.nodeId));
             }
 
-            // Start n producers.
+            // Start n producers. They run until the query that owns this consumer times out, or is
+            // killed, at the latest.
             invariant(_state->producerCompileCtxs().size() == _state->numOfProducers());
+            const auto deadline = _opCtx->getDeadline();
+            const auto timeoutError = _opCtx->getTimeoutError();
             for (size_t idx = 0; idx < _state->numOfProducers(); ++idx) {
                 auto pf = makePromiseFuture<void>();
                 s_globalThreadPool->schedule(
-                    [this, idx, promise = std::move(pf.promise)](auto status) mutable {
+                    [this, idx, deadline, timeoutError, promise = std::move(pf.promise)](
+                        auto status) mutable {
                         invariant(status);
 
                         auto opCtx = cc().makeOperationContext();
+                        if (deadline != Date_t::max()) {
+                            opCtx->setDeadlineByDate(deadline, timeoutError);
+                        }
+
+                        // The producers only access the collection while the query holds its own
+                        // locks and ticket, so they do not compete for a ticket with it.
+                        opCtx->lockState()->skipAcquireTicket();
+
+                        _state->registerProducerOpCtx(opCtx.get());
+                        ON_BLOCK_EXIT([&] { _state->unregisterProducerOpCtx(opCtx.get()); });
 
                         promise.setWith([&] {
                             ExchangeProducer::start(opCtx.get(),
@@ -334,6 +448,13 @@ void ExchangeConsumer::close() {
 
         if (_tid == 0) {
             // Consumer ID 0
+            if (auto status = _opCtx->checkForInterruptNoAssert(); !status.isOK()) {
+                _state->killProducers(status.code());
+            }
+
+            // Let the producers that are paused notice that the pipes are closed.
+            _state->resumeProducers();
+
             // Wait for n producers to finish.
             for (size_t idx = 0; idx < _state->numOfProducers(); ++idx) {
                 _state->producerResults()[idx].wait();
@@ -361,7 +482,10 @@ void ExchangeConsumer::close() {
 
 std::unique_ptr<PlanStageStats> ExchangeConsumer::getStats(bool includeDebugInfo) const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
-    ret->children.emplace_back(_children[0]->getStats(includeDebugInfo));
+    // Only the consumer that owns the master subtree has a child.
+    if (!_children.empty()) {
+        ret->children.emplace_back(_children[0]->getStats(includeDebugInfo));
+    }
     return ret;
 }
 
@@ -394,12 +518,27 @@ std::vector<DebugPrinter::Block> ExchangeConsumer::debugPrint() const {
             uasserted(4822835, "policy not yet implemented");
     }
 
-    DebugPrinter::addNewLine(ret);
-    DebugPrinter::addBlocks(ret, _children[0]->debugPrint());
+    if (!_children.empty()) {
+        DebugPrinter::addNewLine(ret);
+        DebugPrinter::addBlocks(ret, _children[0]->debugPrint());
+    }
 
     return ret;
 }
 
+void ExchangeConsumer::doSaveState() {
+    // Only the consumer that owns the master subtree coordinates the producers.
+    if (_tid == 0) {
+        _state->pauseProducers();
+    }
+}
+
+void ExchangeConsumer::doRestoreState() {
+    if (_tid == 0) {
+        _state->resumeProducers();
+    }
+}
+
 ExchangePipe* ExchangeConsumer::pipe(size_t producerTid) {
     if (_orderPreserving) {
         return _pipes[producerTid].get();
@@ -430,6 +569,51 @@ void ExchangeProducer::putBuffer(size_t consumerId) {
     _pipes[consumerId]->putFullBuffer(std::move(_emptyBuffers[consumerId]));
 }
 
+bool ExchangeProducer::reserveBuffer(size_t consumerId) {
+    if (!_emptyBuffers[consumerId]) {
+        _emptyBuffers[consumerId] = _pipes[consumerId]->getEmptyBuffer(false /* wait */);
+    }
+
+    if (!_emptyBuffers[consumerId] && !_pipes[consumerId]->isClosed()) {
+        // The consumers are behind, and may even be waiting for the next getMore, so do not hold on
+        // to any resources while waiting for them.
+        releaseResourcesWhile(
+            [&]() { _emptyBuffers[consumerId] = _pipes[consumerId]->getEmptyBuffer(); });
+    }
+
+    if (!_emptyBuffers[consumerId]) {
+        closePipes();
+        return false;
+    }
+
+    return true;
+}
+
+void ExchangeProducer::releaseResourcesWhile(const std::function<void()>& whileReleasedFn) {
+    _children[0]->saveState();
+    _opCtx->recoveryUnit()->abandonSnapshot();
+    endActivity();
+
+    if (whileReleasedFn) {
+        whileReleasedFn();
+    }
+
+    beginActivity();
+    _children[0]->restoreState();
+}
+
+void ExchangeProducer::beginActivity() {
+    invariant(!_active);
+    _state->beginProducerActivity(_opCtx);
+    _active = true;
+}
+
+void ExchangeProducer::endActivity() {
+    invariant(_active);
+    _state->endProducerActivity();
+    _active = false;
+}
+
 void ExchangeProducer::closePipes() {
     for (auto& p : _pipes) {
         p->close();
@@ -457,9 +641,19 @@ void ExchangeProducer::start(OperationContext* opCtx,
     ExchangeProducer* p = static_cast<ExchangeProducer*>(producer.get());
 
     p->attachToOperationContext(opCtx);
+    p->_producerYieldPolicy = std::make_unique<ExchangeProducerYieldPolicy>(
+        p, opCtx->getServiceContext()->getFastClockSource());
+    p->attachNewYieldPolicy(p->_producerYieldPolicy.get());
+
+    ON_BLOCK_EXIT([&] {
+        if (p->_active) {
+            p->endActivity();
+        }
+    });
 
     try {
         p->prepare(ctx);
+        p->beginActivity();
         p->open(false);
 
         auto status = p->getNext();
@@ -513,7 +707,25 @@ bool ExchangeProducer::appendData(size_t consumerId) {
 }
 
 PlanState ExchangeProducer::getNext() {
-    while (_children[0]->getNext() == PlanState::ADVANCED) {
+    while (true) {
+        // Reserve the buffers for the next row before producing it, as the sub-tree may have to be
+        // saved while waiting for one.
+        if (_state->policy() == ExchangePolicy::roundrobin) {
+            if (!reserveBuffer(_roundRobinCounter)) {
+                return trackPlanState(PlanState::IS_EOF);
+            }
+        } else {
+            for (size_t idx = 0; idx < _pipes.size(); ++idx) {
+                if (!reserveBuffer(idx)) {
+                    return trackPlanState(PlanState::IS_EOF);
+                }
+            }
+        }
+
+        if (_children[0]->getNext() != PlanState::ADVANCED) {
+            break;
+        }
+
         // Push to the correct pipe.
         switch (_state->policy()) {
             case ExchangePolicy::broadcast: {
@@ -542,11 +754,11 @@ PlanState ExchangeProducer::getNext() {
 
     // Send off partially filled buffers and the eof marker.
     for (size_t idx = 0; idx < _pipes.size(); ++idx) {
-        auto buffer = getBuffer(idx);
         // Detect early out in the loop.
-        if (!buffer) {
+        if (!reserveBuffer(idx)) {
             return trackPlanState(PlanState::IS_EOF);
         }
+        auto buffer = getBuffer(idx);
         buffer->markEof();
         // Send it off to consumer.
         putBuffer(idx);
@@ -122,8 +122,19 @@ public:
     ExchangePipe(size_t size);
 
     void close();
-    std::unique_ptr<ExchangeBuffer> getEmptyBuffer();
-    std::unique_ptr<ExchangeBuffer> getFullBuffer();
+    bool isClosed();
+
+    /**
+     * Returns an empty buffer, or nullptr if the pipe is closed. Unless 'wait' is false, in which
+     * case nullptr is also returned when no buffer is available, waits for one to be returned.
+     */
+    std::unique_ptr<ExchangeBuffer> getEmptyBuffer(bool wait = true);
+
+    /**
+     * Returns a full buffer, or nullptr if the pipe is closed. Throws if 'opCtx' is interrupted
+     * while waiting for a buffer.
+     */
+    std::unique_ptr<ExchangeBuffer> getFullBuffer(OperationContext* opCtx);
     void putEmptyBuffer(std::unique_ptr<ExchangeBuffer>);
     void putFullBuffer(std::unique_ptr<ExchangeBuffer>);
 
@@ -217,6 +228,33 @@ public:
     }
     ExchangePipe* pipe(size_t consumerTid, size_t producerTid);
 
+    /**
+     * The producers hold locks, storage engine cursors and snapshots only while the plan that owns
+     * the consumers is active. When that plan is saved, either because it yields or because the
+     * query is waiting for the next getMore, the producers are paused: they release their
+     * resources at their next yield point and wait to be resumed when the plan is restored.
+     */
+    void pauseProducers();
+    void resumeProducers();
+    bool producersPaused() const {
+        return _producersPaused.load();
+    }
+
+    /**
+     * Called by a producer before it acquires its resources, which waits while the producers are
+     * paused, and after it has released them.
+     */
+    void beginProducerActivity(OperationContext* opCtx);
+    void endProducerActivity();
+
+    /**
+     * Links the operations of the producers to the operation running the consumers, so that they
+     * are killed along with it.
+     */
+    void registerProducerOpCtx(OperationContext* opCtx);
+    void unregisterProducerOpCtx(OperationContext* opCtx);
+    void killProducers(ErrorCodes::Error killCode);
+
 private:
     const ExchangePolicy _policy;
     const size_t _numOfProducers;
@@ -244,6 +282,13 @@ private:
     mongo::Mutex _consumerCloseMutex;
     stdx::condition_variable _consumerCloseCond;
     size_t _consumerClose{0};
+
+    mongo::Mutex _producersMutex;
+    stdx::condition_variable _producersCond;
+    AtomicWord<bool> _producersPaused{false};
+    size_t _activeProducers{0};
+    std::vector<OperationContext*> _producerOpCtxs;
+    boost::optional<ErrorCodes::Error> _producersKillCode;
 };
 
 class ExchangeConsumer final : public PlanStage {
@@ -272,6 +317,10 @@ public:
 
     ExchangePipe* pipe(size_t producerTid);
 
+protected:
+    void doSaveState() final;
+    void doRestoreState() final;
+
 private:
     ExchangeBuffer* getBuffer(size_t producerId);
     void putBuffer(size_t producerId);
@@ -324,6 +373,20 @@ private:
     ExchangeBuffer* getBuffer(size_t consumerId);
     void putBuffer(size_t consumerId);
 
+    /**
+     * Makes sure that an empty buffer is at hand for the given consumer, releasing the resources of
+     * this producer if it has to wait for one. Returns false if the pipe was closed.
+     */
+    bool reserveBuffer(size_t consumerId);
+
+    /**
+     * Saves the sub-tree of this producer and releases its storage snapshot while 'whileReleasedFn'
+     * runs, then waits for the producers to be resumed before restoring the sub-tree.
+     */
+    void releaseResourcesWhile(const std::function<void()>& whileReleasedFn);
+    void beginActivity();
+    void endActivity();
+
     void closePipes();
     bool appendData(size_t consumerId);
 
@@ -337,5 +400,13 @@ private:
 
     // Current empty buffers that this producer is processing.
     std::vector<std::unique_ptr<ExchangeBuffer>> _emptyBuffers;
+
+    // Yields the sub-tree of this producer, in place of the yield policy of the query.
+    std::unique_ptr<PlanYieldPolicy> _producerYieldPolicy;
+
+    // Whether this producer currently holds resources, see ExchangeState::pauseProducers().
+    bool _active{false};
+
+    friend class ExchangeProducerYieldPolicy;
 };
 }  // namespace mongo::sbe
@@ -38,9 +38,16 @@ namespace sbe {
 HashAggStage::HashAggStage(std::unique_ptr<PlanStage> input,
                            value::SlotVector gbs,
                            value::SlotMap<std::unique_ptr<EExpression>> aggs,
+                           size_t memoryLimit,
+                           bool allowDiskUse,
                            PlanNodeId planNodeId)
-    : PlanStage("group"_sd, planNodeId), _gbs(std::move(gbs)), _aggs(std::move(aggs)) {
+    : PlanStage("group"_sd, planNodeId),
+      _gbs(std::move(gbs)),
+      _aggs(std::move(aggs)),
+      _memoryLimit(memoryLimit),
+      _allowDiskUse(allowDiskUse) {
     _children.emplace_back(std::move(input));
+    _specificStats.memoryLimitBytes = _memoryLimit;
 }
 
 std::unique_ptr<PlanStage> HashAggStage::clone() const {
@@ -48,8 +55,12 @@ std::unique_ptr<PlanStage> HashAggStage::clone() const {
     for (auto& [k, v] : _aggs) {
         aggs.emplace(k, v->clone());
     }
-    return std::make_unique<HashAggStage>(
-        _children[0]->clone(), _gbs, std::move(aggs), _commonStats.nodeId);
+    return std::make_unique<HashAggStage>(_children[0]->clone(),
+                                          _gbs,
+                                          std::move(aggs),
+                                          _memoryLimit,
+                                          _allowDiskUse,
+                                          _commonStats.nodeId);
 }
 
 void HashAggStage::prepare(CompileCtx& ctx) {
@@ -95,20 +106,140 @@ value::SlotAccessor* HashAggStage::getAccessor(CompileCtx& ctx, value::SlotId sl
             return it->second;
         }
     } else {
-        return _children[0]->getAccessor(ctx, slot);
+        // The aggregate expressions are being compiled. The slots coming from the runtime
+        // environment are the same for every row, all the other input slots are routed through
+        // our own accessors, so that the expressions can be fed with the spilled rows later on.
+        auto accessor = _children[0]->getAccessor(ctx, slot);
+        if (ctx.isEnvironmentSlot(slot)) {
+            return accessor;
+        }
+
+        for (size_t idx = 0; idx < _inAggSlots.size(); ++idx) {
+            if (_inAggSlots[idx] == slot) {
+                return _inAggAccessors[idx].get();
+            }
+        }
+
+        _inAggSlots.push_back(slot);
+        _inAggChildAccessors.push_back(accessor);
+        _inAggAccessors.emplace_back(std::make_unique<value::ViewOfValueAccessor>());
+        return _inAggAccessors.back().get();
     }
 
     return ctx.getAccessor(slot);
 }
 
+bool HashAggStage::aggregate(value::MaterializedRow& key) {
+    auto it = _ht.find(key);
+    const bool newGroup = it == _ht.end();
+    if (newGroup) {
+        // Once a row of this pass has been spilled, every new group is spilled as well: the memory
+        // usage can go down again, e.g. with $min, but the rows spilled earlier may belong to the
+        // new group, which would then be returned twice.
+        if (_spilling ||
+            (_memoryUsage > _memoryLimit && _partitioner->level() < kMaxPartitionLevel)) {
+            return false;
+        }
+
+        // Copy keys.
+        key.makeOwned();
+        it = _ht.emplace(std::move(key), value::MaterializedRow{0}).first;
+        // Initialize accumulators.
+        it->second.resize(_outAggAccessors.size());
+    }
+
+    // Accumulate. The memory footprint of the accumulators is re-estimated after every update, so
+    // that the growth of accumulators such as $push and $addToSet is accounted for.
+    const size_t oldAggsMemoryUsage = newGroup ? 0 : it->second.memUsageForSorter();
+    _htIt = it;
+    for (size_t idx = 0; idx < _outAggAccessors.size(); ++idx) {
+        auto [owned, tag, val] = _bytecode.run(_aggCodes[idx].get());
+        _outAggAccessors[idx]->reset(owned, tag, val);
+    }
+
+    if (newGroup) {
+        _memoryUsage += it->first.memUsageForSorter();
+    }
+    _memoryUsage += it->second.memUsageForSorter();
+    _memoryUsage -= oldAggsMemoryUsage;
+
+    // The groups which are already in the table cannot be spilled, so a table which outgrows the
+    // memory limit only stops accepting new groups when disk use is allowed.
+    uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
+            "Exceeded memory limit for $group, but didn't allow external sort."
+            " Pass allowDiskUse:true to opt in.",
+            _allowDiskUse || _memoryUsage <= _memoryLimit);
+
+    return true;
+}
+
+void HashAggStage::spill(const value::MaterializedRow& key) {
+    invariant(_partitioner);
+
+    value::MaterializedRow values{_inAggAccessors.size()};
+    for (size_t idx = 0; idx < _inAggAccessors.size(); ++idx) {
+        auto [tag, val] = _inAggAccessors[idx]->getViewOfValue();
+        values.reset(idx, false, tag, val);
+    }
+
+    _partitioner->append(key, values);
+    _spilling = true;
+    ++_specificStats.spilledRecords;
+}
+
+void HashAggStage::finishSpilling() {
+    bool spilled = false;
+    for (auto&& partition : _partitioner->done()) {
+        if (partition) {
+            _pendingPartitions.emplace_back(std::move(partition), _partitioner->level());
+            spilled = true;
+        }
+    }
+
+    if (spilled) {
+        ++_specificStats.spills;
+    }
+}
+
+void HashAggStage::processNextPartition() {
+    invariant(!_pendingPartitions.empty());
+    auto [partition, level] = std::move(_pendingPartitions.front());
+    _pendingPartitions.pop_front();
+
+    _ht.clear();
+    _memoryUsage = 0;
+    _spilling = false;
+    _partitioner = std::make_unique<SpillPartitioner>(getSpillDirectory(), level + 1);
+
+    while (partition->more()) {
+        auto [key, values] = partition->next();
+        for (size_t idx = 0; idx < _inAggAccessors.size(); ++idx) {
+            auto [tag, val] = values.getViewOfValue(idx);
+            _inAggAccessors[idx]->reset(tag, val);
+        }
+
+        if (!aggregate(key)) {
+            spill(key);
+        }
+    }
+
+    finishSpilling();
+    ++_specificStats.partitionsProcessed;
+}
+
 void HashAggStage::open(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
 
     if (reOpen) {
         _ht.clear();
+        _pendingPartitions.clear();
     }
 
+    _memoryUsage = 0;
+    _spilling = false;
+    _partitioner = std::make_unique<SpillPartitioner>(getSpillDirectory(), 0);
+
     while (_children[0]->getNext() == PlanState::ADVANCED) {
         value::MaterializedRow key{_inKeyAccessors.size()};
         // Copy keys in order to do the lookup.
@@ -118,23 +249,18 @@ void HashAggStage::open(bool reOpen) {
             key.reset(idx++, false, tag, val);
         }
 
-        auto [it, inserted] = _ht.try_emplace(std::move(key), value::MaterializedRow{0});
-        if (inserted) {
-            // Copy keys.
-            const_cast<value::MaterializedRow&>(it->first).makeOwned();
-            // Initialize accumulators.
-            it->second.resize(_outAggAccessors.size());
+        for (idx = 0; idx < _inAggAccessors.size(); ++idx) {
+            auto [tag, val] = _inAggChildAccessors[idx]->getViewOfValue();
+            _inAggAccessors[idx]->reset(tag, val);
         }
 
-        // Accumulate.
-        _htIt = it;
-        for (size_t idx = 0; idx < _outAggAccessors.size(); ++idx) {
-            auto [owned, tag, val] = _bytecode.run(_aggCodes[idx].get());
-            _outAggAccessors[idx]->reset(owned, tag, val);
+        if (!aggregate(key)) {
+            spill(key);
         }
     }
 
     _children[0]->close();
+    finishSpilling();
 
     _htIt = _ht.end();
 }
@@ -146,8 +272,14 @@ PlanState HashAggStage::getNext() {
         ++_htIt;
     }
 
-    if (_htIt == _ht.end()) {
-        return trackPlanState(PlanState::IS_EOF);
+    // Once the groups held in memory are exhausted, carry on with the spilled partitions.
+    while (_htIt == _ht.end()) {
+        if (_pendingPartitions.empty()) {
+            return trackPlanState(PlanState::IS_EOF);
+        }
+
+        processNextPartition();
+        _htIt = _ht.begin();
     }
 
     return trackPlanState(PlanState::ADVANCED);
@@ -155,10 +287,15 @@ PlanState HashAggStage::getNext() {
 
 std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<HashAggStats>(_specificStats);
 
     if (includeDebugInfo) {
         DebugPrinter printer;
         BSONObjBuilder bob;
+        bob.appendNumber("memoryLimitBytes", static_cast<long long>(_memoryLimit));
+        bob.appendBool("usedDisk", _specificStats.spills > 0);
+        bob.appendNumber("spills", static_cast<long long>(_specificStats.spills));
+        bob.appendNumber("spilledRecords", static_cast<long long>(_specificStats.spilledRecords));
         bob.append("groupBySlots", _gbs);
         if (!_aggs.empty()) {
             BSONObjBuilder childrenBob(bob.subobjStart("expressions"));
@@ -174,12 +311,14 @@ std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) co
 }
 
 const SpecificStats* HashAggStage::getSpecificStats() const {
-    return nullptr;
+    return &_specificStats;
 }
 
 void HashAggStage::close() {
     _commonStats.closes++;
     _ht.clear();
+    _partitioner.reset();
+    _pendingPartitions.clear();
 }
 
 std::vector<DebugPrinter::Block> HashAggStage::debugPrint() const {
@@ -29,20 +29,37 @@
 
 #pragma once
 
+#include <deque>
 #include <unordered_map>
 
 #include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/exec/sbe/stages/plan_stats.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/exec/sbe/util/spilling.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
 #include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 namespace sbe {
+/**
+ * Groups the rows of its input by the values of the 'gbs' slots and computes the 'aggs'
+ * expressions for every group.
+ *
+ * The groups are kept in an in-memory hash table. Once the estimated size of the table exceeds
+ * 'memoryLimit' bytes, no more groups are added to it: the input rows which belong to the groups
+ * already in the table are still aggregated in memory, whereas the remaining rows are spilled to
+ * disk, partitioned by the hash of their group-by key. After the groups held in memory have been
+ * returned, the spilled partitions are processed one at a time in the same way, partitioning
+ * them again if they still do not fit in memory, up to 'kMaxPartitionLevel' times. If
+ * 'allowDiskUse' is false, exceeding the memory limit raises an error instead.
+ */
 class HashAggStage final : public PlanStage {
 public:
     HashAggStage(std::unique_ptr<PlanStage> input,
                  value::SlotVector gbs,
                  value::SlotMap<std::unique_ptr<EExpression>> aggs,
+                 size_t memoryLimit,
+                 bool allowDiskUse,
                  PlanNodeId planNodeId);
 
     std::unique_ptr<PlanStage> clone() const final;
@@ -58,17 +75,53 @@ public:
     std::vector<DebugPrinter::Block> debugPrint() const final;
 
 private:
+    // The maximum partitioning level. The partitions at this level are aggregated in memory
+    // regardless of the memory limit, as repartitioning them again is unlikely to split them any
+    // further (e.g. when most of the rows share the same key).
+    static constexpr size_t kMaxPartitionLevel = 8;
+
     using TableType = stdx::
         unordered_map<value::MaterializedRow, value::MaterializedRow, value::MaterializedRowHasher>;
 
     using HashKeyAccessor = value::MaterializedRowKeyAccessor<TableType::iterator>;
     using HashAggAccessor = value::MaterializedRowValueAccessor<TableType::iterator>;
 
+    /**
+     * Aggregates the current input row, whose group-by key is 'key', into the hash table. Returns
+     * false if the row belongs to a new group which cannot be added to the table because the
+     * memory limit has been reached, or because rows of this pass have already been spilled.
+     */
+    bool aggregate(value::MaterializedRow& key);
+
+    /**
+     * Writes the current input row to the spilled partitions.
+     */
+    void spill(const value::MaterializedRow& key);
+
+    /**
+     * Moves the partitions produced by the current partitioner to the queue of the partitions
+     * which remain to be processed.
+     */
+    void finishSpilling();
+
+    /**
+     * Rebuilds the hash table from the next spilled partition.
+     */
+    void processNextPartition();
+
     const value::SlotVector _gbs;
     const value::SlotMap<std::unique_ptr<EExpression>> _aggs;
+    const size_t _memoryLimit;
+    const bool _allowDiskUse;
 
     value::SlotAccessorMap _outAccessors;
     std::vector<value::SlotAccessor*> _inKeyAccessors;
+
+    // The input slots read by the aggregate expressions. The expressions read them through the
+    // '_inAggAccessors', which are fed either from the child's accessors or from a spilled row.
+    value::SlotVector _inAggSlots;
+    std::vector<value::SlotAccessor*> _inAggChildAccessors;
+    std::vector<std::unique_ptr<value::ViewOfValueAccessor>> _inAggAccessors;
     std::vector<std::unique_ptr<HashKeyAccessor>> _outKeyAccessors;
 
     std::vector<std::unique_ptr<HashAggAccessor>> _outAggAccessors;
@@ -79,6 +132,17 @@ private:
 
     vm::ByteCode _bytecode;
 
+    // The estimated memory footprint of the groups in the hash table, in bytes.
+    size_t _memoryUsage{0};
+    // Whether a row of the current pass, over the input or over a spilled partition, has been
+    // spilled. New groups are then spilled too, even if the memory usage has gone down again.
+    bool _spilling{false};
+    std::unique_ptr<SpillPartitioner> _partitioner;
+    // The spilled partitions which remain to be processed, along with their partitioning level.
+    std::deque<std::pair<std::unique_ptr<SpilledRows>, size_t>> _pendingPartitions;
+
+    HashAggStats _specificStats;
+
     bool _compiled{false};
 };
 }  // namespace sbe
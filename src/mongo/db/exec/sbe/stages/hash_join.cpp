@@ -42,12 +42,20 @@ HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
                              value::SlotVector outerProjects,
                              value::SlotVector innerCond,
                              value::SlotVector innerProjects,
-                             PlanNodeId planNodeId)
+                             size_t memoryLimit,
+                             bool allowDiskUse,
+                             PlanNodeId planNodeId,
+                             bool reuseOuterOnReOpen,
+                             bool canSpill)
     : PlanStage("hj"_sd, planNodeId),
       _outerCond(std::move(outerCond)),
       _outerProjects(std::move(outerProjects)),
       _innerCond(std::move(innerCond)),
       _innerProjects(std::move(innerProjects)),
+      _memoryLimit(memoryLimit),
+      _allowDiskUse(allowDiskUse),
+      _reuseOuterOnReOpen(reuseOuterOnReOpen),
+      _canSpill(canSpill),
       _probeKey(0) {
     if (_outerCond.size() != _innerCond.size()) {
         uasserted(4822823, "left and right size do not match");
@@ -55,6 +63,7 @@ HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
 
     _children.emplace_back(std::move(outer));
     _children.emplace_back(std::move(inner));
+    _specificStats.memoryLimitBytes = _memoryLimit;
 }
 
 std::unique_ptr<PlanStage> HashJoinStage::clone() const {
@@ -64,7 +73,11 @@ std::unique_ptr<PlanStage> HashJoinStage::clone() const {
                                            _outerProjects,
                                            _innerCond,
                                            _innerProjects,
-                                           _commonStats.nodeId);
+                                           _memoryLimit,
+                                           _allowDiskUse,
+                                           _commonStats.nodeId,
+                                           _reuseOuterOnReOpen,
+                                           _canSpill);
 }
 
 void HashJoinStage::prepare(CompileCtx& ctx) {
@@ -88,6 +101,14 @@ void HashJoinStage::prepare(CompileCtx& ctx) {
         uassert(4822825, str::stream() << "duplicate field: " << slot, inserted);
 
         _inInnerKeyAccessors.emplace_back(_children[1]->getAccessor(ctx, slot));
+        _outInnerKeyAccessors.emplace_back(std::make_unique<value::ViewOfValueAccessor>());
+        _outInnerAccessors[slot] = _outInnerKeyAccessors.back().get();
+    }
+
+    for (auto& slot : _innerProjects) {
+        _inInnerProjectAccessors.emplace_back(_children[1]->getAccessor(ctx, slot));
+        _outInnerProjectAccessors.emplace_back(std::make_unique<value::ViewOfValueAccessor>());
+        _outInnerAccessors[slot] = _outInnerProjectAccessors.back().get();
     }
 
     counter = 0;
@@ -112,14 +133,163 @@ value::SlotAccessor* HashJoinStage::getAccessor(CompileCtx& ctx, value::SlotId s
             return it->second;
         }
 
+        if (auto it = _outInnerAccessors.find(slot); it != _outInnerAccessors.end()) {
+            return it->second;
+        }
+
         return _children[1]->getAccessor(ctx, slot);
     }
 
     return ctx.getAccessor(slot);
 }
 
+void HashJoinStage::insertOuterRow(value::MaterializedRow key,
+                                   value::MaterializedRow project,
+                                   size_t level) {
+    if (_outerPartitioner) {
+        _outerPartitioner->append(key, project);
+        ++_specificStats.spilledRecords;
+        return;
+    }
+
+    _memoryUsage += key.memUsageForSorter() + project.memUsageForSorter();
+    _ht.emplace(std::move(key), std::move(project));
+
+    if (_memoryUsage > _memoryLimit && level < kMaxPartitionLevel) {
+        uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
+                str::stream() << "hash join buffered data usage of " << _memoryUsage
+                              << " bytes exceeds internal limit of " << _memoryLimit << " bytes",
+                _canSpill);
+        uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
+                "Exceeded memory limit for hash join, but didn't allow external sort."
+                " Pass allowDiskUse:true to opt in.",
+                _allowDiskUse);
+
+        // The outer side does not fit in memory, so spill the hash table and all of the remaining
+        // outer rows.
+        _outerPartitioner = std::make_unique<SpillPartitioner>(getSpillDirectory(), level);
+        for (auto&& [htKey, htProject] : _ht) {
+            _outerPartitioner->append(htKey, htProject);
+        }
+        _specificStats.spilledRecords += _ht.size();
+        ++_specificStats.spills;
+
+        _ht.clear();
+        _memoryUsage = 0;
+    }
+}
+
+void HashJoinStage::finishSpilling() {
+    invariant(_outerPartitioner && _innerPartitioner);
+
+    auto outerPartitions = _outerPartitioner->done();
+    auto innerPartitions = _innerPartitioner->done();
+    for (size_t idx = 0; idx < SpillPartitioner::kNumPartitions; ++idx) {
+        // Only the partitions which have rows on both sides can produce any results.
+        if (outerPartitions[idx] && innerPartitions[idx]) {
+            _pendingPartitions.push_back({std::move(outerPartitions[idx]),
+                                          std::move(innerPartitions[idx]),
+                                          _outerPartitioner->level()});
+        }
+    }
+
+    _outerPartitioner.reset();
+    _innerPartitioner.reset();
+}
+
+void HashJoinStage::processNextPartition() {
+    invariant(!_pendingPartitions.empty());
+    auto partitions = std::move(_pendingPartitions.front());
+    _pendingPartitions.pop_front();
+
+    _ht.clear();
+    _memoryUsage = 0;
+    _innerPartition.reset();
+
+    while (partitions.outer->more()) {
+        auto [key, project] = partitions.outer->next();
+        insertOuterRow(std::move(key), std::move(project), partitions.level + 1);
+    }
+
+    if (_outerPartitioner) {
+        // The partition is still too large, so its inner side must be partitioned again too.
+        _innerPartitioner =
+            std::make_unique<SpillPartitioner>(getSpillDirectory(), partitions.level + 1);
+        while (partitions.inner->more()) {
+            auto [key, project] = partitions.inner->next();
+            _innerPartitioner->append(key, project);
+        }
+        finishSpilling();
+    } else {
+        _innerPartition = std::move(partitions.inner);
+    }
+
+    ++_specificStats.partitionsProcessed;
+}
+
+bool HashJoinStage::nextInnerRow() {
+    if (!_probeSpilled) {
+        if (_children[1]->getNext() == PlanState::IS_EOF) {
+            return false;
+        }
+
+        // Copy keys in order to do the lookup.
+        for (size_t idx = 0; idx < _inInnerKeyAccessors.size(); ++idx) {
+            auto [tag, val] = _inInnerKeyAccessors[idx]->getViewOfValue();
+            _probeKey.reset(idx, false, tag, val);
+            _outInnerKeyAccessors[idx]->reset(tag, val);
+        }
+
+        for (size_t idx = 0; idx < _inInnerProjectAccessors.size(); ++idx) {
+            auto [tag, val] = _inInnerProjectAccessors[idx]->getViewOfValue();
+            _outInnerProjectAccessors[idx]->reset(tag, val);
+        }
+
+        return true;
+    }
+
+    while (!_innerPartition || !_innerPartition->more()) {
+        if (_pendingPartitions.empty()) {
+            return false;
+        }
+
+        processNextPartition();
+    }
+
+    _innerRow = _innerPartition->next();
+    for (size_t idx = 0; idx < _inInnerKeyAccessors.size(); ++idx) {
+        auto [tag, val] = _innerRow.first.getViewOfValue(idx);
+        _probeKey.reset(idx, false, tag, val);
+        _outInnerKeyAccessors[idx]->reset(tag, val);
+    }
+
+    for (size_t idx = 0; idx < _inInnerProjectAccessors.size(); ++idx) {
+        auto [tag, val] = _innerRow.second.getViewOfValue(idx);
+        _outInnerProjectAccessors[idx]->reset(tag, val);
+    }
+
+    return true;
+}
+
 void HashJoinStage::open(bool reOpen) {
     _commonStats.opens++;
+
+    if (reOpen && _reuseOuterOnReOpen && _outerInMemory) {
+        // The outer side cannot have changed, so only the inner side needs to be reopened.
+        _children[1]->open(reOpen);
+        _htIt = _ht.end();
+        _htItEnd = _ht.end();
+        return;
+    }
+
+    _ht.clear();
+    _memoryUsage = 0;
+    _outerPartitioner.reset();
+    _innerPartitioner.reset();
+    _pendingPartitions.clear();
+    _innerPartition.reset();
+    _probeSpilled = false;
+
     _children[0]->open(reOpen);
     // Insert the outer side into the hash table.
     while (_children[0]->getNext() == PlanState::ADVANCED) {
@@ -140,13 +310,42 @@ void HashJoinStage::open(bool reOpen) {
             project.reset(idx++, true, tag, val);
         }
 
-        _ht.emplace(std::move(key), std::move(project));
+        insertOuterRow(std::move(key), std::move(project), 0);
     }
 
     _children[0]->close();
+    _outerInMemory = !_outerPartitioner;
 
     _children[1]->open(reOpen);
 
+    if (_outerPartitioner) {
+        // The outer side has been spilled, so partition the inner side in the same way and join
+        // the partitions pairwise.
+        _innerPartitioner = std::make_unique<SpillPartitioner>(getSpillDirectory(), 0);
+        while (_children[1]->getNext() == PlanState::ADVANCED) {
+            value::MaterializedRow key{_inInnerKeyAccessors.size()};
+            value::MaterializedRow project{_inInnerProjectAccessors.size()};
+
+            size_t idx = 0;
+            for (auto& p : _inInnerKeyAccessors) {
+                auto [tag, val] = p->getViewOfValue();
+                key.reset(idx++, false, tag, val);
+            }
+
+            idx = 0;
+            for (auto& p : _inInnerProjectAccessors) {
+                auto [tag, val] = p->getViewOfValue();
+                project.reset(idx++, false, tag, val);
+            }
+
+            _innerPartitioner->append(key, project);
+            ++_specificStats.spilledRecords;
+        }
+
+        finishSpilling();
+        _probeSpilled = true;
+    }
+
     _htIt = _ht.end();
     _htItEnd = _ht.end();
 }
@@ -158,17 +357,9 @@ PlanState HashJoinStage::getNext() {
 
     if (_htIt == _htItEnd) {
         while (_htIt == _htItEnd) {
-            auto state = _children[1]->getNext();
-            if (state == PlanState::IS_EOF) {
+            if (!nextInnerRow()) {
                 // LEFT and OUTER joins should enumerate "non-returned" rows here.
-                return trackPlanState(state);
-            }
-
-            // Copy keys in order to do the lookup.
-            size_t idx = 0;
-            for (auto& p : _inInnerKeyAccessors) {
-                auto [tag, val] = p->getViewOfValue();
-                _probeKey.reset(idx++, false, tag, val);
+                return trackPlanState(PlanState::IS_EOF);
             }
 
             auto [low, hi] = _ht.equal_range(_probeKey);
@@ -185,17 +376,37 @@ PlanState HashJoinStage::getNext() {
 void HashJoinStage::close() {
     _commonStats.closes++;
     _children[1]->close();
+
+    if (!_reuseOuterOnReOpen || !_outerInMemory) {
+        _ht.clear();
+        _outerInMemory = false;
+    }
+    _outerPartitioner.reset();
+    _innerPartitioner.reset();
+    _pendingPartitions.clear();
+    _innerPartition.reset();
 }
 
 std::unique_ptr<PlanStageStats> HashJoinStage::getStats(bool includeDebugInfo) const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<HashJoinStats>(_specificStats);
+
+    if (includeDebugInfo) {
+        BSONObjBuilder bob;
+        bob.appendNumber("memoryLimitBytes", static_cast<long long>(_memoryLimit));
+        bob.appendBool("usedDisk", _specificStats.spills > 0);
+        bob.appendNumber("spills", static_cast<long long>(_specificStats.spills));
+        bob.appendNumber("spilledRecords", static_cast<long long>(_specificStats.spilledRecords));
+        ret->debugInfo = bob.obj();
+    }
+
     ret->children.emplace_back(_children[0]->getStats(includeDebugInfo));
     ret->children.emplace_back(_children[1]->getStats(includeDebugInfo));
     return ret;
 }
 
 const SpecificStats* HashJoinStage::getSpecificStats() const {
-    return nullptr;
+    return &_specificStats;
 }
 
 std::vector<DebugPrinter::Block> HashJoinStage::debugPrint() const {
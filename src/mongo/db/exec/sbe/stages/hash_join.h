@@ -29,12 +29,36 @@
 
 #pragma once
 
+#include <deque>
 #include <vector>
 
+#include "mongo/db/exec/sbe/stages/plan_stats.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/exec/sbe/util/spilling.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
 
 namespace mongo::sbe {
+/**
+ * Joins the rows of the 'outer' and 'inner' children whose 'outerCond' and 'innerCond' slots are
+ * equal. The outer side is loaded into an in-memory hash table, which is then probed with the
+ * rows of the inner side.
+ *
+ * If the estimated size of the hash table exceeds 'memoryLimit' bytes, the stage falls back to a
+ * partitioned hash join: both sides are spilled to disk, partitioned by the hash of their join
+ * keys, and every pair of matching partitions is then joined on its own, partitioning it again if
+ * its outer side still does not fit in memory. Once the stage has spilled, only the 'innerCond'
+ * and 'innerProjects' slots of the inner side are visible to the parent stages. If 'allowDiskUse'
+ * is false, exceeding the memory limit raises an error instead.
+ *
+ * If 'canSpill' is false, e.g. because the parent stages rely on the order of the inner side, the
+ * memory limit is a hard limit which cannot be lifted by allowing disk use.
+ *
+ * If 'reuseOuterOnReOpen' is true, the outer side must not depend on any correlated slot. When the
+ * stage is then reopened, e.g. on the inner side of a loop join, the hash table built by the
+ * previous open() is probed again rather than rebuilt, unless the outer side has spilled. The hash
+ * table is kept across close() calls in this case, and released when the stage is either opened
+ * without 'reOpen' or destroyed.
+ */
 class HashJoinStage final : public PlanStage {
 public:
     HashJoinStage(std::unique_ptr<PlanStage> outer,
@@ -43,7 +67,11 @@ public:
                   value::SlotVector outerProjects,
                   value::SlotVector innerCond,
                   value::SlotVector innerProjects,
-                  PlanNodeId planNodeId);
+                  size_t memoryLimit,
+                  bool allowDiskUse,
+                  PlanNodeId planNodeId,
+                  bool reuseOuterOnReOpen = false,
+                  bool canSpill = true);
 
     std::unique_ptr<PlanStage> clone() const final;
 
@@ -65,10 +93,52 @@ private:
     using HashKeyAccessor = value::MaterializedRowKeyAccessor<TableType::iterator>;
     using HashProjectAccessor = value::MaterializedRowValueAccessor<TableType::iterator>;
 
+    // A pair of spilled partitions, one from each side of the join, which hold the rows whose
+    // keys fall into the same hash bucket at the given partitioning level.
+    struct PartitionPair {
+        std::unique_ptr<SpilledRows> outer;
+        std::unique_ptr<SpilledRows> inner;
+        size_t level;
+    };
+
+    // The maximum partitioning level. The partitions at this level are loaded into memory
+    // regardless of the memory limit, as repartitioning them again is unlikely to split them any
+    // further (e.g. when most of the rows share the same key).
+    static constexpr size_t kMaxPartitionLevel = 8;
+
+    /**
+     * Inserts an outer row into the hash table, or spills it if the outer side does not fit in
+     * memory. When the memory limit is exceeded, all of the rows in the hash table are spilled to
+     * partitions of the given 'level'.
+     */
+    void insertOuterRow(value::MaterializedRow key, value::MaterializedRow project, size_t level);
+
+    /**
+     * Moves the partitions produced by the current partitioners to the queue of the partition
+     * pairs which remain to be joined.
+     */
+    void finishSpilling();
+
+    /**
+     * Rebuilds the hash table from the outer side of the next pending partition pair, and sets
+     * up the inner side of the pair to be probed, or repartitions the pair if it is too large.
+     */
+    void processNextPartition();
+
+    /**
+     * Fetches the next inner row to probe the hash table with. Returns false if there are no more
+     * rows left.
+     */
+    bool nextInnerRow();
+
     const value::SlotVector _outerCond;
     const value::SlotVector _outerProjects;
     const value::SlotVector _innerCond;
     const value::SlotVector _innerProjects;
+    const size_t _memoryLimit;
+    const bool _allowDiskUse;
+    const bool _reuseOuterOnReOpen;
+    const bool _canSpill;
 
     // All defined values from the outer side (i.e. they come from the hash table).
     value::SlotAccessorMap _outOuterAccessors;
@@ -88,15 +158,42 @@ private:
     // Accessors of input codition values (keys) that are being inserted into the hash table.
     std::vector<value::SlotAccessor*> _inInnerKeyAccessors;
 
+    // Accessors of inner projection values.
+    std::vector<value::SlotAccessor*> _inInnerProjectAccessors;
+
+    // The inner keys and projections exposed to the parent stages. They are fed either from the
+    // inner child or from a spilled inner row.
+    value::SlotAccessorMap _outInnerAccessors;
+    std::vector<std::unique_ptr<value::ViewOfValueAccessor>> _outInnerKeyAccessors;
+    std::vector<std::unique_ptr<value::ViewOfValueAccessor>> _outInnerProjectAccessors;
+
     // Key used to probe inside the hash table.
     value::MaterializedRow _probeKey;
 
+    // The estimated memory footprint of the rows in the hash table, in bytes.
+    size_t _memoryUsage{0};
+
+    std::unique_ptr<SpillPartitioner> _outerPartitioner;
+    std::unique_ptr<SpillPartitioner> _innerPartitioner;
+    std::deque<PartitionPair> _pendingPartitions;
+
+    // Set when the inner rows are read from the spilled partitions rather than the inner child.
+    bool _probeSpilled{false};
+
+    // Set when the hash table holds the whole outer side, which can then be reused on reopen if
+    // '_reuseOuterOnReOpen' is true.
+    bool _outerInMemory{false};
+    std::unique_ptr<SpilledRows> _innerPartition;
+    SpilledRows::Row _innerRow;
+
     TableType _ht;
     TableType::iterator _htIt;
     TableType::iterator _htItEnd;
 
     vm::ByteCode _bytecode;
 
+    HashJoinStats _specificStats;
+
     bool _compiled{false};
 };
 }  // namespace mongo::sbe
@@ -110,6 +110,37 @@ void MakeObjStage::projectField(value::Object* obj, size_t idx) {
     }
 }
 
+void MakeObjStage::produceBsonObject(const char* root) {
+    BSONObjBuilder bob;
+    absl::flat_hash_set<size_t> alreadyProjected;
+    auto appendProjectedField = [&](size_t idx) {
+        value::Object projected;
+        projectField(&projected, idx);
+        bson::convertToBsonObj(bob, &projected);
+        alreadyProjected.insert(idx);
+    };
+
+    for (auto&& elem : BSONObj{root}) {
+        auto fieldName = elem.fieldNameStringData();
+        std::string_view sv{fieldName.rawData(), fieldName.size()};
+        if (auto it = _projectFieldsMap.find(sv); it != _projectFieldsMap.end()) {
+            appendProjectedField(it->second);
+        } else if (!isFieldRestricted(sv)) {
+            bob.append(elem);
+        }
+    }
+    for (size_t idx = 0; idx < _projects.size(); ++idx) {
+        if (alreadyProjected.count(idx) == 0) {
+            appendProjectedField(idx);
+        }
+    }
+
+    auto obj = bob.done();
+    auto [tag, val] = value::copyValue(value::TypeTags::bsonObject,
+                                       value::bitcastFrom<const char*>(obj.objdata()));
+    _obj.reset(tag, val);
+}
+
 void MakeObjStage::open(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
@@ -129,7 +160,8 @@ PlanState MakeObjStage::getNext() {
             auto [tag, val] = _root->getViewOfValue();
 
             if (tag == value::TypeTags::bsonObject) {
-                auto be = value::bitcastTo<const char*>(val);
+                const auto rootObj = value::bitcastTo<const char*>(val);
+                auto be = rootObj;
                 auto size = ConstDataView(be).read<LittleEndian<uint32_t>>();
                 auto end = be + size;
                 // Simple heuristic to determine number of fields.
@@ -142,6 +174,10 @@ PlanState MakeObjStage::getNext() {
                     if (auto it = _projectFieldsMap.find(sv);
                         !isFieldRestricted(sv) && it == _projectFieldsMap.end()) {
                         auto [tag, val] = bson::convertFrom(true, be, end, sv.size());
+                        if (tag == value::TypeTags::Nothing) {
+                            produceBsonObject(rootObj);
+                            return trackPlanState(state);
+                        }
                         auto [copyTag, copyVal] = value::copyValue(tag, val);
                         obj->push_back(sv, copyTag, copyVal);
                     } else if (it != _projectFieldsMap.end()) {
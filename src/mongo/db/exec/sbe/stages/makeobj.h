@@ -60,6 +60,13 @@ public:
 private:
     void projectField(value::Object* obj, size_t idx);
 
+    /**
+     * Produces the output object as a BSON object, copying the fields of the BSON object 'root'
+     * verbatim rather than through SBE values. Used when 'root' holds fields of a type SBE values
+     * cannot represent, such as regular expressions, which would otherwise be dropped.
+     */
+    void produceBsonObject(const char* root);
+
     bool isFieldRestricted(const std::string_view& sv) const {
         return _restrictAllFields || _restrictFieldsSet.count(sv) != 0;
     }
@@ -84,6 +84,8 @@ struct ScanStats final : public SpecificStats {
     }
 
     size_t numReads{0};
+    // Number of records discarded by the batch predicate of a scan running in batch mode.
+    size_t numBatchFiltered{0};
 };
 
 struct IndexScanStats final : public SpecificStats {
@@ -182,6 +184,36 @@ struct LoopJoinStats final : public SpecificStats {
     size_t innerCloses{0};
 };
 
+struct HashAggStats final : public SpecificStats {
+    SpecificStats* clone() const final {
+        return new HashAggStats(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
+    size_t memoryLimitBytes{0};
+    size_t spills{0};
+    size_t spilledRecords{0};
+    size_t partitionsProcessed{0};
+};
+
+struct HashJoinStats final : public SpecificStats {
+    SpecificStats* clone() const final {
+        return new HashJoinStats(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
+    size_t memoryLimitBytes{0};
+    size_t spills{0};
+    size_t spilledRecords{0};
+    size_t partitionsProcessed{0};
+};
+
 struct TraverseStats : public SpecificStats {
     SpecificStats* clone() const final {
         return new TraverseStats(*this);
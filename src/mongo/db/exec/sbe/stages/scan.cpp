@@ -31,6 +31,9 @@
 
 #include "mongo/db/exec/sbe/stages/scan.h"
 
+#include <limits>
+
+#include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/trial_run_tracker.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -47,7 +50,9 @@ ScanStage::ScanStage(const NamespaceStringOrUUID& name,
                      bool forward,
                      PlanYieldPolicy* yieldPolicy,
                      PlanNodeId nodeId,
-                     ScanOpenCallback openCallback)
+                     ScanOpenCallback openCallback,
+                     vm::BatchPredicate batchPredicate,
+                     size_t batchSize)
     : PlanStage(seekKeySlot ? "seek"_sd : "scan"_sd, yieldPolicy, nodeId),
       _name(name),
       _recordSlot(recordSlot),
@@ -56,9 +61,14 @@ ScanStage::ScanStage(const NamespaceStringOrUUID& name,
       _vars(std::move(vars)),
       _seekKeySlot(seekKeySlot),
       _forward(forward),
+      _batchPredicate(std::move(batchPredicate)),
+      _batchSize(!_seekKeySlot && !_batchPredicate.empty() ? batchSize : 0),
       _openCallback(openCallback) {
     invariant(_fields.size() == _vars.size());
     invariant(!_seekKeySlot || _forward);
+    for (auto&& term : _batchPredicate.terms()) {
+        invariant(term.column < _fields.size());
+    }
 }
 
 std::unique_ptr<PlanStage> ScanStage::clone() const {
@@ -71,7 +81,9 @@ std::unique_ptr<PlanStage> ScanStage::clone() const {
                                        _forward,
                                        _yieldPolicy,
                                        _commonStats.nodeId,
-                                       _openCallback);
+                                       _openCallback,
+                                       _batchPredicate,
+                                       _batchSize);
 }
 
 void ScanStage::prepare(CompileCtx& ctx) {
@@ -89,6 +101,14 @@ void ScanStage::prepare(CompileCtx& ctx) {
         uassert(4822814, str::stream() << "duplicate field: " << _fields[idx], inserted);
         auto [itRename, insertedRename] = _varAccessors.emplace(_vars[idx], it->second.get());
         uassert(4822815, str::stream() << "duplicate field: " << _vars[idx], insertedRename);
+
+        if (isBatchMode()) {
+            _batchFieldAccessors.push_back(it->second.get());
+        }
+    }
+
+    if (isBatchMode()) {
+        _batchColumns.resize(_fields.size());
     }
 
     if (_seekKeySlot) {
@@ -117,6 +137,12 @@ void ScanStage::doSaveState() {
         _cursor->save();
     }
 
+    // The records of the batch which have not been returned yet may be updated or deleted while
+    // we are yielded, so they are read again on restore.
+    if (isBatchMode()) {
+        _batchIsStale = firstUnreturnedRow() < _batchRecords.size();
+    }
+
     _coll.reset();
 }
 
@@ -141,6 +167,11 @@ void ScanStage::doRestoreState() {
                     << "CollectionScan died due to position in capped collection being deleted. ",
                 couldRestore);
     }
+
+    if (_batchIsStale && _coll->getCollection()) {
+        refreshBatch();
+    }
+    _batchIsStale = false;
 }
 
 void ScanStage::doDetachFromOperationContext() {
@@ -204,6 +235,116 @@ void ScanStage::open(bool reOpen) {
 
     _open = true;
     _firstGetNext = true;
+    resetBatch();
+}
+
+void ScanStage::trackRead() {
+    if (_tracker && _tracker->trackProgress<TrialRunTracker::kNumReads>(1)) {
+        // If we're collecting execution stats during multi-planning and reached the end of the
+        // trial period (trackProgress() will return 'true' in this case), then we can reset the
+        // tracker. Note that a trial period is executed only once per a PlanStge tree, and once
+        // completed never run again on the same tree.
+        _tracker = nullptr;
+    }
+    ++_specificStats.numReads;
+}
+
+void ScanStage::resetBatch() {
+    _batchRecords.clear();
+    for (auto& column : _batchColumns) {
+        column.tags.clear();
+        column.vals.clear();
+    }
+    _batchSelection.clear();
+    _batchPosition = 0;
+    _batchCursorEof = false;
+    _batchIsStale = false;
+}
+
+void ScanStage::selectRows(size_t firstRow) {
+    const auto batchSize = _batchRecords.size();
+    for (auto& column : _batchColumns) {
+        column.tags.resize(batchSize, value::TypeTags::Nothing);
+        column.vals.resize(batchSize, 0);
+    }
+    for (size_t row = firstRow; row < batchSize; ++row) {
+        auto fieldsToMatch = _fieldAccessors.size();
+        const char* rawBson = _batchRecords[row].data.data();
+        auto be = rawBson + 4;
+        auto end = rawBson + ConstDataView(rawBson).read<LittleEndian<uint32_t>>();
+        while (*be != 0 && fieldsToMatch > 0) {
+            auto sv = bson::fieldNameView(be);
+            for (size_t idx = 0; idx < _fields.size(); ++idx) {
+                if (_fields[idx] == sv) {
+                    auto [tag, val] = bson::convertFrom(true, be, end, sv.size());
+                    _batchColumns[idx].tags[row] = tag;
+                    _batchColumns[idx].vals[row] = val;
+                    --fieldsToMatch;
+                    break;
+                }
+            }
+
+            be = bson::advance(be, sv.size());
+        }
+    }
+
+    _batchSelection.clear();
+    _batchPosition = 0;
+    for (uint32_t row = firstRow; row < batchSize; ++row) {
+        _batchSelection.push_back(row);
+    }
+    _batchPredicate.evaluate(_batchColumns, _batchSelection);
+}
+
+bool ScanStage::fillBatch() {
+    while (!_batchCursorEof) {
+        resetBatch();
+
+        checkForInterrupt(_opCtx);
+        _batchCursorEof = _cursor->nextBatch(
+            &_batchRecords, _batchSize, std::numeric_limits<size_t>::max());
+
+        const auto batchSize = _batchRecords.size();
+        for (size_t row = 0; row < batchSize; ++row) {
+            trackRead();
+        }
+
+        selectRows(0);
+        _specificStats.numBatchFiltered += batchSize - _batchSelection.size();
+
+        if (!_batchSelection.empty()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ScanStage::refreshBatch() {
+    // The cursor still follows the last record of the batch, so only the records themselves need
+    // to be read again. Those deleted during the yield are dropped. Nothing is changed until all
+    // of them have been read, so that the batch stays intact if this throws.
+    const size_t firstRow = firstUnreturnedRow();
+    const auto& collection = _coll->getCollection();
+    std::vector<Record> records;
+    for (size_t row = firstRow; row < _batchRecords.size(); ++row) {
+        const auto& id = _batchRecords[row].id;
+        RecordData data;
+        if (collection->getRecordStore()->findRecord(_opCtx, id, &data)) {
+            records.push_back({id, data.getOwned()});
+        }
+    }
+
+    // Keep the rows up to the last one returned, whose values may still be viewed by the parent.
+    _batchRecords.truncate(firstRow);
+    for (auto&& record : records) {
+        _batchRecords.append(record.id, record.data);
+    }
+    for (auto& column : _batchColumns) {
+        column.tags.resize(firstRow);
+        column.vals.resize(firstRow);
+    }
+    selectRows(firstRow);
 }
 
 PlanState ScanStage::getNext() {
@@ -211,6 +352,30 @@ PlanState ScanStage::getNext() {
         return trackPlanState(PlanState::IS_EOF);
     }
 
+    if (isBatchMode()) {
+        if (_batchPosition == _batchSelection.size() && !fillBatch()) {
+            return trackPlanState(PlanState::IS_EOF);
+        }
+
+        auto row = _batchSelection[_batchPosition++];
+        if (_recordAccessor) {
+            _recordAccessor->reset(value::TypeTags::bsonObject,
+                                   value::bitcastFrom<const char*>(_batchRecords[row].data.data()));
+        }
+
+        if (_recordIdAccessor) {
+            _recordIdAccessor->reset(value::TypeTags::RecordId,
+                                     value::bitcastFrom<int64_t>(_batchRecords[row].id.repr()));
+        }
+
+        for (size_t idx = 0; idx < _batchFieldAccessors.size(); ++idx) {
+            _batchFieldAccessors[idx]->reset(_batchColumns[idx].tags[row],
+                                             _batchColumns[idx].vals[row]);
+        }
+
+        return trackPlanState(PlanState::ADVANCED);
+    }
+
     checkForInterrupt(_opCtx);
 
     auto nextRecord =
@@ -257,14 +422,7 @@ PlanState ScanStage::getNext() {
         }
     }
 
-    if (_tracker && _tracker->trackProgress<TrialRunTracker::kNumReads>(1)) {
-        // If we're collecting execution stats during multi-planning and reached the end of the
-        // trial period (trackProgress() will return 'true' in this case), then we can reset the
-        // tracker. Note that a trial period is executed only once per a PlanStge tree, and once
-        // completed never run again on the same tree.
-        _tracker = nullptr;
-    }
-    ++_specificStats.numReads;
+    trackRead();
     return trackPlanState(PlanState::ADVANCED);
 }
 
@@ -273,6 +431,7 @@ void ScanStage::close() {
     _cursor.reset();
     _coll.reset();
     _open = false;
+    resetBatch();
 }
 
 std::unique_ptr<PlanStageStats> ScanStage::getStats(bool includeDebugInfo) const {
@@ -282,6 +441,10 @@ std::unique_ptr<PlanStageStats> ScanStage::getStats(bool includeDebugInfo) const
     if (includeDebugInfo) {
         BSONObjBuilder bob;
         bob.appendNumber("numReads", _specificStats.numReads);
+        if (isBatchMode()) {
+            bob.appendNumber("batchSize", _batchSize);
+            bob.appendNumber("numBatchFiltered", _specificStats.numBatchFiltered);
+        }
         if (_recordSlot) {
             bob.appendIntOrLL("recordSlot", *_recordSlot);
         }
@@ -333,6 +496,11 @@ std::vector<DebugPrinter::Block> ScanStage::debugPrint() const {
     DebugPrinter::addIdentifier(ret, _name.toString());
     ret.emplace_back("`\"");
 
+    if (isBatchMode()) {
+        ret.emplace_back("batch");
+        ret.emplace_back(std::to_string(_batchSize));
+    }
+
     return ret;
 }
 
@@ -417,6 +585,20 @@ value::SlotAccessor* ParallelScanStage::getAccessor(CompileCtx& ctx, value::Slot
     return ctx.getAccessor(slot);
 }
 
+void ParallelScanStage::acquireCollection() {
+    _coll.emplace(_opCtx,
+                  _name,
+                  [](std::shared_ptr<const Collection>& collection,
+                     OperationContext* opCtx,
+                     CollectionUUID uuid) {
+                      collection =
+                          CollectionCatalog::get(opCtx)->lookupCollectionByUUIDForRead(opCtx, uuid);
+                  });
+
+    uassertStatusOK(repl::ReplicationCoordinator::get(_opCtx)->checkCanServeReadsFor(
+        _opCtx, _coll->getNss(), true));
+}
+
 void ParallelScanStage::doSaveState() {
     if (_cursor) {
         _cursor->save();
@@ -434,10 +616,10 @@ void ParallelScanStage::doRestoreState() {
         return;
     }
 
-    _coll.emplace(_opCtx, _name);
-
-    uassertStatusOK(repl::ReplicationCoordinator::get(_opCtx)->checkCanServeReadsFor(
-        _opCtx, _coll->getNss(), true));
+    acquireCollection();
+    uassert(ErrorCodes::QueryPlanKilled,
+            "collection dropped during a parallel scan",
+            _coll->getCollection());
 
     if (_cursor) {
         const bool couldRestore = _cursor->restore();
@@ -466,10 +648,7 @@ void ParallelScanStage::open(bool reOpen) {
 
     invariant(!_cursor);
     invariant(!_coll);
-    _coll.emplace(_opCtx, _name);
-
-    uassertStatusOK(repl::ReplicationCoordinator::get(_opCtx)->checkCanServeReadsFor(
-        _opCtx, _coll->getNss(), true));
+    acquireCollection();
 
     const auto& collection = _coll->getCollection();
 
@@ -538,7 +717,7 @@ PlanState ParallelScanStage::getNext() {
             return PlanState::IS_EOF;
         }
 
-        if (!_range.end.isNull() && nextRecord->id == _range.end) {
+        if (!_range.end.isNull() && nextRecord->id >= _range.end) {
             setNeedsRange();
             nextRecord = boost::none;
         }
@@ -32,12 +32,23 @@
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/sbe/values/bson.h"
+#include "mongo/db/exec/sbe/vm/batch_predicate.h"
 #include "mongo/db/storage/record_store.h"
 
 namespace mongo {
 namespace sbe {
 using ScanOpenCallback = std::function<void(OperationContext*, const CollectionPtr&, bool)>;
 
+/**
+ * Scans the records of a collection, or seeks a single record when 'seekKeySlot' is given.
+ *
+ * When a non-empty 'batchPredicate' and a non-zero 'batchSize' are given, a full scan runs in batch
+ * mode: up to 'batchSize' records are read from the cursor at once, the requested fields are
+ * extracted column-wise, and the batch predicate, whose terms refer to the positions of the fields
+ * in 'fields', is evaluated over the whole batch. Only the records which may satisfy the predicate
+ * are returned. The batch predicate is a conservative pre-filter, so the exact filter must still be
+ * applied on top of this stage.
+ */
 class ScanStage final : public PlanStage {
 public:
     ScanStage(const NamespaceStringOrUUID& name,
@@ -49,7 +60,9 @@ public:
               bool forward,
               PlanYieldPolicy* yieldPolicy,
               PlanNodeId nodeId,
-              ScanOpenCallback openCallback = {});
+              ScanOpenCallback openCallback = {},
+              vm::BatchPredicate batchPredicate = {},
+              size_t batchSize = 0);
 
     std::unique_ptr<PlanStage> clone() const final;
 
@@ -72,6 +85,42 @@ protected:
     void doAttachToTrialRunTracker(TrialRunTracker* tracker) override;
 
 private:
+    bool isBatchMode() const {
+        return _batchSize > 0;
+    }
+
+    void trackRead();
+
+    /**
+     * Resets the batch state so that the next call to getNext() reads a new batch.
+     */
+    void resetBatch();
+
+    /**
+     * Reads records from the cursor into a new batch until at least one of them may satisfy the
+     * batch predicate or the cursor is exhausted. Returns false if the batch is empty.
+     */
+    bool fillBatch();
+
+    /**
+     * Extracts the fields of the records of the batch from 'firstRow' on, and selects those of
+     * them which may satisfy the batch predicate. The batch is then read from the first of them.
+     */
+    void selectRows(size_t firstRow);
+
+    /**
+     * Reads the records of the batch which have not been returned yet again after a yield,
+     * dropping those which have been deleted, and selects them anew.
+     */
+    void refreshBatch();
+
+    /**
+     * Returns the row of the batch after the last one returned, or 0 if none has been returned.
+     */
+    size_t firstUnreturnedRow() const {
+        return _batchPosition == 0 ? 0 : _batchSelection[_batchPosition - 1] + 1;
+    }
+
     const NamespaceStringOrUUID _name;
     const boost::optional<value::SlotId> _recordSlot;
     const boost::optional<value::SlotId> _recordIdSlot;
@@ -79,6 +128,8 @@ private:
     const value::SlotVector _vars;
     const boost::optional<value::SlotId> _seekKeySlot;
     const bool _forward;
+    const vm::BatchPredicate _batchPredicate;
+    const size_t _batchSize;
 
     // If provided, used during a trial run to accumulate certain execution stats. Once the trial
     // run is complete, this pointer is reset to nullptr.
@@ -93,6 +144,20 @@ private:
     value::SlotAccessorMap _varAccessors;
     value::SlotAccessor* _seekKeyAccessor{nullptr};
 
+    // The state of the current batch in batch mode. The records are read ahead into
+    // '_batchRecords', which owns their data for the lifetime of the batch, and the values of the
+    // fields are views into it, stored per field in the same order as '_fields'.
+    std::vector<value::ViewOfValueAccessor*> _batchFieldAccessors;
+    RecordBatch _batchRecords;
+    std::vector<vm::BatchColumn> _batchColumns;
+    std::vector<uint32_t> _batchSelection;
+    size_t _batchPosition{0};
+    bool _batchCursorEof{false};
+
+    // Set when we yield before all the records of the batch have been returned. They are read
+    // again on restore, since their data may no longer match the collection.
+    bool _batchIsStale{false};
+
     bool _open{false};
 
     std::unique_ptr<SeekableRecordCursor> _cursor;
@@ -103,6 +168,12 @@ private:
     ScanStats _specificStats;
 };
 
+/**
+ * Scans a collection together with the clones of this stage, which split up its records by ranges
+ * of record ids. The clones run in worker threads on behalf of a query that holds the lock on the
+ * collection, and only access the collection while that query is active, so they read it lock-free
+ * rather than competing with the query, and with the operations queued behind it, for the lock.
+ */
 class ParallelScanStage final : public PlanStage {
     struct Range {
         RecordId begin;
@@ -151,6 +222,7 @@ protected:
     void doAttachToOperationContext(OperationContext* opCtx) final;
 
 private:
+    void acquireCollection();
     boost::optional<Record> nextRange();
     bool needsRange() const {
         return _currentRange == std::numeric_limits<std::size_t>::max();
@@ -179,7 +251,7 @@ private:
     bool _open{false};
 
     std::unique_ptr<SeekableRecordCursor> _cursor;
-    boost::optional<AutoGetCollectionForReadMaybeLockFree> _coll;
+    boost::optional<AutoGetCollectionLockFree> _coll;
 };
 }  // namespace sbe
 }  // namespace mongo
@@ -31,7 +31,10 @@
 
 #include "mongo/db/exec/sbe/stages/sort.h"
 
+#include <algorithm>
+
 #include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/exec/sbe/util/spilling.h"
 #include "mongo/db/exec/trial_run_tracker.h"
 #include "mongo/util/str.h"
 
@@ -46,6 +49,29 @@ std::string nextFileName() {
 
 namespace mongo {
 namespace sbe {
+namespace {
+/**
+ * Compares two sort keys of 'dirs.size()' parts, where the parts of each key are returned by the
+ * 'lhs' and 'rhs' callbacks respectively. Returns a negative number if the left key sorts first, a
+ * positive number if the right key does, and zero if the keys are equal.
+ */
+template <typename LhsPart, typename RhsPart>
+int compareSortKeys(const std::vector<value::SortDirection>& dirs, LhsPart lhs, RhsPart rhs) {
+    for (size_t idx = 0; idx < dirs.size(); ++idx) {
+        auto [lhsTag, lhsVal] = lhs(idx);
+        auto [rhsTag, rhsVal] = rhs(idx);
+        auto [tag, val] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal);
+
+        auto result = value::bitcastTo<int32_t>(val);
+        if (result) {
+            return dirs[idx] == value::SortDirection::Descending ? -result : result;
+        }
+    }
+
+    return 0;
+}
+}  // namespace
+
 SortStage::SortStage(std::unique_ptr<PlanStage> input,
                      value::SlotVector obs,
                      std::vector<value::SortDirection> dirs,
@@ -119,34 +145,64 @@ value::SlotAccessor* SortStage::getAccessor(CompileCtx& ctx, value::SlotId slot)
 
 void SortStage::makeSorter() {
     SortOptions opts;
-    opts.tempDir = storageGlobalParams.dbpath + "/_tmp";
+    opts.tempDir = getSpillDirectory();
     opts.maxMemoryUsageBytes = _specificStats.maxMemoryUsageBytes;
     opts.extSortAllowed = _allowDiskUse;
     opts.limit =
         _specificStats.limit != std::numeric_limits<size_t>::max() ? _specificStats.limit : 0;
 
-    auto comp = [&](const SorterData& lhs, const SorterData& rhs) {
-        auto size = lhs.first.size();
-        auto& left = lhs.first;
-        auto& right = rhs.first;
-        for (size_t idx = 0; idx < size; ++idx) {
-            auto [lhsTag, lhsVal] = left.getViewOfValue(idx);
-            auto [rhsTag, rhsVal] = right.getViewOfValue(idx);
-            auto [tag, val] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal);
-
-            auto result = value::bitcastTo<int32_t>(val);
-            if (result) {
-                return _dirs[idx] == value::SortDirection::Descending ? -result : result;
-            }
-        }
-
-        return 0;
-    };
+    auto comp = [&](const SorterData& lhs, const SorterData& rhs) { return compareRows(lhs, rhs); };
 
     _sorter.reset(Sorter<value::MaterializedRow, value::MaterializedRow>::make(opts, comp, {}));
     _mergeIt.reset();
 }
 
+int SortStage::compareRows(const SorterData& lhs, const SorterData& rhs) const {
+    return compareSortKeys(_dirs,
+                           [&](size_t idx) { return lhs.first.getViewOfValue(idx); },
+                           [&](size_t idx) { return rhs.first.getViewOfValue(idx); });
+}
+
+bool SortStage::isInputRowDiscardable() const {
+    if (_heap.size() < _specificStats.limit) {
+        return false;
+    }
+
+    const auto& worstKeys = _heap.front().first;
+    return compareSortKeys(_dirs,
+                           [&](size_t idx) { return _inKeyAccessors[idx]->getViewOfValue(); },
+                           [&](size_t idx) { return worstKeys.getViewOfValue(idx); }) >= 0;
+}
+
+void SortStage::addToHeap(value::MaterializedRow keys, value::MaterializedRow vals) {
+    auto less = [&](const SorterData& lhs, const SorterData& rhs) {
+        return compareRows(lhs, rhs) < 0;
+    };
+
+    if (_heap.size() == _specificStats.limit) {
+        std::pop_heap(_heap.begin(), _heap.end(), less);
+        _heapMemoryUsage -=
+            _heap.back().first.memUsageForSorter() + _heap.back().second.memUsageForSorter();
+        _heap.pop_back();
+    }
+
+    _heapMemoryUsage += keys.memUsageForSorter() + vals.memUsageForSorter();
+    _heap.emplace_back(std::move(keys), std::move(vals));
+    std::push_heap(_heap.begin(), _heap.end(), less);
+
+    if (_heapMemoryUsage > _specificStats.maxMemoryUsageBytes) {
+        // The top k rows do not fit in memory, so hand them over to a Sorter which can spill them
+        // to disk, and keep feeding it the rest of the input.
+        makeSorter();
+        for (auto&& row : _heap) {
+            _sorter->emplace(std::move(row.first), std::move(row.second));
+        }
+        _heap.clear();
+        _heapMemoryUsage = 0;
+        _useHeap = false;
+    }
+}
+
 void SortStage::doDetachFromTrialRunTracker() {
     _tracker = nullptr;
 }
@@ -159,9 +215,20 @@ void SortStage::open(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
 
-    makeSorter();
+    _heap.clear();
+    _heapMemoryUsage = 0;
+    _heapPosition = 0;
+    _useHeap = _specificStats.limit != std::numeric_limits<size_t>::max();
+    if (!_useHeap) {
+        makeSorter();
+    }
 
     while (_children[0]->getNext() == PlanState::ADVANCED) {
+        if (_useHeap && isInputRowDiscardable()) {
+            trackInputRow();
+            continue;
+        }
+
         value::MaterializedRow keys{_inKeyAccessors.size()};
         value::MaterializedRow vals{_inValueAccessors.size()};
 
@@ -178,30 +245,54 @@ void SortStage::open(bool reOpen) {
         }
 
         // TODO SERVER-51815: count total mem usage for specificStats.
-        _sorter->emplace(std::move(keys), std::move(vals));
-
-        if (_tracker && _tracker->trackProgress<TrialRunTracker::kNumResults>(1)) {
-            // If we either hit the maximum number of document to return during the trial run, or
-            // if we've performed enough physical reads, stop populating the sort heap and bail out
-            // from the trial run by raising a special exception to signal a runtime planner that
-            // this candidate plan has completed its trial run early. Note that the sort stage is a
-            // blocking operation and until all documents are loaded from the child stage and
-            // sorted, the control is not returned to the runtime planner, so an raising this
-            // special is mechanism to stop the trial run without affecting the plan stats of the
-            // higher level stages.
-            _tracker = nullptr;
-            _children[0]->close();
-            uasserted(ErrorCodes::QueryTrialRunCompleted, "Trial run early exit");
+        if (_useHeap) {
+            addToHeap(std::move(keys), std::move(vals));
+        } else {
+            _sorter->emplace(std::move(keys), std::move(vals));
         }
+
+        trackInputRow();
     }
 
-    _mergeIt.reset(_sorter->done());
-    _specificStats.spills += _sorter->numSpills();
+    if (_useHeap) {
+        std::sort_heap(
+            _heap.begin(), _heap.end(), [&](const SorterData& lhs, const SorterData& rhs) {
+                return compareRows(lhs, rhs) < 0;
+            });
+    } else {
+        _mergeIt.reset(_sorter->done());
+        _specificStats.spills += _sorter->numSpills();
+    }
 
     _children[0]->close();
 }
 
+void SortStage::trackInputRow() {
+    if (_tracker && _tracker->trackProgress<TrialRunTracker::kNumResults>(1)) {
+        // If we either hit the maximum number of document to return during the trial run, or
+        // if we've performed enough physical reads, stop populating the sort heap and bail out
+        // from the trial run by raising a special exception to signal a runtime planner that
+        // this candidate plan has completed its trial run early. Note that the sort stage is a
+        // blocking operation and until all documents are loaded from the child stage and
+        // sorted, the control is not returned to the runtime planner, so an raising this
+        // special is mechanism to stop the trial run without affecting the plan stats of the
+        // higher level stages.
+        _tracker = nullptr;
+        _children[0]->close();
+        uasserted(ErrorCodes::QueryTrialRunCompleted, "Trial run early exit");
+    }
+}
+
 PlanState SortStage::getNext() {
+    if (_useHeap) {
+        if (_heapPosition == _heap.size()) {
+            return trackPlanState(PlanState::IS_EOF);
+        }
+
+        _mergeData = std::move(_heap[_heapPosition++]);
+        return trackPlanState(PlanState::ADVANCED);
+    }
+
     // When the sort spilled data to disk then read back the sorted runs.
     if (_mergeIt && _mergeIt->more()) {
         _mergeData = _mergeIt->next();
@@ -216,6 +307,9 @@ void SortStage::close() {
     _commonStats.closes++;
     _mergeIt.reset();
     _sorter.reset();
+    _heap.clear();
+    _heapMemoryUsage = 0;
+    _heapPosition = 0;
 }
 
 std::unique_ptr<PlanStageStats> SortStage::getStats(bool includeDebugInfo) const {
@@ -39,6 +39,15 @@ class Sorter;
 }  // namespace mongo
 
 namespace mongo::sbe {
+/**
+ * Sorts the rows of its input by the 'obs' slots, in the order given by 'dirs', and returns up to
+ * 'limit' of them.
+ *
+ * When the sort has a limit, the stage runs in top-k mode: it keeps the best 'limit' rows seen so
+ * far in a heap, and only materializes an input row if it makes it into the heap. If the rows in
+ * the heap grow larger than 'memoryLimit' bytes, the stage falls back to a Sorter, which spills to
+ * disk if 'allowDiskUse' is true.
+ */
 class SortStage final : public PlanStage {
 public:
     SortStage(std::unique_ptr<PlanStage> input,
@@ -69,11 +78,35 @@ protected:
     void doAttachToTrialRunTracker(TrialRunTracker* tracker) override;
 
 private:
-    void makeSorter();
-
     using SorterIterator = SortIteratorInterface<value::MaterializedRow, value::MaterializedRow>;
     using SorterData = std::pair<value::MaterializedRow, value::MaterializedRow>;
 
+    void makeSorter();
+
+    /**
+     * Compares the sort keys of two rows, returning a negative number if 'lhs' sorts first, a
+     * positive number if 'rhs' does, and zero if the keys are equal.
+     */
+    int compareRows(const SorterData& lhs, const SorterData& rhs) const;
+
+    /**
+     * Counts an input row towards the trial run, if any, and ends the trial run early if it has
+     * completed.
+     */
+    void trackInputRow();
+
+    /**
+     * Adds a row to the heap used in top-k mode, evicting the worst row if the heap is full. Moves
+     * the rows of the heap to a Sorter if they no longer fit in memory.
+     */
+    void addToHeap(value::MaterializedRow keys, value::MaterializedRow vals);
+
+    /**
+     * Returns true if the current input row would not make it into the heap used in top-k mode,
+     * because the heap is full and the input row does not sort before the worst row in it.
+     */
+    bool isInputRowDiscardable() const;
+
     const value::SlotVector _obs;
     const std::vector<value::SortDirection> _dirs;
     const value::SlotVector _vals;
@@ -90,6 +123,13 @@ private:
     SorterData* _mergeDataIt{&_mergeData};
     std::unique_ptr<Sorter<value::MaterializedRow, value::MaterializedRow>> _sorter;
 
+    // The state of the top-k mode. '_heap' is a max-heap which keeps the row that sorts last on
+    // top, and is sorted once all the input rows have been consumed.
+    bool _useHeap{false};
+    std::vector<SorterData> _heap;
+    size_t _heapMemoryUsage{0};
+    size_t _heapPosition{0};
+
     // If provided, used during a trial run to accumulate certain execution stats. Once the trial
     // run is complete, this pointer is reset to nullptr.
     TrialRunTracker* _tracker{nullptr};
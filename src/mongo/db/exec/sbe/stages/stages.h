@@ -278,7 +278,16 @@ public:
     }
 
 protected:
-    PlanYieldPolicy* const _yieldPolicy{nullptr};
+    /**
+     * Replaces the yield policy of this object, unless yielding was disabled for it.
+     */
+    void resetYieldPolicy(PlanYieldPolicy* yieldPolicy) {
+        if (_yieldPolicy) {
+            _yieldPolicy = yieldPolicy;
+        }
+    }
+
+    PlanYieldPolicy* _yieldPolicy{nullptr};
 
 private:
     static const int kInterruptCheckPeriod = 128;
@@ -340,6 +349,19 @@ public:
      */
     virtual void close() = 0;
 
+    /**
+     * Replaces the yield policy of every stage in this tree which was built with yielding enabled.
+     * Used to bind a tree built for one query, such as a tree taken from the plan cache, to the
+     * yield policy of the query which is about to execute it.
+     */
+    void attachNewYieldPolicy(PlanYieldPolicy* yieldPolicy) {
+        for (auto&& child : _children) {
+            child->attachNewYieldPolicy(yieldPolicy);
+        }
+
+        resetYieldPolicy(yieldPolicy);
+    }
+
     virtual std::vector<DebugPrinter::Block> debugPrint() const {
         auto stats = getCommonStats();
         std::string str = str::stream() << '[' << stats->nodeId << "] " << stats->stageType;
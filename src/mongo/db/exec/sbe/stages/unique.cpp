@@ -58,6 +58,10 @@ value::SlotAccessor* UniqueStage::getAccessor(CompileCtx& ctx, value::SlotId slo
 void UniqueStage::open(bool reOpen) {
     ++_commonStats.opens;
     _children[0]->open(reOpen);
+    // The set of seen keys is scoped to a single open of this stage, so when this stage serves as
+    // the inner side of a loop join the rows produced for each outer row are deduplicated on their
+    // own.
+    _seen.clear();
 }
 
 PlanState UniqueStage::getNext() {
@@ -0,0 +1,116 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/util/spilling.h"
+
+#include <boost/container_hash/hash.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/storage/storage_options.h"
+
+namespace {
+std::string nextFileName() {
+    static mongo::AtomicWord<unsigned> spillFileCounter;
+    return "extsort-spill-sbe." + std::to_string(spillFileCounter.fetchAndAdd(1));
+}
+}  // namespace
+
+#include "mongo/db/sorter/sorter.cpp"
+
+namespace mongo::sbe {
+std::string getSpillDirectory() {
+    if (!internalQuerySlotBasedExecutionSpillDirectory.empty()) {
+        return internalQuerySlotBasedExecutionSpillDirectory;
+    }
+    return storageGlobalParams.dbpath + "/_tmp";
+}
+
+SpilledRows::SpilledRows(const std::string& tempDir)
+    : _fileFullPath(tempDir + "/" + nextFileName()),
+      _writer(std::make_unique<Writer>(SortOptions().TempDir(tempDir), _fileFullPath, 0)) {}
+
+SpilledRows::~SpilledRows() {
+    _writer.reset();
+    _reader.reset();
+    DESTRUCTOR_GUARD(boost::filesystem::remove(_fileFullPath));
+}
+
+void SpilledRows::append(const value::MaterializedRow& key, const value::MaterializedRow& value) {
+    invariant(_writer);
+    _writer->addAlreadySorted(key, value);
+    ++_count;
+}
+
+void SpilledRows::finishWriting() {
+    invariant(_writer && _count > 0);
+    _reader.reset(_writer->done());
+    _writer.reset();
+    _reader->openSource();
+}
+
+bool SpilledRows::more() {
+    invariant(_reader);
+    return _reader->more();
+}
+
+SpilledRows::Row SpilledRows::next() {
+    invariant(_reader);
+    return _reader->next();
+}
+
+size_t SpillPartitioner::partitionOf(const value::MaterializedRow& key) const {
+    auto hash = value::MaterializedRowHasher{}(key);
+    boost::hash_combine(hash, _level);
+    return hash % kNumPartitions;
+}
+
+void SpillPartitioner::append(const value::MaterializedRow& key,
+                              const value::MaterializedRow& value) {
+    auto& partition = _partitions[partitionOf(key)];
+    if (!partition) {
+        partition = std::make_unique<SpilledRows>(_tempDir);
+    }
+    partition->append(key, value);
+}
+
+std::vector<std::unique_ptr<SpilledRows>> SpillPartitioner::done() {
+    for (auto&& partition : _partitions) {
+        if (partition) {
+            partition->finishWriting();
+        }
+    }
+
+    auto partitions = std::move(_partitions);
+    _partitions = std::vector<std::unique_ptr<SpilledRows>>(kNumPartitions);
+    return partitions;
+}
+}  // namespace mongo::sbe
@@ -0,0 +1,124 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/db/exec/sbe/values/slot.h"
+
+namespace mongo {
+template <typename Key, typename Value>
+class SortIteratorInterface;
+template <typename Key, typename Value>
+class SortedFileWriter;
+}  // namespace mongo
+
+namespace mongo::sbe {
+/**
+ * Returns the directory which blocking SBE stages use for their temporary files. This is the
+ * directory given by the 'internalQuerySlotBasedExecutionSpillDirectory' knob, if set, and the
+ * '_tmp' directory under the database path otherwise.
+ */
+std::string getSpillDirectory();
+
+/**
+ * A sequence of (key, value) rows which has been spilled to a temporary file. Rows are appended to
+ * the file first, and once 'finishWriting()' has been called, they can be read back in the same
+ * order. The file is removed when this object is destroyed.
+ */
+class SpilledRows {
+public:
+    using Row = std::pair<value::MaterializedRow, value::MaterializedRow>;
+
+    explicit SpilledRows(const std::string& tempDir);
+    ~SpilledRows();
+
+    void append(const value::MaterializedRow& key, const value::MaterializedRow& value);
+
+    /**
+     * Flushes the rows to the file and prepares them for reading. No rows can be appended after
+     * this call.
+     */
+    void finishWriting();
+
+    bool more();
+    Row next();
+
+    size_t count() const {
+        return _count;
+    }
+
+private:
+    using Writer = SortedFileWriter<value::MaterializedRow, value::MaterializedRow>;
+    using Reader = SortIteratorInterface<value::MaterializedRow, value::MaterializedRow>;
+
+    const std::string _fileFullPath;
+    std::unique_ptr<Writer> _writer;
+    std::unique_ptr<Reader> _reader;
+    size_t _count{0};
+};
+
+/**
+ * Distributes spilled (key, value) rows across a fixed number of partitions by the hash of the key,
+ * so that all rows with equal keys end up in the same partition and every partition can be
+ * processed on its own. A partition which is still too large to be processed in memory can be
+ * partitioned again: the 'level' of the partitioner is mixed into the hash, so that the rows are
+ * distributed differently at each level.
+ */
+class SpillPartitioner {
+public:
+    static constexpr size_t kNumPartitions = 16;
+
+    SpillPartitioner(std::string tempDir, size_t level)
+        : _tempDir(std::move(tempDir)), _level(level) {}
+
+    size_t level() const {
+        return _level;
+    }
+
+    size_t partitionOf(const value::MaterializedRow& key) const;
+
+    void append(const value::MaterializedRow& key, const value::MaterializedRow& value);
+
+    /**
+     * Finishes writing of all partitions and returns them indexed by the partition number. The
+     * partitions which did not receive any rows are returned as nullptr.
+     */
+    std::vector<std::unique_ptr<SpilledRows>> done();
+
+private:
+    const std::string _tempDir;
+    const size_t _level;
+    std::vector<std::unique_ptr<SpilledRows>> _partitions{kNumPartitions};
+};
+}  // namespace mongo::sbe
@@ -534,7 +534,8 @@ BSONType tagToType(TypeTags tag) noexcept {
 std::size_t hashValue(TypeTags tag, Value val) noexcept {
     switch (tag) {
         case TypeTags::NumberInt32:
-            return absl::Hash<int32_t>{}(bitcastTo<int32_t>(val));
+            // Hash as a 64-bit integer, so that equal numbers of different types hash the same.
+            return absl::Hash<int64_t>{}(bitcastTo<int32_t>(val));
         case TypeTags::RecordId:
         case TypeTags::NumberInt64:
             return absl::Hash<int64_t>{}(bitcastTo<int64_t>(val));
@@ -583,7 +584,11 @@ std::size_t hashValue(TypeTags tag, Value val) noexcept {
                 absl::Hash<uint32_t>{}(readFromMemory<uint32_t>(id->data() + 8));
         }
         case TypeTags::ksValue: {
-            return getKeyStringView(val)->hash();
+            // Hash only the key itself, and not its TypeBits, in agreement with the comparison of
+            // KeyStrings.
+            auto ks = getKeyStringView(val);
+            return absl::Hash<std::string_view>{}(
+                std::string_view{ks->getBuffer(), ks->getSize()});
         }
         case TypeTags::Array:
         case TypeTags::ArraySet:
@@ -786,7 +791,7 @@ std::pair<TypeTags, Value> compareValue(TypeTags lhsTag,
                              lsz + 1);
         return {TypeTags::NumberInt32, bitcastFrom<int32_t>(compareHelper(result, 0))};
     } else if (lhsTag == TypeTags::ksValue && rhsTag == TypeTags::ksValue) {
-        auto result = getKeyStringView(lhsValue)->compare(*getKeyStringView(lhsValue));
+        auto result = getKeyStringView(lhsValue)->compare(*getKeyStringView(rhsValue));
         return {TypeTags::NumberInt32, bitcastFrom<int32_t>(result)};
     } else if (lhsTag == TypeTags::Nothing && rhsTag == TypeTags::Nothing) {
         // Special case for Nothing in a hash table (group) and sort comparison.
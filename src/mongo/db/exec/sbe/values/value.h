@@ -483,6 +483,17 @@ public:
         return {_typeTags[idx], _values[idx]};
     }
 
+    /**
+     * Replaces the element at 'idx' with the value, taking ownership of it and releasing the
+     * previous element.
+     */
+    void setAt(std::size_t idx, TypeTags tag, Value val) {
+        invariant(idx < _values.size() && tag != TypeTags::Nothing);
+        releaseValue(_typeTags[idx], _values[idx]);
+        _typeTags[idx] = tag;
+        _values[idx] = val;
+    }
+
     void reserve(size_t s) {
         // Normalize to at least 1.
         s = s ? s : 1;
@@ -0,0 +1,149 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/vm/batch_predicate.h"
+
+#include <cmath>
+
+#include "mongo/db/exec/sbe/vm/vm.h"
+
+namespace mongo::sbe::vm {
+namespace {
+bool isNaNDouble(value::TypeTags tag, value::Value val) {
+    return tag == value::TypeTags::NumberDouble && std::isnan(value::bitcastTo<double>(val));
+}
+
+/**
+ * Returns false if a value with the given tag and value certainly doesn't satisfy the comparison
+ * 'Cmp' against the constant of 'term', and true otherwise.
+ */
+template <typename Cmp>
+bool mayMatch(value::TypeTags tag, value::Value val, const BatchPredicate::Term& term) {
+    Cmp cmp;
+
+    // The common case of a value of the same type as the constant.
+    if (tag == term.constTag) {
+        switch (tag) {
+            case value::TypeTags::NumberInt32:
+                return cmp(value::bitcastTo<int32_t>(val),
+                           value::bitcastTo<int32_t>(term.constVal));
+            case value::TypeTags::NumberInt64:
+                return cmp(value::bitcastTo<int64_t>(val),
+                           value::bitcastTo<int64_t>(term.constVal));
+            case value::TypeTags::NumberDouble: {
+                // NaN sorts before all the numbers in a match expression comparison, which the
+                // plain double comparison doesn't capture.
+                auto doubleVal = value::bitcastTo<double>(val);
+                return std::isnan(doubleVal) ||
+                    cmp(doubleVal, value::bitcastTo<double>(term.constVal));
+            }
+            default:
+                MONGO_UNREACHABLE;
+        }
+    }
+
+    // Arrays may contain a matching element, and decimals and NaNs are left to the exact filter.
+    if (value::isArray(tag) || tag == value::TypeTags::NumberDecimal || isNaNDouble(tag, val)) {
+        return true;
+    }
+
+    // Due to type bracketing, a missing field and any value other than a number never satisfies a
+    // comparison against a number.
+    if (!value::isNumber(tag)) {
+        return false;
+    }
+
+    // A comparison between a long and a double is not exact when carried out over doubles.
+    if ((tag == value::TypeTags::NumberInt64 && term.constTag == value::TypeTags::NumberDouble) ||
+        (tag == value::TypeTags::NumberDouble && term.constTag == value::TypeTags::NumberInt64)) {
+        return true;
+    }
+
+    auto [resultTag, resultVal] =
+        genericNumericCompare(tag, val, term.constTag, term.constVal, cmp);
+    return resultTag == value::TypeTags::Boolean && value::bitcastTo<bool>(resultVal);
+}
+
+template <typename Cmp>
+void filterSelection(const BatchColumn& column,
+                     const BatchPredicate::Term& term,
+                     std::vector<uint32_t>& selection) {
+    size_t numSelected = 0;
+    for (auto row : selection) {
+        if (mayMatch<Cmp>(column.tags[row], column.vals[row], term)) {
+            selection[numSelected++] = row;
+        }
+    }
+    selection.resize(numSelected);
+}
+}  // namespace
+
+void BatchPredicate::addTerm(size_t column,
+                             Op op,
+                             value::TypeTags constTag,
+                             value::Value constVal) {
+    invariant(constTag == value::TypeTags::NumberInt32 ||
+              constTag == value::TypeTags::NumberInt64 ||
+              constTag == value::TypeTags::NumberDouble);
+    invariant(!isNaNDouble(constTag, constVal));
+
+    _terms.push_back(Term{column, op, constTag, constVal});
+}
+
+void BatchPredicate::evaluate(const std::vector<BatchColumn>& columns,
+                              std::vector<uint32_t>& selection) const {
+    for (auto&& term : _terms) {
+        if (selection.empty()) {
+            return;
+        }
+
+        invariant(term.column < columns.size());
+        const auto& column = columns[term.column];
+        switch (term.op) {
+            case Op::less:
+                filterSelection<std::less<>>(column, term, selection);
+                break;
+            case Op::lessEq:
+                filterSelection<std::less_equal<>>(column, term, selection);
+                break;
+            case Op::greater:
+                filterSelection<std::greater<>>(column, term, selection);
+                break;
+            case Op::greaterEq:
+                filterSelection<std::greater_equal<>>(column, term, selection);
+                break;
+            case Op::eq:
+                filterSelection<std::equal_to<>>(column, term, selection);
+                break;
+        }
+    }
+}
+}  // namespace mongo::sbe::vm
@@ -0,0 +1,88 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/db/exec/sbe/values/value.h"
+
+namespace mongo::sbe::vm {
+/**
+ * The values of a single slot for every row of a batch, stored column-wise.
+ */
+struct BatchColumn {
+    std::vector<value::TypeTags> tags;
+    std::vector<value::Value> vals;
+};
+
+/**
+ * A conjunction of comparisons of batch columns against numeric constants, which is evaluated over
+ * a whole batch of rows at once rather than by running bytecode for each row.
+ *
+ * The predicate is a necessary condition for a row to match the query, not the exact filter: a row
+ * is only dropped when some term can tell for certain that it does not match with the semantics
+ * of a match expression comparison against a number. Rows which cannot be decided this way, e.g.
+ * arrays and decimals, are kept and must be checked by the exact filter.
+ */
+class BatchPredicate {
+public:
+    enum class Op { less, lessEq, greater, greaterEq, eq };
+
+    struct Term {
+        size_t column;
+        Op op;
+        value::TypeTags constTag;
+        value::Value constVal;
+    };
+
+    /**
+     * Adds a term comparing the values of 'column' against the given constant, which must be an
+     * int, a long, or a double other than NaN.
+     */
+    void addTerm(size_t column, Op op, value::TypeTags constTag, value::Value constVal);
+
+    bool empty() const {
+        return _terms.empty();
+    }
+
+    const std::vector<Term>& terms() const {
+        return _terms;
+    }
+
+    /**
+     * Narrows 'selection', a list of row numbers into 'columns', down to the rows which may satisfy
+     * all the terms of this predicate. The relative order of the rows is preserved.
+     */
+    void evaluate(const std::vector<BatchColumn>& columns, std::vector<uint32_t>& selection) const;
+
+private:
+    std::vector<Term> _terms;
+};
+}  // namespace mongo::sbe::vm
@@ -91,6 +91,8 @@ int Instruction::stackOffset[Instruction::Tags::lastInstruction] = {
 
     -1,  // getField
     -1,  // getElement
+    0,   // getFieldImm
+    1,   // getFieldAccessImm
 
     -1,  // sum
     -1,  // min
@@ -277,6 +279,54 @@ void CodeFragment::appendGetField() {
     appendSimpleInstruction(Instruction::getField);
 }
 
+namespace {
+/**
+ * Writes a field name as an immediate operand of an instruction; i.e. a one byte length followed by
+ * the characters of the name. Returns the number of bytes written.
+ */
+size_t writeFieldNameToMemory(uint8_t* ptr, StringData fieldName) noexcept {
+    invariant(fieldName.size() <= CodeFragment::kMaxImmFieldNameSize);
+
+    auto size = value::writeToMemory(ptr, static_cast<uint8_t>(fieldName.size()));
+    memcpy(ptr + size, fieldName.rawData(), fieldName.size());
+    return size + fieldName.size();
+}
+
+/**
+ * Reads a field name written by 'writeFieldNameToMemory()'. Returns the name, which is a view into
+ * the instruction stream, and the number of bytes read.
+ */
+std::pair<std::string_view, size_t> readFieldNameFromMemory(const uint8_t* ptr) noexcept {
+    auto size = value::readFromMemory<uint8_t>(ptr);
+    return {std::string_view{reinterpret_cast<const char*>(ptr) + sizeof(size), size},
+            sizeof(size) + size};
+}
+}  // namespace
+
+void CodeFragment::appendGetField(StringData fieldName) {
+    Instruction i;
+    i.tag = Instruction::getFieldImm;
+    adjustStackSimple(i);
+
+    auto offset = allocateSpace(sizeof(Instruction) + sizeof(uint8_t) + fieldName.size());
+
+    offset += value::writeToMemory(offset, i);
+    offset += writeFieldNameToMemory(offset, fieldName);
+}
+
+void CodeFragment::appendGetField(value::SlotAccessor* accessor, StringData fieldName) {
+    Instruction i;
+    i.tag = Instruction::getFieldAccessImm;
+    adjustStackSimple(i);
+
+    auto offset =
+        allocateSpace(sizeof(Instruction) + sizeof(accessor) + sizeof(uint8_t) + fieldName.size());
+
+    offset += value::writeToMemory(offset, i);
+    offset += value::writeToMemory(offset, accessor);
+    offset += writeFieldNameToMemory(offset, fieldName);
+}
+
 void CodeFragment::appendGetElement() {
     appendSimpleInstruction(Instruction::getElement);
 }
@@ -424,7 +474,12 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::getField(value::TypeTa
     }
 
     auto fieldStr = value::getStringView(fieldTag, fieldValue);
+    return getField(objTag, objValue, fieldStr);
+}
 
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::getField(value::TypeTags objTag,
+                                                                   value::Value objValue,
+                                                                   std::string_view fieldStr) {
     if (MONGO_unlikely(failOnPoisonedFieldLookup.shouldFail())) {
         uassert(4623399, "Lookup of $POISON", fieldStr != "POISON");
     }
@@ -555,10 +610,11 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::aggSum(value::TypeTags
         return {true, tag, val};
     }
 
-    // Initialize the accumulator.
+    // Initialize the accumulator. Start with the narrowest numeric type, so that the result is
+    // widened only as needed, in the same way as $sum does in the aggregation framework.
     if (accTag == value::TypeTags::Nothing) {
-        accTag = value::TypeTags::NumberInt64;
-        accValue = value::bitcastFrom<int64_t>(0);
+        accTag = value::TypeTags::NumberInt32;
+        accValue = value::bitcastFrom<int32_t>(0);
     }
 
     return genericAdd(accTag, accValue, fieldTag, fieldValue);
@@ -828,21 +884,40 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinNewKeyString(Ar
     auto orderingBits = value::numericCast<int32_t>(tagInOrdering, valInOrdering);
     BSONObjBuilder bb;
     for (size_t i = 0; i < Ordering::kMaxCompoundIndexKeys; ++i) {
-        bb.append(""_sd, (orderingBits & (1 << i)) ? 1 : 0);
+        // A set bit stands for a descending key component, as in 'Ordering'.
+        bb.append(""_sd, (orderingBits & (1 << i)) ? -1 : 1);
     }
 
     KeyString::HeapBuilder kb{version, Ordering::make(bb.done())};
 
     for (size_t idx = 2; idx < arity - 1u; ++idx) {
         auto [_, tag, val] = getFromStack(idx);
-        if (value::isNumber(tag)) {
+        if (tag == value::TypeTags::NumberInt32 || tag == value::TypeTags::NumberInt64) {
             auto num = value::numericCast<int64_t>(tag, val);
             kb.appendNumberLong(num);
         } else if (value::isString(tag)) {
             auto str = value::getStringView(tag, val);
             kb.appendString(StringData{str.data(), str.length()});
+        } else if (tag == value::TypeTags::ksValue) {
+            // A key produced by the 'joinKeys' builtin holds a single ascending component, which
+            // may be of a BSON type SBE values cannot represent. Append it as the original BSON.
+            auto key = value::getKeyStringView(val);
+            auto keyObj = KeyString::toBson(
+                key->getBuffer(), key->getSize(), KeyString::ALL_ASCENDING, key->getTypeBits());
+            kb.appendBSONElement(keyObj.firstElement());
         } else {
-            uasserted(4822802, "unsuppored key string type");
+            // Any other value is appended through its BSON representation, so that it compares
+            // with the keys of an index like the original BSON value would.
+            uassert(4822802, "unsuppored key string type", tag != value::TypeTags::Nothing);
+            auto [arrTag, arrVal] = value::makeNewArray();
+            value::ValueGuard guard{arrTag, arrVal};
+            auto [copyTag, copyVal] = value::copyValue(tag, val);
+            value::getArrayView(arrVal)->push_back(copyTag, copyVal);
+
+            BSONArrayBuilder arrBuilder;
+            bson::convertToBsonObj(arrBuilder, value::getArrayView(arrVal));
+            auto arr = arrBuilder.done();
+            kb.appendBSONElement(arr.firstElement());
         }
     }
 
@@ -862,6 +937,69 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinNewKeyString(Ar
             value::bitcastFrom<KeyString::Value*>(new KeyString::Value(kb.release()))};
 }
 
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinJoinKeys(ArityType arity) {
+    invariant(arity == 3);
+
+    auto [_, tagDoc, valDoc] = getFromStack(0);
+    auto [__, tagField, valField] = getFromStack(1);
+    auto [___, tagKind, valKind] = getFromStack(2);
+    if (!value::isString(tagField) || tagKind != value::TypeTags::NumberInt32) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+    auto kind = static_cast<JoinKeysKind>(value::bitcastTo<int32_t>(valKind));
+
+    // The join field is read from the BSON representation of the document, as it may hold a value
+    // which cannot be converted into an SBE value, like a regular expression.
+    BSONObj doc;
+    if (tagDoc == value::TypeTags::bsonObject) {
+        doc = BSONObj{value::bitcastTo<const char*>(valDoc)};
+    } else if (tagDoc == value::TypeTags::Object) {
+        BSONObjBuilder objBuilder;
+        bson::convertToBsonObj(objBuilder, value::getObjectView(valDoc));
+        doc = objBuilder.obj();
+    } else {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+    auto fieldName = value::getStringView(tagField, valField);
+    auto field = doc[StringData{fieldName.data(), fieldName.size()}];
+
+    auto [keysTag, keysVal] = value::makeNewArray();
+    value::ValueGuard keysGuard{keysTag, keysVal};
+    auto keys = value::getArrayView(keysVal);
+    auto appendKey = [&](const BSONElement& elem) {
+        KeyString::HeapBuilder kb{KeyString::Version::V1};
+        kb.appendBSONElement(elem);
+        keys->push_back(value::TypeTags::ksValue,
+                        value::bitcastFrom<KeyString::Value*>(new KeyString::Value(kb.release())));
+    };
+
+    if (field.type() != BSONType::Array) {
+        if (field.eoo()) {
+            appendKey(BSON("" << BSONNULL).firstElement());
+        } else {
+            appendKey(field);
+        }
+    } else {
+        if (kind == JoinKeysKind::kForeign) {
+            appendKey(field);
+        }
+        for (auto&& elem : field.Obj()) {
+            appendKey(elem);
+            if (kind == JoinKeysKind::kLocalIndexProbes && elem.type() == BSONType::Array) {
+                auto elemObj = elem.Obj();
+                appendKey(elemObj.isEmpty() ? BSON("" << BSONUndefined).firstElement()
+                                            : elemObj.firstElement());
+            }
+        }
+        if (kind != JoinKeysKind::kForeign && keys->size() == 0) {
+            appendKey(BSON("" << BSONNULL).firstElement());
+        }
+    }
+
+    keysGuard.reset();
+    return {true, keysTag, keysVal};
+}
+
 std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinAbs(ArityType arity) {
     invariant(arity == 1);
 
@@ -1145,6 +1283,239 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinDoubleDoubleSum
     return {false, value::TypeTags::Nothing, 0};
 }
 
+namespace {
+/**
+ * The elements of the array which holds the state of the "aggDoubleDoubleSum" aggregate. As in the
+ * $sum and $avg accumulators of the aggregation framework, the non-decimal values are summed with
+ * a DoubleDoubleSummation, which is stored as the unevaluated sum of two doubles, and the decimal
+ * values are summed separately. The decimal total is only appended once a decimal is summed.
+ */
+enum AggSumValueElems : size_t {
+    kNonDecimalTotalTag,  // The widest numeric type of all the summed values.
+    kNonDecimalTotalSum,
+    kNonDecimalTotalAddend,
+    kDecimalTotal,
+};
+
+value::TypeTags getAggSumTotalTag(const value::Array* state) {
+    return static_cast<value::TypeTags>(
+        value::bitcastTo<int32_t>(state->getAt(kNonDecimalTotalTag).second));
+}
+
+void setAggSumTotalTag(value::Array* state, value::TypeTags totalTag) {
+    state->setAt(kNonDecimalTotalTag,
+                 value::TypeTags::NumberInt32,
+                 value::bitcastFrom<int32_t>(static_cast<int32_t>(totalTag)));
+}
+
+std::pair<value::TypeTags, value::Value> makeAggSumState() {
+    auto [tag, val] = value::makeNewArray();
+    auto state = value::getArrayView(val);
+    state->reserve(kDecimalTotal);
+    state->push_back(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(0));
+    state->push_back(value::TypeTags::NumberDouble, value::bitcastFrom<double>(0.0));
+    state->push_back(value::TypeTags::NumberDouble, value::bitcastFrom<double>(0.0));
+    setAggSumTotalTag(state, value::TypeTags::NumberInt32);
+    return {tag, val};
+}
+
+DoubleDoubleSummation getAggSumNonDecimalTotal(const value::Array* state) {
+    // The two parts of the unevaluated sum are exact, so adding them restores the summation.
+    DoubleDoubleSummation nonDecimalTotal;
+    nonDecimalTotal.addDouble(value::bitcastTo<double>(state->getAt(kNonDecimalTotalSum).second));
+    nonDecimalTotal.addDouble(
+        value::bitcastTo<double>(state->getAt(kNonDecimalTotalAddend).second));
+    return nonDecimalTotal;
+}
+
+void setAggSumNonDecimalTotal(value::Array* state, const DoubleDoubleSummation& nonDecimalTotal) {
+    auto [sum, addend] = nonDecimalTotal.getDoubleDouble();
+    state->setAt(
+        kNonDecimalTotalSum, value::TypeTags::NumberDouble, value::bitcastFrom<double>(sum));
+    state->setAt(
+        kNonDecimalTotalAddend, value::TypeTags::NumberDouble, value::bitcastFrom<double>(addend));
+}
+
+Decimal128 getAggSumDecimalTotal(const value::Array* state) {
+    auto [tag, val] = state->getAt(kDecimalTotal);
+    return tag == value::TypeTags::NumberDecimal ? value::bitcastTo<Decimal128>(val)
+                                                 : Decimal128{};
+}
+
+void addToAggSumDecimalTotal(value::Array* state, Decimal128 x) {
+    auto [tag, val] = value::makeCopyDecimal(getAggSumDecimalTotal(state).add(x));
+    if (state->size() > kDecimalTotal) {
+        state->setAt(kDecimalTotal, tag, val);
+    } else {
+        state->push_back(tag, val);
+    }
+}
+
+/**
+ * Returns the sum, converted to the type of result the $sum accumulator would produce for it.
+ */
+std::tuple<bool, value::TypeTags, value::Value> finalizeAggSum(const value::Array* state) {
+    auto nonDecimalTotal = getAggSumNonDecimalTotal(state);
+    switch (getAggSumTotalTag(state)) {
+        case value::TypeTags::NumberInt32:
+            if (nonDecimalTotal.fitsLong()) {
+                auto result = nonDecimalTotal.getLong();
+                if (result >= std::numeric_limits<int32_t>::min() &&
+                    result <= std::numeric_limits<int32_t>::max()) {
+                    return {false,
+                            value::TypeTags::NumberInt32,
+                            value::bitcastFrom<int32_t>(static_cast<int32_t>(result))};
+                }
+            }
+            // Fall through to the larger type.
+        case value::TypeTags::NumberInt64:
+            if (nonDecimalTotal.fitsLong()) {
+                return {false,
+                        value::TypeTags::NumberInt64,
+                        value::bitcastFrom<int64_t>(nonDecimalTotal.getLong())};
+            }
+            // An integer sum which overflows a 64-bit integer is returned as a double.
+            // Fall through to the larger type.
+        case value::TypeTags::NumberDouble:
+            return {false,
+                    value::TypeTags::NumberDouble,
+                    value::bitcastFrom<double>(nonDecimalTotal.getDouble())};
+        case value::TypeTags::NumberDecimal: {
+            auto [tag, val] = value::makeCopyDecimal(
+                getAggSumDecimalTotal(state).add(nonDecimalTotal.getDecimal()));
+            return {true, tag, val};
+        }
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+}  // namespace
+
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinAggDoubleDoubleSum(
+    ArityType arity) {
+    auto [ownAgg, tagAgg, valAgg] = getFromStack(0);
+    auto [_, tagField, valField] = getFromStack(1);
+
+    // Create the state of the sum once the first number is seen.
+    if (tagAgg == value::TypeTags::Nothing) {
+        if (!value::isNumber(tagField)) {
+            return {false, value::TypeTags::Nothing, 0};
+        }
+        auto [tagNewAgg, valNewAgg] = makeAggSumState();
+        ownAgg = true;
+        tagAgg = tagNewAgg;
+        valAgg = valNewAgg;
+    } else {
+        // Take ownership of the accumulator.
+        topStack(false, value::TypeTags::Nothing, 0);
+    }
+    value::ValueGuard guard{tagAgg, valAgg};
+
+    invariant(ownAgg && tagAgg == value::TypeTags::Array);
+    auto state = value::getArrayView(valAgg);
+
+    // Non-numeric values do not contribute to the sum.
+    if (value::isNumber(tagField)) {
+        setAggSumTotalTag(state,
+                          value::getWidestNumericalType(getAggSumTotalTag(state), tagField));
+        if (tagField == value::TypeTags::NumberDecimal) {
+            addToAggSumDecimalTotal(state, value::bitcastTo<Decimal128>(valField));
+        } else {
+            auto nonDecimalTotal = getAggSumNonDecimalTotal(state);
+            if (tagField == value::TypeTags::NumberDouble) {
+                nonDecimalTotal.addDouble(value::bitcastTo<double>(valField));
+            } else {
+                // Avoid summation of integers using doubles as that loses precision.
+                nonDecimalTotal.addLong(value::numericCast<int64_t>(tagField, valField));
+            }
+            setAggSumNonDecimalTotal(state, nonDecimalTotal);
+        }
+    }
+
+    guard.reset();
+    return {ownAgg, tagAgg, valAgg};
+}
+
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinAggMergeDoubleDoubleSums(
+    ArityType arity) {
+    auto [ownAgg, tagAgg, valAgg] = getFromStack(0);
+    auto [_, tagPartial, valPartial] = getFromStack(1);
+
+    if (tagAgg == value::TypeTags::Nothing) {
+        if (tagPartial != value::TypeTags::Array) {
+            return {false, value::TypeTags::Nothing, 0};
+        }
+        auto [tagNewAgg, valNewAgg] = makeAggSumState();
+        ownAgg = true;
+        tagAgg = tagNewAgg;
+        valAgg = valNewAgg;
+    } else {
+        // Take ownership of the accumulator.
+        topStack(false, value::TypeTags::Nothing, 0);
+    }
+    value::ValueGuard guard{tagAgg, valAgg};
+
+    invariant(ownAgg && tagAgg == value::TypeTags::Array);
+    auto state = value::getArrayView(valAgg);
+
+    // A partial result is missing if none of the values summed into it were numbers.
+    if (tagPartial == value::TypeTags::Array) {
+        auto partial = value::getArrayView(valPartial);
+        setAggSumTotalTag(
+            state,
+            value::getWidestNumericalType(getAggSumTotalTag(state), getAggSumTotalTag(partial)));
+
+        auto nonDecimalTotal = getAggSumNonDecimalTotal(state);
+        nonDecimalTotal.addDouble(
+            value::bitcastTo<double>(partial->getAt(kNonDecimalTotalSum).second));
+        nonDecimalTotal.addDouble(
+            value::bitcastTo<double>(partial->getAt(kNonDecimalTotalAddend).second));
+        setAggSumNonDecimalTotal(state, nonDecimalTotal);
+
+        if (partial->size() > kDecimalTotal) {
+            addToAggSumDecimalTotal(state, getAggSumDecimalTotal(partial));
+        }
+    }
+
+    guard.reset();
+    return {ownAgg, tagAgg, valAgg};
+}
+
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinDoubleDoubleSumFinalize(
+    ArityType arity) {
+    auto [_, tagState, valState] = getFromStack(0);
+    if (tagState != value::TypeTags::Array) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+
+    return finalizeAggSum(value::getArrayView(valState));
+}
+
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinDoubleDoubleAvgFinalize(
+    ArityType arity) {
+    auto [ownState, tagState, valState] = getFromStack(0);
+    auto [ownCount, tagCount, valCount] = getFromStack(1);
+    if (tagState != value::TypeTags::Array || tagCount != value::TypeTags::NumberInt64) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+
+    // Like the $avg accumulator, divide a decimal sum as a decimal and any other sum as a double.
+    auto state = value::getArrayView(valState);
+    auto count = value::bitcastTo<int64_t>(valCount);
+    auto nonDecimalTotal = getAggSumNonDecimalTotal(state);
+    if (getAggSumTotalTag(state) == value::TypeTags::NumberDecimal) {
+        auto [tag, val] =
+            value::makeCopyDecimal(getAggSumDecimalTotal(state)
+                                       .add(nonDecimalTotal.getDecimal())
+                                       .divide(Decimal128(count)));
+        return {true, tag, val};
+    }
+
+    return {false,
+            value::TypeTags::NumberDouble,
+            value::bitcastFrom<double>(nonDecimalTotal.getDouble() / static_cast<double>(count))};
+}
+
 /**
  * A helper for the bultinDate method. The formal parameters yearOrWeekYear and monthOrWeek carry
  * values depending on wether the date is a year-month-day or ISOWeekYear.
@@ -2418,6 +2789,8 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::dispatchBuiltin(Builti
             return builtinKeyStringToString(arity);
         case Builtin::newKs:
             return builtinNewKeyString(arity);
+        case Builtin::joinKeys:
+            return builtinJoinKeys(arity);
         case Builtin::abs:
             return builtinAbs(arity);
         case Builtin::ceil:
@@ -2512,12 +2885,108 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::dispatchBuiltin(Builti
             return builtinShardFilter(arity);
         case Builtin::extractSubArray:
             return builtinExtractSubArray(arity);
+        case Builtin::aggDoubleDoubleSum:
+            return builtinAggDoubleDoubleSum(arity);
+        case Builtin::aggMergeDoubleDoubleSums:
+            return builtinAggMergeDoubleDoubleSums(arity);
+        case Builtin::doubleDoubleSumFinalize:
+            return builtinDoubleDoubleSumFinalize(arity);
+        case Builtin::doubleDoubleAvgFinalize:
+            return builtinDoubleDoubleAvgFinalize(arity);
     }
 
     MONGO_UNREACHABLE;
 }
 
+/**
+ * With GCC and clang the interpreter loop below dispatches directly from the end of one instruction
+ * to the start of the next one through a table of label addresses, rather than going back to the
+ * top of the loop and through the switch. Every instruction then ends with its own indirect branch,
+ * which is much easier for the CPU to predict than the single shared branch of the switch. The
+ * switch is still used to dispatch the first instruction of the code fragment.
+ */
+#if defined(__GNUC__)
+#define MONGO_SBE_VM_THREADED_DISPATCH
+#endif
+
+#ifdef MONGO_SBE_VM_THREADED_DISPATCH
+#define MONGO_SBE_VM_CASE(name) \
+    case Instruction::name:     \
+    name##_label:
+#define MONGO_SBE_VM_NEXT                                  \
+    {                                                      \
+        if (pcPointer == pcEnd) {                          \
+            break;                                         \
+        }                                                  \
+        i = value::readFromMemory<Instruction>(pcPointer); \
+        pcPointer += sizeof(i);                            \
+        goto* kDispatchTable[i.tag];                       \
+    }
+#else
+#define MONGO_SBE_VM_CASE(name) case Instruction::name:
+#define MONGO_SBE_VM_NEXT break
+#endif
+
 std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragment* code) {
+#ifdef MONGO_SBE_VM_THREADED_DISPATCH
+    // This table must be kept in sync with Instruction::Tags.
+    static void* const kDispatchTable[] = {
+        &&pushConstVal_label,
+        &&pushAccessVal_label,
+        &&pushMoveVal_label,
+        &&pushLocalVal_label,
+        &&pop_label,
+        &&swap_label,
+        &&add_label,
+        &&sub_label,
+        &&mul_label,
+        &&div_label,
+        &&idiv_label,
+        &&mod_label,
+        &&negate_label,
+        &&numConvert_label,
+        &&logicNot_label,
+        &&less_label,
+        &&lessEq_label,
+        &&greater_label,
+        &&greaterEq_label,
+        &&eq_label,
+        &&neq_label,
+        &&cmp3w_label,
+        &&fillEmpty_label,
+        &&getField_label,
+        &&getElement_label,
+        &&getFieldImm_label,
+        &&getFieldAccessImm_label,
+        &&aggSum_label,
+        &&aggMin_label,
+        &&aggMax_label,
+        &&aggFirst_label,
+        &&aggLast_label,
+        &&exists_label,
+        &&isNull_label,
+        &&isObject_label,
+        &&isArray_label,
+        &&isString_label,
+        &&isNumber_label,
+        &&isBinData_label,
+        &&isDate_label,
+        &&isNaN_label,
+        &&isRecordId_label,
+        &&isMinKey_label,
+        &&isMaxKey_label,
+        &&typeMatch_label,
+        &&function_label,
+        &&functionSmall_label,
+        &&jmp_label,
+        &&jmpTrue_label,
+        &&jmpNothing_label,
+        &&fail_label,
+    };
+    static_assert(sizeof(kDispatchTable) / sizeof(kDispatchTable[0]) ==
+                  Instruction::lastInstruction);
+#endif
+
     auto pcPointer = code->instrs().data();
     auto pcEnd = pcPointer + code->instrs().size();
 
@@ -2528,7 +2997,7 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
             Instruction i = value::readFromMemory<Instruction>(pcPointer);
             pcPointer += sizeof(i);
             switch (i.tag) {
-                case Instruction::pushConstVal: {
+                MONGO_SBE_VM_CASE(pushConstVal) {
                     auto tag = value::readFromMemory<value::TypeTags>(pcPointer);
                     pcPointer += sizeof(tag);
                     auto val = value::readFromMemory<value::Value>(pcPointer);
@@ -2536,27 +3005,27 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
 
                     pushStack(false, tag, val);
 
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::pushAccessVal: {
+                MONGO_SBE_VM_CASE(pushAccessVal) {
                     auto accessor = value::readFromMemory<value::SlotAccessor*>(pcPointer);
                     pcPointer += sizeof(accessor);
 
                     auto [tag, val] = accessor->getViewOfValue();
                     pushStack(false, tag, val);
 
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::pushMoveVal: {
+                MONGO_SBE_VM_CASE(pushMoveVal) {
                     auto accessor = value::readFromMemory<value::SlotAccessor*>(pcPointer);
                     pcPointer += sizeof(accessor);
 
                     auto [tag, val] = accessor->copyOrMoveValue();
                     pushStack(true, tag, val);
 
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::pushLocalVal: {
+                MONGO_SBE_VM_CASE(pushLocalVal) {
                     auto stackOffset = value::readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(stackOffset);
 
@@ -2564,9 +3033,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
 
                     pushStack(false, tag, val);
 
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::pop: {
+                MONGO_SBE_VM_CASE(pop) {
                     auto [owned, tag, val] = getFromStack(0);
                     popStack();
 
@@ -2574,9 +3043,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                         value::releaseValue(tag, val);
                     }
 
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::swap: {
+                MONGO_SBE_VM_CASE(swap) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(1);
 
@@ -2592,9 +3061,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                         invariant(!rhsOwned);
                     }
 
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::add: {
+                MONGO_SBE_VM_CASE(add) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2609,9 +3078,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::sub: {
+                MONGO_SBE_VM_CASE(sub) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2626,9 +3095,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::mul: {
+                MONGO_SBE_VM_CASE(mul) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2643,9 +3112,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::div: {
+                MONGO_SBE_VM_CASE(div) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2660,9 +3129,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::idiv: {
+                MONGO_SBE_VM_CASE(idiv) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2677,9 +3146,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::mod: {
+                MONGO_SBE_VM_CASE(mod) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2694,9 +3163,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::negate: {
+                MONGO_SBE_VM_CASE(negate) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     auto [resultOwned, resultTag, resultVal] = genericSub(
@@ -2708,9 +3177,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                         value::releaseValue(resultTag, resultVal);
                     }
 
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::numConvert: {
+                MONGO_SBE_VM_CASE(numConvert) {
                     auto tag = value::readFromMemory<value::TypeTags>(pcPointer);
                     pcPointer += sizeof(tag);
 
@@ -2724,9 +3193,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                         value::releaseValue(lhsTag, lhsVal);
                     }
 
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::logicNot: {
+                MONGO_SBE_VM_CASE(logicNot) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     auto [resultOwned, resultTag, resultVal] = genericNot(tag, val);
@@ -2736,9 +3205,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::less: {
+                MONGO_SBE_VM_CASE(less) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2753,9 +3222,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::lessEq: {
+                MONGO_SBE_VM_CASE(lessEq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2771,9 +3240,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::greater: {
+                MONGO_SBE_VM_CASE(greater) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2789,9 +3258,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::greaterEq: {
+                MONGO_SBE_VM_CASE(greaterEq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2807,9 +3276,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::eq: {
+                MONGO_SBE_VM_CASE(eq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2824,9 +3293,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::neq: {
+                MONGO_SBE_VM_CASE(neq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2841,9 +3310,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::cmp3w: {
+                MONGO_SBE_VM_CASE(cmp3w) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2858,9 +3327,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::fillEmpty: {
+                MONGO_SBE_VM_CASE(fillEmpty) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2876,9 +3345,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                             value::releaseValue(rhsTag, rhsVal);
                         }
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::getField: {
+                MONGO_SBE_VM_CASE(getField) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2893,9 +3362,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::getElement: {
+                MONGO_SBE_VM_CASE(getElement) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2910,9 +3379,37 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::aggSum: {
+                MONGO_SBE_VM_CASE(getFieldImm) {
+                    auto [fieldName, fieldNameSize] = readFieldNameFromMemory(pcPointer);
+                    pcPointer += fieldNameSize;
+
+                    auto [objOwned, objTag, objVal] = getFromStack(0);
+
+                    auto [owned, tag, val] = getField(objTag, objVal, fieldName);
+
+                    topStack(owned, tag, val);
+
+                    if (objOwned) {
+                        value::releaseValue(objTag, objVal);
+                    }
+                    MONGO_SBE_VM_NEXT;
+                }
+                MONGO_SBE_VM_CASE(getFieldAccessImm) {
+                    auto accessor = value::readFromMemory<value::SlotAccessor*>(pcPointer);
+                    pcPointer += sizeof(accessor);
+                    auto [fieldName, fieldNameSize] = readFieldNameFromMemory(pcPointer);
+                    pcPointer += fieldNameSize;
+
+                    auto [objTag, objVal] = accessor->getViewOfValue();
+
+                    auto [owned, tag, val] = getField(objTag, objVal, fieldName);
+
+                    pushStack(owned, tag, val);
+                    MONGO_SBE_VM_NEXT;
+                }
+                MONGO_SBE_VM_CASE(aggSum) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2927,9 +3424,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::aggMin: {
+                MONGO_SBE_VM_CASE(aggMin) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2944,9 +3441,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::aggMax: {
+                MONGO_SBE_VM_CASE(aggMax) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2961,9 +3458,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::aggFirst: {
+                MONGO_SBE_VM_CASE(aggFirst) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2978,9 +3475,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::aggLast: {
+                MONGO_SBE_VM_CASE(aggLast) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -2995,9 +3492,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::exists: {
+                MONGO_SBE_VM_CASE(exists) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     topStack(false,
@@ -3007,9 +3504,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::isNull: {
+                MONGO_SBE_VM_CASE(isNull) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -3021,9 +3518,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::isObject: {
+                MONGO_SBE_VM_CASE(isObject) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -3035,9 +3532,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::isArray: {
+                MONGO_SBE_VM_CASE(isArray) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -3049,9 +3546,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::isString: {
+                MONGO_SBE_VM_CASE(isString) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -3063,9 +3560,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::isNumber: {
+                MONGO_SBE_VM_CASE(isNumber) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -3077,9 +3574,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::isBinData: {
+                MONGO_SBE_VM_CASE(isBinData) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -3091,9 +3588,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::isDate: {
+                MONGO_SBE_VM_CASE(isDate) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -3105,9 +3602,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::isNaN: {
+                MONGO_SBE_VM_CASE(isNaN) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -3119,9 +3616,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::isRecordId: {
+                MONGO_SBE_VM_CASE(isRecordId) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -3133,9 +3630,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::isMinKey: {
+                MONGO_SBE_VM_CASE(isMinKey) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -3147,9 +3644,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::isMaxKey: {
+                MONGO_SBE_VM_CASE(isMaxKey) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -3161,9 +3658,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::typeMatch: {
+                MONGO_SBE_VM_CASE(typeMatch) {
                     auto typeMask = value::readFromMemory<uint32_t>(pcPointer);
                     pcPointer += sizeof(typeMask);
 
@@ -3178,10 +3675,10 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::function:
-                case Instruction::functionSmall: {
+                MONGO_SBE_VM_CASE(function)
+                MONGO_SBE_VM_CASE(functionSmall) {
                     auto f = value::readFromMemory<Builtin>(pcPointer);
                     pcPointer += sizeof(f);
                     ArityType arity{0};
@@ -3205,16 +3702,16 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
 
                     pushStack(owned, tag, val);
 
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::jmp: {
+                MONGO_SBE_VM_CASE(jmp) {
                     auto jumpOffset = value::readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(jumpOffset);
 
                     pcPointer += jumpOffset;
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::jmpTrue: {
+                MONGO_SBE_VM_CASE(jmpTrue) {
                     auto jumpOffset = value::readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(jumpOffset);
 
@@ -3228,9 +3725,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::jmpNothing: {
+                MONGO_SBE_VM_CASE(jmpNothing) {
                     auto jumpOffset = value::readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(jumpOffset);
 
@@ -3238,9 +3735,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (tag == value::TypeTags::Nothing) {
                         pcPointer += jumpOffset;
                     }
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
-                case Instruction::fail: {
+                MONGO_SBE_VM_CASE(fail) {
                     auto [ownedCode, tagCode, valCode] = getFromStack(1);
                     invariant(tagCode == value::TypeTags::NumberInt64);
 
@@ -3253,7 +3750,7 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
 
                     uasserted(code, message);
 
-                    break;
+                    MONGO_SBE_VM_NEXT;
                 }
                 default:
                     MONGO_UNREACHABLE;
@@ -3274,6 +3771,10 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
     return {owned, tag, val};
 }
 
+#undef MONGO_SBE_VM_NEXT
+#undef MONGO_SBE_VM_CASE
+#undef MONGO_SBE_VM_THREADED_DISPATCH
+
 bool ByteCode::runPredicate(const CodeFragment* code) {
     auto [owned, tag, val] = run(code);
 
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -148,6 +149,11 @@ struct Instruction {
         getField,
         getElement,
 
+        // Fused forms of getField which carry a constant field name inline. The second one also
+        // reads the object directly from a slot accessor instead of from the stack.
+        getFieldImm,
+        getFieldAccessImm,
+
         aggSum,
         aggMin,
         aggMax,
@@ -187,6 +193,25 @@ struct Instruction {
 };
 static_assert(sizeof(Instruction) == sizeof(uint8_t));
 
+/**
+ * Selects which join keys the 'joinKeys' builtin computes from the join field of a document taking
+ * part in an equality join, such as a pushed down $lookup. Every join key is a KeyString holding a
+ * single ascending component, so that it compares with the other keys like the original BSON values
+ * do under the $eq query operator, even if they are of a type SBE values cannot represent.
+ */
+enum class JoinKeysKind : int32_t {
+    // The values a local document looks up: the elements of its join field if that is an array,
+    // or the value of the field otherwise. A missing field or an empty array looks up null.
+    kLocal,
+    // The values a foreign document is found by: the value of its join field, as well as its
+    // elements if that is an array. A missing field is found by null.
+    kForeign,
+    // The keys to probe an index on the foreign join field with for a local document: its 'kLocal'
+    // join keys, as well as the first element of each of those keys which is an array, or
+    // undefined if it is an empty array, as arrays are indexed by their elements.
+    kLocalIndexProbes,
+};
+
 enum class Builtin : uint8_t {
     split,
     regexMatch,
@@ -202,6 +227,7 @@ enum class Builtin : uint8_t {
     newObj,
     ksToString,  // KeyString to string
     newKs,       // new KeyString
+    joinKeys,    // KeyStrings of the values an equality join matches a document on
     abs,         // absolute value
     ceil,
     floor,
@@ -249,6 +275,10 @@ enum class Builtin : uint8_t {
     regexFindAll,
     shardFilter,
     extractSubArray,
+    aggDoubleDoubleSum,
+    aggMergeDoubleDoubleSums,
+    doubleDoubleSumFinalize,
+    doubleDoubleAvgFinalize,
 };
 
 using SmallArityType = uint8_t;
@@ -312,6 +342,8 @@ public:
         appendSimpleInstruction(Instruction::fillEmpty);
     }
     void appendGetField();
+    void appendGetField(StringData fieldName);
+    void appendGetField(value::SlotAccessor* accessor, StringData fieldName);
     void appendGetElement();
     void appendSum();
     void appendMin();
@@ -344,6 +376,11 @@ public:
     }
     void appendNumericConvert(value::TypeTags targetTag);
 
+    /**
+     * Field names longer than this cannot be encoded inline by the fused getField instructions.
+     */
+    static constexpr size_t kMaxImmFieldNameSize = std::numeric_limits<uint8_t>::max();
+
 private:
     void appendSimpleInstruction(Instruction::Tags tag);
     auto allocateSpace(size_t size) {
@@ -466,6 +503,10 @@ private:
                                                              value::TypeTags fieldTag,
                                                              value::Value fieldValue);
 
+    std::tuple<bool, value::TypeTags, value::Value> getField(value::TypeTags objTag,
+                                                             value::Value objValue,
+                                                             std::string_view fieldStr);
+
     std::tuple<bool, value::TypeTags, value::Value> getElement(value::TypeTags objTag,
                                                                value::Value objValue,
                                                                value::TypeTags fieldTag,
@@ -565,6 +606,7 @@ private:
     std::tuple<bool, value::TypeTags, value::Value> builtinNewObj(ArityType arity);
     std::tuple<bool, value::TypeTags, value::Value> builtinKeyStringToString(ArityType arity);
     std::tuple<bool, value::TypeTags, value::Value> builtinNewKeyString(ArityType arity);
+    std::tuple<bool, value::TypeTags, value::Value> builtinJoinKeys(ArityType arity);
     std::tuple<bool, value::TypeTags, value::Value> builtinAbs(ArityType arity);
     std::tuple<bool, value::TypeTags, value::Value> builtinCeil(ArityType arity);
     std::tuple<bool, value::TypeTags, value::Value> builtinFloor(ArityType arity);
@@ -576,6 +618,13 @@ private:
     std::tuple<bool, value::TypeTags, value::Value> builtinAddToArray(ArityType arity);
     std::tuple<bool, value::TypeTags, value::Value> builtinAddToSet(ArityType arity);
     std::tuple<bool, value::TypeTags, value::Value> builtinDoubleDoubleSum(ArityType arity);
+    std::tuple<bool, value::TypeTags, value::Value> builtinAggDoubleDoubleSum(ArityType arity);
+    std::tuple<bool, value::TypeTags, value::Value> builtinAggMergeDoubleDoubleSums(
+        ArityType arity);
+    std::tuple<bool, value::TypeTags, value::Value> builtinDoubleDoubleSumFinalize(
+        ArityType arity);
+    std::tuple<bool, value::TypeTags, value::Value> builtinDoubleDoubleAvgFinalize(
+        ArityType arity);
     std::tuple<bool, value::TypeTags, value::Value> builtinBitTestZero(ArityType arity);
     std::tuple<bool, value::TypeTags, value::Value> builtinBitTestMask(ArityType arity);
     std::tuple<bool, value::TypeTags, value::Value> builtinBitTestPosition(ArityType arity);
@@ -53,6 +53,19 @@ const BSONElement nullElt = nullObj.firstElement();
 const BSONObj undefinedObj = BSON("" << BSONUndefined);
 const BSONElement undefinedElt = undefinedObj.firstElement();
 
+template <class BuilderT>
+void appendToKeyString(const BSONElement& elem,
+                       const CollatorInterface* collator,
+                       KeyString::BuilderBase<BuilderT>* keyString) {
+    if (collator) {
+        keyString->appendBSONElement(elem, [&](StringData stringData) {
+            return collator->getComparisonString(stringData);
+        });
+    } else {
+        keyString->appendBSONElement(elem);
+    }
+}
+
 /**
  * Returns the non-array element at the specified path. This function returns an empty BSON element
  * if the path doesn't exist.
@@ -175,7 +188,8 @@ void BtreeKeyGenerator::_getKeysArrEltFixed(const std::vector<const char*>& fiel
                                             bool mayExpandArrayUnembedded,
                                             const std::vector<PositionalPathInfo>& positionalInfo,
                                             MultikeyPaths* multikeyPaths,
-                                            boost::optional<RecordId> id) const {
+                                            boost::optional<RecordId> id,
+                                            const KeyPrefix* keyPrefix) const {
     // fieldNamesTemp and fixedTemp are passed in by the caller to be used as temporary data
     // structures as we need them to be mutable in the recursion. When they are stored outside we
     // can reuse their memory.
@@ -202,7 +216,8 @@ void BtreeKeyGenerator::_getKeysArrEltFixed(const std::vector<const char*>& fiel
                       numNotFound,
                       positionalInfo,
                       multikeyPaths,
-                      id);
+                      id,
+                      keyPrefix);
 }
 
 void BtreeKeyGenerator::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
@@ -266,7 +281,8 @@ void BtreeKeyGenerator::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder
                           0,
                           _emptyPositionalInfo,
                           multikeyPaths,
-                          id);
+                          id,
+                          nullptr);
         // Put the sequence back into the set, it will sort and guarantee uniqueness, this is
         // O(NlogN)
         keys->adopt_sequence(std::move(seq));
@@ -318,7 +334,8 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
                                           unsigned numNotFound,
                                           const std::vector<PositionalPathInfo>& positionalInfo,
                                           MultikeyPaths* multikeyPaths,
-                                          boost::optional<RecordId> id) const {
+                                          boost::optional<RecordId> id,
+                                          const KeyPrefix* keyPrefix) const {
     BSONElement arrElt;
 
     // A set containing the position of any indexed fields in the key pattern that traverse through
@@ -388,14 +405,13 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
             return;
         }
         KeyString::PooledBuilder keyString(pooledBufferBuilder, _keyStringVersion, _ordering);
-        for (const auto& elem : *fixed) {
-            if (_collator) {
-                keyString.appendBSONElement(elem, [&](StringData stringData) {
-                    return _collator->getComparisonString(stringData);
-                });
-            } else {
-                keyString.appendBSONElement(elem);
-            }
+        size_t firstElement = 0;
+        if (keyPrefix) {
+            keyString.resetFromPrefix(keyPrefix->keyString);
+            firstElement = keyPrefix->numElements;
+        }
+        for (size_t i = firstElement; i < fixed->size(); ++i) {
+            appendToKeyString((*fixed)[i], _collator, &keyString);
         }
         if (id) {
             keyString.appendRecordId(*id);
@@ -434,7 +450,8 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
                             true,
                             _emptyPositionalInfo,
                             multikeyPaths,
-                            id);
+                            id,
+                            keyPrefix);
     } else {
         BSONObj arrObj = arrElt.embeddedObject();
 
@@ -505,6 +522,31 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
                 arrObj, subPositionalInfo[i].remainingPath);
         }
 
+        // The leading indexed fields which have been traversed to the end and do not traverse
+        // 'arrElt' have the same element in every key generated for the elements of 'arrElt'. If
+        // there are more of those than 'keyPrefix' covers and 'arrElt' has more than one element,
+        // encode them once here.
+        size_t numPrefixElements = 0;
+        while (numPrefixElements < fixed->size() && *(*fieldNames)[numPrefixElements] == '\0' &&
+               arrIdxs.find(numPrefixElements) == arrIdxs.end()) {
+            ++numPrefixElements;
+        }
+        BSONObjIterator arrObjIt(arrObj);
+        arrObjIt.next();
+        boost::optional<KeyPrefix> arrKeyPrefix;
+        if (numPrefixElements > (keyPrefix ? keyPrefix->numElements : 0) && arrObjIt.more()) {
+            arrKeyPrefix.emplace(_keyStringVersion, _ordering);
+            size_t i = 0;
+            if (keyPrefix) {
+                arrKeyPrefix->keyString.resetFromPrefix(keyPrefix->keyString);
+                i = keyPrefix->numElements;
+            }
+            for (; i < numPrefixElements; ++i) {
+                appendToKeyString((*fixed)[i], _collator, &arrKeyPrefix->keyString);
+            }
+            arrKeyPrefix->numElements = numPrefixElements;
+        }
+
         // Generate a key for each element of the indexed array.
         std::vector<const char*> fieldNamesTemp;
         std::vector<BSONElement> fixedTemp;
@@ -522,7 +564,8 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
                                 mayExpandArrayUnembedded,
                                 subPositionalInfo,
                                 multikeyPaths,
-                                id);
+                                id,
+                                arrKeyPrefix ? &*arrKeyPrefix : keyPrefix);
         }
     }
 
@@ -148,9 +148,23 @@ private:
         const char* remainingPath;
     };
 
+    /**
+     * The encoding of the elements of the leading 'numElements' indexed fields, which is shared
+     * by all of the keys generated by a call to _getKeysWithArray(). Expanding an array generates
+     * a key per array element, so encoding the fields that do not traverse the array once saves
+     * re-encoding them for every key.
+     */
+    struct KeyPrefix {
+        KeyPrefix(KeyString::Version version, Ordering ordering) : keyString(version, ordering) {}
+
+        KeyString::Builder keyString;
+        size_t numElements = 0;
+    };
+
     /**
      * This recursive method does the heavy-lifting for getKeys().
-     * It will modify 'fieldNames' and 'fixed'.
+     * It will modify 'fieldNames' and 'fixed'. If 'keyPrefix' is non-null, the leading elements
+     * of 'fixed' that it encodes must not change during the recursion.
      */
     void _getKeysWithArray(std::vector<const char*>* fieldNames,
                            std::vector<BSONElement>* fixed,
@@ -160,7 +174,8 @@ private:
                            unsigned numNotFound,
                            const std::vector<PositionalPathInfo>& positionalInfo,
                            MultikeyPaths* multikeyPaths,
-                           boost::optional<RecordId> id) const;
+                           boost::optional<RecordId> id,
+                           const KeyPrefix* keyPrefix) const;
 
     /**
      * An optimized version of the key generation algorithm to be used when it is known that 'obj'
@@ -229,7 +244,8 @@ private:
                              bool mayExpandArrayUnembedded,
                              const std::vector<PositionalPathInfo>& positionalInfo,
                              MultikeyPaths* multikeyPaths,
-                             boost::optional<RecordId> id) const;
+                             boost::optional<RecordId> id,
+                             const KeyPrefix* keyPrefix) const;
 
     KeyString::Value _buildNullKeyString() const;
 
@@ -411,6 +411,23 @@ TEST(BtreeKeyGeneratorTest, GetKeysFromCompoundMissing) {
     ASSERT(testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths));
 }
 
+TEST(BtreeKeyGeneratorTest, GetKeysFromCompoundWithArrayAfterLeadingFields) {
+    BSONObj keyPattern = fromjson("{x: 1, y: 1, 'z.w': 1}");
+    BSONObj genKeysFrom = fromjson("{x: 'a', y: 1.5, z: [{w: [1, 2]}, {w: 3}]}");
+    KeyString::HeapBuilder keyString1(KeyString::Version::kLatestVersion,
+                                      fromjson("{'': 'a', '': 1.5, '': 1}"),
+                                      Ordering::make(BSONObj()));
+    KeyString::HeapBuilder keyString2(KeyString::Version::kLatestVersion,
+                                      fromjson("{'': 'a', '': 1.5, '': 2}"),
+                                      Ordering::make(BSONObj()));
+    KeyString::HeapBuilder keyString3(KeyString::Version::kLatestVersion,
+                                      fromjson("{'': 'a', '': 1.5, '': 3}"),
+                                      Ordering::make(BSONObj()));
+    KeyStringSet expectedKeys{keyString1.release(), keyString2.release(), keyString3.release()};
+    MultikeyPaths expectedMultikeyPaths{MultikeyComponents{}, MultikeyComponents{}, {0U, 1U}};
+    ASSERT(testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths));
+}
+
 TEST(BtreeKeyGeneratorTest, GetKeysFromArraySubelementComplex) {
     BSONObj keyPattern = fromjson("{'a.b': 1}");
     BSONObj genKeysFrom = fromjson("{a:[{b:[2]}]}");
@@ -0,0 +1,181 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/column_key_generator.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+
+namespace mongo {
+namespace {
+
+void appendProjectedArray(const BSONObj& arr,
+                          const FieldRef& path,
+                          size_t pathIdx,
+                          BSONArrayBuilder* out);
+
+/**
+ * Appends to 'out' what an inclusion projection of 'path', from component 'pathIdx' onwards,
+ * keeps of the object 'obj'. Like a find projection, objects along the path are kept even when they
+ * lack the next component, arrays are traversed element by element and scalars that stand where an
+ * object is expected are dropped.
+ */
+void appendProjectedObject(const BSONObj& obj,
+                           const FieldRef& path,
+                           size_t pathIdx,
+                           BSONObjBuilder* out) {
+    auto child = obj[path.getPart(pathIdx)];
+    if (child.eoo()) {
+        return;
+    }
+
+    if (pathIdx + 1 == path.numParts()) {
+        out->append(child);
+        return;
+    }
+
+    if (child.type() == BSONType::Object) {
+        BSONObjBuilder sub(out->subobjStart(child.fieldNameStringData()));
+        appendProjectedObject(child.embeddedObject(), path, pathIdx + 1, &sub);
+    } else if (child.type() == BSONType::Array) {
+        BSONArrayBuilder sub(out->subarrayStart(child.fieldNameStringData()));
+        appendProjectedArray(child.embeddedObject(), path, pathIdx + 1, &sub);
+    }
+}
+
+void appendProjectedArray(const BSONObj& arr,
+                          const FieldRef& path,
+                          size_t pathIdx,
+                          BSONArrayBuilder* out) {
+    for (auto&& elem : arr) {
+        if (elem.type() == BSONType::Object) {
+            BSONObjBuilder sub(out->subobjStart());
+            appendProjectedObject(elem.embeddedObject(), path, pathIdx, &sub);
+        } else if (elem.type() == BSONType::Array) {
+            BSONArrayBuilder sub(out->subarrayStart());
+            appendProjectedArray(elem.embeddedObject(), path, pathIdx, &sub);
+        }
+    }
+}
+
+}  // namespace
+
+ColumnKeyGenerator::ColumnKeyGenerator(const BSONObj& keyPattern,
+                                       KeyString::Version keyStringVersion,
+                                       Ordering ordering)
+    : _keyStringVersion(keyStringVersion), _ordering(ordering) {
+    for (auto&& elem : keyPattern) {
+        _paths.emplace_back(elem.fieldNameStringData());
+        invariant(_topLevelFieldToColumn
+                      .emplace(_paths.back().getPart(0).toString(), _paths.size() - 1)
+                      .second);
+    }
+}
+
+void ColumnKeyGenerator::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                 const BSONObj& obj,
+                                 const RecordId& id,
+                                 KeyStringSet* keys) const {
+    auto keysSequence = keys->extract_sequence();
+    std::vector<bool> columnHasKey(_paths.size(), false);
+
+    auto addKey = [&](size_t column, size_t fieldPosition, const BSONElement& value) {
+        KeyString::PooledBuilder keyString(pooledBufferBuilder, _keyStringVersion, _ordering);
+        keyString.appendNumberLong(static_cast<long long>(column));
+        keyString.appendNumberLong(id.repr());
+        if (value) {
+            keyString.appendNumberLong(static_cast<long long>(fieldPosition));
+            keyString.appendBSONElement(value);
+        }
+        keyString.appendRecordId(id);
+        keysSequence.push_back(keyString.release());
+        columnHasKey[column] = true;
+    };
+
+    size_t fieldPosition = 0;
+    for (auto&& elem : obj) {
+        auto columnIt = _topLevelFieldToColumn.find(elem.fieldNameStringData());
+        if (columnIt == _topLevelFieldToColumn.end() || columnHasKey[columnIt->second]) {
+            ++fieldPosition;
+            continue;
+        }
+
+        const size_t column = columnIt->second;
+        const FieldRef& path = _paths[column];
+        if (path.numParts() == 1) {
+            addKey(column, fieldPosition, elem);
+        } else if (elem.type() == BSONType::Object || elem.type() == BSONType::Array) {
+            BSONObjBuilder bob;
+            if (elem.type() == BSONType::Object) {
+                BSONObjBuilder sub(bob.subobjStart(""));
+                appendProjectedObject(elem.embeddedObject(), path, 1, &sub);
+            } else {
+                BSONArrayBuilder sub(bob.subarrayStart(""));
+                appendProjectedArray(elem.embeddedObject(), path, 1, &sub);
+            }
+            addKey(column, fieldPosition, bob.done().firstElement());
+        } else {
+            addKey(column, fieldPosition, BSONElement());
+        }
+        ++fieldPosition;
+    }
+
+    for (size_t column = 0; column < _paths.size(); ++column) {
+        if (!columnHasKey[column]) {
+            addKey(column, 0, BSONElement());
+        }
+    }
+
+    keys->adopt_sequence(std::move(keysSequence));
+}
+
+// static
+ColumnKeyGenerator::Cell ColumnKeyGenerator::parseCell(const BSONObj& key) {
+    BSONObjIterator it(key);
+    Cell cell;
+    cell.column = static_cast<size_t>(it.next().numberLong());
+    cell.recordId = RecordId(it.next().numberLong());
+    if (it.more()) {
+        cell.fieldPosition = static_cast<size_t>(it.next().numberLong());
+        cell.value = it.next();
+    }
+    return cell;
+}
+
+// static
+BSONObj ColumnKeyGenerator::makeColumnKeyPrefix(size_t column) {
+    return BSON("" << static_cast<long long>(column));
+}
+
+BSONObj ColumnKeyGenerator::makeCellKeyPrefix(size_t column, const RecordId& id) {
+    return BSON("" << static_cast<long long>(column) << "" << id.repr());
+}
+
+}  // namespace mongo
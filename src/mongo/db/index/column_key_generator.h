@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/field_ref.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/key_string.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+/**
+ * Generates the keys of a columnstore index, such as {a: "columnstore", "b.c": "columnstore"}.
+ * Each path in the key pattern is a column, and every document contributes exactly one key to each
+ * column:
+ *      { '': <column number>, '': <record id>, '': <field position>, '': <value> }
+ * The column number is the position of the path in the key pattern and the field position is the
+ * position of the path's top-level field within the document. The value is what an inclusion
+ * projection of the path keeps of that top-level field. If the projection keeps nothing, the key
+ * stops after the record id. Because the record id comes right after the column number, each
+ * column can be read in record id order and several columns can be read side by side to rebuild
+ * the projected part of each document without reading the document itself.
+ */
+class ColumnKeyGenerator {
+public:
+    /**
+     * The decoded form of a single columnstore index key.
+     */
+    struct Cell {
+        size_t column;
+        RecordId recordId;
+
+        // The position of the column's top-level field in the document, and the value kept for the
+        // column under an empty field name. Both are unset if the document has nothing to keep.
+        boost::optional<size_t> fieldPosition;
+        BSONElement value;
+    };
+
+    ColumnKeyGenerator(const BSONObj& keyPattern,
+                       KeyString::Version keyStringVersion,
+                       Ordering ordering);
+
+    /**
+     * Adds one key per column of this index for the document 'obj' stored at 'id' to 'keys'.
+     */
+    void getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                 const BSONObj& obj,
+                 const RecordId& id,
+                 KeyStringSet* keys) const;
+
+    /**
+     * Decodes an index key, as returned by a cursor over the index, into a Cell. The Cell's value
+     * points into 'key', which must outlive it.
+     */
+    static Cell parseCell(const BSONObj& key);
+
+    /**
+     * Returns the key prefix shared by all of the keys of the given column, which can be used to
+     * position a cursor at the start or the end of the column.
+     */
+    static BSONObj makeColumnKeyPrefix(size_t column);
+
+    /**
+     * Returns the key prefix shared by all of the keys of the given column for the document stored
+     * at 'id', which can be used to position a cursor at that document's cell.
+     */
+    static BSONObj makeCellKeyPrefix(size_t column, const RecordId& id);
+
+    /**
+     * Returns the paths stored by this index, in column order.
+     */
+    const std::vector<FieldRef>& getPaths() const {
+        return _paths;
+    }
+
+private:
+    std::vector<FieldRef> _paths;
+
+    // Maps the top-level field of each path to its column. No two paths share a top-level field.
+    StringMap<size_t> _topLevelFieldToColumn;
+
+    const KeyString::Version _keyStringVersion;
+    const Ordering _ordering;
+};
+
+}  // namespace mongo
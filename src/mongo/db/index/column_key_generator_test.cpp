@@ -0,0 +1,118 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/index/column_key_generator.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const RecordId kRecordId{7};
+
+struct ColumnKeyGeneratorTest : public unittest::Test {
+    /**
+     * Generates the keys of 'doc' for an index with key pattern 'keyPattern' and returns them
+     * decoded, in index order.
+     */
+    std::vector<BSONObj> getKeys(const BSONObj& keyPattern, const BSONObj& doc) {
+        ColumnKeyGenerator keyGen{keyPattern, KeyString::Version::kLatestVersion, kOrdering};
+        KeyStringSet keys;
+        keyGen.getKeys(allocator, doc, kRecordId, &keys);
+
+        std::vector<BSONObj> decoded;
+        for (auto&& keyString : keys) {
+            decoded.push_back(KeyString::toBson(keyString, kOrdering));
+            ASSERT_EQ(KeyString::decodeRecordIdAtEnd(keyString.getBuffer(), keyString.getSize()),
+                      kRecordId);
+        }
+        return decoded;
+    }
+
+    const Ordering kOrdering = Ordering::make(BSONObj());
+    SharedBufferFragmentBuilder allocator{KeyString::HeapBuilder::kHeapAllocatorDefaultBytes};
+};
+
+TEST_F(ColumnKeyGeneratorTest, StoresTopLevelFieldsWithTheirPositions) {
+    auto keys = getKeys(fromjson("{a: 'columnstore', b: 'columnstore'}"),
+                        fromjson("{_id: 1, b: {c: 2}, a: 'x', d: 3}"));
+
+    ASSERT_EQ(keys.size(), 2U);
+    ASSERT_BSONOBJ_EQ(keys[0], BSON("" << 0LL << "" << 7LL << "" << 2LL << "" << "x"));
+    ASSERT_BSONOBJ_EQ(keys[1], BSON("" << 1LL << "" << 7LL << "" << 1LL << "" << BSON("c" << 2)));
+}
+
+TEST_F(ColumnKeyGeneratorTest, StoresAKeyForMissingFields) {
+    auto keys = getKeys(fromjson("{a: 'columnstore', 'b.c': 'columnstore'}"), fromjson("{b: 1}"));
+
+    ASSERT_EQ(keys.size(), 2U);
+    ASSERT_BSONOBJ_EQ(keys[0], BSON("" << 0LL << "" << 7LL));
+    ASSERT_BSONOBJ_EQ(keys[1], BSON("" << 1LL << "" << 7LL));
+}
+
+TEST_F(ColumnKeyGeneratorTest, KeepsWhatAProjectionOfADottedPathKeeps) {
+    auto keys = getKeys(fromjson("{'a.b': 'columnstore'}"),
+                        fromjson("{a: [1, {b: 2, c: 3}, {c: 4}, [{b: 5}, 6]], z: 1}"));
+
+    ASSERT_EQ(keys.size(), 1U);
+    ASSERT_BSONOBJ_EQ(keys[0],
+                      BSON("" << 0LL << "" << 7LL << "" << 0LL << ""
+                              << fromjson("{v: [{b: 2}, {}, [{b: 5}]]}")["v"]));
+}
+
+TEST_F(ColumnKeyGeneratorTest, KeepsObjectsAlongADottedPath) {
+    auto keys = getKeys(fromjson("{'a.b.c': 'columnstore'}"), fromjson("{a: {b: {d: 1}, e: 2}}"));
+
+    ASSERT_EQ(keys.size(), 1U);
+    ASSERT_BSONOBJ_EQ(keys[0],
+                      BSON("" << 0LL << "" << 7LL << "" << 0LL << "" << fromjson("{b: {}}")));
+}
+
+TEST_F(ColumnKeyGeneratorTest, ParseCellRoundTrips) {
+    auto keys = getKeys(fromjson("{a: 'columnstore', b: 'columnstore'}"), fromjson("{a: [1, 2]}"));
+    ASSERT_EQ(keys.size(), 2U);
+
+    auto present = ColumnKeyGenerator::parseCell(keys[0]);
+    ASSERT_EQ(present.column, 0U);
+    ASSERT_EQ(present.recordId, kRecordId);
+    ASSERT(present.fieldPosition);
+    ASSERT_EQ(*present.fieldPosition, 0U);
+    ASSERT_BSONELT_EQ(present.value, BSON("" << BSON_ARRAY(1 << 2)).firstElement());
+
+    auto missing = ColumnKeyGenerator::parseCell(keys[1]);
+    ASSERT_EQ(missing.column, 1U);
+    ASSERT_EQ(missing.recordId, kRecordId);
+    ASSERT_FALSE(missing.fieldPosition);
+    ASSERT(missing.value.eoo());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -36,6 +36,7 @@
 #include <utility>
 #include <vector>
 
+#include "mongo/base/checked_cast.h"
 #include "mongo/base/error_codes.h"
 #include "mongo/base/status.h"
 #include "mongo/db/catalog/index_catalog.h"
@@ -494,13 +495,16 @@ public:
         _sorter->add(keyString, mongo::NullValue());
     }
 
+    void merge(std::unique_ptr<BulkBuilder> other) final;
+
     const MultikeyPaths& getMultikeyPaths() const final;
 
     bool isMultikey() const final;
 
     /**
      * Inserts all multikey metadata keys cached during the BulkBuilder's lifetime into the
-     * underlying Sorter, finalizes it, and returns an iterator over the sorted dataset.
+     * underlying Sorter, finalizes it, and returns an iterator over the sorted dataset. If other
+     * BulkBuilders were merged into this one, the returned iterator merges their sorted runs.
      */
     Sorter::Iterator* done() final;
 
@@ -511,6 +515,8 @@ public:
 private:
     void _insertMultikeyMetadataKeysIntoSorter();
 
+    void _mergeMultikeyPaths(const MultikeyPaths& multikeyPaths);
+
     Sorter* _makeSorter(
         size_t maxMemoryUsageBytes,
         boost::optional<StringData> fileName = boost::none,
@@ -519,9 +525,14 @@ private:
     Sorter::Settings _makeSorterSettings() const;
 
     IndexCatalogEntry* _indexCatalogEntry;
+    const size_t _maxMemoryUsageBytes;
     std::unique_ptr<Sorter> _sorter;
     int64_t _keysInserted = 0;
 
+    // Sorters taken over from the BulkBuilders merged into this one. Their contents are merged
+    // with the contents of '_sorter' when done() is called.
+    std::vector<std::unique_ptr<Sorter>> _mergedSorters;
+
     // Set to true if any document added to the BulkBuilder causes the index to become multikey.
     bool _isMultiKey = false;
 
@@ -544,12 +555,15 @@ std::unique_ptr<IndexAccessMethod::BulkBuilder> AbstractIndexAccessMethod::initi
 
 AbstractIndexAccessMethod::BulkBuilderImpl::BulkBuilderImpl(IndexCatalogEntry* index,
                                                             size_t maxMemoryUsageBytes)
-    : _indexCatalogEntry(index), _sorter(_makeSorter(maxMemoryUsageBytes)) {}
+    : _indexCatalogEntry(index),
+      _maxMemoryUsageBytes(maxMemoryUsageBytes),
+      _sorter(_makeSorter(maxMemoryUsageBytes)) {}
 
 AbstractIndexAccessMethod::BulkBuilderImpl::BulkBuilderImpl(IndexCatalogEntry* index,
                                                             size_t maxMemoryUsageBytes,
                                                             const IndexStateInfo& stateInfo)
     : _indexCatalogEntry(index),
+      _maxMemoryUsageBytes(maxMemoryUsageBytes),
       _sorter(_makeSorter(maxMemoryUsageBytes, stateInfo.getFileName(), stateInfo.getRanges())),
       _keysInserted(stateInfo.getNumKeys().value_or(0)),
       _isMultiKey(stateInfo.getIsMultikey()),
@@ -593,18 +607,7 @@ Status AbstractIndexAccessMethod::BulkBuilderImpl::insert(OperationContext* opCt
         return exceptionToStatus();
     }
 
-    if (!multikeyPaths->empty()) {
-        if (_indexMultikeyPaths.empty()) {
-            _indexMultikeyPaths = *multikeyPaths;
-        } else {
-            invariant(_indexMultikeyPaths.size() == multikeyPaths->size());
-            for (size_t i = 0; i < multikeyPaths->size(); ++i) {
-                _indexMultikeyPaths[i].insert(boost::container::ordered_unique_range_t(),
-                                              (*multikeyPaths)[i].begin(),
-                                              (*multikeyPaths)[i].end());
-            }
-        }
-    }
+    _mergeMultikeyPaths(*multikeyPaths);
 
     for (const auto& keyString : *keys) {
         _sorter->add(keyString, mongo::NullValue());
@@ -618,6 +621,41 @@ Status AbstractIndexAccessMethod::BulkBuilderImpl::insert(OperationContext* opCt
     return Status::OK();
 }
 
+void AbstractIndexAccessMethod::BulkBuilderImpl::merge(std::unique_ptr<BulkBuilder> other) {
+    auto otherImpl = checked_cast<BulkBuilderImpl*>(other.get());
+    invariant(otherImpl->_indexCatalogEntry == _indexCatalogEntry);
+
+    _keysInserted += otherImpl->_keysInserted;
+    _isMultiKey = _isMultiKey || otherImpl->_isMultiKey;
+    _mergeMultikeyPaths(otherImpl->_indexMultikeyPaths);
+    _multikeyMetadataKeys.insert(otherImpl->_multikeyMetadataKeys.begin(),
+                                 otherImpl->_multikeyMetadataKeys.end());
+
+    _mergedSorters.push_back(std::move(otherImpl->_sorter));
+    for (auto& sorter : otherImpl->_mergedSorters) {
+        _mergedSorters.push_back(std::move(sorter));
+    }
+}
+
+void AbstractIndexAccessMethod::BulkBuilderImpl::_mergeMultikeyPaths(
+    const MultikeyPaths& multikeyPaths) {
+    if (multikeyPaths.empty()) {
+        return;
+    }
+
+    if (_indexMultikeyPaths.empty()) {
+        _indexMultikeyPaths = multikeyPaths;
+        return;
+    }
+
+    invariant(_indexMultikeyPaths.size() == multikeyPaths.size());
+    for (size_t i = 0; i < multikeyPaths.size(); ++i) {
+        _indexMultikeyPaths[i].insert(boost::container::ordered_unique_range_t(),
+                                      multikeyPaths[i].begin(),
+                                      multikeyPaths[i].end());
+    }
+}
+
 const MultikeyPaths& AbstractIndexAccessMethod::BulkBuilderImpl::getMultikeyPaths() const {
     return _indexMultikeyPaths;
 }
@@ -629,7 +667,18 @@ bool AbstractIndexAccessMethod::BulkBuilderImpl::isMultikey() const {
 IndexAccessMethod::BulkBuilder::Sorter::Iterator*
 AbstractIndexAccessMethod::BulkBuilderImpl::done() {
     _insertMultikeyMetadataKeysIntoSorter();
-    return _sorter->done();
+    if (_mergedSorters.empty()) {
+        return _sorter->done();
+    }
+
+    std::vector<std::shared_ptr<Sorter::Iterator>> iters;
+    iters.reserve(_mergedSorters.size() + 1);
+    iters.emplace_back(_sorter->done());
+    for (auto& sorter : _mergedSorters) {
+        iters.emplace_back(sorter->done());
+    }
+    return Sorter::Iterator::merge(
+        iters, makeSortOptions(_maxMemoryUsageBytes), BtreeExternalSortComparison());
 }
 
 int64_t AbstractIndexAccessMethod::BulkBuilderImpl::getKeysInserted() const {
@@ -638,6 +687,9 @@ int64_t AbstractIndexAccessMethod::BulkBuilderImpl::getKeysInserted() const {
 
 AbstractIndexAccessMethod::BulkBuilder::Sorter::PersistedState
 AbstractIndexAccessMethod::BulkBuilderImpl::persistDataForShutdown() {
+    // The persisted state describes the ranges of a single Sorter file, so the sorted runs of
+    // merged BulkBuilders cannot be resumed from.
+    invariant(_mergedSorters.empty());
     _insertMultikeyMetadataKeysIntoSorter();
     return _sorter->persistDataForShutdown();
 }
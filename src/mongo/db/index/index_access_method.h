@@ -254,6 +254,14 @@ public:
          */
         virtual void addToSorter(const KeyString::Value& keyString) = 0;
 
+        /**
+         * Takes over the keys inserted into 'other', which must be a BulkBuilder of the same index
+         * on which done() has not been called. The sorted runs of both BulkBuilders are merged
+         * when done() is called on this BulkBuilder, so that the keys of several BulkBuilders
+         * filled concurrently are not sorted again.
+         */
+        virtual void merge(std::unique_ptr<BulkBuilder> other) = 0;
+
         virtual const MultikeyPaths& getMultikeyPaths() const = 0;
 
         virtual bool isMultikey() const = 0;
@@ -165,6 +165,41 @@ void BM_KeyGenArrayOfArray(benchmark::State& state, int32_t elements) {
     }
 }
 
+void BM_KeyGenCompoundArray(benchmark::State& state, int32_t elements) {
+    std::mt19937 gen(numGen());
+
+    // The index {x: 1, y: 1, a: 1} on documents whose last indexed field is an array, so that
+    // every generated key starts with the same elements for 'x' and 'y'.
+    BSONObjBuilder builder;
+    builder.append("x", std::string(100, 'x'));
+    builder.append("y", 1.5);
+    BSONArrayBuilder arrBuilder(builder.subarrayStart(kFieldName));
+    for (int32_t i = 0; i < elements; ++i) {
+        arrBuilder.append(static_cast<int32_t>(gen()));
+    }
+    arrBuilder.done();
+    BSONObj obj = builder.obj();
+
+    BtreeKeyGenerator generator({"x", "y", kFieldName},
+                                {BSONElement{}, BSONElement{}, BSONElement{}},
+                                false,
+                                nullptr,
+                                KeyString::Version::kLatestVersion,
+                                Ordering::make(BSON("x" << 1 << "y" << 1 << kFieldName << 1)));
+
+    SharedBufferFragmentBuilder allocator(kMemBlockSize,
+                                          SharedBufferFragmentBuilder::ConstantGrowStrategy());
+    KeyStringSet keys;
+    MultikeyPaths multikeyPaths;
+
+    for (auto _ : state) {
+        generator.getKeys(allocator, obj, false, &keys, &multikeyPaths);
+        benchmark::ClobberMemory();
+        keys.clear();
+        multikeyPaths.clear();
+    }
+}
+
 BENCHMARK_CAPTURE(BM_KeyGenBasic, Generic, false);
 BENCHMARK_CAPTURE(BM_KeyGenBasic, SkipMultikey, true);
 
@@ -176,6 +211,10 @@ BENCHMARK_CAPTURE(BM_KeyGenArrayZero, 1K, 1000);
 BENCHMARK_CAPTURE(BM_KeyGenArrayZero, 10K, 10000);
 BENCHMARK_CAPTURE(BM_KeyGenArrayZero, 100K, 100000);
 
+BENCHMARK_CAPTURE(BM_KeyGenCompoundArray, 10, 10);
+BENCHMARK_CAPTURE(BM_KeyGenCompoundArray, 1K, 1000);
+BENCHMARK_CAPTURE(BM_KeyGenCompoundArray, 100K, 100000);
+
 BENCHMARK_CAPTURE(BM_KeyGenArrayOfArray, 10x10, 10);
 BENCHMARK_CAPTURE(BM_KeyGenArrayOfArray, 100x100, 100);
 BENCHMARK_CAPTURE(BM_KeyGenArrayOfArray, 1Kx1K, 1000);
@@ -70,9 +70,12 @@ void SkippedRecordTracker::record(OperationContext* opCtx, const RecordId& recor
     auto toInsert = BSON(kRecordIdField << recordId.repr());
 
     // Lazily initialize table when we record the first document.
-    if (!_skippedRecordsTable) {
-        _skippedRecordsTable =
-            opCtx->getServiceContext()->getStorageEngine()->makeTemporaryRecordStore(opCtx);
+    {
+        stdx::lock_guard<Latch> lk(_initMutex);
+        if (!_skippedRecordsTable) {
+            _skippedRecordsTable =
+                opCtx->getServiceContext()->getStorageEngine()->makeTemporaryRecordStore(opCtx);
+        }
     }
     // A WriteUnitOfWork may not already be active if the originating operation was part of an
     // insert into the external sorter.
@@ -33,6 +33,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/temporary_record_store.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
 
 namespace mongo {
 
@@ -54,7 +55,8 @@ public:
     /**
      * Records a RecordId that was unable to be indexed due to a key generation error. At the
      * conclusion of the build, the key generation and insertion into the index should be attempted
-     * again by calling 'retrySkippedRecords'.
+     * again by calling 'retrySkippedRecords'. May be called concurrently by the workers of a
+     * parallel collection scan.
      */
     void record(OperationContext* opCtx, const RecordId& recordId);
 
@@ -88,6 +90,9 @@ private:
     // kept along with it with a call to finalizeTemporaryTable().
     std::unique_ptr<TemporaryRecordStore> _skippedRecordsTable;
 
+    // Serializes the lazy initialization of '_skippedRecordsTable' in record().
+    Mutex _initMutex = MONGO_MAKE_LATCH("SkippedRecordTracker::_initMutex");
+
     AtomicWord<std::uint32_t> _skippedRecordCounter{0};
 };
 
@@ -168,6 +168,8 @@ private:
  */
 class ComparisonMatchExpression : public ComparisonMatchExpressionBase {
 public:
+    using InputParamId = int32_t;
+
     /**
      * Returns true if the MatchExpression is a ComparisonMatchExpression.
      */
@@ -193,6 +195,22 @@ public:
     virtual ~ComparisonMatchExpression() = default;
 
     bool matchesSingleElement(const BSONElement&, MatchDetails* details = nullptr) const final;
+
+    /**
+     * Marks the right-hand side of this expression as an input parameter of a parameterized query.
+     * A plan built for such a query reads the value from a slot rather than embedding it as a
+     * constant, so the plan can be reused by queries which only differ in the value.
+     */
+    void setInputParamId(boost::optional<InputParamId> paramId) {
+        _inputParamId = paramId;
+    }
+
+    boost::optional<InputParamId> getInputParamId() const {
+        return _inputParamId;
+    }
+
+private:
+    boost::optional<InputParamId> _inputParamId;
 };
 
 class EqualityMatchExpression final : public ComparisonMatchExpression {
@@ -221,6 +239,7 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        e->setInputParamId(getInputParamId());
         return e;
     }
 
@@ -257,6 +276,7 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        e->setInputParamId(getInputParamId());
         return e;
     }
 
@@ -293,6 +313,7 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        e->setInputParamId(getInputParamId());
         return e;
     }
 
@@ -334,6 +355,7 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        e->setInputParamId(getInputParamId());
         return e;
     }
 
@@ -374,6 +396,7 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        e->setInputParamId(getInputParamId());
         return e;
     }
 
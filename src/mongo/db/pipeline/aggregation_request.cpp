@@ -250,6 +250,22 @@ StatusWith<AggregationRequest> AggregationRequest::parseFromBSON(
                                       << typeName(elem.type())};
             }
             request.setIsMapReduceCommand(elem.boolean());
+        } else if (fieldName == kDegreeOfParallelismName) {
+            if (!elem.isNumber()) {
+                return {ErrorCodes::TypeMismatch,
+                        str::stream() << kDegreeOfParallelismName << " must be a number, not a "
+                                      << typeName(elem.type())};
+            }
+
+            auto degreeOfParallelism = elem.safeNumberLong();
+            if (degreeOfParallelism < 1 ||
+                degreeOfParallelism > QueryRequest::kMaxDegreeOfParallelism) {
+                return {ErrorCodes::BadValue,
+                        str::stream() << kDegreeOfParallelismName << " must be between 1 and "
+                                      << QueryRequest::kMaxDegreeOfParallelism
+                                      << ", but received: " << degreeOfParallelism};
+            }
+            request.setDegreeOfParallelism(static_cast<int>(degreeOfParallelism));
         } else if (isMongocryptdArgument(fieldName)) {
             return {ErrorCodes::FailedToParse,
                     str::stream() << "unrecognized field '" << elem.fieldName()
@@ -355,6 +371,8 @@ Document AggregationRequest::serializeToCommandObj() const {
         {kLegacyRuntimeConstantsName,
          _legacyRuntimeConstants ? Value(_legacyRuntimeConstants->toBSON()) : Value()},
         {kIsMapReduceCommandName, _isMapReduceCommand ? Value(true) : Value()},
+        {kDegreeOfParallelismName,
+         _degreeOfParallelism ? Value(*_degreeOfParallelism) : Value()},
         {kLetName, !_letParameters.isEmpty() ? Value(_letParameters) : Value()},
         // Only serialize collection UUID if one was specified.
         {kCollectionUUIDName, _collectionUUID ? Value(*_collectionUUID) : Value()},
@@ -65,6 +65,7 @@ public:
     static constexpr StringData kLegacyRuntimeConstantsName = "runtimeConstants"_sd;
     static constexpr StringData kUse44SortKeysName = "use44SortKeys"_sd;
     static constexpr StringData kIsMapReduceCommandName = "isMapReduceCommand"_sd;
+    static constexpr StringData kDegreeOfParallelismName = "$_degreeOfParallelism"_sd;
     static constexpr StringData kLetName = "let"_sd;
     static constexpr StringData kCollectionUUIDName = "collectionUUID"_sd;
     static constexpr StringData kRequestReshardingResumeToken = "$_requestReshardingResumeToken"_sd;
@@ -233,6 +234,10 @@ public:
         return _isMapReduceCommand;
     }
 
+    boost::optional<int> getDegreeOfParallelism() const {
+        return _degreeOfParallelism;
+    }
+
     const auto& getCollectionUUID() const {
         return _collectionUUID;
     }
@@ -313,6 +318,10 @@ public:
         _isMapReduceCommand = isMapReduce;
     }
 
+    void setDegreeOfParallelism(boost::optional<int> degreeOfParallelism) {
+        _degreeOfParallelism = degreeOfParallelism;
+    }
+
     void setCollectionUUID(UUID collectionUUID) {
         _collectionUUID = std::move(collectionUUID);
     }
@@ -377,5 +386,8 @@ private:
 
     // True when an aggregation was invoked by the MapReduce command.
     bool _isMapReduceCommand = false;
+
+    // If set, overrides the default number of worker threads the aggregation may be executed with.
+    boost::optional<int> _degreeOfParallelism;
 };
 }  // namespace mongo
@@ -406,6 +406,33 @@ TEST(AggregationRequestTest, ShouldRejectNonBoolIsMapReduceCommand) {
     ASSERT_NOT_OK(AggregationRequest::parseFromBSON(nss, inputBson).getStatus());
 }
 
+TEST(AggregationRequestTest, ShouldParseDegreeOfParallelism) {
+    NamespaceString nss("a.collection");
+    const BSONObj inputBson =
+        fromjson("{pipeline: [{$match: {a: 'abc'}}], cursor: {}, $_degreeOfParallelism: 8}");
+    auto request = unittest::assertGet(AggregationRequest::parseFromBSON(nss, inputBson));
+    ASSERT(request.getDegreeOfParallelism());
+    ASSERT_EQ(*request.getDegreeOfParallelism(), 8);
+    ASSERT_VALUE_EQ(request.serializeToCommandObj()[AggregationRequest::kDegreeOfParallelismName],
+                    Value(8));
+}
+
+TEST(AggregationRequestTest, ShouldRejectInvalidDegreeOfParallelism) {
+    NamespaceString nss("a.collection");
+    ASSERT_NOT_OK(AggregationRequest::parseFromBSON(
+                      nss,
+                      fromjson("{pipeline: [], cursor: {}, $_degreeOfParallelism: 'abc'}"))
+                      .getStatus());
+    ASSERT_NOT_OK(
+        AggregationRequest::parseFromBSON(
+            nss, fromjson("{pipeline: [], cursor: {}, $_degreeOfParallelism: 0}"))
+            .getStatus());
+    ASSERT_NOT_OK(
+        AggregationRequest::parseFromBSON(
+            nss, fromjson("{pipeline: [], cursor: {}, $_degreeOfParallelism: 129}"))
+            .getStatus());
+}
+
 TEST(AggregationRequestTest, ShouldRejectNoCursorNoExplain) {
     NamespaceString nss("a.collection");
     const BSONObj inputBson = fromjson("{pipeline: [{$match: {a: 'abc'}}]}");
@@ -101,6 +101,22 @@ public:
     StringMap<boost::intrusive_ptr<Expression>> getIdFields() const;
     const std::vector<AccumulationStatement>& getAccumulatedFields() const;
 
+    /**
+     * Returns the field names of the _id when it is a document, in the order in which they were
+     * specified. Returns an empty vector if the _id is a single expression.
+     */
+    const std::vector<std::string>& getIdFieldNames() const {
+        return _idFieldNames;
+    }
+
+    /**
+     * Returns the expressions computing the _id. There is a single expression unless the _id is a
+     * document, in which case the expressions line up with 'getIdFieldNames()'.
+     */
+    const std::vector<boost::intrusive_ptr<Expression>>& getIdExpressions() const {
+        return _idExpressions;
+    }
+
     /**
      * Convenience method for creating a new $group stage. If maxMemoryUsageBytes is boost::none,
      * then it will actually use the value of internalDocumentSourceGroupMaxMemoryBytes.
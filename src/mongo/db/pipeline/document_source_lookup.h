@@ -159,6 +159,24 @@ public:
         return _localField;
     }
 
+    const FieldPath& getAsField() const {
+        return _as;
+    }
+
+    const NamespaceString& getResolvedNs() const {
+        return _resolvedNs;
+    }
+
+    /**
+     * Returns true if this stage is a plain 'localField/foreignField' equality join against a
+     * collection: it was not constructed with pipeline syntax, the foreign namespace is not a
+     * view, and it has not absorbed a subsequent $unwind or $match stage.
+     */
+    bool isSimpleEqualityJoin() const {
+        return !wasConstructedWithPipelineSyntax() && _resolvedPipeline.size() == 1 &&
+            !_unwindSrc && !_matchSrc && !_additionalFilter;
+    }
+
     const std::vector<LetVariable>& getLetVariables() const {
         return _letVariables;
     }
@@ -31,6 +31,7 @@
 
 #include <utility>
 
+#include "mongo/db/commands/test_commands_enabled.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/process_interface/stub_mongo_process_interface.h"
 #include "mongo/db/query/collation/collation_spec.h"
@@ -73,6 +74,12 @@ ExpressionContext::ExpressionContext(OperationContext* opCtx,
         // 'jsHeapLimitMB' limit.
         jsHeapLimitMB = boost::none;
     }
+
+    degreeOfParallelism = request.getDegreeOfParallelism();
+    uassert(ErrorCodes::InvalidOptions,
+            str::stream() << "The '" << AggregationRequest::kDegreeOfParallelismName
+                          << "' option is only supported when testing commands are enabled",
+            !degreeOfParallelism || getTestCommandsEnabled());
 }
 
 ExpressionContext::ExpressionContext(
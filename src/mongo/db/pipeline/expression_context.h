@@ -331,6 +331,11 @@ public:
     // 'jsHeapLimitMB' server parameter.
     boost::optional<int> jsHeapLimitMB;
 
+    // When set overrides the 'internalQueryDefaultDOP' server parameter, i.e. the number of worker
+    // threads the slot-based execution engine may use to run the parallelizable parts of a plan.
+    // Only accepted when testing commands are enabled.
+    boost::optional<int> degreeOfParallelism;
+
     // An interface for accessing information or performing operations that have different
     // implementations on mongod and mongos, or that only make sense on one of the two.
     // Additionally, putting some of this functionality behind an interface prevents aggregation
@@ -59,6 +59,7 @@
 #include "mongo/db/pipeline/document_source_geo_near.h"
 #include "mongo/db/pipeline/document_source_geo_near_cursor.h"
 #include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_lookup.h"
 #include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_sample.h"
 #include "mongo/db/pipeline/document_source_sample_from_random_cursor.h"
@@ -70,9 +71,11 @@
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_executor_factory.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/s/collection_sharding_state.h"
+#include "mongo/db/server_options.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/top.h"
 #include "mongo/db/storage/record_store.h"
@@ -198,7 +201,8 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
     boost::optional<std::string> groupIdForDistinctScan,
     const AggregationRequest* aggRequest,
     const size_t plannerOpts,
-    const MatchExpressionParser::AllowedFeatureSet& matcherFeatures) {
+    const MatchExpressionParser::AllowedFeatureSet& matcherFeatures,
+    std::vector<intrusive_ptr<DocumentSource>> pipelineForPushdown = {}) {
     auto qr = std::make_unique<QueryRequest>(nss);
     qr->setTailableMode(expCtx->tailableMode);
     qr->setFilter(queryObj);
@@ -237,6 +241,10 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
     // Mark the metadata that's requested by the pipeline on the CQ.
     cq.getValue()->requestAdditionalMetadata(metadataRequested);
 
+    // Attach the pipeline stages which should be executed by the query layer on top of the access
+    // plan, if any.
+    cq.getValue()->setPipeline(std::move(pipelineForPushdown));
+
     if (groupIdForDistinctScan) {
         // When the pipeline includes a $group that groups by a single field
         // (groupIdForDistinctScan), we use getExecutorDistinct() to attempt to get an executor that
@@ -269,6 +277,102 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
         expCtx->opCtx, &collection, std::move(cq.getValue()), permitYield, plannerOpts);
 }
 
+/**
+ * Returns true if 'expr' can be evaluated by the slot-based execution engine as part of a pushed
+ * down $group, that is if it is either a constant or a path into the document being grouped.
+ */
+bool isExpressionEligibleForGroupPushdown(const Expression* expr) {
+    if (dynamic_cast<const ExpressionConstant*>(expr)) {
+        return true;
+    }
+
+    auto fieldPathExpr = dynamic_cast<const ExpressionFieldPath*>(expr);
+    return fieldPathExpr && fieldPathExpr->isRootFieldPath() &&
+        fieldPathExpr->getFieldPath().getPathLength() > 1;
+}
+
+/**
+ * Returns the $group stage at the front of 'pipeline' if it can be pushed down into the query layer
+ * and executed by the slot-based execution engine, or nullptr otherwise.
+ */
+intrusive_ptr<DocumentSourceGroup> getGroupStageForPushdown(
+    const intrusive_ptr<ExpressionContext>& expCtx, Pipeline* pipeline, size_t plannerOpts) {
+    static const StringDataSet kSupportedAccumulators{
+        "$sum", "$avg", "$min", "$max", "$first", "$last", "$push", "$addToSet"};
+
+    if (!internalQueryEnableSlotBasedExecutionEngine.load() ||
+        !internalQuerySlotBasedExecutionGroupPushdown.load()) {
+        return nullptr;
+    }
+
+    // The pushed down $group produces final results, compares values without regard to a
+    // collation, and does not propagate the latest oplog timestamp.
+    if (expCtx->needsMerge || expCtx->getCollator() ||
+        expCtx->tailableMode != TailableModeEnum::kNormal ||
+        (plannerOpts & QueryPlannerParams::TRACK_LATEST_OPLOG_TS)) {
+        return nullptr;
+    }
+
+    auto groupStage = dynamic_cast<DocumentSourceGroup*>(pipeline->peekFront());
+    if (!groupStage || groupStage->doingMerge()) {
+        return nullptr;
+    }
+
+    for (auto&& idExpr : groupStage->getIdExpressions()) {
+        if (!isExpressionEligibleForGroupPushdown(idExpr.get())) {
+            return nullptr;
+        }
+    }
+
+    for (auto&& accStmt : groupStage->getAccumulatedFields()) {
+        if (!kSupportedAccumulators.count(accStmt.makeAccumulator()->getOpName()) ||
+            !isExpressionEligibleForGroupPushdown(accStmt.expr.argument.get())) {
+            return nullptr;
+        }
+    }
+
+    return groupStage;
+}
+
+/**
+ * Returns the $lookup stage at the front of 'pipeline' if it is an equality join which may be pushed
+ * down into the query layer and executed by the slot-based execution engine, or nullptr otherwise.
+ * Whether the join can actually be executed there, and with which strategy, is decided when the
+ * query solution is extended with it.
+ */
+intrusive_ptr<DocumentSourceLookUp> getLookupStageForPushdown(
+    const intrusive_ptr<ExpressionContext>& expCtx, Pipeline* pipeline, size_t plannerOpts) {
+    if (!internalQueryEnableSlotBasedExecutionEngine.load() ||
+        !internalQuerySlotBasedExecutionLookupPushdown.load()) {
+        return nullptr;
+    }
+
+    // The pushed down $lookup compares values without regard to a collation, runs against an
+    // unsharded foreign collection local to this node, and does not propagate the latest oplog
+    // timestamp.
+    if (expCtx->needsMerge || expCtx->getCollator() ||
+        serverGlobalParams.clusterRole != ClusterRole::None ||
+        expCtx->tailableMode != TailableModeEnum::kNormal ||
+        (plannerOpts & QueryPlannerParams::TRACK_LATEST_OPLOG_TS)) {
+        return nullptr;
+    }
+
+    auto lookupStage = dynamic_cast<DocumentSourceLookUp*>(pipeline->peekFront());
+    if (!lookupStage || !lookupStage->isSimpleEqualityJoin()) {
+        return nullptr;
+    }
+
+    // Only top-level fields are supported, so that neither side of the join has to traverse
+    // arrays nested along a dotted path.
+    if (lookupStage->getLocalField()->getPathLength() != 1 ||
+        lookupStage->getForeignField()->getPathLength() != 1 ||
+        lookupStage->getAsField().getPathLength() != 1) {
+        return nullptr;
+    }
+
+    return lookupStage;
+}
+
 /**
  * Examines the indexes in 'collection' and returns the field name of a geo-indexed field suitable
  * for use in $geoNear. 2d indexes are given priority over 2dsphere indexes.
@@ -774,6 +878,55 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
         }
     }
 
+    if (auto groupStage = getGroupStageForPushdown(expCtx, pipeline, plannerOpts)) {
+        // The $group is executed by the query layer, so the access plan must produce the documents
+        // with all fields the $group depends on, rather than just counting them.
+        auto swExecutorGrouped = attemptToGetExecutor(expCtx,
+                                                      collection,
+                                                      nss,
+                                                      queryObj,
+                                                      projObj,
+                                                      deps.metadataDeps(),
+                                                      sortObj,
+                                                      skipThenLimit,
+                                                      boost::none, /* groupIdForDistinctScan */
+                                                      aggRequest,
+                                                      plannerOpts & ~QueryPlannerParams::IS_COUNT,
+                                                      matcherFeatures,
+                                                      {groupStage});
+        if (swExecutorGrouped.isOK()) {
+            pipeline->popFrontWithName(DocumentSourceGroup::kStageName);
+            *hasNoRequirements = false;
+            return swExecutorGrouped;
+        }
+    }
+
+    if (auto lookupStage = getLookupStageForPushdown(expCtx, pipeline, plannerOpts)) {
+        // The local documents are joined by the query layer, so they must be produced in full
+        // rather than just counted.
+        auto swExecutorJoined = attemptToGetExecutor(expCtx,
+                                                     collection,
+                                                     nss,
+                                                     queryObj,
+                                                     projObj,
+                                                     deps.metadataDeps(),
+                                                     sortObj,
+                                                     skipThenLimit,
+                                                     boost::none, /* groupIdForDistinctScan */
+                                                     aggRequest,
+                                                     plannerOpts & ~QueryPlannerParams::IS_COUNT,
+                                                     matcherFeatures,
+                                                     {lookupStage});
+        if (swExecutorJoined.isOK()) {
+            pipeline->popFrontWithName(DocumentSourceLookUp::kStageName);
+            *hasNoRequirements = false;
+            return swExecutorJoined;
+        } else if (swExecutorJoined != ErrorCodes::NoQueryExecutionPlans) {
+            return swExecutorJoined.getStatus().withContext(
+                "Failed to determine whether the query system can execute the $lookup");
+        }
+    }
+
     return attemptToGetExecutor(expCtx,
                                 collection,
                                 nss,
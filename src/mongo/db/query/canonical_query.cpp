@@ -38,8 +38,10 @@
 #include "mongo/db/cst/cst_parser.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_array.h"
+#include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/query/canonical_query_encoder.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/indexability.h"
@@ -56,6 +58,42 @@ bool parsingCanProduceNoopMatchNodes(const ExtensionsCallback& extensionsCallbac
          allowedFeatures & MatchExpressionParser::AllowedFeatures::kJavascript);
 }
 
+/**
+ * Returns true if a comparison against 'elem' can be evaluated by a plan which reads the value
+ * from a slot. MinKey, MaxKey, null, undefined, NaN, regex and array values change either the
+ * generated predicate or the shape of the index bounds, and so are always embedded in the plan.
+ */
+bool isParameterizableValue(const BSONElement& elem) {
+    switch (elem.type()) {
+        case BSONType::MinKey:
+        case BSONType::MaxKey:
+        case BSONType::jstNULL:
+        case BSONType::Undefined:
+        case BSONType::RegEx:
+        case BSONType::Array:
+            return false;
+        case BSONType::NumberDouble:
+            return !std::isnan(elem.numberDouble());
+        case BSONType::NumberDecimal:
+            return !elem.numberDecimal().isNaN();
+        default:
+            return true;
+    }
+}
+
+void parameterizeMatchExpression(MatchExpression* expr,
+                                 ComparisonMatchExpression::InputParamId* nextParamId) {
+    if (ComparisonMatchExpression::isComparisonMatchExpression(expr)) {
+        auto comparison = static_cast<ComparisonMatchExpression*>(expr);
+        comparison->setInputParamId(isParameterizableValue(comparison->getData())
+                                        ? boost::make_optional((*nextParamId)++)
+                                        : boost::none);
+    }
+
+    for (size_t i = 0; i < expr->numChildren(); ++i) {
+        parameterizeMatchExpression(expr->getChild(i), nextParamId);
+    }
+}
 }  // namespace
 
 // static
@@ -106,6 +144,13 @@ StatusWith<std::unique_ptr<CanonicalQuery>> CanonicalQuery::canonicalize(
                                                       qr->nss(),
                                                       qr->getLegacyRuntimeConstants(),
                                                       qr->getLetParameters());
+        if (auto degreeOfParallelism = qr->getDegreeOfParallelism()) {
+            uassert(ErrorCodes::InvalidOptions,
+                    str::stream() << "The '" << QueryRequest::kDegreeOfParallelismField
+                                  << "' option is only supported when testing commands are enabled",
+                    getTestCommandsEnabled());
+            newExpCtx->degreeOfParallelism = static_cast<int>(*degreeOfParallelism);
+        }
     } else {
         newExpCtx = expCtx;
         // A collator can enter through both the QueryRequest and ExpressionContext arguments.
@@ -506,6 +551,20 @@ std::string CanonicalQuery::toStringShort() const {
     return ss;
 }
 
+CanonicalQuery::CanonicalQuery() = default;
+
+CanonicalQuery::~CanonicalQuery() = default;
+
+void CanonicalQuery::setPipeline(std::vector<boost::intrusive_ptr<DocumentSource>> pipeline) {
+    _pipeline = std::move(pipeline);
+}
+
+void CanonicalQuery::parameterize() {
+    ComparisonMatchExpression::InputParamId nextParamId = 0;
+    parameterizeMatchExpression(_root.get(), &nextParamId);
+    _isParameterized = true;
+}
+
 CanonicalQuery::QueryShapeString CanonicalQuery::encodeKey() const {
     return canonical_query_encoder::encode(*this);
 }
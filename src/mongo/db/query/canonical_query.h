@@ -43,6 +43,7 @@
 
 namespace mongo {
 
+class DocumentSource;
 class OperationContext;
 
 class CanonicalQuery {
@@ -216,9 +217,33 @@ public:
         return _expCtx.get();
     }
 
+    /**
+     * Sets the aggregation pipeline stages which have been pushed down into the query layer and
+     * must be executed on top of the access plan chosen for this query. The stages are expected
+     * to be supported by the slot-based execution engine.
+     */
+    void setPipeline(std::vector<boost::intrusive_ptr<DocumentSource>> pipeline);
+
+    const std::vector<boost::intrusive_ptr<DocumentSource>>& pipeline() const {
+        return _pipeline;
+    }
+
+    /**
+     * Marks the comparison predicates of this query whose values can be read from slots at runtime
+     * as input parameters. The plans built for a parameterized query can be kept in the plan cache
+     * and reused by queries of the same shape. See 'ComparisonMatchExpression::setInputParamId()'.
+     */
+    void parameterize();
+
+    bool isParameterized() const {
+        return _isParameterized;
+    }
+
+    ~CanonicalQuery();
+
 private:
     // You must go through canonicalize to create a CanonicalQuery.
-    CanonicalQuery() {}
+    CanonicalQuery();
 
     Status init(OperationContext* opCtx,
                 boost::intrusive_ptr<ExpressionContext> expCtx,
@@ -247,6 +272,12 @@ private:
     QueryMetadataBitSet _metadataDeps;
 
     bool _canHaveNoopMatchNodes = false;
+
+    // Pipeline stages pushed down from the aggregation layer, if any. See 'setPipeline()'.
+    std::vector<boost::intrusive_ptr<DocumentSource>> _pipeline;
+
+    // True if the input parameters of this query have been marked. See 'parameterize()'.
+    bool _isParameterized = false;
 };
 
 }  // namespace mongo
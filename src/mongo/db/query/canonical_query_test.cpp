@@ -29,6 +29,8 @@
 
 #include "mongo/db/query/canonical_query.h"
 
+#include <set>
+
 #include "mongo/db/json.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
@@ -390,6 +392,40 @@ TEST(CanonicalQueryTest, NorWithOneChildNormalizedAfterNormalizingChild) {
     ASSERT_EQ(MatchExpression::EQ, root->getChild(0)->matchType());
 }
 
+TEST(CanonicalQueryTest, ParameterizeAssignsInputParamIdsToComparisons) {
+    unique_ptr<CanonicalQuery> cq(
+        canonicalize("{a: 1, b: {$gt: 'x'}, c: null, d: [1, 2], e: {$lt: MinKey}, f: NaN}"));
+    ASSERT_FALSE(cq->isParameterized());
+    cq->parameterize();
+    ASSERT_TRUE(cq->isParameterized());
+
+    const MatchExpression* root = cq->root();
+    ASSERT_EQUALS(root->matchType(), MatchExpression::AND);
+    ASSERT_EQUALS(root->numChildren(), 6U);
+
+    std::set<ComparisonMatchExpression::InputParamId> paramIds;
+    for (size_t i = 0; i < root->numChildren(); ++i) {
+        auto child = root->getChild(i);
+        ASSERT_TRUE(ComparisonMatchExpression::isComparisonMatchExpression(child));
+        auto paramId = static_cast<const ComparisonMatchExpression*>(child)->getInputParamId();
+        if (child->path() == "a" || child->path() == "b") {
+            ASSERT_TRUE(paramId);
+            paramIds.insert(*paramId);
+        } else {
+            ASSERT_FALSE(paramId);
+        }
+    }
+    ASSERT_EQUALS(paramIds.size(), 2U);
+
+    // Clones of a parameterized filter keep their input parameters.
+    auto clone = root->shallowClone();
+    for (size_t i = 0; i < root->numChildren(); ++i) {
+        ASSERT_TRUE(
+            static_cast<const ComparisonMatchExpression*>(root->getChild(i))->getInputParamId() ==
+            static_cast<const ComparisonMatchExpression*>(clone->getChild(i))->getInputParamId());
+    }
+}
+
 void assertValidSortOrder(BSONObj sort, BSONObj filter = BSONObj{}) {
     QueryTestServiceContext serviceContext;
     auto opCtx = serviceContext.makeOperationContext();
@@ -42,6 +42,7 @@
 #include "mongo/db/exec/and_hash.h"
 #include "mongo/db/exec/and_sorted.h"
 #include "mongo/db/exec/collection_scan.h"
+#include "mongo/db/exec/column_scan.h"
 #include "mongo/db/exec/count_scan.h"
 #include "mongo/db/exec/distinct_scan.h"
 #include "mongo/db/exec/ensure_sorted.h"
@@ -90,6 +91,16 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
             return std::make_unique<CollectionScan>(
                 expCtx, _collection, params, _ws, csn->filter.get());
         }
+        case STAGE_COLUMN_SCAN: {
+            const ColumnScanNode* csn = static_cast<const ColumnScanNode*>(root);
+
+            invariant(_collection);
+            auto descriptor = _collection->getIndexCatalog()->findIndexByName(
+                _opCtx, csn->index.identifier.catalogName);
+            invariant(descriptor);
+            return std::make_unique<ColumnScanStage>(
+                expCtx, _collection, descriptor, csn->fields, _ws);
+        }
         case STAGE_IXSCAN: {
             const IndexScanNode* ixn = static_cast<const IndexScanNode*>(root);
 
@@ -381,6 +392,8 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
         case STAGE_CACHED_PLAN:
         case STAGE_COUNT:
         case STAGE_DELETE:
+        case STAGE_EQ_LOOKUP:
+        case STAGE_GROUP:
         case STAGE_IDHACK:
         case STAGE_MOCK:
         case STAGE_MULTI_ITERATOR:
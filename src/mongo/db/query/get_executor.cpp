@@ -34,12 +34,14 @@
 #include "mongo/db/query/get_executor.h"
 
 #include <boost/optional.hpp>
+#include <cmath>
 #include <limits>
 #include <memory>
 
 #include "mongo/base/error_codes.h"
 #include "mongo/base/parse_number.h"
 #include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/db_raii.h"
 #include "mongo/db/exec/cached_plan.h"
 #include "mongo/db/exec/collection_scan.h"
 #include "mongo/db/exec/count.h"
@@ -63,6 +65,8 @@
 #include "mongo/db/index_names.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
+#include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_lookup.h"
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/canonical_query_encoder.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
@@ -84,6 +88,7 @@
 #include "mongo/db/query/query_settings_decoration.h"
 #include "mongo/db/query/sbe_cached_solution_planner.h"
 #include "mongo/db/query/sbe_multi_planner.h"
+#include "mongo/db/query/sbe_plan_cache.h"
 #include "mongo/db/query/sbe_sub_planner.h"
 #include "mongo/db/query/stage_builder_util.h"
 #include "mongo/db/query/util/make_data_structure.h"
@@ -621,7 +626,7 @@ public:
                     }
 
                     return buildCachedPlan(
-                        std::move(querySolution), plannerParams, cs->decisionWorks);
+                        std::move(querySolution), plannerParams, planCacheKey, *cs);
                 }
             }
         }
@@ -714,7 +719,8 @@ protected:
      */
     virtual std::unique_ptr<ResultType> buildCachedPlan(std::unique_ptr<QuerySolution> solution,
                                                         const QueryPlannerParams& plannerParams,
-                                                        size_t decisionWorks) = 0;
+                                                        const PlanCacheKey& planCacheKey,
+                                                        const CachedSolution& cachedSolution) = 0;
 
     /**
      * Constructs a special PlanStage tree for rooted $or queries. Each clause of the $or is planned
@@ -757,7 +763,12 @@ public:
                                   CanonicalQuery* cq,
                                   PlanYieldPolicy* yieldPolicy,
                                   size_t plannerOptions)
-        : PrepareExecutionHelper{opCtx, collection, std::move(cq), yieldPolicy, plannerOptions},
+        : PrepareExecutionHelper{opCtx,
+                                 collection,
+                                 std::move(cq),
+                                 yieldPolicy,
+                                 // Only the classic engine can execute a COLUMN_SCAN stage.
+                                 plannerOptions | QueryPlannerParams::GENERATE_COLUMN_SCANS},
           _ws{ws} {}
 
 protected:
@@ -830,7 +841,8 @@ protected:
     std::unique_ptr<ClassicPrepareExecutionResult> buildCachedPlan(
         std::unique_ptr<QuerySolution> solution,
         const QueryPlannerParams& plannerParams,
-        size_t decisionWorks) final {
+        const PlanCacheKey& planCacheKey,
+        const CachedSolution& cachedSolution) final {
         auto result = makeResult();
         auto&& root = buildExecutableTree(*solution);
 
@@ -843,7 +855,7 @@ protected:
                                                           _ws,
                                                           _cq,
                                                           plannerParams,
-                                                          decisionWorks,
+                                                          cachedSolution.decisionWorks,
                                                           std::move(root)),
                         std::move(solution));
         return result;
@@ -914,14 +926,51 @@ protected:
         return nullptr;
     }
 
+    /**
+     * Builds the execution tree for a solution recovered from the plan cache. If the query has been
+     * parameterized, the tree is cloned from an SBE plan built for an earlier query of the same
+     * shape, when one is cached, instead of running the stage builder again. Otherwise the newly
+     * built tree is cached, if it can be reused by other queries.
+     */
+    std::pair<std::unique_ptr<sbe::PlanStage>, stage_builder::PlanStageData>
+    buildCachedExecutableTree(const QuerySolution& solution,
+                              const QueryPlannerParams& plannerParams,
+                              const PlanCacheKey& planCacheKey,
+                              const CachedSolution& cachedSolution) const {
+        auto sbeYieldPolicy = dynamic_cast<PlanYieldPolicySBE*>(_yieldPolicy);
+        if (!_cq->isParameterized() || !sbeYieldPolicy ||
+            internalQuerySlotBasedExecutionPlanCacheMaxEntriesPerCollection.load() == 0) {
+            return buildExecutableTree(solution);
+        }
+
+        auto planCache = CollectionQueryInfo::get(_collection).getPlanCache();
+        auto key = sbe::computeCachedPlanKey(
+            planCacheKey, cachedSolution, *_cq, plannerParams.options);
+        if (auto cachedPlan = planCache->getSbePlan(key)) {
+            if (auto execTree = sbe::cloneCachedPlan(
+                    _opCtx, _collection, *_cq, solution, *cachedPlan, sbeYieldPolicy)) {
+                return std::move(*execTree);
+            }
+        }
+
+        auto execTree = buildExecutableTree(solution);
+        if (auto cachedPlan =
+                sbe::makeCachedPlan(*_cq, solution, *execTree.first, execTree.second)) {
+            planCache->setSbePlan(key, std::move(cachedPlan));
+        }
+        return execTree;
+    }
+
     std::unique_ptr<SlotBasedPrepareExecutionResult> buildCachedPlan(
         std::unique_ptr<QuerySolution> solution,
         const QueryPlannerParams& plannerParams,
-        size_t decisionWorks) final {
+        const PlanCacheKey& planCacheKey,
+        const CachedSolution& cachedSolution) final {
         auto result = makeResult();
-        auto execTree = buildExecutableTree(*solution);
+        auto execTree = buildCachedExecutableTree(
+            *solution, plannerParams, planCacheKey, cachedSolution);
         result->emplace(std::move(execTree), std::move(solution));
-        result->setDecisionWorks(decisionWorks);
+        result->setDecisionWorks(cachedSolution.decisionWorks);
         return result;
     }
 
@@ -1046,6 +1095,119 @@ std::unique_ptr<PlanYieldPolicySBE> makeSbeYieldPolicy(
                                                 std::move(whileYieldingFn));
 }
 
+/**
+ * Returns an index of 'foreignColl' which can be probed with the local join keys of an equality
+ * $lookup on 'foreignField', or boost::none if there is no such index. The index must be a plain
+ * btree index leading with 'foreignField' which has an entry for every document and compares values
+ * with the simple collation.
+ */
+boost::optional<EqLookupNode::ForeignIndex> findForeignIndexForLookup(
+    OperationContext* opCtx, const CollectionPtr& foreignColl, StringData foreignField) {
+    auto it = foreignColl->getIndexCatalog()->getIndexIterator(opCtx, false);
+    while (it->more()) {
+        auto entry = it->next();
+        auto desc = entry->descriptor();
+        if (desc->getAccessMethodName() != IndexNames::BTREE || desc->isSparse() ||
+            desc->isPartial() || desc->hidden() || !desc->collation().isEmpty() ||
+            desc->keyPattern().firstElementFieldNameStringData() != foreignField) {
+            continue;
+        }
+
+        return EqLookupNode::ForeignIndex{
+            desc->indexName(),
+            desc->keyPattern(),
+            entry->accessMethod()->getSortedDataInterface()->getKeyStringVersion()};
+    }
+    return boost::none;
+}
+
+/**
+ * Chooses how the equality $lookup 'lookupStage', which has been pushed down into the query layer
+ * on top of the documents of 'collection', is executed. Returns the EqLookupNode to perform it, or
+ * nullptr if the foreign collection does not exist or the join cannot be executed within the memory
+ * limit.
+ *
+ * A hash join reads the foreign collection once and keeps it in memory, so it is only chosen when
+ * the foreign collection is estimated to fit within the memory limit, regardless of 'allowDiskUse'.
+ * An indexed loop join instead probes an index of the foreign collection once per local document.
+ * Both costs are estimated from the collection sizes and the cheaper strategy is picked.
+ */
+std::unique_ptr<EqLookupNode> planEqLookup(OperationContext* opCtx,
+                                           const CollectionPtr& collection,
+                                           const CanonicalQuery& cq,
+                                           const DocumentSourceLookUp& lookupStage) {
+    AutoGetCollectionForReadMaybeLockFree foreignColl(opCtx, lookupStage.getResolvedNs());
+    if (!foreignColl) {
+        return nullptr;
+    }
+
+    const auto foreignField = lookupStage.getForeignField()->fullPath();
+    auto foreignIndex = findForeignIndexForLookup(opCtx, foreignColl.getCollection(), foreignField);
+
+    double numLocalDocs = collection->numRecords(opCtx);
+    if (auto limit = cq.getQueryRequest().getLimit()) {
+        numLocalDocs = std::min(numLocalDocs, static_cast<double>(*limit));
+    }
+    const double numForeignDocs = foreignColl->numRecords(opCtx);
+    const bool foreignFitsInMemory = foreignColl->dataSize(opCtx) <=
+        static_cast<uint64_t>(internalQuerySlotBasedExecutionHashLookupMaxMemoryBytes.load());
+
+    const double hashJoinCost = numForeignDocs + numLocalDocs;
+    const double indexedLoopJoinCost = numLocalDocs * (1 + std::log2(numForeignDocs + 1));
+
+    EqLookupNode::LookupStrategy strategy;
+    if (foreignFitsInMemory && (!foreignIndex || hashJoinCost <= indexedLoopJoinCost)) {
+        strategy = EqLookupNode::LookupStrategy::kHashJoin;
+        foreignIndex = boost::none;
+    } else if (foreignIndex) {
+        strategy = EqLookupNode::LookupStrategy::kIndexedLoopJoin;
+    } else {
+        // Hash joining a foreign collection which does not fit in memory would spill all of it to
+        // disk, or fail without 'allowDiskUse', so leave the join to the classic $lookup.
+        return nullptr;
+    }
+
+    return std::make_unique<EqLookupNode>(lookupStage.getResolvedNs(),
+                                          foreignColl->uuid(),
+                                          lookupStage.getLocalField()->fullPath(),
+                                          foreignField,
+                                          lookupStage.getAsField().fullPath(),
+                                          strategy,
+                                          std::move(foreignIndex));
+}
+
+/**
+ * Places the aggregation pipeline stages which have been pushed down into the query layer on top of
+ * the access plan represented by 'solution'. Currently $group and equality $lookup can be pushed
+ * down. Returns an error if a pushed down stage cannot be executed by the query layer after all, in
+ * which case the caller is expected to run the stage in the aggregation pipeline instead.
+ */
+Status extendSolutionWithPipeline(OperationContext* opCtx,
+                                  const CollectionPtr& collection,
+                                  const CanonicalQuery& cq,
+                                  QuerySolution* solution) {
+    for (auto&& stage : cq.pipeline()) {
+        if (auto groupStage = dynamic_cast<DocumentSourceGroup*>(stage.get())) {
+            solution->extendWith(std::make_unique<GroupNode>(groupStage->getIdFieldNames(),
+                                                             groupStage->getIdExpressions(),
+                                                             groupStage->getAccumulatedFields()));
+            continue;
+        }
+
+        auto lookupStage = dynamic_cast<DocumentSourceLookUp*>(stage.get());
+        invariant(lookupStage);
+        auto lookupNode = planEqLookup(opCtx, collection, cq, *lookupStage);
+        if (!lookupNode) {
+            return {ErrorCodes::NoQueryExecutionPlans,
+                    str::stream() << "Cannot push down $lookup from "
+                                  << lookupStage->getResolvedNs().ns()
+                                  << " into the query layer"};
+        }
+        solution->extendWith(std::move(lookupNode));
+    }
+    return Status::OK();
+}
+
 StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getSlotBasedExecutor(
     OperationContext* opCtx,
     const CollectionPtr* collection,
@@ -1055,6 +1217,11 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getSlotBasedExe
     invariant(cq);
     auto nss = cq->nss();
     auto yieldPolicy = makeSbeYieldPolicy(opCtx, requestedYieldPolicy, nss);
+    if (internalQuerySlotBasedExecutionPlanCacheMaxEntriesPerCollection.load() > 0) {
+        // Hold the constants of the query in input parameters, so that the SBE plan built for it
+        // can be cached and reused by other queries of the same shape.
+        cq->parameterize();
+    }
     SlotBasedPrepareExecutionHelper helper{
         opCtx, *collection, cq.get(), yieldPolicy.get(), plannerOptions};
     auto executionResult = helper.prepare();
@@ -1076,13 +1243,34 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getSlotBasedExe
                                                   plannerOptions)) {
         // Do the runtime planning and pick the best candidate plan.
         auto candidates = planner->plan(std::move(solutions), std::move(roots));
-        return plan_executor_factory::make(opCtx,
-                                           std::move(cq),
-                                           std::move(candidates),
-                                           collection,
-                                           std::move(nss),
-                                           std::move(yieldPolicy));
+        if (cq->pipeline().empty()) {
+            return plan_executor_factory::make(opCtx,
+                                               std::move(cq),
+                                               std::move(candidates),
+                                               collection,
+                                               std::move(nss),
+                                               std::move(yieldPolicy));
+        }
+
+        // The pushed down pipeline stages must consume the full output of the access plan, so the
+        // results buffered during the trial run cannot be reused. Keep only the winning solution
+        // and rebuild the execution tree for it below.
+        solutions.clear();
+        solutions.push_back(std::move(candidates.winner().solution));
+        roots.clear();
+    }
+
+    if (!cq->pipeline().empty()) {
+        invariant(solutions.size() == 1);
+        auto status = extendSolutionWithPipeline(opCtx, *collection, *cq, solutions[0].get());
+        if (!status.isOK()) {
+            return status;
+        }
+        roots.clear();
+        roots.push_back(stage_builder::buildSlotBasedExecutableTree(
+            opCtx, *collection, *cq, *solutions[0], yieldPolicy.get()));
     }
+
     // No need for runtime planning, just use the constructed plan stage tree.
     invariant(roots.size() == 1);
     return plan_executor_factory::make(opCtx,
@@ -1101,7 +1289,8 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutor(
     std::unique_ptr<CanonicalQuery> canonicalQuery,
     PlanYieldPolicy::YieldPolicy yieldPolicy,
     size_t plannerOptions) {
-    return internalQueryEnableSlotBasedExecutionEngine.load()
+    // A query with pushed down pipeline stages can only be executed by the slot-based engine.
+    return internalQueryEnableSlotBasedExecutionEngine.load() || !canonicalQuery->pipeline().empty()
         ? getSlotBasedExecutor(
               opCtx, collection, std::move(canonicalQuery), yieldPolicy, plannerOptions)
         : getClassicExecutor(
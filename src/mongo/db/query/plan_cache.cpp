@@ -433,7 +433,9 @@ std::string SolutionCacheData::toString() const {
 
 PlanCache::PlanCache() : PlanCache(internalQueryCacheMaxEntriesPerCollection.load()) {}
 
-PlanCache::PlanCache(size_t size) : _cache(size) {}
+PlanCache::PlanCache(size_t size)
+    : _cache(size),
+      _sbePlans(internalQuerySlotBasedExecutionPlanCacheMaxEntriesPerCollection.load()) {}
 
 PlanCache::~PlanCache() {}
 
@@ -683,6 +685,26 @@ Status PlanCache::remove(const CanonicalQuery& canonicalQuery) {
 void PlanCache::clear() {
     stdx::lock_guard<Latch> cacheLock(_cacheMutex);
     _cache.clear();
+    _sbePlans.clear();
+}
+
+std::shared_ptr<const sbe::CachedSbePlan> PlanCache::getSbePlan(const std::string& key) const {
+    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    std::shared_ptr<const sbe::CachedSbePlan>* plan = nullptr;
+    if (!_sbePlans.get(key, &plan).isOK()) {
+        return nullptr;
+    }
+    invariant(plan);
+    return *plan;
+}
+
+void PlanCache::setSbePlan(const std::string& key, std::shared_ptr<const sbe::CachedSbePlan> plan) {
+    invariant(plan);
+
+    // Destroy the evicted plan, if any, outside of the mutex.
+    std::unique_ptr<std::shared_ptr<const sbe::CachedSbePlan>> evictedPlan;
+    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    evictedPlan = _sbePlans.add(key, new std::shared_ptr<const sbe::CachedSbePlan>(std::move(plan)));
 }
 
 PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
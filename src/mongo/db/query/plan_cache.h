@@ -44,6 +44,10 @@
 #include "mongo/util/container_size_helper.h"
 
 namespace mongo {
+namespace sbe {
+struct CachedSbePlan;
+}  // namespace sbe
+
 /**
  * Represents the "key" used in the PlanCache mapping from query shape -> query plan.
  */
@@ -587,6 +591,20 @@ public:
         const std::function<BSONObj(const PlanCacheEntry&)>& serializationFunc,
         const std::function<bool(const BSONObj&)>& filterFunc) const;
 
+    /**
+     * Returns the fully built SBE plan stored under 'key' with 'setSbePlan()', or nullptr if there
+     * is no such plan.
+     */
+    std::shared_ptr<const sbe::CachedSbePlan> getSbePlan(const std::string& key) const;
+
+    /**
+     * Stores a fully built SBE plan under 'key'. Unlike the cache entries, which map a query shape
+     * to the data needed to recreate a QuerySolution, these plans can be cloned and executed
+     * directly. The least recently used plan is evicted once the number of plans exceeds
+     * 'internalQuerySlotBasedExecutionPlanCacheMaxEntriesPerCollection'.
+     */
+    void setSbePlan(const std::string& key, std::shared_ptr<const sbe::CachedSbePlan> plan);
+
 private:
     struct NewEntryState {
         bool shouldBeCreated = false;
@@ -602,7 +620,10 @@ private:
 
     LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> _cache;
 
-    // Protects _cache.
+    // Fully built SBE plans, keyed by the strings computed with 'sbe::computeCachedPlanKey()'.
+    LRUKeyValue<std::string, std::shared_ptr<const sbe::CachedSbePlan>> _sbePlans;
+
+    // Protects _cache and _sbePlans.
     mutable Mutex _cacheMutex = MONGO_MAKE_LATCH("PlanCache::_cacheMutex");
 
     // Holds computed information about the collection's indexes.  Used for generating plan
@@ -63,7 +63,11 @@ void addStageSummaryStr(const PlanStage* stage, StringBuilder& sb) {
 
     // Some leaf nodes also provide info about the index they used.
     const SpecificStats* specific = stage->getSpecificStats();
-    if (STAGE_COUNT_SCAN == stage->stageType()) {
+    if (STAGE_COLUMN_SCAN == stage->stageType()) {
+        const ColumnScanStats* spec = static_cast<const ColumnScanStats*>(specific);
+        const KeyPattern keyPattern{spec->keyPattern};
+        sb << " " << keyPattern;
+    } else if (STAGE_COUNT_SCAN == stage->stageType()) {
         const CountScanStats* spec = static_cast<const CountScanStats*>(specific);
         const KeyPattern keyPattern{spec->keyPattern};
         sb << " " << keyPattern;
@@ -132,6 +136,9 @@ size_t getKeysExamined(StageType type, const SpecificStats* specific) {
     } else if (STAGE_IDHACK == type) {
         const IDHackStats* spec = static_cast<const IDHackStats*>(specific);
         return spec->keysExamined;
+    } else if (STAGE_COLUMN_SCAN == type) {
+        const ColumnScanStats* spec = static_cast<const ColumnScanStats*>(specific);
+        return spec->keysExamined;
     } else if (STAGE_COUNT_SCAN == type) {
         const CountScanStats* spec = static_cast<const CountScanStats*>(specific);
         return spec->keysExamined;
@@ -244,6 +251,16 @@ void statsToBSON(const PlanStageStats& stats,
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("docsExamined", spec->docsTested);
         }
+    } else if (STAGE_COLUMN_SCAN == stats.stageType) {
+        ColumnScanStats* spec = static_cast<ColumnScanStats*>(stats.specific.get());
+
+        if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
+            bob->appendNumber("keysExamined", spec->keysExamined);
+        }
+
+        bob->append("keyPattern", spec->keyPattern);
+        bob->append("indexName", spec->indexName);
+        bob->append("fields", spec->fields);
     } else if (STAGE_COUNT == stats.stageType) {
         CountStats* spec = static_cast<CountStats*>(stats.specific.get());
 
@@ -599,6 +616,10 @@ void PlanExplainerImpl::getSummaryStats(PlanSummaryStats* statsOut) const {
             const IndexScanStats* ixscanStats =
                 static_cast<const IndexScanStats*>(ixscan->getSpecificStats());
             statsOut->indexesUsed.insert(ixscanStats->indexName);
+        } else if (STAGE_COLUMN_SCAN == stages[i]->stageType()) {
+            const ColumnScanStats* columnScanStats =
+                static_cast<const ColumnScanStats*>(stages[i]->getSpecificStats());
+            statsOut->indexesUsed.insert(columnScanStats->indexName);
         } else if (STAGE_COUNT_SCAN == stages[i]->stageType()) {
             const CountScan* countScan = static_cast<const CountScan*>(stages[i]);
             const CountScanStats* countScanStats =
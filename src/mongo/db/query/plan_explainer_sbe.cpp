@@ -115,6 +115,42 @@ void statsToBSON(const QuerySolutionNode* node,
             }
             break;
         }
+        case STAGE_GROUP: {
+            auto gn = static_cast<const GroupNode*>(node);
+            if (gn->idFieldNames.empty()) {
+                gn->idExpressions[0]->serialize(false).addToBsonObj(bob, "_id"_sd);
+            } else {
+                BSONObjBuilder idBob(bob->subobjStart("_id"));
+                for (size_t idx = 0; idx < gn->idFieldNames.size(); ++idx) {
+                    gn->idExpressions[idx]->serialize(false).addToBsonObj(&idBob,
+                                                                          gn->idFieldNames[idx]);
+                }
+            }
+
+            BSONObjBuilder accsBob(bob->subobjStart("accumulators"));
+            for (auto&& acc : gn->accumulators) {
+                Value(acc.makeAccumulator()->serialize(
+                          acc.expr.initializer, acc.expr.argument, false))
+                    .addToBsonObj(&accsBob, acc.fieldName);
+            }
+            break;
+        }
+        case STAGE_EQ_LOOKUP: {
+            auto eln = static_cast<const EqLookupNode*>(node);
+            bob->append("from", eln->foreignCollection.coll());
+            bob->append("as", eln->joinField);
+            bob->append("localField", eln->joinFieldLocal);
+            bob->append("foreignField", eln->joinFieldForeign);
+            bob->append("strategy",
+                        eln->lookupStrategy == EqLookupNode::LookupStrategy::kHashJoin
+                            ? "HashJoin"
+                            : "IndexedLoopJoin");
+            if (eln->foreignIndex) {
+                bob->append("indexName", eln->foreignIndex->name);
+                bob->append("keyPattern", eln->foreignIndex->keyPattern);
+            }
+            break;
+        }
         case STAGE_LIMIT: {
             auto ln = static_cast<const LimitNode*>(node);
             bob->appendNumber("limitAmount", ln->limit);
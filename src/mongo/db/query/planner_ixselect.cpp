@@ -591,6 +591,10 @@ bool QueryPlannerIXSelect::_compatible(const BSONElement& keyPatternElt,
         return (exprtype == MatchExpression::TEXT);
     } else if (IndexNames::GEO_HAYSTACK == indexedFieldType) {
         return false;
+    } else if (IndexNames::COLUMN == indexedFieldType) {
+        // Columnstore indexes are ordered by RecordId rather than by value, so they cannot provide
+        // bounds for any predicate.
+        return false;
     } else {
         LOGV2_WARNING(20954,
                       "Unknown indexing for given node and field",
@@ -39,6 +39,7 @@
 #include "mongo/base/string_data.h"
 #include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/field_ref.h"
 #include "mongo/db/index/wildcard_key_generator.h"
 #include "mongo/db/index_names.h"
 #include "mongo/db/matcher/expression_algo.h"
@@ -179,6 +180,9 @@ string optionString(size_t options) {
             case QueryPlannerParams::ENUMERATE_OR_CHILDREN_LOCKSTEP:
                 ss << "ENUMERATE_OR_CHILDREN_LOCKSTEP ";
                 break;
+            case QueryPlannerParams::GENERATE_COLUMN_SCANS:
+                ss << "GENERATE_COLUMN_SCANS ";
+                break;
             case QueryPlannerParams::DEFAULT:
                 MONGO_UNREACHABLE;
                 break;
@@ -334,6 +338,67 @@ std::unique_ptr<QuerySolution> buildWholeIXSoln(const IndexEntry& index,
     return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
 }
 
+/**
+ * Returns a solution that answers 'query' by reading the columnstore index 'index' instead of the
+ * collection, or nullptr if the query may need a path that the index does not store. Only queries
+ * with an empty filter and an inclusion projection can be answered this way.
+ */
+std::unique_ptr<QuerySolution> buildColumnScanSoln(const IndexEntry& index,
+                                                   const CanonicalQuery& query,
+                                                   const QueryPlannerParams& params) {
+    invariant(index.type == IndexType::INDEX_COLUMN);
+    const auto& qr = query.getQueryRequest();
+    const auto* projection = query.getProj();
+    if (!query.getQueryObj().isEmpty() || !projection || qr.returnKey() ||
+        projection->type() != projection_ast::ProjectType::kInclusion ||
+        projection->requiresDocument()) {
+        return nullptr;
+    }
+
+    // Collect every path that the stages above the scan read: the projection, the sort and, on a
+    // sharded collection, the shard key.
+    std::vector<std::string> requiredPaths = projection->getRequiredFields();
+    for (auto&& sortElem : qr.getSort()) {
+        if (!sortElem.isNumber()) {
+            return nullptr;
+        }
+        requiredPaths.push_back(sortElem.fieldName());
+    }
+    if (params.options & QueryPlannerParams::INCLUDE_SHARD_FILTER) {
+        for (auto&& shardKeyElem : params.shardKey) {
+            requiredPaths.push_back(shardKeyElem.fieldName());
+        }
+    }
+
+    // Each required path must lie within one of the columns. Only those columns are read.
+    std::vector<bool> columnIsRead(index.keyPattern.nFields(), false);
+    for (auto&& path : requiredPaths) {
+        const FieldRef pathRef(path);
+        size_t column = 0;
+        for (auto&& keyElem : index.keyPattern) {
+            if (FieldRef(keyElem.fieldNameStringData()).isPrefixOfOrEqualTo(pathRef)) {
+                break;
+            }
+            ++column;
+        }
+        if (column == columnIsRead.size()) {
+            return nullptr;
+        }
+        columnIsRead[column] = true;
+    }
+
+    std::vector<std::string> fields;
+    size_t column = 0;
+    for (auto&& keyElem : index.keyPattern) {
+        if (columnIsRead[column++]) {
+            fields.push_back(keyElem.fieldName());
+        }
+    }
+
+    auto solnRoot = std::make_unique<ColumnScanNode>(index, std::move(fields));
+    return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
+}
+
 bool providesSort(const CanonicalQuery& query, const BSONObj& kp) {
     return query.getQueryRequest().getSort().isPrefixOf(kp, SimpleBSONElementComparator::kInstance);
 }
@@ -945,6 +1010,21 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
                 ErrorCodes::NoQueryExecutionPlans,
                 "$hint: refusing to build whole-index solution, because it's a wildcard index");
         }
+        if (relevantIndices.front().type == IndexType::INDEX_COLUMN) {
+            // A columnstore index has no documents to fetch, so it can only be scanned by column.
+            auto soln = (params.options & QueryPlannerParams::GENERATE_COLUMN_SCANS)
+                ? buildColumnScanSoln(relevantIndices.front(), query, params)
+                : nullptr;
+            if (!soln) {
+                return Status(ErrorCodes::NoQueryExecutionPlans,
+                              "$hint: a columnstore index can only answer a query with an empty "
+                              "filter whose projection and sort read indexed paths");
+            }
+            LOGV2_DEBUG(5130006, 5, "Planner: outputting soln that uses hinted columnstore index");
+            std::vector<std::unique_ptr<QuerySolution>> out;
+            out.push_back(std::move(soln));
+            return {std::move(out)};
+        }
         // Return hinted index solution if found.
         auto soln = buildWholeIXSoln(relevantIndices.front(), query, params);
         if (!soln) {
@@ -1082,6 +1162,22 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         }
     }
 
+    // A columnstore index can stand in for the collection scan if it stores every path that the
+    // query reads. Such solutions are not cached, since they have no index tags to replay.
+    if (params.options & QueryPlannerParams::GENERATE_COLUMN_SCANS && out.size() == 0) {
+        for (auto&& index : fullIndexList) {
+            if (index.type != INDEX_COLUMN) {
+                continue;
+            }
+
+            if (auto soln = buildColumnScanSoln(index, query, params)) {
+                LOGV2_DEBUG(5130007, 5, "Planner: outputting soln that uses columnstore index");
+                out.push_back(std::move(soln));
+                break;
+            }
+        }
+    }
+
     // The caller can explicitly ask for a collscan.
     bool collscanRequested = (params.options & QueryPlannerParams::INCLUDE_COLLSCAN);
 
@@ -0,0 +1,189 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_planner_test_fixture.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * A specialization of the QueryPlannerTest fixture which lets the planner answer queries from a
+ * columnstore index.
+ */
+class QueryPlannerColumnstoreTest : public QueryPlannerTest {
+protected:
+    void setUp() final {
+        QueryPlannerTest::setUp();
+
+        // A column scan only replaces a collection scan that the planner would otherwise have to
+        // generate, so don't request one.
+        params.options &= ~QueryPlannerParams::INCLUDE_COLLSCAN;
+        params.options |= QueryPlannerParams::GENERATE_COLUMN_SCANS;
+    }
+
+    void addColumnstoreIndex(BSONObj keyPattern) {
+        params.indices.push_back({std::move(keyPattern),
+                                  IndexType::INDEX_COLUMN,
+                                  IndexDescriptor::kLatestIndexVersion,
+                                  false,  // multikey
+                                  {},     // multikeyPaths
+                                  {},     // multikeyPathSet
+                                  false,  // sparse
+                                  false,  // unique
+                                  IndexEntry::Identifier{"columnstore"},
+                                  nullptr,  // filterExpr
+                                  BSONObj(),
+                                  nullptr,
+                                  nullptr});
+    }
+};
+
+TEST_F(QueryPlannerColumnstoreTest, ReadsOnlyTheColumnsOfTheProjection) {
+    addColumnstoreIndex(BSON("a"
+                             << "columnstore"
+                             << "b"
+                             << "columnstore"
+                             << "c"
+                             << "columnstore"));
+
+    runQuerySortProj(BSONObj(), BSONObj(), fromjson("{_id: 0, c: 1, a: 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, c: 1, a: 1}, node: {column: {name: 'columnstore', "
+        "fields: ['a', 'c']}}}}");
+}
+
+TEST_F(QueryPlannerColumnstoreTest, ReadsTheColumnOfAPrefixOfAProjectedPath) {
+    addColumnstoreIndex(BSON("a"
+                             << "columnstore"));
+
+    runQuerySortProj(BSONObj(), BSONObj(), fromjson("{_id: 0, 'a.b': 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{proj: {spec: {_id: 0, 'a.b': 1}, node: {column: {fields: ['a']}}}}");
+}
+
+TEST_F(QueryPlannerColumnstoreTest, SortsOnAnIndexedPath) {
+    addColumnstoreIndex(BSON("a"
+                             << "columnstore"
+                             << "b"
+                             << "columnstore"));
+
+    runQuerySortProj(BSONObj(), fromjson("{b: 1}"), fromjson("{_id: 0, a: 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: {sort: {pattern: {b: 1}, limit: 0, node: "
+        "{column: {fields: ['a', 'b']}}}}}}");
+}
+
+TEST_F(QueryPlannerColumnstoreTest, ReadsTheShardKeyToFilterOrphans) {
+    addColumnstoreIndex(BSON("a"
+                             << "columnstore"
+                             << "s"
+                             << "columnstore"));
+    params.options |= QueryPlannerParams::INCLUDE_SHARD_FILTER;
+    params.shardKey = BSON("s" << 1);
+
+    runQuerySortProj(BSONObj(), BSONObj(), fromjson("{_id: 0, a: 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: {sharding_filter: {node: "
+        "{column: {fields: ['a', 's']}}}}}}");
+}
+
+TEST_F(QueryPlannerColumnstoreTest, FallsBackToACollectionScanWithoutAProjection) {
+    addColumnstoreIndex(BSON("a"
+                             << "columnstore"));
+
+    runQuery(BSONObj());
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
+TEST_F(QueryPlannerColumnstoreTest, FallsBackToACollectionScanWithAFilter) {
+    addColumnstoreIndex(BSON("a"
+                             << "columnstore"));
+
+    runQuerySortProj(fromjson("{a: 1}"), BSONObj(), fromjson("{_id: 0, a: 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{proj: {spec: {_id: 0, a: 1}, node: {cscan: {dir: 1}}}}");
+}
+
+TEST_F(QueryPlannerColumnstoreTest, FallsBackToACollectionScanForAnUnindexedPath) {
+    addColumnstoreIndex(BSON("a"
+                             << "columnstore"));
+
+    // The projection includes _id, which the index does not store.
+    runQuerySortProj(BSONObj(), BSONObj(), fromjson("{a: 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{proj: {spec: {a: 1}, node: {cscan: {dir: 1}}}}");
+}
+
+TEST_F(QueryPlannerColumnstoreTest, DoesNotGenerateColumnScansUnlessAsked) {
+    params.options &= ~QueryPlannerParams::GENERATE_COLUMN_SCANS;
+    addColumnstoreIndex(BSON("a"
+                             << "columnstore"));
+
+    runQuerySortProj(BSONObj(), BSONObj(), fromjson("{_id: 0, a: 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{proj: {spec: {_id: 0, a: 1}, node: {cscan: {dir: 1}}}}");
+}
+
+TEST_F(QueryPlannerColumnstoreTest, HintedIndexIsScannedByColumn) {
+    addColumnstoreIndex(BSON("a"
+                             << "columnstore"));
+
+    runQuerySortProjSkipNToReturnHint(BSONObj(),
+                                      BSONObj(),
+                                      fromjson("{_id: 0, a: 1}"),
+                                      0,
+                                      0,
+                                      BSON("a"
+                                           << "columnstore"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{proj: {spec: {_id: 0, a: 1}, node: {column: {fields: ['a']}}}}");
+}
+
+TEST_F(QueryPlannerColumnstoreTest, HintedIndexThatCannotAnswerTheQueryFails) {
+    addColumnstoreIndex(BSON("a"
+                             << "columnstore"));
+
+    runInvalidQueryHint(BSONObj(),
+                        BSON("a"
+                             << "columnstore"));
+    runInvalidQueryHint(fromjson("{a: 1}"),
+                        BSON("a"
+                             << "columnstore"));
+}
+
+}  // namespace
+}  // namespace mongo
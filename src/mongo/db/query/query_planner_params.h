@@ -118,6 +118,11 @@ struct QueryPlannerParams {
         // is thought to be helpful in general, but particularly in cases where all children of the
         // $or use the same fields and have the same indexes available, as in this example.
         ENUMERATE_OR_CHILDREN_LOCKSTEP = 1 << 12,
+
+        // Set this to let the planner answer a query from a columnstore index instead of scanning
+        // the collection, when the query only reads paths stored by the index. Only the classic
+        // execution engine can run the resulting COLUMN_SCAN stage.
+        GENERATE_COLUMN_SCANS = 1 << 13,
     };
 
     // See Options enum above.
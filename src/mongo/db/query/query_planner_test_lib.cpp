@@ -352,6 +352,40 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
         }
 
         return filterMatches(filter.Obj(), collation, trueSoln);
+    } else if (STAGE_COLUMN_SCAN == trueSoln->getType()) {
+        const ColumnScanNode* csn = static_cast<const ColumnScanNode*>(trueSoln);
+        BSONElement el = testSoln["column"];
+        if (el.eoo() || !el.isABSONObj()) {
+            return false;
+        }
+        BSONObj columnObj = el.Obj();
+        invariant(bsonObjFieldsAreInSet(columnObj, {"name", "fields"}));
+
+        BSONElement name = columnObj["name"];
+        if (!name.eoo()) {
+            if (name.type() != BSONType::String) {
+                return false;
+            }
+            if (name.valueStringData() != csn->index.identifier.catalogName) {
+                return false;
+            }
+        }
+
+        BSONElement fields = columnObj["fields"];
+        if (fields.eoo()) {
+            return true;
+        }
+        if (fields.type() != BSONType::Array) {
+            return false;
+        }
+        std::vector<std::string> expectedFields;
+        for (auto&& field : fields.Obj()) {
+            if (field.type() != BSONType::String) {
+                return false;
+            }
+            expectedFields.push_back(field.str());
+        }
+        return expectedFields == csn->fields;
     } else if (STAGE_GEO_NEAR_2D == trueSoln->getType()) {
         const GeoNear2DNode* node = static_cast<const GeoNear2DNode*>(trueSoln);
         BSONElement el = testSoln["geoNear2d"];
@@ -350,6 +350,15 @@ StatusWith<std::unique_ptr<QueryRequest>> QueryRequest::parseFromFindCommand(
                 return status;
             }
             qr->_requestResumeToken = el.boolean();
+        } else if (fieldName == kDegreeOfParallelismField) {
+            if (!el.isNumber()) {
+                str::stream ss;
+                ss << "Failed to parse: " << cmdObj.toString() << ". "
+                   << "'" << kDegreeOfParallelismField << "' field must be numeric.";
+                return Status(ErrorCodes::FailedToParse, ss);
+            }
+
+            qr->_degreeOfParallelism = el.numberLong();
         } else if (fieldName == kUse44SortKeys) {
             Status status = checkFieldType(el, Bool);
             if (!status.isOK()) {
@@ -545,6 +554,10 @@ void QueryRequest::asFindCommandInternal(BSONObjBuilder* cmdBuilder) const {
     if (!_resumeAfter.isEmpty()) {
         cmdBuilder->append(kResumeAfterField, _resumeAfter);
     }
+
+    if (_degreeOfParallelism) {
+        cmdBuilder->append(kDegreeOfParallelismField, *_degreeOfParallelism);
+    }
 }
 
 void QueryRequest::addShowRecordIdMetaProj() {
@@ -590,6 +603,14 @@ Status QueryRequest::validate() const {
                           << "BatchSize value must be non-negative, but received: " << *_batchSize);
     }
 
+    if (_degreeOfParallelism &&
+        (*_degreeOfParallelism < 1 || *_degreeOfParallelism > kMaxDegreeOfParallelism)) {
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << kDegreeOfParallelismField << " must be between 1 and "
+                                    << kMaxDegreeOfParallelism
+                                    << ", but received: " << *_degreeOfParallelism);
+    }
+
     if (_ntoreturn && *_ntoreturn < 0) {
         return Status(ErrorCodes::BadValue,
                       str::stream()
@@ -1062,6 +1083,9 @@ StatusWith<BSONObj> QueryRequest::asAggregationCommand() const {
     if (_allowDiskUse) {
         aggregationBuilder.append(QueryRequest::kAllowDiskUseField, _allowDiskUse);
     }
+    if (_degreeOfParallelism) {
+        aggregationBuilder.append(QueryRequest::kDegreeOfParallelismField, *_degreeOfParallelism);
+    }
     if (_legacyRuntimeConstants) {
         BSONObjBuilder rtcBuilder(aggregationBuilder.subobjStart(kLegacyRuntimeConstantsField));
         _legacyRuntimeConstants->serialize(&rtcBuilder);
@@ -80,6 +80,7 @@ public:
     static constexpr auto kAllowSpeculativeMajorityReadField = "allowSpeculativeMajorityRead";
     static constexpr auto kRequestResumeTokenField = "$_requestResumeToken";
     static constexpr auto kResumeAfterField = "$_resumeAfter";
+    static constexpr auto kDegreeOfParallelismField = "$_degreeOfParallelism";
     static constexpr auto kUse44SortKeys = "_use44SortKeys";
     static constexpr auto kMaxTimeMSOpOnlyField = "maxTimeMSOpOnly";
 
@@ -87,6 +88,9 @@ public:
     static constexpr auto kNaturalSortField = "$natural";
 
     static constexpr auto kFindCommandName = "find";
+
+    // The upper bound of the degree of parallelism a query may request.
+    static constexpr int kMaxDegreeOfParallelism = 128;
     static constexpr auto kShardVersionField = "shardVersion";
 
     explicit QueryRequest(NamespaceStringOrUUID nss);
@@ -461,6 +465,14 @@ public:
         return _resumeAfter;
     }
 
+    boost::optional<long long> getDegreeOfParallelism() const {
+        return _degreeOfParallelism;
+    }
+
+    void setDegreeOfParallelism(boost::optional<long long> degreeOfParallelism) {
+        _degreeOfParallelism = degreeOfParallelism;
+    }
+
     void setResumeAfter(BSONObj resumeAfter) {
         _resumeAfter = resumeAfter;
     }
@@ -550,6 +562,8 @@ private:
     // If non-empty, instructs the query to resume from the RecordId given by the object's $recordId
     // field.
     BSONObj _resumeAfter;
+    // If set, overrides the default number of worker threads the query may be executed with.
+    boost::optional<long long> _degreeOfParallelism;
 
     bool _wantMore = true;
 
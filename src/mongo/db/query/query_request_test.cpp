@@ -944,6 +944,28 @@ TEST(QueryRequestTest, ParseFromCommandBatchSizeZero) {
     ASSERT(!qr->getLimit());
 }
 
+TEST(QueryRequestTest, ParseFromCommandDegreeOfParallelism) {
+    BSONObj cmdObj = fromjson("{find: 'testns', $_degreeOfParallelism: 4}");
+    const NamespaceString nss("test.testns");
+    bool isExplain = false;
+    unique_ptr<QueryRequest> qr(
+        assertGet(QueryRequest::makeFromFindCommand(nss, cmdObj, isExplain)));
+
+    ASSERT(qr->getDegreeOfParallelism());
+    ASSERT_EQ(4, *qr->getDegreeOfParallelism());
+}
+
+TEST(QueryRequestTest, ParseFromCommandDegreeOfParallelismOutOfRangeError) {
+    const NamespaceString nss("test.testns");
+    bool isExplain = false;
+    ASSERT_NOT_OK(QueryRequest::makeFromFindCommand(
+                      nss, fromjson("{find: 'testns', $_degreeOfParallelism: 0}"), isExplain)
+                      .getStatus());
+    ASSERT_NOT_OK(QueryRequest::makeFromFindCommand(
+                      nss, fromjson("{find: 'testns', $_degreeOfParallelism: 129}"), isExplain)
+                      .getStatus());
+}
+
 TEST(QueryRequestTest, ParseFromCommandDefaultBatchSize) {
     BSONObj cmdObj = fromjson("{find: 'testns'}");
     const NamespaceString nss("test.testns");
@@ -167,6 +167,14 @@ void QuerySolution::setRoot(std::unique_ptr<QuerySolutionNode> root) {
     assignNodeIds(idGenerator, *_root);
 }
 
+void QuerySolution::extendWith(std::unique_ptr<QuerySolutionNode> extensionRoot) {
+    invariant(_root);
+    invariant(extensionRoot->children.empty());
+
+    extensionRoot->children.push_back(_root.release());
+    setRoot(std::move(extensionRoot));
+}
+
 //
 // TextNode
 //
@@ -260,6 +268,37 @@ QuerySolutionNode* VirtualScanNode::clone() const {
     return copy;
 }
 
+//
+// ColumnScanNode
+//
+
+void ColumnScanNode::appendToString(str::stream* ss, int indent) const {
+    addIndent(ss, indent);
+    *ss << "COLUMN_SCAN\n";
+    addIndent(ss, indent + 1);
+    *ss << "name = " << index.identifier.catalogName << '\n';
+    addIndent(ss, indent + 1);
+    *ss << "fields = [" << boost::algorithm::join(fields, ", ") << "]\n";
+    addCommon(ss, indent);
+}
+
+FieldAvailability ColumnScanNode::getFieldAvailability(const std::string& field) const {
+    // A column holds everything under its path, so it also provides the paths below it.
+    const FieldRef fieldRef(field);
+    for (auto&& path : fields) {
+        if (FieldRef(path).isPrefixOfOrEqualTo(fieldRef)) {
+            return FieldAvailability::kFullyProvided;
+        }
+    }
+    return FieldAvailability::kNotProvided;
+}
+
+QuerySolutionNode* ColumnScanNode::clone() const {
+    auto copy = new ColumnScanNode(this->index, this->fields);
+    cloneBaseData(copy);
+    return copy;
+}
+
 //
 // AndHashNode
 //
@@ -1349,6 +1388,85 @@ QuerySolutionNode* EnsureSortedNode::clone() const {
     return copy;
 }
 
+//
+// GroupNode
+//
+
+void GroupNode::appendToString(str::stream* ss, int indent) const {
+    addIndent(ss, indent);
+    *ss << "GROUP\n";
+    addIndent(ss, indent + 1);
+    *ss << "key = {";
+    for (size_t idx = 0; idx < idExpressions.size(); ++idx) {
+        if (idx > 0) {
+            *ss << ", ";
+        }
+        *ss << (idFieldNames.empty() ? "_id" : idFieldNames[idx]) << ": "
+            << idExpressions[idx]->serialize(false).toString();
+    }
+    *ss << "}\n";
+    addIndent(ss, indent + 1);
+    *ss << "accs = [";
+    for (size_t idx = 0; idx < accumulators.size(); ++idx) {
+        if (idx > 0) {
+            *ss << ", ";
+        }
+        *ss << accumulators[idx].fieldName << ": "
+            << accumulators[idx].expr.argument->serialize(false).toString();
+    }
+    *ss << "]\n";
+    addCommon(ss, indent);
+    addIndent(ss, indent + 1);
+    *ss << "Child:" << '\n';
+    children[0]->appendToString(ss, indent + 2);
+}
+
+QuerySolutionNode* GroupNode::clone() const {
+    auto copy = new GroupNode(idFieldNames, idExpressions, accumulators);
+    cloneBaseData(copy);
+    return copy;
+}
+
+//
+// EqLookupNode
+//
+
+void EqLookupNode::appendToString(str::stream* ss, int indent) const {
+    addIndent(ss, indent);
+    *ss << "EQ_LOOKUP\n";
+    addIndent(ss, indent + 1);
+    *ss << "from = " << foreignCollection.toString() << '\n';
+    addIndent(ss, indent + 1);
+    *ss << "localField = " << joinFieldLocal << '\n';
+    addIndent(ss, indent + 1);
+    *ss << "foreignField = " << joinFieldForeign << '\n';
+    addIndent(ss, indent + 1);
+    *ss << "as = " << joinField << '\n';
+    addIndent(ss, indent + 1);
+    *ss << "strategy = "
+        << (lookupStrategy == LookupStrategy::kHashJoin ? "HashJoin" : "IndexedLoopJoin") << '\n';
+    if (foreignIndex) {
+        addIndent(ss, indent + 1);
+        *ss << "index = " << foreignIndex->name << '\n';
+    }
+    addCommon(ss, indent);
+    addIndent(ss, indent + 1);
+    *ss << "Child:" << '\n';
+    children[0]->appendToString(ss, indent + 2);
+}
+
+QuerySolutionNode* EqLookupNode::clone() const {
+    auto copy = new EqLookupNode(foreignCollection,
+                                 foreignCollectionUuid,
+                                 joinFieldLocal,
+                                 joinFieldForeign,
+                                 joinField,
+                                 lookupStrategy,
+                                 foreignIndex);
+    cloneBaseData(copy);
+    return copy;
+}
+
 //
 // EofNode
 //
@@ -36,11 +36,15 @@
 #include "mongo/db/fts/fts_query.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/query/index_bounds.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_enumerator_explain_info.h"
 #include "mongo/db/query/stage_types.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/util/id_generator.h"
+#include "mongo/util/uuid.h"
 
 namespace mongo {
 
@@ -362,6 +366,13 @@ public:
      */
     void setRoot(std::unique_ptr<QuerySolutionNode> root);
 
+    /**
+     * Places 'extensionRoot' on top of the current root of this QuerySolution, so that the current
+     * root becomes the only child of 'extensionRoot'. The 'extensionRoot' must not have any
+     * children. Node ids are reassigned for the whole tree.
+     */
+    void extendWith(std::unique_ptr<QuerySolutionNode> extensionRoot);
+
     // Any filters in root or below point into this object.  Must be owned.
     BSONObj filterData;
 
@@ -545,6 +556,40 @@ struct VirtualScanNode : public QuerySolutionNodeWithSortSet {
     bool hasRecordId;
 };
 
+/**
+ * A ColumnScanNode reads some of the columns of a columnstore index side by side and outputs, for
+ * every document in the collection, an object holding only the top-level fields that those columns
+ * store. It replaces a collection scan when nothing downstream needs any other field.
+ */
+struct ColumnScanNode : public QuerySolutionNodeWithSortSet {
+    ColumnScanNode(IndexEntry index, std::vector<std::string> fields)
+        : index(std::move(index)), fields(std::move(fields)) {}
+
+    virtual ~ColumnScanNode() {}
+
+    virtual StageType getType() const {
+        return STAGE_COLUMN_SCAN;
+    }
+
+    virtual void appendToString(str::stream* ss, int indent) const;
+
+    // The output is a document that holds every field the rest of the plan reads.
+    bool fetched() const {
+        return true;
+    }
+    FieldAvailability getFieldAvailability(const std::string& field) const;
+    bool sortedByDiskLoc() const {
+        return false;
+    }
+
+    QuerySolutionNode* clone() const;
+
+    IndexEntry index;
+
+    // The paths of 'index' to read, in the order in which they appear in its key pattern.
+    std::vector<std::string> fields;
+};
+
 struct AndHashNode : public QuerySolutionNode {
     AndHashNode();
     virtual ~AndHashNode();
@@ -1234,6 +1279,124 @@ struct EnsureSortedNode : public QuerySolutionNode {
     BSONObj pattern;
 };
 
+/**
+ * Represents a $group stage which has been pushed down from the aggregation pipeline into the query
+ * layer. Documents from the child are grouped by the _id, and for every group a single document is
+ * produced holding the group key in the '_id' field, along with the value of each accumulator under
+ * its own field name. This node is only supported by the slot-based execution engine.
+ */
+struct GroupNode : public QuerySolutionNodeWithSortSet {
+    GroupNode(std::vector<std::string> idFieldNames,
+              std::vector<boost::intrusive_ptr<Expression>> idExpressions,
+              std::vector<AccumulationStatement> accumulators)
+        : idFieldNames(std::move(idFieldNames)),
+          idExpressions(std::move(idExpressions)),
+          accumulators(std::move(accumulators)) {}
+
+    StageType getType() const override {
+        return STAGE_GROUP;
+    }
+
+    void appendToString(str::stream* ss, int indent) const override;
+
+    bool fetched() const {
+        return true;
+    }
+
+    FieldAvailability getFieldAvailability(const std::string& field) const {
+        return FieldAvailability::kFullyProvided;
+    }
+
+    bool sortedByDiskLoc() const override {
+        return false;
+    }
+
+    QuerySolutionNode* clone() const final;
+
+    // Empty if the _id is a single expression, otherwise holds the names of the _id fields which
+    // line up with 'idExpressions'.
+    std::vector<std::string> idFieldNames;
+    std::vector<boost::intrusive_ptr<Expression>> idExpressions;
+    std::vector<AccumulationStatement> accumulators;
+};
+
+/**
+ * Represents an equality $lookup which has been pushed down from the aggregation pipeline into the
+ * query layer. Every document from the child is returned with an array of the documents of the
+ * foreign collection whose 'joinFieldForeign' matches its 'joinFieldLocal' stored under
+ * 'joinField', as DocumentSourceLookUp would do. This node is only supported by the slot-based
+ * execution engine.
+ */
+struct EqLookupNode : public QuerySolutionNodeWithSortSet {
+    enum class LookupStrategy {
+        // The foreign collection is loaded into a hash table once, which is then probed with the
+        // keys of every local document.
+        kHashJoin,
+        // The keys of every local document are looked up in 'foreignIndex'.
+        kIndexedLoopJoin,
+    };
+
+    /**
+     * An index of the foreign collection whose leading field is 'joinFieldForeign'.
+     */
+    struct ForeignIndex {
+        std::string name;
+        BSONObj keyPattern;
+        KeyString::Version keyStringVersion;
+    };
+
+    EqLookupNode(NamespaceString foreignCollection,
+                 UUID foreignCollectionUuid,
+                 std::string joinFieldLocal,
+                 std::string joinFieldForeign,
+                 std::string joinField,
+                 LookupStrategy lookupStrategy,
+                 boost::optional<ForeignIndex> foreignIndex)
+        : foreignCollection(std::move(foreignCollection)),
+          foreignCollectionUuid(std::move(foreignCollectionUuid)),
+          joinFieldLocal(std::move(joinFieldLocal)),
+          joinFieldForeign(std::move(joinFieldForeign)),
+          joinField(std::move(joinField)),
+          lookupStrategy(lookupStrategy),
+          foreignIndex(std::move(foreignIndex)) {}
+
+    StageType getType() const override {
+        return STAGE_EQ_LOOKUP;
+    }
+
+    void appendToString(str::stream* ss, int indent) const override;
+
+    bool fetched() const {
+        return true;
+    }
+
+    FieldAvailability getFieldAvailability(const std::string& field) const {
+        return FieldAvailability::kFullyProvided;
+    }
+
+    bool sortedByDiskLoc() const override {
+        return false;
+    }
+
+    QuerySolutionNode* clone() const final;
+
+    NamespaceString foreignCollection;
+    UUID foreignCollectionUuid;
+
+    // The top-level fields of the local and foreign documents to join on.
+    std::string joinFieldLocal;
+    std::string joinFieldForeign;
+
+    // The top-level field of the local documents which receives the array of matching foreign
+    // documents.
+    std::string joinField;
+
+    LookupStrategy lookupStrategy;
+
+    // Set if 'lookupStrategy' is 'kIndexedLoopJoin'.
+    boost::optional<ForeignIndex> foreignIndex;
+};
+
 struct EofNode : public QuerySolutionNodeWithSortSet {
     EofNode() {}
 
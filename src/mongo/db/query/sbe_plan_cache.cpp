@@ -0,0 +1,251 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/sbe_plan_cache.h"
+
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/exec/sbe/values/bson.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/query/sbe_stage_builder_helpers.h"
+#include "mongo/db/query/sbe_stage_builder_index_scan.h"
+
+namespace mongo::sbe {
+namespace {
+// The number of queries which have run a clone of a cached plan rather than building their own.
+Counter64 planCacheSbePlanHits;
+ServerStatusMetricField<Counter64> planCacheSbePlanHitsMetric("query.planCacheSbePlanHits",
+                                                              &planCacheSbePlanHits);
+
+/**
+ * Returns true if the stages built for the solution tree rooted at 'node' can be reused by other
+ * queries of the same shape once the runtime environment 'env' is rebound. Index scans must keep
+ * their seek keys in 'env', and the other stages may only depend on the query shape. Collection
+ * scans are never reused, as the stage builder splits them between threads and pre-filters their
+ * records based on the state of the operation and on the constants of the filter.
+ */
+bool isReusable(const QuerySolutionNode* node, const RuntimeEnvironment& env) {
+    switch (node->getType()) {
+        case STAGE_IXSCAN:
+            if (!env.getSlotIfExists(
+                    stage_builder::makeIndexBoundsSlotName(node->nodeId(), true))) {
+                return false;
+            }
+            break;
+        case STAGE_FETCH:
+        case STAGE_LIMIT:
+        case STAGE_OR:
+        case STAGE_PROJECTION_COVERED:
+        case STAGE_PROJECTION_DEFAULT:
+        case STAGE_PROJECTION_SIMPLE:
+        case STAGE_RETURN_KEY:
+        case STAGE_SKIP:
+        case STAGE_SORT_DEFAULT:
+        case STAGE_SORT_KEY_GENERATOR:
+        case STAGE_SORT_MERGE:
+        case STAGE_SORT_SIMPLE:
+            break;
+        default:
+            return false;
+    }
+
+    return std::all_of(node->children.begin(), node->children.end(), [&](auto&& child) {
+        return isReusable(child, env);
+    });
+}
+
+/**
+ * Appends a description of the filter 'expr' to 'builder', in which the values of the input
+ * parameters are replaced by their types. Any other part of the filter is appended verbatim.
+ */
+void appendFilterKey(const MatchExpression* expr, StringBuilder* builder) {
+    if (ComparisonMatchExpression::isComparisonMatchExpression(expr)) {
+        auto comparison = static_cast<const ComparisonMatchExpression*>(expr);
+        if (comparison->getInputParamId()) {
+            *builder << '(' << static_cast<int>(expr->matchType()) << ' ' << expr->path() << ' '
+                     << static_cast<int>(comparison->getData().type()) << ')';
+            return;
+        }
+    }
+
+    switch (expr->matchType()) {
+        case MatchExpression::AND:
+        case MatchExpression::OR:
+        case MatchExpression::NOR:
+        case MatchExpression::NOT:
+        case MatchExpression::ELEM_MATCH_OBJECT:
+        case MatchExpression::ELEM_MATCH_VALUE:
+            *builder << '(' << static_cast<int>(expr->matchType()) << ' ' << expr->path();
+            for (size_t i = 0; i < expr->numChildren(); ++i) {
+                appendFilterKey(expr->getChild(i), builder);
+            }
+            *builder << ')';
+            return;
+        default: {
+            BSONObjBuilder bob;
+            expr->serialize(&bob);
+            auto obj = bob.done();
+            *builder << '(' << StringData{obj.objdata(), static_cast<size_t>(obj.objsize())}
+                     << ')';
+            return;
+        }
+    }
+}
+
+/**
+ * Stores the values of the input parameters of the filter 'expr' into the slots of the runtime
+ * environment 'env'. Parameters which have no slot in 'env', because the plan doesn't evaluate
+ * them, are skipped.
+ */
+void bindInputParams(const MatchExpression* expr, RuntimeEnvironment* env) {
+    if (ComparisonMatchExpression::isComparisonMatchExpression(expr)) {
+        auto comparison = static_cast<const ComparisonMatchExpression*>(expr);
+        if (auto paramId = comparison->getInputParamId()) {
+            if (auto slot = env->getSlotIfExists(stage_builder::makeInputParamSlotName(*paramId))) {
+                const auto& rhs = comparison->getData();
+                auto [tagView, valView] = bson::convertFrom(
+                    true, rhs.rawdata(), rhs.rawdata() + rhs.size(), rhs.fieldNameSize() - 1);
+                auto [tag, val] = value::copyValue(tagView, valView);
+                env->resetSlot(*slot, tag, val, true);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < expr->numChildren(); ++i) {
+        bindInputParams(expr->getChild(i), env);
+    }
+}
+
+/**
+ * Stores the seek keys computed from the bounds of every index scan of the solution tree rooted at
+ * 'node' into the runtime environment 'env'. Returns false if some index scan cannot be bound.
+ */
+bool bindIndexBounds(OperationContext* opCtx,
+                     const CollectionPtr& collection,
+                     const QuerySolutionNode* node,
+                     RuntimeEnvironment* env) {
+    if (node->getType() == STAGE_IXSCAN &&
+        !stage_builder::bindIndexBounds(
+            opCtx, collection, static_cast<const IndexScanNode*>(node), env)) {
+        return false;
+    }
+
+    return std::all_of(node->children.begin(), node->children.end(), [&](auto&& child) {
+        return bindIndexBounds(opCtx, collection, child, env);
+    });
+}
+
+stage_builder::PlanStageData copyPlanStageData(const stage_builder::PlanStageData& data) {
+    stage_builder::PlanStageData copy{data.env->makeDeepCopy()};
+    copy.outputs = data.outputs;
+    copy.shouldTrackLatestOplogTimestamp = data.shouldTrackLatestOplogTimestamp;
+    copy.shouldTrackResumeToken = data.shouldTrackResumeToken;
+    copy.shouldUseTailableScan = data.shouldUseTailableScan;
+    return copy;
+}
+}  // namespace
+
+std::string computeCachedPlanKey(const PlanCacheKey& planCacheKey,
+                                 const CachedSolution& cachedSolution,
+                                 const CanonicalQuery& cq,
+                                 size_t plannerOptions) {
+    StringBuilder builder;
+    builder << planCacheKey.toString() << '|' << cachedSolution.plannerData->toString() << '|'
+            << plannerOptions << '|' << cq.metadataDeps().to_string() << '|';
+    appendFilterKey(cq.root(), &builder);
+
+    // The rest of the query request is appended verbatim.
+    const auto& qr = cq.getQueryRequest();
+    BSONObjBuilder bob;
+    bob.append(QueryRequest::kProjectionField, qr.getProj());
+    bob.append(QueryRequest::kSortField, qr.getSort());
+    bob.append(QueryRequest::kHintField, qr.getHint());
+    bob.append(QueryRequest::kCollationField, qr.getCollation());
+    bob.append(QueryRequest::kMinField, qr.getMin());
+    bob.append(QueryRequest::kMaxField, qr.getMax());
+    if (auto skip = qr.getSkip()) {
+        bob.append(QueryRequest::kSkipField, *skip);
+    }
+    if (auto limit = qr.getLimit()) {
+        bob.append(QueryRequest::kLimitField, *limit);
+    }
+    if (auto ntoreturn = qr.getNToReturn()) {
+        bob.append(QueryRequest::kNToReturnField, *ntoreturn);
+    }
+    if (const auto& let = qr.getLetParameters()) {
+        bob.append(QueryRequest::kLetField, *let);
+    }
+    bob.append(QueryRequest::kReturnKeyField, qr.returnKey());
+    bob.append(QueryRequest::kShowRecordIdField, qr.showRecordId());
+    bob.append(QueryRequest::kAllowDiskUseField, qr.allowDiskUse());
+    auto obj = bob.done();
+    builder << '|' << StringData{obj.objdata(), static_cast<size_t>(obj.objsize())};
+
+    return builder.str();
+}
+
+std::shared_ptr<const CachedSbePlan> makeCachedPlan(const CanonicalQuery& cq,
+                                                    const QuerySolution& solution,
+                                                    const PlanStage& root,
+                                                    const stage_builder::PlanStageData& data) {
+    if (!cq.isParameterized() || data.shouldTrackLatestOplogTimestamp ||
+        data.shouldTrackResumeToken || data.shouldUseTailableScan ||
+        !isReusable(solution.root(), *data.env)) {
+        return nullptr;
+    }
+
+    return std::make_shared<const CachedSbePlan>(root.clone(), copyPlanStageData(data));
+}
+
+boost::optional<std::pair<std::unique_ptr<PlanStage>, stage_builder::PlanStageData>>
+cloneCachedPlan(OperationContext* opCtx,
+                const CollectionPtr& collection,
+                const CanonicalQuery& cq,
+                const QuerySolution& solution,
+                const CachedSbePlan& cachedPlan,
+                PlanYieldPolicySBE* yieldPolicy) {
+    auto data = copyPlanStageData(cachedPlan.planStageData);
+    if (!isReusable(solution.root(), *data.env) ||
+        !bindIndexBounds(opCtx, collection, solution.root(), data.env)) {
+        return boost::none;
+    }
+    bindInputParams(cq.root(), data.env);
+
+    auto root = cachedPlan.root->clone();
+    root->attachNewYieldPolicy(yieldPolicy);
+    root->attachToOperationContext(opCtx);
+
+    // Register this plan to yield according to the configured policy.
+    yieldPolicy->registerPlan(root.get());
+
+    planCacheSbePlanHits.increment();
+    return {{std::move(root), std::move(data)}};
+}
+}  // namespace mongo::sbe
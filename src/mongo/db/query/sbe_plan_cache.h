@@ -0,0 +1,96 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/plan_yield_policy_sbe.h"
+#include "mongo/db/query/query_solution.h"
+#include "mongo/db/query/sbe_stage_builder.h"
+
+namespace mongo::sbe {
+/**
+ * A fully built SBE plan kept in the plan cache, so that a query whose solution is recovered from
+ * the cache can clone this plan instead of running the stage builder again. The plan is built for
+ * a parameterized query (see 'CanonicalQuery::parameterize()'): the values of the input parameters
+ * and the seek keys of the index scans are held in runtime environment slots, which are rebound
+ * to the values of every query reusing the plan.
+ *
+ * A cached plan is never prepared or executed, and is not modified once it has been cached.
+ */
+struct CachedSbePlan {
+    CachedSbePlan(std::unique_ptr<PlanStage> root, stage_builder::PlanStageData planStageData)
+        : root(std::move(root)), planStageData(std::move(planStageData)) {}
+
+    const std::unique_ptr<PlanStage> root;
+    const stage_builder::PlanStageData planStageData;
+};
+
+/**
+ * Computes the key under which the plan built for 'cq' from the cached solution 'cachedSolution'
+ * is stored in the plan cache. Along with the plan cache key of the query shape, the key captures
+ * everything the plan depends on except the values of the input parameters of 'cq', so that two
+ * queries with the same key can run the same plan once the parameters are rebound.
+ */
+std::string computeCachedPlanKey(const PlanCacheKey& planCacheKey,
+                                 const CachedSolution& cachedSolution,
+                                 const CanonicalQuery& cq,
+                                 size_t plannerOptions);
+
+/**
+ * Returns a copy of the plan 'root' and 'data', built for the parameterized query 'cq' from
+ * 'solution', to be stored in the plan cache. Returns nullptr if the plan cannot be reused by other
+ * queries of the same shape. Must be called before the plan is prepared.
+ */
+std::shared_ptr<const CachedSbePlan> makeCachedPlan(const CanonicalQuery& cq,
+                                                    const QuerySolution& solution,
+                                                    const PlanStage& root,
+                                                    const stage_builder::PlanStageData& data);
+
+/**
+ * Clones 'cachedPlan' for the query 'cq', whose 'solution' has been recovered from the same cache
+ * entry as the solution the plan was built from, and binds the clone to the input parameters of
+ * 'cq', the index bounds of 'solution', the operation context and 'yieldPolicy'. Returns
+ * boost::none if the plan cannot be used for 'solution', in which case the caller should build a
+ * new plan.
+ */
+boost::optional<std::pair<std::unique_ptr<PlanStage>, stage_builder::PlanStageData>>
+cloneCachedPlan(OperationContext* opCtx,
+                const CollectionPtr& collection,
+                const CanonicalQuery& cq,
+                const QuerySolution& solution,
+                const CachedSbePlan& cachedPlan,
+                PlanYieldPolicySBE* yieldPolicy);
+}  // namespace mongo::sbe
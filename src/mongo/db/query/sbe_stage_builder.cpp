@@ -33,8 +33,10 @@
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/exec/sbe/stages/co_scan.h"
+#include "mongo/db/exec/sbe/stages/exchange.h"
 #include "mongo/db/exec/sbe/stages/filter.h"
 #include "mongo/db/exec/sbe/stages/hash_agg.h"
+#include "mongo/db/exec/sbe/stages/hash_join.h"
 #include "mongo/db/exec/sbe/stages/limit_skip.h"
 #include "mongo/db/exec/sbe/stages/loop_join.h"
 #include "mongo/db/exec/sbe/stages/makeobj.h"
@@ -46,17 +48,21 @@
 #include "mongo/db/exec/sbe/stages/traverse.h"
 #include "mongo/db/exec/sbe/stages/union.h"
 #include "mongo/db/exec/sbe/stages/unique.h"
+#include "mongo/db/exec/sbe/stages/unwind.h"
 #include "mongo/db/exec/shard_filterer.h"
 #include "mongo/db/fts/fts_index_format.h"
 #include "mongo/db/fts/fts_query_impl.h"
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/index/fts_access_method.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/sbe_stage_builder_coll_scan.h"
+#include "mongo/db/query/sbe_stage_builder_expression.h"
 #include "mongo/db/query/sbe_stage_builder_filter.h"
 #include "mongo/db/query/sbe_stage_builder_helpers.h"
 #include "mongo/db/query/sbe_stage_builder_index_scan.h"
 #include "mongo/db/query/sbe_stage_builder_projection.h"
 #include "mongo/db/query/util/make_data_structure.h"
+#include "mongo/db/repl/read_concern_args.h"
 #include "mongo/db/s/collection_sharding_state.h"
 
 namespace mongo::stage_builder {
@@ -101,6 +107,10 @@ std::string PlanStageData::debugString() const {
 }
 
 namespace {
+// The maximum amount of memory an index intersection may use for its hash tables, which matches
+// the limit of the classic AndHashStage.
+constexpr size_t kMaxIndexIntersectionMemoryUsageBytes = 32 * 1024 * 1024;
+
 const QuerySolutionNode* getNodeByType(const QuerySolutionNode* root, StageType type) {
     if (root->getType() == type) {
         return root;
@@ -140,6 +150,27 @@ SlotBasedStageBuilder::SlotBasedStageBuilder(OperationContext* opCtx,
         auto vsn = static_cast<const VirtualScanNode*>(node);
         _shouldProduceRecordIdSlot = vsn->hasRecordId;
     }
+
+    // A pushed down $group or $lookup produces new documents which are not associated with any
+    // record.
+    if (solution.root()->getType() == STAGE_GROUP || solution.root()->getType() == STAGE_EQ_LOOKUP) {
+        _shouldProduceRecordIdSlot = false;
+    }
+
+    // Parallel producers run on their own operation contexts and read from their own snapshots, so
+    // intra-query parallelism is only used when the query doesn't depend on the order of records or
+    // on a particular snapshot.
+    const auto& qr = _cq.getQueryRequest();
+    const auto readConcernLevel = repl::ReadConcernArgs::get(_opCtx).getLevel();
+    if (!_data.shouldTrackLatestOplogTimestamp && !_data.shouldTrackResumeToken &&
+        !_data.shouldUseTailableScan && !_opCtx->inMultiDocumentTransaction() &&
+        (readConcernLevel == repl::ReadConcernLevel::kLocalReadConcern ||
+         readConcernLevel == repl::ReadConcernLevel::kAvailableReadConcern) &&
+        !qr.getSort().hasField(QueryRequest::kNaturalSortField) &&
+        !qr.getHint().hasField(QueryRequest::kNaturalSortField)) {
+        _degreeOfParallelism =
+            _cq.getExpCtx()->degreeOfParallelism.value_or(internalQueryDefaultDOP.load());
+    }
 }
 
 std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::build(const QuerySolutionNode* root) {
@@ -177,14 +208,22 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
 
     auto csn = static_cast<const CollectionScanNode*>(root);
 
-    auto [stage, outputs] = generateCollScan(_opCtx,
-                                             _collection,
-                                             csn,
-                                             &_slotIdGenerator,
-                                             &_frameIdGenerator,
-                                             _yieldPolicy,
-                                             _data.env,
-                                             reqs.getIsTailableCollScanResumeBranch());
+    auto [stage, outputs] = reqs.getIsBuildingParallelSubtree()
+        ? generateParallelCollScan(_opCtx,
+                                   _collection,
+                                   csn,
+                                   &_slotIdGenerator,
+                                   &_frameIdGenerator,
+                                   _yieldPolicy,
+                                   _data.env)
+        : generateCollScan(_opCtx,
+                           _collection,
+                           csn,
+                           &_slotIdGenerator,
+                           &_frameIdGenerator,
+                           _yieldPolicy,
+                           _data.env,
+                           reqs.getIsTailableCollScanResumeBranch());
 
     if (reqs.has(kReturnKey)) {
         // Assign the 'returnKeySlot' to be the empty object.
@@ -245,8 +284,16 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
     // Index scans cannot produce an oplogTsSlot, so assert that the caller doesn't need it.
     invariant(!reqs.has(kOplogTs));
 
-    return generateIndexScan(
-        _opCtx, _collection, ixn, reqs, &_slotIdGenerator, &_spoolIdGenerator, _yieldPolicy);
+    // The seek keys of a parameterized query are kept in the runtime environment, so that the plan
+    // can be cached and reused by other queries of the same shape.
+    return generateIndexScan(_opCtx,
+                             _collection,
+                             ixn,
+                             reqs,
+                             &_slotIdGenerator,
+                             &_spoolIdGenerator,
+                             _yieldPolicy,
+                             _cq.isParameterized() ? _data.env : nullptr);
 }
 
 std::tuple<sbe::value::SlotId, sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>>
@@ -767,6 +814,81 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
     return {std::move(stage), std::move(outputs)};
 }
 
+std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots>
+SlotBasedStageBuilder::buildAndHashOrSorted(const QuerySolutionNode* root,
+                                            const PlanStageReqs& reqs) {
+    invariant(!reqs.getIndexKeyBitset());
+    invariant(!reqs.has(kOplogTs));
+    uassert(5073805,
+            str::stream() << "ReturnKey is not supported by " << stageTypeToString(root->getType())
+                          << " stage",
+            !reqs.has(kReturnKey));
+    invariant(root->children.size() >= 2);
+
+    // If the parent needs a 'resultSlot', it is taken from the first fetched child. Classic index
+    // intersection merges the fetched documents of all of its children, but they are all the same
+    // version of the document, so any one of them will do.
+    const auto& children = root->children;
+    boost::optional<size_t> resultChild;
+    if (reqs.has(kResult)) {
+        auto it = std::find_if(
+            children.begin(), children.end(), [](auto&& child) { return child->fetched(); });
+        uassert(5073806,
+                str::stream() << stageTypeToString(root->getType())
+                              << " stage has no fetched children to produce a result from",
+                it != children.end());
+        resultChild = std::distance(children.begin(), it);
+    }
+
+    auto childReqs = [&](size_t idx) {
+        return reqs.copy().clear(kResult).set(kRecordId).setIf(kResult, resultChild == idx);
+    };
+
+    // The output of the intersection is streamed from the last child, whose RecordIds probe the
+    // hash tables built from the RecordIds of all the other children, so that the intersection
+    // preserves the order of the last child. The planner relies on this when it chooses which child
+    // goes last. Every child produces each RecordId at most once, as index scans over multikey
+    // indexes deduplicate their output.
+    auto [stage, outputs] = build(children.back(), childReqs(children.size() - 1));
+    if (resultChild != children.size() - 1) {
+        outputs.clear(kResult);
+    }
+
+    for (size_t idx = children.size() - 1; idx-- > 0;) {
+        auto [outerStage, outerOutputs] = build(children[idx], childReqs(idx));
+
+        auto outerProjects = sbe::makeSV();
+        if (resultChild == idx) {
+            outerProjects.push_back(outerOutputs.get(kResult));
+        }
+
+        auto innerProjects = sbe::makeSV();
+        if (outputs.has(kResult)) {
+            innerProjects.push_back(outputs.get(kResult));
+        }
+
+        // The hash join must not spill, as a spilling hash join does not preserve the order of its
+        // inner side.
+        stage = sbe::makeS<sbe::HashJoinStage>(std::move(outerStage),
+                                               std::move(stage),
+                                               sbe::makeSV(outerOutputs.get(kRecordId)),
+                                               std::move(outerProjects),
+                                               sbe::makeSV(outputs.get(kRecordId)),
+                                               std::move(innerProjects),
+                                               kMaxIndexIntersectionMemoryUsageBytes,
+                                               false /* allowDiskUse */,
+                                               root->nodeId(),
+                                               false /* reuseOuterOnReOpen */,
+                                               false /* canSpill */);
+
+        if (resultChild == idx) {
+            outputs.set(kResult, outerOutputs.get(kResult));
+        }
+    }
+
+    return {std::move(stage), std::move(outputs)};
+}
+
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder::buildText(
     const QuerySolutionNode* root, const PlanStageReqs& reqs) {
     invariant(_collection);
@@ -919,6 +1041,454 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
     return {std::move(stage), std::move(outputs)};
 }
 
+std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder::buildGroup(
+    const QuerySolutionNode* root, const PlanStageReqs& reqs) {
+    using namespace std::literals;
+
+    const auto groupNode = static_cast<const GroupNode*>(root);
+    invariant(!reqs.getIndexKeyBitset());
+    invariant(!reqs.has(kRecordId) && !reqs.has(kOplogTs));
+
+    // If the input of the group can be produced in parallel, and the partial results of all the
+    // accumulators can be merged, then each producer pre-aggregates its share of the input and the
+    // partial results are merged above the exchange. Otherwise, if the input can still be produced
+    // in parallel, the exchange is placed directly below the group when the child is built.
+    const bool isPartialAggregation = _degreeOfParallelism > 1 &&
+        !reqs.getIsBuildingParallelSubtree() && canBuildParallelSubtree(groupNode->children[0]) &&
+        std::all_of(groupNode->accumulators.begin(),
+                    groupNode->accumulators.end(),
+                    [](auto&& acc) {
+                        const StringData opName = acc.makeAccumulator()->getOpName();
+                        return opName == "$sum"_sd || opName == "$avg"_sd || opName == "$min"_sd ||
+                            opName == "$max"_sd;
+                    });
+
+    auto childReqs =
+        PlanStageReqs{}.set(kResult).setIsBuildingParallelSubtree(isPartialAggregation);
+    auto [stage, childOutputs] = build(groupNode->children[0], childReqs);
+    auto rootSlot = childOutputs.get(kResult);
+    auto relevantSlots = sbe::makeSV(rootSlot);
+
+    // Evaluates 'expr' against the input document and projects the result into a new slot, which
+    // is visible to the HashAggStage.
+    auto projectExpression = [&](Expression* expr) {
+        auto [slot, sbeExpr, exprStage] = generateExpression(_opCtx,
+                                                             expr,
+                                                             std::move(stage),
+                                                             &_slotIdGenerator,
+                                                             &_frameIdGenerator,
+                                                             rootSlot,
+                                                             _data.env,
+                                                             root->nodeId(),
+                                                             &relevantSlots);
+        stage =
+            sbe::makeProjectStage(std::move(exprStage), root->nodeId(), slot, std::move(sbeExpr));
+        relevantSlots.push_back(slot);
+        return slot;
+    };
+
+    // Compute the group key. A key with a single component which evaluates to missing groups by
+    // null, while the missing components of a compound key are omitted from the key document.
+    auto keySlot = _slotIdGenerator.generate();
+    if (groupNode->idFieldNames.empty()) {
+        invariant(groupNode->idExpressions.size() == 1);
+        auto idSlot = projectExpression(groupNode->idExpressions[0].get());
+        stage = sbe::makeProjectStage(std::move(stage),
+                                      root->nodeId(),
+                                      keySlot,
+                                      makeFillEmptyNull(sbe::makeE<sbe::EVariable>(idSlot)));
+    } else {
+        invariant(groupNode->idFieldNames.size() == groupNode->idExpressions.size());
+        std::vector<std::unique_ptr<sbe::EExpression>> keyArgs;
+        for (size_t idx = 0; idx < groupNode->idFieldNames.size(); ++idx) {
+            auto idSlot = projectExpression(groupNode->idExpressions[idx].get());
+            keyArgs.push_back(makeConstant(groupNode->idFieldNames[idx]));
+            keyArgs.push_back(groupNode->idFieldNames.size() == 1
+                                  ? makeFillEmptyNull(sbe::makeE<sbe::EVariable>(idSlot))
+                                  : sbe::makeE<sbe::EVariable>(idSlot));
+        }
+        stage = sbe::makeProjectStage(std::move(stage),
+                                      root->nodeId(),
+                                      keySlot,
+                                      sbe::makeE<sbe::EFunction>("newObj"sv, std::move(keyArgs)));
+    }
+    relevantSlots.push_back(keySlot);
+
+    // Translate each accumulator into one or more SBE aggregate expressions, along with an
+    // expression which computes the final value of the accumulator once the group is complete.
+    sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> aggs;
+    // The name of the aggregate function which merges partial results, for each aggregate slot.
+    sbe::value::SlotMap<std::string_view> mergeFunctions;
+    std::vector<std::unique_ptr<sbe::EExpression>> resultArgs;
+    resultArgs.push_back(makeConstant("_id"sv));
+    resultArgs.push_back(sbe::makeE<sbe::EVariable>(keySlot));
+
+    auto numericOrNothing = [](sbe::value::SlotId slot, std::unique_ptr<sbe::EExpression> value) {
+        return sbe::makeE<sbe::EIf>(
+            makeFunction("isNumber"sv, sbe::makeE<sbe::EVariable>(slot)),
+            std::move(value),
+            sbe::makeE<sbe::EConstant>(sbe::value::TypeTags::Nothing, 0));
+    };
+
+    for (auto&& acc : groupNode->accumulators) {
+        auto argSlot = projectExpression(acc.expr.argument.get());
+        auto aggSlot = _slotIdGenerator.generate();
+        const StringData opName = acc.makeAccumulator()->getOpName();
+
+        std::unique_ptr<sbe::EExpression> finalExpr;
+        if (opName == "$sum"_sd) {
+            // Non-numeric values do not contribute to the sum. The values are summed, and the type
+            // of the result is chosen, in the same way as by the $sum accumulator.
+            aggs.emplace(aggSlot,
+                         makeFunction("aggDoubleDoubleSum"sv, sbe::makeE<sbe::EVariable>(argSlot)));
+            mergeFunctions.emplace(aggSlot, "aggMergeDoubleDoubleSums"sv);
+            finalExpr = sbe::makeE<sbe::EFunction>(
+                "fillEmpty"sv,
+                sbe::makeEs(makeFunction("doubleDoubleSumFinalize"sv,
+                                         sbe::makeE<sbe::EVariable>(aggSlot)),
+                            makeConstant(sbe::value::TypeTags::NumberInt32, int32_t{0})));
+        } else if (opName == "$avg"_sd) {
+            // Track the sum and the count of the numeric values separately, and divide them once
+            // the group is complete. The average of a group without numeric values is null.
+            auto countSlot = _slotIdGenerator.generate();
+            aggs.emplace(aggSlot,
+                         makeFunction("aggDoubleDoubleSum"sv, sbe::makeE<sbe::EVariable>(argSlot)));
+            aggs.emplace(
+                countSlot,
+                makeFunction(
+                    "sum"sv,
+                    numericOrNothing(argSlot,
+                                     makeConstant(sbe::value::TypeTags::NumberInt64, int64_t{1}))));
+            mergeFunctions.emplace(aggSlot, "aggMergeDoubleDoubleSums"sv);
+            mergeFunctions.emplace(countSlot, "sum"sv);
+            finalExpr = sbe::makeE<sbe::EIf>(
+                makeFunction("exists"sv, sbe::makeE<sbe::EVariable>(countSlot)),
+                makeFunction("doubleDoubleAvgFinalize"sv,
+                             sbe::makeE<sbe::EVariable>(aggSlot),
+                             sbe::makeE<sbe::EVariable>(countSlot)),
+                sbe::makeE<sbe::EConstant>(sbe::value::TypeTags::Null, 0));
+        } else if (opName == "$min"_sd || opName == "$max"_sd) {
+            // Null and missing values are ignored by $min and $max.
+            aggs.emplace(
+                aggSlot,
+                makeFunction(opName == "$min"_sd ? "min"sv : "max"sv,
+                             sbe::makeE<sbe::EIf>(
+                                 generateNullOrMissing(sbe::EVariable{argSlot}),
+                                 sbe::makeE<sbe::EConstant>(sbe::value::TypeTags::Nothing, 0),
+                                 sbe::makeE<sbe::EVariable>(argSlot))));
+            mergeFunctions.emplace(aggSlot, opName == "$min"_sd ? "min"sv : "max"sv);
+            finalExpr = makeFillEmptyNull(sbe::makeE<sbe::EVariable>(aggSlot));
+        } else if (opName == "$first"_sd || opName == "$last"_sd) {
+            // A missing value is reported as null by $first and $last.
+            aggs.emplace(aggSlot,
+                         makeFunction(opName == "$first"_sd ? "first"sv : "last"sv,
+                                      makeFillEmptyNull(sbe::makeE<sbe::EVariable>(argSlot))));
+            finalExpr = sbe::makeE<sbe::EVariable>(aggSlot);
+        } else if (opName == "$push"_sd || opName == "$addToSet"_sd) {
+            // Missing values are skipped when accumulating into an array.
+            aggs.emplace(aggSlot,
+                         makeFunction(opName == "$push"_sd ? "addToArray"sv : "addToSet"sv,
+                                      sbe::makeE<sbe::EVariable>(argSlot)));
+            finalExpr = sbe::makeE<sbe::EVariable>(aggSlot);
+        } else {
+            uasserted(5139200,
+                      str::stream() << "Accumulator " << opName
+                                    << " is not supported in the slot-based execution engine");
+        }
+
+        resultArgs.push_back(makeConstant(acc.fieldName));
+        resultArgs.push_back(std::move(finalExpr));
+    }
+
+    if (isPartialAggregation) {
+        // Each producer computes the aggregates into fresh partial slots, and the final hash
+        // aggregation merges the partial results of all producers into the original slots, so that
+        // the final expressions built above can be used unchanged.
+        sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> partialAggs;
+        sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> mergeAggs;
+        auto exchangeFields = sbe::makeSV(keySlot);
+        for (auto&& [aggSlot, aggExpr] : aggs) {
+            auto partialSlot = _slotIdGenerator.generate();
+            partialAggs.emplace(partialSlot, std::move(aggExpr));
+            mergeAggs.emplace(aggSlot,
+                              makeFunction(mergeFunctions.at(aggSlot),
+                                           sbe::makeE<sbe::EVariable>(partialSlot)));
+            exchangeFields.push_back(partialSlot);
+        }
+
+        stage = sbe::makeS<sbe::HashAggStage>(
+            std::move(stage),
+            sbe::makeSV(keySlot),
+            std::move(partialAggs),
+            static_cast<size_t>(internalDocumentSourceGroupMaxMemoryBytes.load()),
+            _cq.getExpCtx()->allowDiskUse,
+            root->nodeId());
+        stage = sbe::makeS<sbe::ExchangeConsumer>(std::move(stage),
+                                                  _degreeOfParallelism,
+                                                  std::move(exchangeFields),
+                                                  sbe::ExchangePolicy::roundrobin,
+                                                  nullptr,
+                                                  nullptr,
+                                                  root->nodeId());
+        aggs = std::move(mergeAggs);
+    }
+
+    stage = sbe::makeS<sbe::HashAggStage>(std::move(stage),
+                                          sbe::makeSV(keySlot),
+                                          std::move(aggs),
+                                          static_cast<size_t>(
+                                              internalDocumentSourceGroupMaxMemoryBytes.load()),
+                                          _cq.getExpCtx()->allowDiskUse,
+                                          root->nodeId());
+
+    // Assemble the output document from the group key and the final values of the accumulators.
+    PlanStageSlots outputs;
+    outputs.set(kResult, _slotIdGenerator.generate());
+    stage = sbe::makeProjectStage(std::move(stage),
+                                  root->nodeId(),
+                                  outputs.get(kResult),
+                                  sbe::makeE<sbe::EFunction>("newObj"sv, std::move(resultArgs)));
+
+    return {std::move(stage), std::move(outputs)};
+}
+
+std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder::buildEqLookup(
+    const QuerySolutionNode* root, const PlanStageReqs& reqs) {
+    using namespace std::literals;
+
+    const auto eqLookupNode = static_cast<const EqLookupNode*>(root);
+    const auto nodeId = root->nodeId();
+    invariant(!reqs.getIndexKeyBitset());
+    invariant(!reqs.has(kRecordId) && !reqs.has(kOplogTs));
+
+    auto [localStage, localOutputs] =
+        build(eqLookupNode->children[0], PlanStageReqs{}.set(kResult));
+    auto localDocSlot = localOutputs.get(kResult);
+
+    const NamespaceStringOrUUID foreignNssOrUuid{eqLookupNode->foreignCollection.db().toString(),
+                                                 eqLookupNode->foreignCollectionUuid};
+
+    // Produces each of the join keys in the array in 'keysSlot' from 'stage'.
+    auto makeJoinKeysStage = [&](std::unique_ptr<sbe::PlanStage> stage,
+                                 sbe::value::SlotId keysSlot) {
+        auto keySlot = _slotIdGenerator.generate();
+        stage = sbe::makeS<sbe::UnwindStage>(
+            std::move(stage), keysSlot, keySlot, _slotIdGenerator.generate(), true, nodeId);
+        stage = sbe::makeS<sbe::FilterStage<false>>(
+            std::move(stage), makeFunction("exists"sv, sbe::makeE<sbe::EVariable>(keySlot)), nodeId);
+        return std::make_pair(keySlot, std::move(stage));
+    };
+    // The join keys are computed from the BSON values of the join fields with the semantics of the
+    // $eq query operator the classic $lookup looks up the foreign documents with.
+    auto getJoinKeys = [](sbe::value::SlotId docSlot,
+                          const std::string& field,
+                          sbe::vm::JoinKeysKind kind) {
+        return makeFunction("joinKeys"sv,
+                            sbe::makeE<sbe::EVariable>(docSlot),
+                            makeConstant(field),
+                            makeConstant(sbe::value::TypeTags::NumberInt32,
+                                         static_cast<int32_t>(kind)));
+    };
+    const bool isHashJoin =
+        eqLookupNode->lookupStrategy == EqLookupNode::LookupStrategy::kHashJoin;
+
+    // The join keys of each local document are computed once, and unwound on the inner side of the
+    // loop join below for every local document. An index on the foreign join field is probed with
+    // a superset of the join keys, as arrays are indexed by their elements rather than as a whole.
+    auto localKeysSlot = _slotIdGenerator.generate();
+    localStage = sbe::makeProjectStage(
+        std::move(localStage),
+        nodeId,
+        localKeysSlot,
+        getJoinKeys(localDocSlot, eqLookupNode->joinFieldLocal, sbe::vm::JoinKeysKind::kLocal));
+    auto localProbesSlot = localKeysSlot;
+    if (!isHashJoin) {
+        localProbesSlot = _slotIdGenerator.generate();
+        localStage = sbe::makeProjectStage(std::move(localStage),
+                                           nodeId,
+                                           localProbesSlot,
+                                           getJoinKeys(localDocSlot,
+                                                       eqLookupNode->joinFieldLocal,
+                                                       sbe::vm::JoinKeysKind::kLocalIndexProbes));
+    }
+    auto [localKeySlot, localKeysStage] = makeJoinKeysStage(
+        sbe::makeS<sbe::LimitSkipStage>(sbe::makeS<sbe::CoScanStage>(nodeId), 1, boost::none, nodeId),
+        localProbesSlot);
+
+    // Find the foreign documents matching any of the local join keys.
+    auto foreignDocSlot = _slotIdGenerator.generate();
+    auto foreignRecordIdSlot = _slotIdGenerator.generate();
+    std::unique_ptr<sbe::PlanStage> matchStage;
+    if (isHashJoin) {
+        // Build a hash table of the foreign collection keyed by the foreign join keys. The hash
+        // table only depends on the foreign collection, so it is built for the first local
+        // document and probed again for every following one.
+        std::unique_ptr<sbe::PlanStage> foreignStage =
+            sbe::makeS<sbe::ScanStage>(foreignNssOrUuid,
+                                       foreignDocSlot,
+                                       foreignRecordIdSlot,
+                                       std::vector<std::string>{},
+                                       sbe::makeSV(),
+                                       boost::none,
+                                       true,
+                                       _yieldPolicy,
+                                       nodeId);
+        auto foreignKeysSlot = _slotIdGenerator.generate();
+        foreignStage = sbe::makeProjectStage(std::move(foreignStage),
+                                             nodeId,
+                                             foreignKeysSlot,
+                                             getJoinKeys(foreignDocSlot,
+                                                         eqLookupNode->joinFieldForeign,
+                                                         sbe::vm::JoinKeysKind::kForeign));
+        auto [foreignKeySlot, foreignKeysStage] =
+            makeJoinKeysStage(std::move(foreignStage), foreignKeysSlot);
+
+        matchStage = sbe::makeS<sbe::HashJoinStage>(
+            std::move(foreignKeysStage),
+            std::move(localKeysStage),
+            sbe::makeSV(foreignKeySlot),
+            sbe::makeSV(foreignDocSlot, foreignRecordIdSlot),
+            sbe::makeSV(localKeySlot),
+            sbe::makeSV(),
+            static_cast<size_t>(internalQuerySlotBasedExecutionHashLookupMaxMemoryBytes.load()),
+            _cq.getExpCtx()->allowDiskUse,
+            nodeId,
+            true /* reuseOuterOnReOpen */);
+    } else {
+        // Probe the foreign index for every index probe of the local document, with bounds
+        // covering all the index keys whose leading component equals the probe, and fetch the
+        // matching documents.
+        invariant(eqLookupNode->foreignIndex);
+        const auto& foreignIndex = *eqLookupNode->foreignIndex;
+        int32_t orderingBits = foreignIndex.keyPattern.firstElement().number() < 0 ? 1 : 0;
+        auto makeKeyBound = [&](KeyString::Discriminator discriminator) {
+            return makeFunction(
+                "ks"sv,
+                makeConstant(sbe::value::TypeTags::NumberInt64,
+                             static_cast<int64_t>(foreignIndex.keyStringVersion)),
+                makeConstant(sbe::value::TypeTags::NumberInt32, orderingBits),
+                sbe::makeE<sbe::EVariable>(localKeySlot),
+                makeConstant(sbe::value::TypeTags::NumberInt64,
+                             static_cast<int64_t>(discriminator)));
+        };
+
+        auto [indexRecordIdSlot, indexScanStage] =
+            generateSingleIntervalIndexScan(foreignNssOrUuid,
+                                            foreignIndex.name,
+                                            true,
+                                            makeKeyBound(KeyString::Discriminator::kExclusiveBefore),
+                                            makeKeyBound(KeyString::Discriminator::kExclusiveAfter),
+                                            sbe::IndexKeysInclusionSet{},
+                                            sbe::makeSV(),
+                                            boost::none,
+                                            &_slotIdGenerator,
+                                            _yieldPolicy,
+                                            nodeId);
+        matchStage = sbe::makeS<sbe::LoopJoinStage>(std::move(localKeysStage),
+                                                    std::move(indexScanStage),
+                                                    sbe::makeSV(),
+                                                    sbe::makeSV(localKeySlot),
+                                                    nullptr,
+                                                    nodeId);
+
+        auto fetchStage = sbe::makeS<sbe::ScanStage>(foreignNssOrUuid,
+                                                     foreignDocSlot,
+                                                     foreignRecordIdSlot,
+                                                     std::vector<std::string>{},
+                                                     sbe::makeSV(),
+                                                     indexRecordIdSlot,
+                                                     true,
+                                                     nullptr,
+                                                     nodeId);
+        matchStage = sbe::makeS<sbe::LoopJoinStage>(
+            std::move(matchStage),
+            sbe::makeS<sbe::LimitSkipStage>(std::move(fetchStage), 1, boost::none, nodeId),
+            sbe::makeSV(),
+            sbe::makeSV(indexRecordIdSlot),
+            nullptr,
+            nodeId);
+
+        // A probe for the first element of an array join key also finds foreign documents which
+        // merely contain that element, so only keep those sharing a join key with the local one.
+        auto [emptyTag, emptyVal] = sbe::value::makeNewArray();
+        matchStage = sbe::makeS<sbe::FilterStage<false>>(
+            std::move(matchStage),
+            sbe::makeE<sbe::EPrimBinary>(
+                sbe::EPrimBinary::neq,
+                makeFunction("setIntersection"sv,
+                             sbe::makeE<sbe::EVariable>(localKeysSlot),
+                             getJoinKeys(foreignDocSlot,
+                                         eqLookupNode->joinFieldForeign,
+                                         sbe::vm::JoinKeysKind::kForeign)),
+                sbe::makeE<sbe::EConstant>(emptyTag, emptyVal)),
+            nodeId);
+    }
+
+    // A foreign document matching several local join keys is only returned once.
+    matchStage =
+        sbe::makeS<sbe::UniqueStage>(std::move(matchStage), sbe::makeSV(foreignRecordIdSlot), nodeId);
+
+    // Accumulate the matching foreign documents into an array. The hash aggregation produces no
+    // row if there is no match, in which case the union falls back to an empty array.
+    auto matchesSlot = _slotIdGenerator.generate();
+    sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> aggs;
+    aggs.emplace(matchesSlot,
+                 makeFunction("addToArray"sv, sbe::makeE<sbe::EVariable>(foreignDocSlot)));
+    matchStage = sbe::makeS<sbe::HashAggStage>(
+        std::move(matchStage),
+        sbe::makeSV(),
+        std::move(aggs),
+        static_cast<size_t>(internalDocumentSourceGroupMaxMemoryBytes.load()),
+        _cq.getExpCtx()->allowDiskUse,
+        nodeId);
+
+    auto emptySlot = _slotIdGenerator.generate();
+    auto [emptyTag, emptyVal] = sbe::value::makeNewArray();
+    auto emptyStage = sbe::makeProjectStage(
+        sbe::makeS<sbe::LimitSkipStage>(sbe::makeS<sbe::CoScanStage>(nodeId), 1, boost::none, nodeId),
+        nodeId,
+        emptySlot,
+        sbe::makeE<sbe::EConstant>(emptyTag, emptyVal));
+
+    auto joinedSlot = _slotIdGenerator.generate();
+    std::vector<std::unique_ptr<sbe::PlanStage>> branches;
+    branches.push_back(std::move(matchStage));
+    branches.push_back(std::move(emptyStage));
+    auto innerStage = sbe::makeS<sbe::LimitSkipStage>(
+        sbe::makeS<sbe::UnionStage>(std::move(branches),
+                                    std::vector<sbe::value::SlotVector>{sbe::makeSV(matchesSlot),
+                                                                        sbe::makeSV(emptySlot)},
+                                    sbe::makeSV(joinedSlot),
+                                    nodeId),
+        1,
+        boost::none,
+        nodeId);
+
+    auto stage = sbe::makeS<sbe::LoopJoinStage>(std::move(localStage),
+                                                std::move(innerStage),
+                                                sbe::makeSV(localDocSlot),
+                                                isHashJoin
+                                                    ? sbe::makeSV(localKeysSlot)
+                                                    : sbe::makeSV(localKeysSlot, localProbesSlot),
+                                                nullptr,
+                                                nodeId);
+
+    // Store the array of matching foreign documents under the 'as' field of the local document.
+    PlanStageSlots outputs;
+    outputs.set(kResult, _slotIdGenerator.generate());
+    stage = sbe::makeS<sbe::MakeObjStage>(std::move(stage),
+                                          outputs.get(kResult),
+                                          localDocSlot,
+                                          std::vector<std::string>{},
+                                          std::vector<std::string>{eqLookupNode->joinField},
+                                          sbe::makeSV(joinedSlot),
+                                          false,
+                                          false,
+                                          nodeId);
+
+    return {std::move(stage), std::move(outputs)};
+}
+
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots>
 SlotBasedStageBuilder::makeUnionForTailableCollScan(const QuerySolutionNode* root,
                                                     const PlanStageReqs& reqs) {
@@ -1088,6 +1658,61 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
             std::move(outputs)};
 }
 
+bool SlotBasedStageBuilder::canBuildParallelSubtree(const QuerySolutionNode* root) const {
+    switch (root->getType()) {
+        case STAGE_PROJECTION_SIMPLE:
+        case STAGE_PROJECTION_DEFAULT:
+            return canBuildParallelSubtree(root->children[0]);
+        case STAGE_COLLSCAN: {
+            // Only a plain forward scan of a large enough collection is worth splitting between
+            // several threads. Every other kind of collection scan depends on the order in which
+            // the records are returned.
+            auto csn = static_cast<const CollectionScanNode*>(root);
+            return _collection && !_collection->ns().isOplog() &&
+                csn->direction == CollectionScanParams::FORWARD && !csn->minTs && !csn->maxTs &&
+                !csn->resumeAfterRecordId && !csn->tailable &&
+                !csn->shouldTrackLatestOplogTimestamp && !csn->requestResumeToken &&
+                !csn->stopApplyingFilterAfterFirstMatch &&
+                _collection->numRecords(_opCtx) >=
+                static_cast<uint64_t>(
+                    internalQuerySlotBasedExecutionParallelScanMinRecords.load());
+        }
+        default:
+            return false;
+    }
+}
+
+std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots>
+SlotBasedStageBuilder::buildParallelSubtree(const QuerySolutionNode* root,
+                                            const PlanStageReqs& reqs) {
+    invariant(!reqs.getIndexKeyBitset());
+    invariant(!reqs.getIsBuildingParallelSubtree());
+
+    auto childReqs = reqs.copy().setIsBuildingParallelSubtree(true);
+    auto [stage, childOutputs] = build(root, childReqs);
+
+    // Only the required slots are passed through the exchange, and so only these slots are
+    // visible above it.
+    PlanStageSlots outputs;
+    sbe::value::SlotVector fields;
+    for (auto&& name : {kResult, kRecordId, kReturnKey, kOplogTs}) {
+        if (reqs.has(name)) {
+            outputs.set(name, childOutputs.get(name));
+            fields.push_back(childOutputs.get(name));
+        }
+    }
+
+    stage = sbe::makeS<sbe::ExchangeConsumer>(std::move(stage),
+                                              _degreeOfParallelism,
+                                              std::move(fields),
+                                              sbe::ExchangePolicy::roundrobin,
+                                              nullptr,
+                                              nullptr,
+                                              root->nodeId());
+
+    return {std::move(stage), std::move(outputs)};
+}
+
 // Returns a non-null pointer to the root of a plan tree, or a non-OK status if the PlanStage tree
 // could not be constructed.
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder::build(
@@ -1110,9 +1735,13 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
             {STAGE_PROJECTION_DEFAULT, &SlotBasedStageBuilder::buildProjectionDefault},
             {STAGE_PROJECTION_COVERED, &SlotBasedStageBuilder::buildProjectionCovered},
             {STAGE_OR, &SlotBasedStageBuilder::buildOr},
+            {STAGE_AND_HASH, &SlotBasedStageBuilder::buildAndHashOrSorted},
+            {STAGE_AND_SORTED, &SlotBasedStageBuilder::buildAndHashOrSorted},
             {STAGE_TEXT, &SlotBasedStageBuilder::buildText},
             {STAGE_RETURN_KEY, &SlotBasedStageBuilder::buildReturnKey},
             {STAGE_EOF, &SlotBasedStageBuilder::buildEof},
+            {STAGE_GROUP, &SlotBasedStageBuilder::buildGroup},
+            {STAGE_EQ_LOOKUP, &SlotBasedStageBuilder::buildEqLookup},
             {STAGE_SORT_MERGE, &SlotBasedStageBuilder::buildSortMerge},
             {STAGE_SHARDING_FILTER, &SlotBasedStageBuilder::buildShardFilter}};
 
@@ -1139,6 +1768,13 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
             break;
     }
 
+    // If this sub-tree can be executed by several threads, and we're not already in the process of
+    // building such a sub-tree, then build it under an exchange.
+    if (_degreeOfParallelism > 1 && !reqs.getIsBuildingParallelSubtree() &&
+        !reqs.getIndexKeyBitset() && canBuildParallelSubtree(root)) {
+        return buildParallelSubtree(root, reqs);
+    }
+
     return std::invoke(kStageBuilders.at(root->getType()), *this, root, reqs);
 }
 }  // namespace mongo::stage_builder
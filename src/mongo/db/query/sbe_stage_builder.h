@@ -176,6 +176,15 @@ public:
         _isTailableCollScanResumeBranch = b;
     }
 
+    bool getIsBuildingParallelSubtree() const {
+        return _isBuildingParallelSubtree;
+    }
+
+    PlanStageReqs& setIsBuildingParallelSubtree(bool b) {
+        _isBuildingParallelSubtree = b;
+        return *this;
+    }
+
     friend PlanStageSlots::PlanStageSlots(const PlanStageReqs& reqs,
                                           sbe::value::SlotIdGenerator* slotIdGenerator);
 
@@ -197,6 +206,11 @@ private:
     // collection scan, this flag indicates whether we're currently building an anchor or resume
     // branch. At all other times, this flag will be false.
     bool _isTailableCollScanResumeBranch{false};
+
+    // When we're in the middle of building a sub-tree which is going to be cloned and executed by
+    // each of the producers of an exchange, this flag will be set to true. Otherwise this flag will
+    // be false.
+    bool _isBuildingParallelSubtree{false};
 };
 
 void PlanStageSlots::forEachSlot(const PlanStageReqs& reqs,
@@ -301,6 +315,13 @@ private:
     std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildOr(
         const QuerySolutionNode* root, const PlanStageReqs& reqs);
 
+    /**
+     * Builds both AND_HASH and AND_SORTED nodes, which differ only in the order of the RecordIds
+     * produced by their children, as a chain of hash joins on the RecordIds.
+     */
+    std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildAndHashOrSorted(
+        const QuerySolutionNode* root, const PlanStageReqs& reqs);
+
     std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildText(
         const QuerySolutionNode* root, const PlanStageReqs& reqs);
 
@@ -310,6 +331,12 @@ private:
     std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildEof(
         const QuerySolutionNode* root, const PlanStageReqs& reqs);
 
+    std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildGroup(
+        const QuerySolutionNode* root, const PlanStageReqs& reqs);
+
+    std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildEqLookup(
+        const QuerySolutionNode* root, const PlanStageReqs& reqs);
+
     std::tuple<sbe::value::SlotId, sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>>
     makeLoopJoinForFetch(std::unique_ptr<sbe::PlanStage> inputStage,
                          sbe::value::SlotId recordIdSlot,
@@ -322,6 +349,19 @@ private:
     std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildShardFilter(
         const QuerySolutionNode* root, const PlanStageReqs& reqs);
 
+    /**
+     * Returns true if the sub-tree rooted at 'root' can be executed by several threads at once,
+     * each of them producing a disjoint part of the result.
+     */
+    bool canBuildParallelSubtree(const QuerySolutionNode* root) const;
+
+    /**
+     * Builds the sub-tree rooted at 'root' so that it is executed by '_degreeOfParallelism'
+     * producers, and places an exchange on top of it to gather the produced rows.
+     */
+    std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildParallelSubtree(
+        const QuerySolutionNode* root, const PlanStageReqs& reqs);
+
     sbe::value::SlotIdGenerator _slotIdGenerator;
     sbe::value::FrameIdGenerator _frameIdGenerator;
     sbe::value::SpoolIdGenerator _spoolIdGenerator;
@@ -335,6 +375,10 @@ private:
     bool _buildHasStarted{false};
     bool _shouldProduceRecordIdSlot{true};
 
+    // The number of threads used to execute the parallel parts of the plan. A value of 1 means
+    // that the whole plan is executed by the calling thread.
+    int _degreeOfParallelism{1};
+
     // A factory to construct shard filters.
     ShardFiltererFactoryInterface* _shardFiltererFactory;
 };
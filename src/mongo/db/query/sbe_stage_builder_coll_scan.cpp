@@ -42,6 +42,8 @@
 #include "mongo/db/exec/sbe/stages/project.h"
 #include "mongo/db/exec/sbe/stages/scan.h"
 #include "mongo/db/exec/sbe/stages/union.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/sbe_stage_builder.h"
 #include "mongo/db/query/sbe_stage_builder_filter.h"
 #include "mongo/db/query/util/make_data_structure.h"
@@ -298,6 +300,92 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateOptimizedOplo
     return {std::move(stage), std::move(outputs)};
 }
 
+/**
+ * Builds a batch predicate for a generic collection scan out of the numeric comparisons against
+ * top-level fields found in the conjunction at the root of the filter 'csn->filter', if any. The
+ * fields involved are added to 'fields' and 'slots' so that the scan can extract them. The exact
+ * filter is still applied on top of the scan, so the batch predicate only needs to be a necessary
+ * condition for a document to match.
+ */
+sbe::vm::BatchPredicate makeBatchPredicateIfNeeded(const CollectionScanNode* csn,
+                                                   std::vector<std::string>& fields,
+                                                   sbe::value::SlotVector& slots,
+                                                   sbe::value::SlotIdGenerator* slotIdGenerator) {
+    sbe::vm::BatchPredicate predicate;
+    if (!csn->filter || internalQuerySlotBasedExecutionScanBatchSize.load() == 0) {
+        return predicate;
+    }
+
+    auto addTerm = [&](const MatchExpression* expr) {
+        if (!ComparisonMatchExpression::isComparisonMatchExpression(expr)) {
+            return;
+        }
+
+        auto path = expr->path();
+        if (path.empty() || path.find('.') != std::string::npos) {
+            return;
+        }
+
+        auto&& rhs = static_cast<const ComparisonMatchExpression*>(expr)->getData();
+        auto [constTag, constVal] = [&]() -> std::pair<sbe::value::TypeTags, sbe::value::Value> {
+            switch (rhs.type()) {
+                case NumberInt:
+                    return {sbe::value::TypeTags::NumberInt32,
+                            sbe::value::bitcastFrom<int32_t>(rhs.numberInt())};
+                case NumberLong:
+                    return {sbe::value::TypeTags::NumberInt64,
+                            sbe::value::bitcastFrom<int64_t>(rhs.numberLong())};
+                case NumberDouble:
+                    if (!std::isnan(rhs.numberDouble())) {
+                        return {sbe::value::TypeTags::NumberDouble,
+                                sbe::value::bitcastFrom<double>(rhs.numberDouble())};
+                    }
+                    [[fallthrough]];
+                default:
+                    return {sbe::value::TypeTags::Nothing, 0};
+            }
+        }();
+        if (constTag == sbe::value::TypeTags::Nothing) {
+            return;
+        }
+
+        auto op = [&]() {
+            switch (expr->matchType()) {
+                case MatchExpression::LT:
+                    return sbe::vm::BatchPredicate::Op::less;
+                case MatchExpression::LTE:
+                    return sbe::vm::BatchPredicate::Op::lessEq;
+                case MatchExpression::GT:
+                    return sbe::vm::BatchPredicate::Op::greater;
+                case MatchExpression::GTE:
+                    return sbe::vm::BatchPredicate::Op::greaterEq;
+                case MatchExpression::EQ:
+                    return sbe::vm::BatchPredicate::Op::eq;
+                default:
+                    MONGO_UNREACHABLE;
+            }
+        }();
+
+        auto it = std::find(fields.begin(), fields.end(), path);
+        if (it == fields.end()) {
+            fields.push_back(path.toString());
+            slots.push_back(slotIdGenerator->generate());
+            it = std::prev(fields.end());
+        }
+        predicate.addTerm(std::distance(fields.begin(), it), op, constTag, constVal);
+    };
+
+    if (csn->filter->matchType() == MatchExpression::AND) {
+        for (size_t idx = 0; idx < csn->filter->numChildren(); ++idx) {
+            addTerm(csn->filter->getChild(idx));
+        }
+    } else {
+        addTerm(csn->filter.get());
+    }
+
+    return predicate;
+}
+
 /**
  * Generates a generic collecion scan sub-tree. If a resume token has been provided, the scan will
  * start from a RecordId contained within this token, otherwise from the beginning of the
@@ -335,6 +423,11 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateGenericCollSc
     auto&& [fields, slots, tsSlot] = makeOplogTimestampSlotsIfNeeded(
         collection, slotIdGenerator, csn->shouldTrackLatestOplogTimestamp);
 
+    // Scans of the oplog and scans resuming from a given record are not run in batch mode.
+    auto batchPredicate = !collection->ns().isOplog() && !seekRecordIdSlot
+        ? makeBatchPredicateIfNeeded(csn, fields, slots, slotIdGenerator)
+        : sbe::vm::BatchPredicate{};
+
     NamespaceStringOrUUID nss{collection->ns().db().toString(), collection->uuid()};
     auto stage = sbe::makeS<sbe::ScanStage>(nss,
                                             resultSlot,
@@ -345,7 +438,9 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateGenericCollSc
                                             forward,
                                             yieldPolicy,
                                             csn->nodeId(),
-                                            makeOpenCallbackIfNeeded(collection, csn));
+                                            makeOpenCallbackIfNeeded(collection, csn),
+                                            std::move(batchPredicate),
+                                            internalQuerySlotBasedExecutionScanBatchSize.load());
 
     // Check if the scan should be started after the provided resume RecordId and construct a nested
     // loop join sub-tree to project out the resume RecordId as a seekRecordIdSlot and feed it to
@@ -482,4 +577,51 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
                                        isTailableResumeBranch);
     }
 }
+
+std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateParallelCollScan(
+    OperationContext* opCtx,
+    const CollectionPtr& collection,
+    const CollectionScanNode* csn,
+    sbe::value::SlotIdGenerator* slotIdGenerator,
+    sbe::value::FrameIdGenerator* frameIdGenerator,
+    PlanYieldPolicy* yieldPolicy,
+    sbe::RuntimeEnvironment* env) {
+    invariant(csn->direction == CollectionScanParams::FORWARD);
+    invariant(!csn->minTs && !csn->maxTs && !csn->resumeAfterRecordId);
+    invariant(!csn->tailable && !csn->shouldTrackLatestOplogTimestamp);
+
+    auto resultSlot = slotIdGenerator->generate();
+    auto recordIdSlot = slotIdGenerator->generate();
+
+    // Each worker thread runs its own clone of this sub-tree, with its own storage engine cursor.
+    // The exchange producers replace the yield policy of the query with their own, which also
+    // yields whenever the query itself is saved.
+    NamespaceStringOrUUID nss{collection->ns().db().toString(), collection->uuid()};
+    std::unique_ptr<sbe::PlanStage> stage =
+        sbe::makeS<sbe::ParallelScanStage>(nss,
+                                           resultSlot,
+                                           recordIdSlot,
+                                           std::vector<std::string>{},
+                                           sbe::makeSV(),
+                                           yieldPolicy,
+                                           csn->nodeId());
+
+    if (csn->filter) {
+        stage = generateFilter(opCtx,
+                               csn->filter.get(),
+                               std::move(stage),
+                               slotIdGenerator,
+                               frameIdGenerator,
+                               resultSlot,
+                               env,
+                               sbe::makeSV(resultSlot, recordIdSlot),
+                               csn->nodeId());
+    }
+
+    PlanStageSlots outputs;
+    outputs.set(PlanStageSlots::kResult, resultSlot);
+    outputs.set(PlanStageSlots::kRecordId, recordIdSlot);
+
+    return {std::move(stage), std::move(outputs)};
+}
 }  // namespace mongo::stage_builder
@@ -60,4 +60,21 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
     sbe::RuntimeEnvironment* env,
     bool isTailableResumeBranch);
 
+/**
+ * Generates an SBE plan stage sub-tree implementing a collection scan which can be executed by
+ * multiple threads at once, each of them scanning a different range of the collection. The scan
+ * returns the documents in no particular order. Only forward scans of non-oplog collections
+ * which don't need to be resumed are supported.
+ *
+ * Returns a resultSlot, a recordIdSlot and the generated PlanStage sub-tree.
+ */
+std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateParallelCollScan(
+    OperationContext* opCtx,
+    const CollectionPtr& collection,
+    const CollectionScanNode* csn,
+    sbe::value::SlotIdGenerator* slotIdGenerator,
+    sbe::value::FrameIdGenerator* frameIdGenerator,
+    PlanYieldPolicy* yieldPolicy,
+    sbe::RuntimeEnvironment* env);
+
 }  // namespace mongo::stage_builder
@@ -1129,6 +1129,8 @@ public:
             sbe::makeS<sbe::HashAggStage>(std::move(limitNumChildren),
                                           sbe::makeSV(),
                                           sbe::makeEM(groupSlot, std::move(addToArrayExpr)),
+                                          std::numeric_limits<std::size_t>::max(),
+                                          false /* allowDiskUse */,
                                           _context->planNodeId);
         EvalStage groupEvalStage = {std::move(groupStage), sbe::makeSV(groupSlot)};
 
@@ -1157,6 +1159,8 @@ public:
             std::move(unwindEvalStage.stage),
             sbe::makeSV(),
             sbe::makeEM(finalGroupSlot, std::move(finalAddToArrayExpr)),
+            std::numeric_limits<std::size_t>::max(),
+            false /* allowDiskUse */,
             _context->planNodeId);
 
         // Create a branch stage to select between the branch that produces one null if any eleemnts
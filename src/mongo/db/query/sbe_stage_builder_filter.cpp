@@ -403,6 +403,32 @@ void generateArraySize(MatchExpressionVisitorContext* context,
                       LeafTraversalMode::kDoNotTraverseLeaf);
 }
 
+/**
+ * Returns an expression which produces the right-hand side value 'tag' and 'val' of the comparison
+ * match expression 'expr', taking ownership of the value. If 'expr' is an input parameter of a
+ * parameterized query, the value is kept in a runtime environment slot, so that it can be replaced
+ * when the plan is reused by another query of the same shape. Otherwise, it becomes a constant.
+ */
+std::unique_ptr<sbe::EExpression> makeComparisonOperand(MatchExpressionVisitorContext* context,
+                                                        const ComparisonMatchExpression* expr,
+                                                        sbe::value::TypeTags tag,
+                                                        sbe::value::Value val) {
+    auto paramId = expr->getInputParamId();
+    if (!paramId) {
+        return sbe::makeE<sbe::EConstant>(tag, val);
+    }
+
+    auto slotName = makeInputParamSlotName(*paramId);
+    if (auto slot = context->env->getSlotIfExists(slotName)) {
+        // The same predicate has already been placed into another filter of this plan.
+        sbe::value::releaseValue(tag, val);
+        return sbe::makeE<sbe::EVariable>(*slot);
+    }
+
+    return sbe::makeE<sbe::EVariable>(
+        context->env->registerSlot(slotName, tag, val, true, context->slotIdGenerator));
+}
+
 /**
  * Generates a path traversal SBE plan stage sub-tree which implments the comparison match
  * expression 'expr'. The comparison itself executes using the given 'binaryOp'.
@@ -410,8 +436,8 @@ void generateArraySize(MatchExpressionVisitorContext* context,
 void generateComparison(MatchExpressionVisitorContext* context,
                         const ComparisonMatchExpression* expr,
                         sbe::EPrimBinary::Op binaryOp) {
-    auto makePredicate = [expr, binaryOp](sbe::value::SlotId inputSlot,
-                                          EvalStage inputStage) -> EvalExprStagePair {
+    auto makePredicate = [context, expr, binaryOp](sbe::value::SlotId inputSlot,
+                                                   EvalStage inputStage) -> EvalExprStagePair {
         const auto& rhs = expr->getData();
         auto [tagView, valView] = sbe::bson::convertFrom(
             true, rhs.rawdata(), rhs.rawdata() + rhs.size(), rhs.fieldNameSize() - 1);
@@ -479,11 +505,11 @@ void generateComparison(MatchExpressionVisitorContext* context,
                     break;
             }
         }
-        return {
-            makeFillEmptyFalse(sbe::makeE<sbe::EPrimBinary>(binaryOp,
-                                                            sbe::makeE<sbe::EVariable>(inputSlot),
-                                                            sbe::makeE<sbe::EConstant>(tag, val))),
-            std::move(inputStage)};
+        return {makeFillEmptyFalse(
+                    sbe::makeE<sbe::EPrimBinary>(binaryOp,
+                                                 sbe::makeE<sbe::EVariable>(inputSlot),
+                                                 makeComparisonOperand(context, expr, tag, val))),
+                std::move(inputStage)};
     };
 
     generatePredicate(context, expr->path(), std::move(makePredicate));
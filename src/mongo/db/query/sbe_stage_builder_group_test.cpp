@@ -0,0 +1,193 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/exec/sbe/values/bson.h"
+#include "mongo/db/exec/shard_filterer_mock.h"
+#include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/query_solution.h"
+#include "mongo/db/query/sbe_stage_builder_test_fixture.h"
+#include "mongo/db/query/shard_filterer_factory_mock.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+
+class SbeStageBuilderGroupTest : public SbeStageBuilderTestFixture {
+protected:
+    /**
+     * Runs a $group described by 'groupSpec' over 'docs' using a GroupNode on top of a
+     * VirtualScanNode, and returns the produced documents sorted by _id.
+     */
+    std::vector<BSONObj> runGroup(const std::vector<BSONObj>& docs, const BSONObj& groupSpec) {
+        auto expCtx = make_intrusive<ExpressionContextForTest>();
+        auto groupStage = dynamic_cast<DocumentSourceGroup*>(
+            DocumentSourceGroup::createFromBson(BSON("$group" << groupSpec).firstElement(), expCtx)
+                .get());
+        ASSERT(groupStage);
+
+        std::vector<BSONArray> virtScanDocs;
+        for (auto&& doc : docs) {
+            virtScanDocs.push_back(BSON_ARRAY(doc));
+        }
+
+        auto groupNode = std::make_unique<GroupNode>(groupStage->getIdFieldNames(),
+                                                     groupStage->getIdExpressions(),
+                                                     groupStage->getAccumulatedFields());
+        groupNode->children.push_back(new VirtualScanNode(virtScanDocs, false));
+
+        auto querySolution = makeQuerySolution(std::move(groupNode));
+        auto [resultSlots, stage, data] = buildPlanStage(
+            std::move(querySolution),
+            false,
+            std::make_unique<ShardFiltererFactoryMock>(
+                std::make_unique<ConstantFilterMock>(true, BSONObj{})));
+        auto resultAccessors = prepareTree(&data.ctx, stage.get(), resultSlots);
+
+        std::vector<BSONObj> results;
+        for (auto st = stage->getNext(); st == sbe::PlanState::ADVANCED; st = stage->getNext()) {
+            auto [tag, val] = resultAccessors[0]->getViewOfValue();
+            ASSERT_TRUE(tag == sbe::value::TypeTags::Object);
+
+            BSONObjBuilder bob;
+            sbe::bson::convertToBsonObj(bob, sbe::value::getObjectView(val));
+            results.push_back(bob.obj());
+        }
+
+        std::sort(results.begin(),
+                  results.end(),
+                  [](const BSONObj& lhs, const BSONObj& rhs) {
+                      return SimpleBSONElementComparator::kInstance.evaluate(lhs["_id"] <
+                                                                             rhs["_id"]);
+                  });
+        return results;
+    }
+};
+
+TEST_F(SbeStageBuilderGroupTest, GroupBySingleField) {
+    auto docs = std::vector<BSONObj>{BSON("a" << 1 << "b" << 1),
+                                     BSON("a" << 1 << "b" << 3),
+                                     BSON("a" << 2 << "b"
+                                              << "x"),
+                                     BSON("b" << 5)};
+
+    auto results = runGroup(docs,
+                            fromjson("{_id: '$a', s: {$sum: '$b'}, mn: {$min: '$b'}, "
+                                     "f: {$first: '$b'}, p: {$push: '$b'}, avg: {$avg: '$b'}}"));
+
+    ASSERT_EQ(results.size(), 3U);
+    ASSERT_BSONOBJ_EQ(results[0],
+                      fromjson("{_id: null, s: 5, mn: 5, f: 5, p: [5], avg: 5.0}"));
+    ASSERT_BSONOBJ_EQ(results[1], fromjson("{_id: 1, s: 4, mn: 1, f: 1, p: [1, 3], avg: 2.0}"));
+    ASSERT_BSONOBJ_EQ(results[2],
+                      fromjson("{_id: 2, s: 0, mn: 'x', f: 'x', p: ['x'], avg: null}"));
+}
+
+TEST_F(SbeStageBuilderGroupTest, GroupByCompoundKey) {
+    auto docs = std::vector<BSONObj>{BSON("a" << 1 << "b" << 1 << "c" << 1),
+                                     BSON("a" << 1 << "b" << 1 << "c" << 1),
+                                     BSON("a" << 1 << "c" << 2),
+                                     BSON("a" << 1 << "b" << BSONNULL << "c" << 3)};
+
+    auto results = runGroup(docs,
+                            fromjson("{_id: {x: '$a', y: '$b'}, mx: {$max: '$c'}, "
+                                     "l: {$last: '$b'}, set: {$addToSet: '$c'}}"));
+
+    ASSERT_EQ(results.size(), 3U);
+    ASSERT_BSONOBJ_EQ(results[0], fromjson("{_id: {x: 1}, mx: 2, l: null, set: [2]}"));
+    ASSERT_BSONOBJ_EQ(results[1], fromjson("{_id: {x: 1, y: null}, mx: 3, l: null, set: [3]}"));
+    ASSERT_BSONOBJ_EQ(results[2], fromjson("{_id: {x: 1, y: 1}, mx: 1, l: 1, set: [1]}"));
+}
+
+TEST_F(SbeStageBuilderGroupTest, SumAndAvgOfMixedNumericTypesMatchAccumulators) {
+    const auto kLongMax = std::numeric_limits<long long>::max();
+    const auto kIntMax = std::numeric_limits<int>::max();
+    auto docs = std::vector<BSONObj>{BSON("a" << 1 << "b" << 1),
+                                     BSON("a" << 1 << "b" << 2LL),
+                                     BSON("a" << 2 << "b" << kIntMax),
+                                     BSON("a" << 2 << "b" << 1),
+                                     BSON("a" << 3 << "b" << kLongMax),
+                                     BSON("a" << 3 << "b" << 1LL),
+                                     BSON("a" << 4 << "b" << Decimal128("0.5")),
+                                     BSON("a" << 4 << "b" << 1),
+                                     BSON("a" << 4 << "b" << 0.25)};
+    for (int i = 0; i < 10; ++i) {
+        docs.push_back(BSON("a" << 5 << "b" << 0.1));
+    }
+
+    auto results = runGroup(docs, fromjson("{_id: '$a', s: {$sum: '$b'}, avg: {$avg: '$b'}}"));
+    ASSERT_EQ(results.size(), 5U);
+
+    // An int and a long sum to a long.
+    ASSERT_EQ(results[0]["s"].type(), NumberLong);
+    ASSERT_EQ(results[0]["s"].numberLong(), 3);
+    ASSERT_EQ(results[0]["avg"].type(), NumberDouble);
+    ASSERT_EQ(results[0]["avg"].numberDouble(), 1.5);
+
+    // Ints which overflow an int sum to a long.
+    ASSERT_EQ(results[1]["s"].type(), NumberLong);
+    ASSERT_EQ(results[1]["s"].numberLong(), kIntMax + 1LL);
+
+    // Longs which overflow a long sum to a double, rather than to a decimal.
+    ASSERT_EQ(results[2]["s"].type(), NumberDouble);
+    ASSERT_EQ(results[2]["s"].numberDouble(), static_cast<double>(kLongMax) + 1.0);
+    ASSERT_EQ(results[2]["avg"].type(), NumberDouble);
+
+    // A decimal widens the sum and the average to a decimal.
+    ASSERT_EQ(results[3]["s"].type(), NumberDecimal);
+    ASSERT_TRUE(results[3]["s"].numberDecimal().isEqual(Decimal128("1.75")));
+    ASSERT_EQ(results[3]["avg"].type(), NumberDecimal);
+
+    // Doubles are summed with extended precision, so ten times 0.1 sums to exactly 1.
+    ASSERT_EQ(results[4]["s"].type(), NumberDouble);
+    ASSERT_EQ(results[4]["s"].numberDouble(), 1.0);
+    ASSERT_EQ(results[4]["avg"].numberDouble(), 0.1);
+}
+
+TEST_F(SbeStageBuilderGroupTest, EqualNumbersOfDifferentTypesGroupTogether) {
+    auto docs = std::vector<BSONObj>{BSON("a" << 1 << "b" << 1),
+                                     BSON("a" << 1LL << "b" << 1),
+                                     BSON("a" << 1.0 << "b" << 1),
+                                     BSON("a" << Decimal128("1") << "b" << 1),
+                                     BSON("a" << 2LL << "b" << 1)};
+
+    auto results = runGroup(docs, fromjson("{_id: '$a', count: {$sum: '$b'}}"));
+
+    ASSERT_EQ(results.size(), 2U);
+    ASSERT_BSONOBJ_EQ(results[0], fromjson("{_id: 1, count: 4}"));
+    ASSERT_BSONOBJ_EQ(results[1], fromjson("{_id: 2, count: 1}"));
+}
+
+TEST_F(SbeStageBuilderGroupTest, GroupOverEmptyInputProducesNoGroups) {
+    auto results = runGroup({}, fromjson("{_id: null, count: {$sum: 1}}"));
+    ASSERT_EQ(results.size(), 0U);
+}
+}  // namespace mongo
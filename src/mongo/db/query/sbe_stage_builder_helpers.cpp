@@ -41,6 +41,7 @@
 #include "mongo/db/exec/sbe/stages/union.h"
 #include "mongo/db/exec/sbe/stages/unwind.h"
 #include "mongo/db/matcher/matcher_type_set.h"
+#include "mongo/util/str.h"
 
 namespace mongo::stage_builder {
 
@@ -486,4 +487,12 @@ std::pair<sbe::value::TypeTags, sbe::value::Value> makeValue(const BSONArray& ba
     return {sbe::value::TypeTags::bsonArray, sbe::value::bitcastFrom<uint8_t*>(data)};
 }
 
+std::string makeInputParamSlotName(int32_t paramId) {
+    return str::stream() << "inputParam" << paramId;
+}
+
+std::string makeIndexBoundsSlotName(PlanNodeId nodeId, bool isLowKey) {
+    return str::stream() << (isLowKey ? "ixscanLowKey" : "ixscanHighKey") << nodeId;
+}
+
 }  // namespace mongo::stage_builder
@@ -347,4 +347,17 @@ std::pair<sbe::value::SlotVector, std::unique_ptr<sbe::PlanStage>> generateVirtu
  */
 std::pair<sbe::value::TypeTags, sbe::value::Value> makeValue(const BSONArray& ba);
 
+/**
+ * Returns the name of the runtime environment slot which holds the value of the input parameter
+ * 'paramId' in a plan built for a parameterized query.
+ */
+std::string makeInputParamSlotName(int32_t paramId);
+
+/**
+ * Returns the name of the runtime environment slot which holds the low (if 'isLowKey' is true) or
+ * the high seek key of the single-interval index scan built for the IXSCAN node 'nodeId' of a
+ * parameterized query.
+ */
+std::string makeIndexBoundsSlotName(PlanNodeId nodeId, bool isLowKey);
+
 }  // namespace mongo::stage_builder
@@ -51,6 +51,7 @@
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/sbe_stage_builder.h"
+#include "mongo/db/query/sbe_stage_builder_helpers.h"
 #include "mongo/db/query/util/make_data_structure.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/str.h"
@@ -611,14 +612,31 @@ generateGenericMultiIntervalIndexScan(const CollectionPtr& collection,
                                            sbe::makeEs(sbe::makeE<sbe::EVariable>(resultSlot))),
                 ixn->nodeId())};
 }
+/**
+ * Generates the low/high key values for the index bounds of the index scan node 'ixn'. See
+ * 'makeIntervalsFromIndexBounds()'.
+ */
+std::vector<std::pair<std::unique_ptr<KeyString::Value>, std::unique_ptr<KeyString::Value>>>
+makeIntervalsFromIndexScanNode(OperationContext* opCtx,
+                               const CollectionPtr& collection,
+                               const IndexScanNode* ixn) {
+    auto descriptor =
+        collection->getIndexCatalog()->findIndexByName(opCtx, ixn->index.identifier.catalogName);
+    auto accessMethod = collection->getIndexCatalog()->getEntry(descriptor)->accessMethod();
+    return makeIntervalsFromIndexBounds(
+        ixn->bounds,
+        ixn->direction == 1,
+        accessMethod->getSortedDataInterface()->getKeyStringVersion(),
+        accessMethod->getSortedDataInterface()->getOrdering());
+}
 }  // namespace
 
 std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateSingleIntervalIndexScan(
-    const CollectionPtr& collection,
+    const NamespaceStringOrUUID& collection,
     const std::string& indexName,
     bool forward,
-    std::unique_ptr<KeyString::Value> lowKey,
-    std::unique_ptr<KeyString::Value> highKey,
+    std::unique_ptr<sbe::EExpression> lowKeyExpr,
+    std::unique_ptr<sbe::EExpression> highKeyExpr,
     sbe::IndexKeysInclusionSet indexKeysToInclude,
     sbe::value::SlotVector indexKeySlots,
     boost::optional<sbe::value::SlotId> recordSlot,
@@ -636,17 +654,15 @@ std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateSingleInt
             sbe::makeS<sbe::CoScanStage>(planNodeId), 1, boost::none, planNodeId),
         planNodeId,
         lowKeySlot,
-        sbe::makeE<sbe::EConstant>(sbe::value::TypeTags::ksValue,
-                                   sbe::value::bitcastFrom<KeyString::Value*>(lowKey.release())),
+        std::move(lowKeyExpr),
         highKeySlot,
-        sbe::makeE<sbe::EConstant>(sbe::value::TypeTags::ksValue,
-                                   sbe::value::bitcastFrom<KeyString::Value*>(highKey.release())));
+        std::move(highKeyExpr));
 
     // Scan the index in the range {'lowKeySlot', 'highKeySlot'} (subject to inclusive or
     // exclusive boundaries), and produce a single field recordIdSlot that can be used to
     // position into the collection.
     auto ixscan = sbe::makeS<sbe::IndexScanStage>(
-        NamespaceStringOrUUID{collection->ns().db().toString(), collection->uuid()},
+        collection,
         indexName,
         forward,
         recordSlot,
@@ -668,6 +684,34 @@ std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateSingleInt
                                            planNodeId)};
 }
 
+std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateSingleIntervalIndexScan(
+    const CollectionPtr& collection,
+    const std::string& indexName,
+    bool forward,
+    std::unique_ptr<KeyString::Value> lowKey,
+    std::unique_ptr<KeyString::Value> highKey,
+    sbe::IndexKeysInclusionSet indexKeysToInclude,
+    sbe::value::SlotVector indexKeySlots,
+    boost::optional<sbe::value::SlotId> recordSlot,
+    sbe::value::SlotIdGenerator* slotIdGenerator,
+    PlanYieldPolicy* yieldPolicy,
+    PlanNodeId planNodeId) {
+    return generateSingleIntervalIndexScan(
+        NamespaceStringOrUUID{collection->ns().db().toString(), collection->uuid()},
+        indexName,
+        forward,
+        sbe::makeE<sbe::EConstant>(sbe::value::TypeTags::ksValue,
+                                   sbe::value::bitcastFrom<KeyString::Value*>(lowKey.release())),
+        sbe::makeE<sbe::EConstant>(sbe::value::TypeTags::ksValue,
+                                   sbe::value::bitcastFrom<KeyString::Value*>(highKey.release())),
+        indexKeysToInclude,
+        std::move(indexKeySlots),
+        recordSlot,
+        slotIdGenerator,
+        yieldPolicy,
+        planNodeId);
+}
+
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateIndexScan(
     OperationContext* opCtx,
     const CollectionPtr& collection,
@@ -675,17 +719,14 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateIndexScan(
     PlanStageReqs reqs,
     sbe::value::SlotIdGenerator* slotIdGenerator,
     sbe::value::SpoolIdGenerator* spoolIdGenerator,
-    PlanYieldPolicy* yieldPolicy) {
+    PlanYieldPolicy* yieldPolicy,
+    sbe::RuntimeEnvironment* env) {
     uassert(4822864, "Index scans with a filter are not supported in SBE", !ixn->filter);
 
     auto descriptor =
         collection->getIndexCatalog()->findIndexByName(opCtx, ixn->index.identifier.catalogName);
     auto accessMethod = collection->getIndexCatalog()->getEntry(descriptor)->accessMethod();
-    auto intervals =
-        makeIntervalsFromIndexBounds(ixn->bounds,
-                                     ixn->direction == 1,
-                                     accessMethod->getSortedDataInterface()->getKeyStringVersion(),
-                                     accessMethod->getSortedDataInterface()->getOrdering());
+    auto intervals = makeIntervalsFromIndexScanNode(opCtx, collection, ixn);
 
     std::unique_ptr<sbe::PlanStage> stage;
     sbe::value::SlotVector indexKeySlots;
@@ -724,14 +765,32 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateIndexScan(
     if (intervals.size() == 1) {
         // If we have just a single interval, we can construct a simplified sub-tree.
         auto&& [lowKey, highKey] = intervals[0];
+        auto makeSeekKeyExpr = [&](std::unique_ptr<KeyString::Value> key,
+                                   bool isLowKey) -> std::unique_ptr<sbe::EExpression> {
+            auto tag = sbe::value::TypeTags::ksValue;
+            auto val = sbe::value::bitcastFrom<KeyString::Value*>(key.release());
+            if (!env) {
+                return sbe::makeE<sbe::EConstant>(tag, val);
+            }
+
+            // Keep the seek keys in the runtime environment, so that they can be replaced when
+            // the plan is reused for another query of the same shape. See 'bindIndexBounds()'.
+            return sbe::makeE<sbe::EVariable>(
+                env->registerSlot(makeIndexBoundsSlotName(ixn->nodeId(), isLowKey),
+                                  tag,
+                                  val,
+                                  true,
+                                  slotIdGenerator));
+        };
         sbe::value::SlotId recordIdSlot;
 
         std::tie(recordIdSlot, stage) =
-            generateSingleIntervalIndexScan(collection,
+            generateSingleIntervalIndexScan(NamespaceStringOrUUID{collection->ns().db().toString(),
+                                                                  collection->uuid()},
                                             ixn->index.identifier.catalogName,
                                             ixn->direction == 1,
-                                            std::move(lowKey),
-                                            std::move(highKey),
+                                            makeSeekKeyExpr(std::move(lowKey), true),
+                                            makeSeekKeyExpr(std::move(highKey), false),
                                             indexKeyBitset,
                                             indexKeySlots,
                                             boost::none,  // recordSlot
@@ -821,4 +880,31 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateIndexScan(
 
     return {std::move(stage), std::move(outputs)};
 }
+
+bool bindIndexBounds(OperationContext* opCtx,
+                     const CollectionPtr& collection,
+                     const IndexScanNode* ixn,
+                     sbe::RuntimeEnvironment* env) {
+    auto lowKeySlot = env->getSlotIfExists(makeIndexBoundsSlotName(ixn->nodeId(), true));
+    auto highKeySlot = env->getSlotIfExists(makeIndexBoundsSlotName(ixn->nodeId(), false));
+    if (!lowKeySlot || !highKeySlot) {
+        return false;
+    }
+
+    auto intervals = makeIntervalsFromIndexScanNode(opCtx, collection, ixn);
+    if (intervals.size() != 1) {
+        return false;
+    }
+
+    auto&& [lowKey, highKey] = intervals[0];
+    env->resetSlot(*lowKeySlot,
+                   sbe::value::TypeTags::ksValue,
+                   sbe::value::bitcastFrom<KeyString::Value*>(lowKey.release()),
+                   true);
+    env->resetSlot(*highKeySlot,
+                   sbe::value::TypeTags::ksValue,
+                   sbe::value::bitcastFrom<KeyString::Value*>(highKey.release()),
+                   true);
+    return true;
+}
 }  // namespace mongo::stage_builder
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/sbe/values/value.h"
 #include "mongo/db/query/query_solution.h"
@@ -47,6 +48,10 @@ class PlanStageSlots;
  *
  * If the caller provides a slot ID for the 'returnKeySlot' parameter, this method will populate
  * the specified slot with the rehydrated index key for each record.
+ *
+ * If 'env' is provided and the index bounds form a single interval, the seek keys are kept in
+ * slots of this runtime environment rather than embedded as constants, so that they can later be
+ * replaced with 'bindIndexBounds()'.
  */
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateIndexScan(
     OperationContext* opCtx,
@@ -55,7 +60,19 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateIndexScan(
     PlanStageReqs reqs,
     sbe::value::SlotIdGenerator* slotIdGenerator,
     sbe::value::SpoolIdGenerator* spoolIdGenerator,
-    PlanYieldPolicy* yieldPolicy);
+    PlanYieldPolicy* yieldPolicy,
+    sbe::RuntimeEnvironment* env = nullptr);
+
+/**
+ * Stores the seek keys computed from the index bounds of 'ixn' into the runtime environment slots
+ * of a single-interval index scan previously generated for a node of the same shape with the
+ * 'env' parameter of 'generateIndexScan()'. Returns false if 'env' has no such slots, or if the
+ * bounds of 'ixn' don't form a single interval, in which case the plan cannot be reused.
+ */
+bool bindIndexBounds(OperationContext* opCtx,
+                     const CollectionPtr& collection,
+                     const IndexScanNode* ixn,
+                     sbe::RuntimeEnvironment* env);
 
 /**
  * Constructs the most simple version of an index scan from the single interval index bounds. The
@@ -88,4 +105,22 @@ std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateSingleInt
     PlanYieldPolicy* yieldPolicy,
     PlanNodeId nodeId);
 
+/**
+ * Same as above, but scans the index 'indexName' of the collection 'collection', and the seek keys
+ * are computed at runtime by the 'lowKeyExpr' and 'highKeyExpr' expressions, which may depend on
+ * correlated slots.
+ */
+std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateSingleIntervalIndexScan(
+    const NamespaceStringOrUUID& collection,
+    const std::string& indexName,
+    bool forward,
+    std::unique_ptr<sbe::EExpression> lowKeyExpr,
+    std::unique_ptr<sbe::EExpression> highKeyExpr,
+    sbe::IndexKeysInclusionSet indexKeysToInclude,
+    sbe::value::SlotVector vars,
+    boost::optional<sbe::value::SlotId> recordSlot,
+    sbe::value::SlotIdGenerator* slotIdGenerator,
+    PlanYieldPolicy* yieldPolicy,
+    PlanNodeId nodeId);
+
 }  // namespace mongo::stage_builder
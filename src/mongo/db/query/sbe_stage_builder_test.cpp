@@ -119,4 +119,48 @@ TEST_F(SbeStageBuilderTest, TestLimitOneVirtualScan) {
     }
     ASSERT_EQ(index, 1);
 }
+
+TEST_F(SbeStageBuilderTest, TestAndHashOfVirtualScans) {
+    auto makeVirtualScan = [](std::vector<int64_t> recordIds) {
+        std::vector<BSONArray> docs;
+        for (auto recordId : recordIds) {
+            docs.push_back(BSON_ARRAY(recordId << BSON("a" << recordId)));
+        }
+        return std::make_unique<VirtualScanNode>(docs, true);
+    };
+
+    // Construct a QuerySolution consisting of an AndHashNode which intersects the RecordIds of two
+    // VirtualScanNodes. The intersection is expected to preserve the order of the last child.
+    auto andHashNode = std::make_unique<AndHashNode>();
+    andHashNode->children.push_back(makeVirtualScan({1, 2, 3, 4, 5}).release());
+    andHashNode->children.push_back(makeVirtualScan({6, 4, 2, 0}).release());
+
+    // Make a QuerySolution from the root AndHashNode.
+    auto querySolution = makeQuerySolution(std::move(andHashNode));
+
+    // Translate the QuerySolution tree to an sbe::PlanStage.
+    auto shardFiltererInterface = makeAlwaysPassShardFiltererInterface();
+    auto [resultSlots, stage, data] =
+        buildPlanStage(std::move(querySolution), true, std::move(shardFiltererInterface));
+    auto resultAccessors = prepareTree(&data.ctx, stage.get(), resultSlots);
+
+    std::vector<int64_t> expected{4, 2};
+    size_t index = 0;
+    for (auto st = stage->getNext(); st == sbe::PlanState::ADVANCED; st = stage->getNext()) {
+        ASSERT_LT(index, expected.size());
+
+        // Assert that the recordIDs are what we expect.
+        auto [tag, val] = resultAccessors[0]->getViewOfValue();
+        ASSERT_TRUE(tag == sbe::value::TypeTags::NumberInt64);
+        ASSERT_EQ(expected[index], sbe::value::bitcastTo<int64_t>(val));
+
+        // Assert that the document produced from the stage is what we expect.
+        auto [tagDoc, valDoc] = resultAccessors[1]->getViewOfValue();
+        ASSERT_TRUE(tagDoc == sbe::value::TypeTags::bsonObject);
+        auto bo = BSONObj(sbe::value::bitcastTo<const char*>(valDoc));
+        ASSERT_BSONOBJ_EQ(bo, BSON("a" << expected[index]));
+        ++index;
+    }
+    ASSERT_EQ(index, expected.size());
+}
 }  // namespace mongo
@@ -39,15 +39,18 @@ StringData stageTypeToString(StageType stageType) {
         {STAGE_AND_SORTED, "AND_SORTED"_sd},
         {STAGE_CACHED_PLAN, "CACHED_PLAN"},
         {STAGE_COLLSCAN, "COLLSCAN"_sd},
+        {STAGE_COLUMN_SCAN, "COLUMN_SCAN"_sd},
         {STAGE_COUNT, "COUNT"_sd},
         {STAGE_COUNT_SCAN, "COUNT_SCAN"_sd},
         {STAGE_DELETE, "DELETE"_sd},
         {STAGE_DISTINCT_SCAN, "DISTINCT_SCAN"_sd},
         {STAGE_ENSURE_SORTED, "SORTED"_sd},
         {STAGE_EOF, "EOF"_sd},
+        {STAGE_EQ_LOOKUP, "EQ_LOOKUP"_sd},
         {STAGE_FETCH, "FETCH"_sd},
         {STAGE_GEO_NEAR_2D, "GEO_NEAR_2D"_sd},
         {STAGE_GEO_NEAR_2DSPHERE, "GEO_NEAR_2DSPHERE"_sd},
+        {STAGE_GROUP, "GROUP"_sd},
         {STAGE_IDHACK, "IDHACK"_sd},
         {STAGE_IXSCAN, "IXSCAN"_sd},
         {STAGE_LIMIT, "LIMIT"_sd},
@@ -52,6 +52,10 @@ enum StageType {
     STAGE_CACHED_PLAN,
     STAGE_COLLSCAN,
 
+    // Reads a subset of the columns of a columnstore index side by side, rebuilding the indexed
+    // part of each document instead of fetching it from the collection.
+    STAGE_COLUMN_SCAN,
+
     // A virtual scan stage that simulates a collection scan and doesn't depend on underlying
     // storage.
     STAGE_VIRTUAL_SCAN,
@@ -75,12 +79,20 @@ enum StageType {
 
     STAGE_EOF,
 
+    // Implements an equality $lookup which has been pushed down from the aggregation pipeline into
+    // the query layer.
+    STAGE_EQ_LOOKUP,
+
     STAGE_FETCH,
 
     // The two $geoNear impls imply a fetch+sort and must be stages.
     STAGE_GEO_NEAR_2D,
     STAGE_GEO_NEAR_2DSPHERE,
 
+    // Implements a $group which has been pushed down from the aggregation pipeline into the query
+    // layer.
+    STAGE_GROUP,
+
     STAGE_IDHACK,
 
     STAGE_IXSCAN,
@@ -121,6 +121,27 @@ BaseCloner::AfterStageBehavior AllDatabaseCloner::connectStage() {
     return kContinueNormally;
 }
 
+DBClientConnection* AllDatabaseCloner::getAdditionalClient(size_t workerId) {
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto it = _additionalClients.find(workerId);
+        if (it != _additionalClients.end()) {
+            return it->second;
+        }
+    }
+    auto* client = _makeClientFn();
+    client->setHandshakeValidationHook(
+        [this](const executor::RemoteCommandResponse& isMasterReply) {
+            return ensurePrimaryOrSecondary(isMasterReply);
+        });
+    uassertStatusOK(client->connect(getSource(), StringData()));
+    uassertStatusOK(replAuthenticate(client).withContext(
+        str::stream() << "Failed to authenticate to " << getSource()));
+    stdx::lock_guard<Latch> lk(_mutex);
+    _additionalClients.emplace(workerId, client);
+    return client;
+}
+
 BaseCloner::AfterStageBehavior AllDatabaseCloner::getInitialSyncIdStage() {
     auto wireVersion = static_cast<WireVersion>(getClient()->getMaxWireVersion());
     {
@@ -216,6 +237,10 @@ void AllDatabaseCloner::postStage() {
                                                                       getStorageInterface(),
                                                                       getDBPool());
         }
+        if (_makeClientFn) {
+            _currentDatabaseCloner->setGetClientFn(
+                [this](size_t workerId) { return getAdditionalClient(workerId); });
+        }
         auto dbStatus = _currentDatabaseCloner->run();
         if (dbStatus.isOK()) {
             LOGV2_DEBUG(21057,
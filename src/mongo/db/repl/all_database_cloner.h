@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <functional>
+#include <map>
 #include <vector>
 
 #include "mongo/db/repl/base_cloner.h"
@@ -64,6 +66,21 @@ public:
 
     std::string toString() const;
 
+    /**
+     * Returns a new, unconnected connection that its caller keeps valid, and shuts down on
+     * cancellation, until the initial sync attempt ends.
+     */
+    using MakeClientFn = std::function<DBClientConnection*()>;
+
+    /**
+     * Lets the DatabaseCloners clone collections concurrently over connections from
+     * 'makeClientFn'. Each concurrent clone thread gets its own connection, which the threads of
+     * later databases reuse.
+     */
+    void setMakeClientFn(MakeClientFn makeClientFn) {
+        _makeClientFn = std::move(makeClientFn);
+    }
+
 protected:
     ClonerStages getStages() final;
 
@@ -106,6 +123,13 @@ private:
      */
     AfterStageBehavior connectStage();
 
+    /**
+     * Returns the connection of the concurrent clone thread 'workerId'. The first time it is
+     * asked for, or after connecting it failed, the connection is made with _makeClientFn and
+     * connected and authenticated the same way connectStage does the cloner's own connection.
+     */
+    DBClientConnection* getAdditionalClient(size_t workerId);
+
     /**
      * Stage function that gets the wire version and initial sync ID.
      */
@@ -136,12 +160,14 @@ private:
     // (X)  Access only allowed from the main flow of control called from run() or constructor.
     // (MX) Write access with mutex from main flow of control, read access with mutex from other
     //      threads, read access allowed from main flow without mutex.
-    ConnectStage _connectStage;                              // (R)
-    ConnectStage _getInitialSyncIdStage;                     // (R)
-    ClonerStage<AllDatabaseCloner> _listDatabasesStage;      // (R)
-    std::vector<std::string> _databases;                     // (X)
-    std::unique_ptr<DatabaseCloner> _currentDatabaseCloner;  // (MX)
-    Stats _stats;                                            // (MX)
+    ConnectStage _connectStage;                                // (R)
+    ConnectStage _getInitialSyncIdStage;                       // (R)
+    ClonerStage<AllDatabaseCloner> _listDatabasesStage;        // (R)
+    std::vector<std::string> _databases;                       // (X)
+    std::unique_ptr<DatabaseCloner> _currentDatabaseCloner;    // (MX)
+    MakeClientFn _makeClientFn;                                // (X)
+    std::map<size_t, DBClientConnection*> _additionalClients;  // (M)
+    Stats _stats;                                              // (MX)
 };
 
 }  // namespace repl
@@ -75,7 +75,7 @@ CollectionBulkLoaderImpl::~CollectionBulkLoaderImpl() {
 
 Status CollectionBulkLoaderImpl::init(const std::vector<BSONObj>& secondaryIndexSpecs) {
     return _runTaskReleaseResourcesOnFailure([&secondaryIndexSpecs, this]() -> Status {
-        return writeConflictRetry(
+        auto status = writeConflictRetry(
             _opCtx.get(),
             "CollectionBulkLoader::init",
             _collection->getNss().ns(),
@@ -118,6 +118,23 @@ Status CollectionBulkLoaderImpl::init(const std::vector<BSONObj>& secondaryIndex
                 wuow.commit();
                 return Status::OK();
             });
+        if (!status.isOK()) {
+            return status;
+        }
+
+        // Documents of capped collections are inserted with their index keys one at a time. The
+        // OpObservers for system collections and internal databases must see every insert.
+        if (collectionBulkLoaderUseStorageBulkLoad && (_idIndexBlock || _secondaryIndexesBlock) &&
+            !_nss.isSystem() && !_nss.isOnInternalDb()) {
+            _recordBulkBuilder =
+                _collection->getCollection()->getRecordStore()->makeBulkBuilder(_opCtx.get());
+            LOGV2_DEBUG(5130003,
+                        2,
+                        "Initialized collection bulk loader",
+                        "namespace"_attr = _nss.ns(),
+                        "storageBulkLoad"_attr = static_cast<bool>(_recordBulkBuilder));
+        }
+        return Status::OK();
     });
 }
 
@@ -127,33 +144,39 @@ Status CollectionBulkLoaderImpl::_insertDocumentsForUncappedCollection(
     auto iter = begin;
     while (iter != end) {
         std::vector<RecordId> locs;
-        Status status = writeConflictRetry(
-            _opCtx.get(), "CollectionBulkLoaderImpl/insertDocumentsUncapped", _nss.ns(), [&] {
-                WriteUnitOfWork wunit(_opCtx.get());
-                auto insertIter = iter;
-                int bytesInBlock = 0;
-                locs.clear();
-
-                auto onRecordInserted = [&](const RecordId& location) {
-                    locs.emplace_back(location);
-                    return Status::OK();
-                };
-
-                while (insertIter != end && bytesInBlock < collectionBulkLoaderBatchSizeInBytes) {
-                    const auto& doc = *insertIter++;
-                    bytesInBlock += doc.objsize();
-                    // This version of insert will not update any indexes.
-                    const auto status =
-                        (*_collection)
-                            ->insertDocumentForBulkLoader(_opCtx.get(), doc, onRecordInserted);
-                    if (!status.isOK()) {
-                        return status;
+        Status status = Status::OK();
+        if (_recordBulkBuilder) {
+            status = _appendDocumentsToBulkBuilder(iter, end, &locs);
+        } else {
+            status = writeConflictRetry(
+                _opCtx.get(), "CollectionBulkLoaderImpl/insertDocumentsUncapped", _nss.ns(), [&] {
+                    WriteUnitOfWork wunit(_opCtx.get());
+                    auto insertIter = iter;
+                    int bytesInBlock = 0;
+                    locs.clear();
+
+                    auto onRecordInserted = [&](const RecordId& location) {
+                        locs.emplace_back(location);
+                        return Status::OK();
+                    };
+
+                    while (insertIter != end &&
+                           bytesInBlock < collectionBulkLoaderBatchSizeInBytes) {
+                        const auto& doc = *insertIter++;
+                        bytesInBlock += doc.objsize();
+                        // This version of insert will not update any indexes.
+                        const auto status =
+                            (*_collection)
+                                ->insertDocumentForBulkLoader(_opCtx.get(), doc, onRecordInserted);
+                        if (!status.isOK()) {
+                            return status;
+                        }
                     }
-                }
 
-                wunit.commit();
-                return Status::OK();
-            });
+                    wunit.commit();
+                    return Status::OK();
+                });
+        }
 
         if (!status.isOK()) {
             return status;
@@ -181,6 +204,27 @@ Status CollectionBulkLoaderImpl::_insertDocumentsForUncappedCollection(
     return Status::OK();
 }
 
+Status CollectionBulkLoaderImpl::_appendDocumentsToBulkBuilder(
+    const std::vector<BSONObj>::const_iterator begin,
+    const std::vector<BSONObj>::const_iterator end,
+    std::vector<RecordId>* locs) {
+    // The records are not written in a storage transaction, so there is nothing to retry on a
+    // write conflict and nothing to roll back on failure. A failed load drops the collection.
+    auto insertIter = begin;
+    int bytesInBlock = 0;
+    while (insertIter != end && bytesInBlock < collectionBulkLoaderBatchSizeInBytes) {
+        const auto& doc = *insertIter++;
+        bytesInBlock += doc.objsize();
+        auto loc = (*_collection)
+                       ->appendDocumentForBulkLoader(_opCtx.get(), doc, _recordBulkBuilder.get());
+        if (!loc.isOK()) {
+            return loc.getStatus();
+        }
+        locs->push_back(loc.getValue());
+    }
+    return Status::OK();
+}
+
 Status CollectionBulkLoaderImpl::_insertDocumentsForCappedCollection(
     const std::vector<BSONObj>::const_iterator begin,
     const std::vector<BSONObj>::const_iterator end) {
@@ -228,6 +272,13 @@ Status CollectionBulkLoaderImpl::commit() {
                     "namespace"_attr = _nss.ns());
         UnreplicatedWritesBlock uwb(_opCtx.get());
 
+        // Finish the bulk load first, so that the records are visible to the duplicate key removal
+        // below.
+        if (_recordBulkBuilder) {
+            _recordBulkBuilder->commit();
+            _recordBulkBuilder.reset();
+        }
+
         // Commit before deleting dups, so the dups will be removed from secondary indexes when
         // deleted.
         if (_secondaryIndexesBlock) {
@@ -342,6 +393,8 @@ Status CollectionBulkLoaderImpl::commit() {
 
 void CollectionBulkLoaderImpl::_releaseResources() {
     invariant(&cc() == _opCtx->getClient());
+    _recordBulkBuilder.reset();
+
     if (_secondaryIndexesBlock) {
         CollectionWriter collWriter(*_collection);
         _secondaryIndexesBlock->abortIndexBuild(
@@ -92,11 +92,19 @@ private:
     /**
      * For uncapped collections, we will insert documents in batches of size
      * collectionBulkLoaderBatchSizeInBytes or up to one document size greater. All insertions in a
-     * given batch will be inserted in one WriteUnitOfWork.
+     * given batch will be inserted in one WriteUnitOfWork, unless '_recordBulkBuilder' is set.
      */
     Status _insertDocumentsForUncappedCollection(const std::vector<BSONObj>::const_iterator begin,
                                                  const std::vector<BSONObj>::const_iterator end);
 
+    /**
+     * Appends documents through '_recordBulkBuilder' until collectionBulkLoaderBatchSizeInBytes or
+     * up to one document size greater have been appended, and adds their RecordIds to 'locs'.
+     */
+    Status _appendDocumentsToBulkBuilder(const std::vector<BSONObj>::const_iterator begin,
+                                         const std::vector<BSONObj>::const_iterator end,
+                                         std::vector<RecordId>* locs);
+
     /**
      * Adds document and associated RecordId to index blocks after inserting into RecordStore.
      */
@@ -108,6 +116,9 @@ private:
     NamespaceString _nss;
     std::unique_ptr<MultiIndexBlock> _idIndexBlock;
     std::unique_ptr<MultiIndexBlock> _secondaryIndexesBlock;
+    // Set if documents are appended to the empty collection through the storage engine's bulk load
+    // interface rather than inserted in storage transactions.
+    std::unique_ptr<RecordStoreBulkBuilder> _recordBulkBuilder;
     BSONObj _idIndexSpec;
     Stats _stats;
 };
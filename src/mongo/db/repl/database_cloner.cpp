@@ -31,12 +31,17 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include "mongo/base/string_data.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands/list_collections_filter.h"
 #include "mongo/db/repl/database_cloner.h"
 #include "mongo/db/repl/database_cloner_common.h"
 #include "mongo/db/repl/database_cloner_gen.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
@@ -127,9 +132,23 @@ void DatabaseCloner::postStage() {
             _stats.collectionStats.back().ns = coll.first.ns();
         }
     }
-    for (const auto& coll : _collections) {
-        auto& sourceNss = coll.first;
-        auto& collectionOptions = coll.second;
+    const auto concurrency =
+        std::min(_collections.size(),
+                 static_cast<size_t>(initialSyncMaxConcurrentCollectionClones.load()));
+    const bool succeeded = (concurrency > 1 && _getClientFn)
+        ? cloneCollectionsConcurrently(concurrency)
+        : cloneCollectionsSequentially();
+    // Abort the database cloner if a collection clone failed.
+    if (!succeeded)
+        return;
+    stdx::lock_guard<Latch> lk(_mutex);
+    _stats.end = getSharedData()->getClock()->now();
+}
+
+bool DatabaseCloner::cloneCollectionsSequentially() {
+    for (size_t index = 0; index < _collections.size(); ++index) {
+        auto& sourceNss = _collections[index].first;
+        auto& collectionOptions = _collections[index].second;
         {
             stdx::lock_guard<Latch> lk(_mutex);
             _currentCollectionCloner = std::make_unique<CollectionCloner>(sourceNss,
@@ -141,36 +160,112 @@ void DatabaseCloner::postStage() {
                                                                           getDBPool());
         }
         auto collStatus = _currentCollectionCloner->run();
-        if (collStatus.isOK()) {
-            LOGV2_DEBUG(21148,
-                        1,
-                        "collection clone finished: {namespace}",
-                        "Collection clone finished",
-                        "namespace"_attr = sourceNss);
-        } else {
-            LOGV2_ERROR(21149,
-                        "collection clone for '{namespace}' failed due to {error}",
-                        "Collection clone failed",
-                        "namespace"_attr = sourceNss,
-                        "error"_attr = collStatus.toString());
-            setSyncFailedStatus({ErrorCodes::InitialSyncFailure,
-                                 collStatus
-                                     .withContext(str::stream() << "Error cloning collection '"
-                                                                << sourceNss.toString() << "'")
-                                     .toString()});
-        }
-        {
+        reportCollectionCloneStatus(index, collStatus);
+        stdx::lock_guard<Latch> lk(_mutex);
+        finishCollectionClone(lk, index, _currentCollectionCloner.get(), collStatus);
+        _currentCollectionCloner = nullptr;
+        if (!collStatus.isOK())
+            return false;
+    }
+    return true;
+}
+
+bool DatabaseCloner::cloneCollectionsConcurrently(size_t concurrency) {
+    size_t nextIndex = 0;  // Guarded by _mutex.
+    bool failed = false;   // Guarded by _mutex.
+
+    // Clones collections on 'client' until there are none left to start or any clone has failed.
+    auto cloneCollections = [&](DBClientConnection* client) {
+        while (true) {
+            size_t index;
+            CollectionCloner* cloner;
+            {
+                stdx::lock_guard<Latch> lk(_mutex);
+                if (failed || nextIndex == _collections.size())
+                    return;
+                index = nextIndex++;
+                auto& coll = _collections[index];
+                auto& slot = _concurrentCollectionCloners[index];
+                slot = std::make_unique<CollectionCloner>(coll.first,
+                                                          coll.second,
+                                                          getSharedData(),
+                                                          getSource(),
+                                                          client,
+                                                          getStorageInterface(),
+                                                          getDBPool());
+                cloner = slot.get();
+            }
+            auto collStatus = cloner->run();
+            reportCollectionCloneStatus(index, collStatus);
             stdx::lock_guard<Latch> lk(_mutex);
-            _stats.collectionStats[_stats.clonedCollections] = _currentCollectionCloner->getStats();
-            _currentCollectionCloner = nullptr;
-            // Abort the database cloner if the collection clone failed.
+            finishCollectionClone(lk, index, cloner, collStatus);
+            _concurrentCollectionCloners.erase(index);
             if (!collStatus.isOK())
-                return;
-            _stats.clonedCollections++;
+                failed = true;
         }
+    };
+
+    std::vector<stdx::thread> workers;
+    for (size_t workerId = 1; workerId < concurrency; ++workerId) {
+        workers.emplace_back([&, workerId] {
+            const std::string threadName = str::stream()
+                << "DatabaseCloner-" << _dbName << "-" << workerId;
+            ThreadClient tc(threadName, getGlobalServiceContext());
+            DBClientConnection* client;
+            try {
+                client = _getClientFn(workerId);
+            } catch (const DBException& e) {
+                // The remaining threads, which always include this cloner's own, still clone
+                // every collection.
+                LOGV2_WARNING(5130008,
+                              "Database cloner could not open an additional connection to the "
+                              "sync source",
+                              "db"_attr = _dbName,
+                              "syncSource"_attr = getSource(),
+                              "error"_attr = e.toStatus());
+                return;
+            }
+            cloneCollections(client);
+        });
     }
+    cloneCollections(getClient());
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
     stdx::lock_guard<Latch> lk(_mutex);
-    _stats.end = getSharedData()->getClock()->now();
+    return !failed;
+}
+
+void DatabaseCloner::reportCollectionCloneStatus(size_t index, const Status& status) {
+    auto& sourceNss = _collections[index].first;
+    if (status.isOK()) {
+        LOGV2_DEBUG(21148,
+                    1,
+                    "collection clone finished: {namespace}",
+                    "Collection clone finished",
+                    "namespace"_attr = sourceNss);
+    } else {
+        LOGV2_ERROR(21149,
+                    "collection clone for '{namespace}' failed due to {error}",
+                    "Collection clone failed",
+                    "namespace"_attr = sourceNss,
+                    "error"_attr = status.toString());
+        setSyncFailedStatus({ErrorCodes::InitialSyncFailure,
+                             status
+                                 .withContext(str::stream() << "Error cloning collection '"
+                                                            << sourceNss.toString() << "'")
+                                 .toString()});
+    }
+}
+
+void DatabaseCloner::finishCollectionClone(WithLock,
+                                           size_t index,
+                                           CollectionCloner* cloner,
+                                           const Status& status) {
+    _stats.collectionStats[index] = cloner->getStats();
+    if (status.isOK())
+        _stats.clonedCollections++;
 }
 
 DatabaseCloner::Stats DatabaseCloner::getStats() const {
@@ -179,6 +274,9 @@ DatabaseCloner::Stats DatabaseCloner::getStats() const {
     if (_currentCollectionCloner) {
         stats.collectionStats[_stats.clonedCollections] = _currentCollectionCloner->getStats();
     }
+    for (const auto& [index, cloner] : _concurrentCollectionCloners) {
+        stats.collectionStats[index] = cloner->getStats();
+    }
     return stats;
 }
 
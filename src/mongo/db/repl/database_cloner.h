@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <functional>
+#include <map>
 #include <vector>
 
 #include "mongo/db/repl/base_cloner.h"
@@ -54,6 +56,13 @@ public:
         void append(BSONObjBuilder* builder) const;
     };
 
+    /**
+     * Returns the connection to the sync source of the concurrent clone thread 'workerId', which
+     * counts from 1. The connection is connected and authenticated, and stays valid until the
+     * initial sync attempt ends. Throws if no such connection can be made.
+     */
+    using GetClientFn = std::function<DBClientConnection*(size_t workerId)>;
+
     DatabaseCloner(const std::string& dbName,
                    InitialSyncSharedData* sharedData,
                    const HostAndPort& source,
@@ -67,6 +76,15 @@ public:
 
     std::string toString() const;
 
+    /**
+     * Allows postStage to clone up to 'initialSyncMaxConcurrentCollectionClones' collections at
+     * once, using connections from 'getClientFn' for all but the first. Without it collections
+     * are cloned one at a time on the cloner's own connection.
+     */
+    void setGetClientFn(GetClientFn getClientFn) {
+        _getClientFn = std::move(getClientFn);
+    }
+
     static CollectionOptions parseCollectionOptions(const BSONObj& element);
 
 protected:
@@ -93,6 +111,33 @@ private:
      */
     void postStage() final;
 
+    /**
+     * Clones the collections in _collections one after another on the cloner's own connection.
+     * Returns false if a collection clone failed.
+     */
+    bool cloneCollectionsSequentially();
+
+    /**
+     * Clones the collections in _collections on 'concurrency' threads, each of which takes the
+     * next uncloned collection until none are left or a clone fails. Returns false if a
+     * collection clone failed.
+     */
+    bool cloneCollectionsConcurrently(size_t concurrency);
+
+    /**
+     * Logs the outcome of the collection clone at 'index', and fails the initial sync attempt if
+     * the clone failed.
+     */
+    void reportCollectionCloneStatus(size_t index, const Status& status);
+
+    /**
+     * Records the outcome of the collection clone at 'index' in _stats.
+     */
+    void finishCollectionClone(WithLock,
+                               size_t index,
+                               CollectionCloner* cloner,
+                               const Status& status);
+
     std::string describeForFuzzer(BaseClonerStage* stage) const final {
         return _dbName + " db: { " + stage->getName() + ": 1 } ";
     }
@@ -106,11 +151,13 @@ private:
     // (X)  Access only allowed from the main flow of control called from run() or constructor.
     // (MX) Write access with mutex from main flow of control, read access with mutex from other
     //      threads, read access allowed from main flow without mutex.
-    const std::string _dbName;                                                // (R)
-    ClonerStage<DatabaseCloner> _listCollectionsStage;                        // (R)
-    std::vector<std::pair<NamespaceString, CollectionOptions>> _collections;  // (X)
-    std::unique_ptr<CollectionCloner> _currentCollectionCloner;               // (MX)
-    Stats _stats;                                                             // (MX)
+    const std::string _dbName;                                                         // (R)
+    ClonerStage<DatabaseCloner> _listCollectionsStage;                                 // (R)
+    std::vector<std::pair<NamespaceString, CollectionOptions>> _collections;           // (X)
+    std::unique_ptr<CollectionCloner> _currentCollectionCloner;                        // (MX)
+    std::map<size_t, std::unique_ptr<CollectionCloner>> _concurrentCollectionCloners;  // (M)
+    GetClientFn _getClientFn;                                                          // (X)
+    Stats _stats;                                                                      // (MX)
 };
 
 }  // namespace repl
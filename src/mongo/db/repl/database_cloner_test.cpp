@@ -32,6 +32,7 @@
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/repl/database_cloner.h"
 #include "mongo/db/repl/initial_sync_cloner_test_fixture.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/service_context_test_fixture.h"
@@ -39,6 +40,7 @@
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
 #include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace repl {
@@ -396,6 +398,108 @@ TEST_F(DatabaseClonerTest, CreateCollections) {
     ASSERT(stats.commitCalled);
 }
 
+// A cloner allowed to clone collections concurrently still clones all of them on its own
+// connection when it cannot open any additional ones.
+TEST_F(DatabaseClonerTest, ConcurrentCloneFallsBackToOwnConnection) {
+    auto concurrencyDefault = initialSyncMaxConcurrentCollectionClones.load();
+    initialSyncMaxConcurrentCollectionClones.store(2);
+    ON_BLOCK_EXIT([&] { initialSyncMaxConcurrentCollectionClones.store(concurrencyDefault); });
+
+    const BSONObj idIndexSpec = BSON("v" << 1 << "key" << BSON("_id" << 1) << "name"
+                                         << "_id_");
+    const std::vector<BSONObj> sourceInfos = {
+        BSON("name"
+             << "a"
+             << "type"
+             << "collection"
+             << "options" << BSONObj() << "info"
+             << BSON("readOnly" << false << "uuid" << UUID::gen())),
+        BSON("name"
+             << "b"
+             << "type"
+             << "collection"
+             << "options" << BSONObj() << "info"
+             << BSON("readOnly" << false << "uuid" << UUID::gen()))};
+    _mockServer->setCommandReply("listCollections",
+                                 createListCollectionsResponse({sourceInfos[0], sourceInfos[1]}));
+    _mockServer->setCommandReply("collStats", BSON("size" << 0));
+    _mockServer->setCommandReply("count", {createCountResponse(0), createCountResponse(0)});
+    _mockServer->setCommandReply("listIndexes",
+                                 {createCursorResponse(_dbName + ".a", BSON_ARRAY(idIndexSpec)),
+                                  createCursorResponse(_dbName + ".b", BSON_ARRAY(idIndexSpec))});
+    auto cloner = makeDatabaseCloner();
+    cloner->setGetClientFn([](size_t) -> DBClientConnection* {
+        uasserted(ErrorCodes::HostUnreachable, "Sync source is unreachable");
+    });
+    ASSERT_OK(cloner->run());
+
+    auto stats = cloner->getStats();
+    ASSERT_EQUALS(2U, stats.collections);
+    ASSERT_EQUALS(2U, stats.clonedCollections);
+    ASSERT_EQUALS(_dbName + ".a", stats.collectionStats[0].ns);
+    ASSERT_EQUALS(_dbName + ".b", stats.collectionStats[1].ns);
+    ASSERT(_collections[NamespaceString{_dbName, "a"}].stats->commitCalled);
+    ASSERT(_collections[NamespaceString{_dbName, "b"}].stats->commitCalled);
+}
+
+// Two collections cloned concurrently are each cloned on their own connection, at the same time.
+TEST_F(DatabaseClonerTest, ConcurrentCloneUsesAnAdditionalConnection) {
+    auto concurrencyDefault = initialSyncMaxConcurrentCollectionClones.load();
+    initialSyncMaxConcurrentCollectionClones.store(2);
+    ON_BLOCK_EXIT([&] { initialSyncMaxConcurrentCollectionClones.store(concurrencyDefault); });
+
+    const BSONObj idIndexSpec = BSON("v" << 1 << "key" << BSON("_id" << 1) << "name"
+                                         << "_id_");
+    const std::vector<BSONObj> sourceInfos = {
+        BSON("name"
+             << "a"
+             << "type"
+             << "collection"
+             << "options" << BSONObj() << "info"
+             << BSON("readOnly" << false << "uuid" << UUID::gen())),
+        BSON("name"
+             << "b"
+             << "type"
+             << "collection"
+             << "options" << BSONObj() << "info"
+             << BSON("readOnly" << false << "uuid" << UUID::gen()))};
+    _mockServer->setCommandReply("listCollections",
+                                 createListCollectionsResponse({sourceInfos[0], sourceInfos[1]}));
+    _mockServer->setCommandReply("collStats", BSON("size" << 0));
+    _mockServer->setCommandReply("count", {createCountResponse(0), createCountResponse(0)});
+    _mockServer->setCommandReply("listIndexes",
+                                 {createCursorResponse(_dbName + ".a", BSON_ARRAY(idIndexSpec)),
+                                  createCursorResponse(_dbName + ".b", BSON_ARRAY(idIndexSpec))});
+    auto cloner = makeDatabaseCloner();
+    MockDBClientConnection additionalClient(_mockServer.get(), true /* autoReconnect */);
+    std::vector<size_t> workerIds;
+    cloner->setGetClientFn([&](size_t workerId) -> DBClientConnection* {
+        workerIds.push_back(workerId);
+        return &additionalClient;
+    });
+
+    // Both collection clones hang at once, which they can only do on separate connections.
+    auto collClonerFailPoint = globalFailPointRegistry().find("hangBeforeClonerStage");
+    auto timesEntered = collClonerFailPoint->setMode(
+        FailPoint::alwaysOn, 0, fromjson("{cloner: 'CollectionCloner', stage: 'count'}"));
+
+    stdx::thread clonerThread([&] {
+        Client::initThread("ClonerRunner");
+        ASSERT_OK(cloner->run());
+    });
+    collClonerFailPoint->waitForTimesEntered(timesEntered + 2);
+    collClonerFailPoint->setMode(FailPoint::off, 0);
+    clonerThread.join();
+
+    ASSERT_EQUALS(1U, workerIds.size());
+    ASSERT_EQUALS(1U, workerIds.front());
+    auto stats = cloner->getStats();
+    ASSERT_EQUALS(2U, stats.collections);
+    ASSERT_EQUALS(2U, stats.clonedCollections);
+    ASSERT(_collections[NamespaceString{_dbName, "a"}].stats->commitCalled);
+    ASSERT(_collections[NamespaceString{_dbName, "b"}].stats->commitCalled);
+}
+
 TEST_F(DatabaseClonerTest, DatabaseAndCollectionStats) {
     auto uuid1 = UUID::gen();
     auto uuid2 = UUID::gen();
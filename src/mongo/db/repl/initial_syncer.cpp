@@ -338,6 +338,9 @@ void InitialSyncer::_cancelRemainingWork_inlock() {
     if (_client) {
         _client->shutdownAndDisallowReconnect();
     }
+    for (auto& client : _clonerClients) {
+        client->shutdownAndDisallowReconnect();
+    }
     _shutdownComponent_inlock(_applier);
     _shutdownComponent_inlock(_fCVFetcher);
     _shutdownComponent_inlock(_lastOplogEntryFetcher);
@@ -380,6 +383,16 @@ bool InitialSyncer::_isShuttingDown_inlock() const {
     return State::kShuttingDown == _state;
 }
 
+DBClientConnection* InitialSyncer::_makeClonerClient() {
+    stdx::lock_guard<Latch> lock(_mutex);
+    {
+        stdx::lock_guard<InitialSyncSharedData> sharedDataLock(*_sharedData);
+        uassertStatusOK(_sharedData->getStatus(sharedDataLock));
+    }
+    _clonerClients.push_back(_createClientFn());
+    return _clonerClients.back().get();
+}
+
 std::string InitialSyncer::getDiagnosticString() const {
     LockGuard lk(_mutex);
     str::stream out;
@@ -1133,6 +1146,7 @@ void InitialSyncer::_fcvFetcherCallback(const StatusWith<Fetcher::QueryResponse>
     _client = _createClientFn();
     _initialSyncState = std::make_unique<InitialSyncState>(std::make_unique<AllDatabaseCloner>(
         _sharedData.get(), _syncSource, _client.get(), _storage, _writerPool));
+    _initialSyncState->allDatabaseCloner->setMakeClientFn([this] { return _makeClonerClient(); });
 
     // Create oplog applier.
     auto consistencyMarkers = _replicationProcess->getConsistencyMarkers();
@@ -1335,6 +1349,10 @@ void InitialSyncer::_allDatabaseClonerCallback(
 
     stdx::lock_guard<Latch> lock(_mutex);
     _client.reset();
+    for (auto& client : _clonerClients) {
+        client->shutdownAndDisallowReconnect();
+    }
+    _clonerClients.clear();
     auto status = _checkForShutdownAndConvertStatus_inlock(databaseClonerFinishStatus,
                                                            "error cloning databases");
     if (!status.isOK()) {
@@ -337,6 +337,13 @@ private:
     bool _isShuttingDown() const;
     bool _isShuttingDown_inlock() const;
 
+    /**
+     * Creates an additional, unconnected connection for the cloners of the current attempt. The
+     * connection is shut down along with _client, and destroyed once data cloning is done.
+     * Throws if the attempt has already been canceled.
+     */
+    DBClientConnection* _makeClonerClient();
+
     /**
      * Initial sync flowchart:
      *
@@ -748,6 +755,9 @@ private:
     std::unique_ptr<OplogBuffer> _oplogBuffer;    // (M)
     std::unique_ptr<OplogApplier> _oplogApplier;  // (M)
 
+    // Connections to the sync source the cloners made in addition to _client.
+    std::vector<std::unique_ptr<DBClientConnection>> _clonerClients;  // (M)
+
     // Used to signal changes in _state.
     mutable stdx::condition_variable _stateCondition;
 
@@ -115,6 +115,7 @@ void _addOplogChainOpsToWriterVectors(OperationContext* opCtx,
                                       std::vector<std::vector<OplogEntry>>* derivedOps,
                                       OplogEntry* op,
                                       CachedCollectionProperties* collPropertiesCache,
+                                      WriterAssignments* writerAssignments,
                                       std::vector<std::vector<const OplogEntry*>>* writerVectors) {
     std::vector<OplogEntry> txnOps;
     bool shouldSerialize = false;
@@ -124,8 +125,12 @@ void _addOplogChainOpsToWriterVectors(OperationContext* opCtx,
     partialTxnList->clear();
 
     // Transaction entries cannot have different session updates.
-    OplogApplierUtils::addDerivedOps(
-        opCtx, &derivedOps->back(), writerVectors, collPropertiesCache, shouldSerialize);
+    OplogApplierUtils::addDerivedOps(opCtx,
+                                     &derivedOps->back(),
+                                     writerVectors,
+                                     collPropertiesCache,
+                                     writerAssignments,
+                                     shouldSerialize);
 }
 
 }  // namespace
@@ -482,12 +487,24 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
             _writerPool->getStats().numThreads);
         fillWriterVectors(opCtx, &ops, &writerVectors, &derivedOps);
 
-        // Wait for writes to finish before applying ops.
-        _writerPool->waitForIdle();
+        // Applying a command may read oplog entries back, so a batch holding one waits for its
+        // oplog writes to finish. A batch of CRUD ops is applied on the writer threads as they free
+        // up from the oplog writes instead. Such a batch is covered by minValid before any of it is
+        // applied, and the oplog truncate-after point stays set until both the oplog writes and the
+        // application are done, so a crash in between still truncates the partial batch away.
+        const bool overlapOplogWrites = !getOptions().skipWritesToOplog &&
+            oplogApplicationOverlapsOplogWrites.load() &&
+            std::none_of(ops.begin(), ops.end(), [](const auto& op) { return op.isCommand(); });
+
+        if (!overlapOplogWrites) {
+            // Wait for writes to finish before applying ops.
+            _writerPool->waitForIdle();
+        }
 
         // Use this fail point to hold the PBWM lock after we have written the oplog entries but
         // before we have applied them.
         if (MONGO_unlikely(pauseBatchApplicationAfterWritingOplogEntries.shouldFail())) {
+            _writerPool->waitForIdle();
             LOGV2(21231,
                   "pauseBatchApplicationAfterWritingOplogEntries fail point enabled. Blocking "
                   "until fail point is disabled");
@@ -496,7 +513,9 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
 
         // Reset consistency markers in case the node fails while applying ops.
         if (!getOptions().skipWritesToOplog) {
-            _consistencyMarkers->setOplogTruncateAfterPoint(opCtx, Timestamp());
+            if (!overlapOplogWrites) {
+                _consistencyMarkers->setOplogTruncateAfterPoint(opCtx, Timestamp());
+            }
             _consistencyMarkers->setMinValidToAtLeast(opCtx, ops.back().getOpTime());
         }
 
@@ -551,6 +570,11 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
                     return status;
                 }
             }
+
+            // Every oplog write of the batch has finished by now as well.
+            if (overlapOplogWrites) {
+                _consistencyMarkers->setOplogTruncateAfterPoint(opCtx, Timestamp());
+            }
         }
     }
 
@@ -618,7 +642,8 @@ void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
     std::vector<OplogEntry>* ops,
     std::vector<std::vector<const OplogEntry*>>* writerVectors,
     std::vector<std::vector<OplogEntry>>* derivedOps,
-    SessionUpdateTracker* sessionUpdateTracker) noexcept {
+    SessionUpdateTracker* sessionUpdateTracker,
+    WriterAssignments* writerAssignments) noexcept {
 
     LogicalSessionIdMap<std::vector<OplogEntry*>> partialTxnOps;
     CachedCollectionProperties collPropertiesCache;
@@ -638,6 +663,7 @@ void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
                                                  &derivedOps->back(),
                                                  writerVectors,
                                                  &collPropertiesCache,
+                                                 writerAssignments,
                                                  false /*serial*/);
             }
         }
@@ -674,8 +700,13 @@ void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
                 // oplog and fill writers with those operations.
                 // Flush partialTxnList operations for current transaction.
                 auto& partialTxnList = partialTxnOps[*logicalSessionId];
-                _addOplogChainOpsToWriterVectors(
-                    opCtx, &partialTxnList, derivedOps, &op, &collPropertiesCache, writerVectors);
+                _addOplogChainOpsToWriterVectors(opCtx,
+                                                 &partialTxnList,
+                                                 derivedOps,
+                                                 &op,
+                                                 &collPropertiesCache,
+                                                 writerAssignments,
+                                                 writerVectors);
             } else {
                 // The applyOps entry was not generated as part of a transaction.
                 invariant(!op.getPrevWriteOpTimeInTransaction());
@@ -687,6 +718,7 @@ void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
                                                  &derivedOps->back(),
                                                  writerVectors,
                                                  &collPropertiesCache,
+                                                 writerAssignments,
                                                  false /*serial*/);
             }
             continue;
@@ -698,12 +730,18 @@ void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
         if (op.isPreparedCommit() && (getOptions().mode == OplogApplication::Mode::kInitialSync)) {
             auto logicalSessionId = op.getSessionId();
             auto& partialTxnList = partialTxnOps[*logicalSessionId];
-            _addOplogChainOpsToWriterVectors(
-                opCtx, &partialTxnList, derivedOps, &op, &collPropertiesCache, writerVectors);
+            _addOplogChainOpsToWriterVectors(opCtx,
+                                             &partialTxnList,
+                                             derivedOps,
+                                             &op,
+                                             &collPropertiesCache,
+                                             writerAssignments,
+                                             writerVectors);
             continue;
         }
 
-        OplogApplierUtils::addToWriterVector(opCtx, &op, writerVectors, &collPropertiesCache);
+        OplogApplierUtils::addToWriterVector(
+            opCtx, &op, writerVectors, &collPropertiesCache, writerAssignments);
     }
 }
 
@@ -713,14 +751,22 @@ void OplogApplierImpl::fillWriterVectors(
     std::vector<std::vector<const OplogEntry*>>* writerVectors,
     std::vector<std::vector<OplogEntry>>* derivedOps) noexcept {
 
+    // Both passes share the writer assignments, so that a session's transactions table update
+    // flushed by the second pass goes to the same writer as its updates from the first pass.
     SessionUpdateTracker sessionUpdateTracker;
-    _deriveOpsAndFillWriterVectors(opCtx, ops, writerVectors, derivedOps, &sessionUpdateTracker);
+    WriterAssignments writerAssignments;
+    _deriveOpsAndFillWriterVectors(
+        opCtx, ops, writerVectors, derivedOps, &sessionUpdateTracker, &writerAssignments);
 
     auto newOplogWrites = sessionUpdateTracker.flushAll();
     if (!newOplogWrites.empty()) {
         derivedOps->emplace_back(std::move(newOplogWrites));
-        _deriveOpsAndFillWriterVectors(
-            opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr);
+        _deriveOpsAndFillWriterVectors(opCtx,
+                                       &derivedOps->back(),
+                                       writerVectors,
+                                       derivedOps,
+                                       nullptr,
+                                       &writerAssignments);
     }
 }
 
@@ -61,12 +61,14 @@
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/replication_process.h"
 #include "mongo/db/repl/storage_interface.h"
+#include "mongo/db/repl/storage_interface_impl.h"
 #include "mongo/db/service_context_d_test_fixture.h"
 #include "mongo/db/session_catalog_mongod.h"
 #include "mongo/db/session_txn_record_gen.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/transaction_participant_gen.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
@@ -458,6 +460,259 @@ TEST_F(OplogApplierImplTest,
                                                      createOplogCollectionOptions()));
 }
 
+/**
+ * Records the ops each writer was given instead of applying them.
+ */
+class TrackWriterVectorsApplier : public OplogApplierImpl {
+public:
+    using OplogApplierImpl::OplogApplierImpl;
+
+    Status applyOplogBatchPerWorker(OperationContext* opCtx,
+                                    std::vector<const OplogEntry*>* ops,
+                                    WorkerMultikeyPathInfo* workerMultikeyPathInfo) override {
+        std::vector<OplogEntry> writerOps;
+        for (auto&& opPtr : *ops) {
+            writerOps.push_back(*opPtr);
+        }
+        stdx::lock_guard<Latch> lk(_mutex);
+        writerVectors.push_back(std::move(writerOps));
+        return Status::OK();
+    }
+
+    std::vector<std::vector<OplogEntry>> writerVectors;
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("TrackWriterVectorsApplier::_mutex");
+};
+
+TEST_F(OplogApplierImplTest, MultiApplyAssignsTheTransactionTableUpdatesOfASessionToOneWriter) {
+    NamespaceString nss("test." + _agent.getSuiteName() + "_" + _agent.getTestName());
+    auto uuid = createCollectionWithUuid(_opCtx.get(), nss);
+    auto lsid = makeLogicalSessionId(_opCtx.get());
+
+    // The commit of a transaction updates the transactions table right away, while the update for
+    // the later retryable write is only flushed once the rest of the batch has been assigned.
+    auto commitOp = makeCommandOplogEntryWithSessionInfoAndStmtId(
+        {Timestamp(Seconds(1), 1), 1LL},
+        NamespaceString{"admin", "$cmd"},
+        BSON("applyOps" << BSON_ARRAY(BSON("op"
+                                           << "i"
+                                           << "ns" << nss.ns() << "ui" << uuid << "o"
+                                           << BSON("_id" << 1)))),
+        lsid,
+        TxnNumber(1),
+        StmtId(0),
+        OpTime());
+    auto retryableWriteOp = makeInsertDocumentOplogEntryWithSessionInfoAndStmtId(
+        {Timestamp(Seconds(1), 2), 1LL}, nss, uuid, BSON("_id" << 2), lsid, TxnNumber(2), 0);
+
+    auto writerPool = makeReplWriterPool();
+    ASSERT_GT(writerPool->getStats().numThreads, 1U);
+    NoopOplogApplierObserver observer;
+    TrackWriterVectorsApplier oplogApplier(
+        nullptr,  // executor
+        nullptr,  // oplogBuffer
+        &observer,
+        ReplicationCoordinator::get(_opCtx.get()),
+        getConsistencyMarkers(),
+        getStorageInterface(),
+        repl::OplogApplier::Options(repl::OplogApplication::Mode::kSecondary),
+        writerPool.get());
+    ASSERT_EQUALS(retryableWriteOp.getOpTime(),
+                  unittest::assertGet(
+                      oplogApplier.applyOplogBatch(_opCtx.get(), {commitOp, retryableWriteOp})));
+
+    std::vector<OpTime> txnTableUpdateOpTimes;
+    for (auto&& writerOps : oplogApplier.writerVectors) {
+        for (auto&& op : writerOps) {
+            if (op.getNss() == NamespaceString::kSessionTransactionsTableNamespace) {
+                txnTableUpdateOpTimes.push_back(op.getOpTime());
+            }
+        }
+        if (!txnTableUpdateOpTimes.empty()) {
+            // Both updates are on this writer, in the order of the batch.
+            ASSERT_EQUALS(2U, txnTableUpdateOpTimes.size());
+            ASSERT_EQUALS(commitOp.getOpTime(), txnTableUpdateOpTimes[0]);
+            ASSERT_EQUALS(retryableWriteOp.getOpTime(), txnTableUpdateOpTimes[1]);
+            return;
+        }
+    }
+    FAIL("No writer was given the transactions table updates");
+}
+
+TEST_F(OplogApplierImplTest, MultiApplyCrudBatchOverlappingItsOplogWritesResetsConsistencyMarkers) {
+    NamespaceString nss("local." + _agent.getSuiteName() + "_" + _agent.getTestName());
+    createCollection(_opCtx.get(), nss, CollectionOptions());
+    ASSERT_TRUE(oplogApplicationOverlapsOplogWrites.load());
+
+    std::vector<OplogEntry> ops;
+    for (int i = 0; i < 3; ++i) {
+        ops.push_back(makeInsertDocumentOplogEntry(
+            {Timestamp(Seconds(1), i + 1), 1LL}, nss, BSON("_id" << i)));
+    }
+
+    auto writerPool = makeReplWriterPool();
+    NoopOplogApplierObserver observer;
+    OplogApplierImpl oplogApplier(
+        nullptr,  // executor
+        nullptr,  // oplogBuffer
+        &observer,
+        ReplicationCoordinator::get(_opCtx.get()),
+        getConsistencyMarkers(),
+        getStorageInterface(),
+        repl::OplogApplier::Options(repl::OplogApplication::Mode::kSecondary),
+        writerPool.get());
+    ASSERT_EQUALS(ops.back().getOpTime(),
+                  unittest::assertGet(oplogApplier.applyOplogBatch(_opCtx.get(), ops)));
+
+    // The batch only returns once both its oplog writes and its application have finished, so the
+    // truncate-after point must be reset and minValid must cover the whole batch.
+    ASSERT_EQUALS(Timestamp(), getConsistencyMarkers()->getOplogTruncateAfterPoint(_opCtx.get()));
+    ASSERT_EQUALS(ops.back().getOpTime(), getConsistencyMarkers()->getMinValid(_opCtx.get()));
+    ASSERT_EQUALS(
+        3LL, AutoGetCollectionForRead(_opCtx.get(), nss).getCollection()->numRecords(_opCtx.get()));
+}
+
+/**
+ * Holds back every write to the oplog until it is released or 'blockFor' has passed, so that tests
+ * can tell whether a batch is applied while its oplog writes are still in flight.
+ */
+class OplogWritesBlockingStorageInterface : public StorageInterfaceImpl {
+public:
+    explicit OplogWritesBlockingStorageInterface(Milliseconds blockFor) : _blockFor(blockFor) {}
+
+    Status insertDocuments(OperationContext* opCtx,
+                           const NamespaceStringOrUUID& nsOrUUID,
+                           const std::vector<InsertStatement>& docs) override {
+        if (nsOrUUID.nss() != NamespaceString::kRsOplogNamespace) {
+            return StorageInterfaceImpl::insertDocuments(opCtx, nsOrUUID, docs);
+        }
+
+        {
+            stdx::unique_lock<Latch> lk(_mutex);
+            _cv.wait_for(lk, _blockFor.toSystemDuration(), [&] { return _released; });
+        }
+        auto status = StorageInterfaceImpl::insertDocuments(opCtx, nsOrUUID, docs);
+        stdx::lock_guard<Latch> lk(_mutex);
+        _oplogWritten = true;
+        return status;
+    }
+
+    void release() {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _released = true;
+        _cv.notify_all();
+    }
+
+    bool oplogWritten() {
+        stdx::lock_guard<Latch> lk(_mutex);
+        return _oplogWritten;
+    }
+
+private:
+    const Milliseconds _blockFor;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("OplogWritesBlockingStorageInterface::_mutex");
+    stdx::condition_variable _cv;
+    bool _released = false;
+    bool _oplogWritten = false;
+};
+
+TEST_F(OplogApplierImplTest, MultiApplyCrudBatchAppliesOpsWhileItsOplogWritesAreInFlight) {
+    NamespaceString nss("test." + _agent.getSuiteName() + "_" + _agent.getTestName());
+    createCollection(_opCtx.get(), nss, CollectionOptions());
+    ASSERT_TRUE(oplogApplicationOverlapsOplogWrites.load());
+
+    OpTime lastApplied({Timestamp(Seconds(1), 0), 1LL});
+    ReplicationCoordinator::get(_opCtx.get())->setMyLastAppliedOpTimeAndWallTime({lastApplied, {}});
+
+    std::vector<OplogEntry> ops;
+    for (int i = 0; i < 3; ++i) {
+        ops.push_back(makeInsertDocumentOplogEntry(
+            {Timestamp(Seconds(1), i + 1), 1LL}, nss, BSON("_id" << i)));
+    }
+
+    // The oplog writes are only released by the application of the batch. Should the batch wait
+    // for them, they are released by the timeout instead and the test fails below.
+    OplogWritesBlockingStorageInterface storageInterface(Seconds(10));
+    bool applied = false;
+    bool oplogWrittenWhenApplied = false;
+    Timestamp truncateAfterPointWhenApplied;
+    _opObserver->onInsertsFn = [&](OperationContext* opCtx,
+                                   const NamespaceString& insertNss,
+                                   const std::vector<BSONObj>&) {
+        if (insertNss != nss || applied) {
+            return;
+        }
+        applied = true;
+        oplogWrittenWhenApplied = storageInterface.oplogWritten();
+        truncateAfterPointWhenApplied = getConsistencyMarkers()->getOplogTruncateAfterPoint(opCtx);
+        storageInterface.release();
+    };
+
+    auto writerPool = makeReplWriterPool();
+    NoopOplogApplierObserver observer;
+    OplogApplierImpl oplogApplier(
+        nullptr,  // executor
+        nullptr,  // oplogBuffer
+        &observer,
+        ReplicationCoordinator::get(_opCtx.get()),
+        getConsistencyMarkers(),
+        &storageInterface,
+        repl::OplogApplier::Options(repl::OplogApplication::Mode::kSecondary),
+        writerPool.get());
+    ASSERT_EQUALS(ops.back().getOpTime(),
+                  unittest::assertGet(oplogApplier.applyOplogBatch(_opCtx.get(), ops)));
+
+    // While the oplog writes were in flight the truncate-after point covered the partial batch.
+    ASSERT_TRUE(applied);
+    ASSERT_FALSE(oplogWrittenWhenApplied);
+    ASSERT_EQUALS(lastApplied.getTimestamp(), truncateAfterPointWhenApplied);
+
+    ASSERT_TRUE(storageInterface.oplogWritten());
+    ASSERT_EQUALS(Timestamp(), getConsistencyMarkers()->getOplogTruncateAfterPoint(_opCtx.get()));
+}
+
+TEST_F(OplogApplierImplTest, MultiApplyCommandBatchWaitsForItsOplogWritesBeforeApplyingOps) {
+    NamespaceString nss("test." + _agent.getSuiteName() + "_" + _agent.getTestName());
+    ASSERT_TRUE(oplogApplicationOverlapsOplogWrites.load());
+
+    // Nothing releases the oplog writes, so a batch which does not wait for them is applied while
+    // they are held back.
+    OplogWritesBlockingStorageInterface storageInterface(Milliseconds(200));
+    bool applied = false;
+    bool oplogWrittenWhenApplied = false;
+    _opObserver->onCreateCollectionFn = [&](OperationContext*,
+                                            const CollectionPtr&,
+                                            const NamespaceString& collectionName,
+                                            const CollectionOptions&,
+                                            const BSONObj&) {
+        if (collectionName == nss) {
+            applied = true;
+            oplogWrittenWhenApplied = storageInterface.oplogWritten();
+        }
+    };
+
+    auto op = makeCreateCollectionOplogEntry({Timestamp(Seconds(1), 1), 1LL}, nss);
+    auto writerPool = makeReplWriterPool();
+    NoopOplogApplierObserver observer;
+    OplogApplierImpl oplogApplier(
+        nullptr,  // executor
+        nullptr,  // oplogBuffer
+        &observer,
+        ReplicationCoordinator::get(_opCtx.get()),
+        getConsistencyMarkers(),
+        &storageInterface,
+        repl::OplogApplier::Options(repl::OplogApplication::Mode::kSecondary),
+        writerPool.get());
+    ASSERT_EQUALS(op.getOpTime(),
+                  unittest::assertGet(oplogApplier.applyOplogBatch(_opCtx.get(), {op})));
+
+    ASSERT_TRUE(applied);
+    ASSERT_TRUE(oplogWrittenWhenApplied);
+    ASSERT_EQUALS(Timestamp(), getConsistencyMarkers()->getOplogTruncateAfterPoint(_opCtx.get()));
+}
+
 TEST_F(OplogApplierImplTest,
        OplogApplicationThreadFuncUsesApplyOplogEntryOrGroupedInsertsToApplyOperation) {
     NamespaceString nss("local." + _agent.getSuiteName() + "_" + _agent.getTestName());
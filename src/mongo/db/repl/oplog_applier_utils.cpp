@@ -74,6 +74,34 @@ CachedCollectionProperties::getCollectionPropertiesImpl(OperationContext* opCtx,
     return collProperties;
 }
 
+uint32_t WriterAssignments::getWriterId(
+    uint32_t hash,
+    const std::vector<std::vector<const OplogEntry*>>& writerVectors,
+    boost::optional<uint32_t> forceWriterId) {
+    if (forceWriterId) {
+        _writerIdByHash.emplace(hash, *forceWriterId);
+        return *forceWriterId;
+    }
+
+    auto it = _writerIdByHash.find(hash);
+    if (it != _writerIdByHash.end()) {
+        return it->second;
+    }
+
+    // Start the search at the writer the hash maps to, so that ties are broken the way plain hash
+    // partitioning would break them.
+    const uint32_t numWriters = writerVectors.size();
+    uint32_t writerId = hash % numWriters;
+    for (uint32_t i = 1; i < numWriters; ++i) {
+        const uint32_t candidate = (hash % numWriters + i) % numWriters;
+        if (writerVectors[candidate].size() < writerVectors[writerId].size()) {
+            writerId = candidate;
+        }
+    }
+    _writerIdByHash.emplace(hash, writerId);
+    return writerId;
+}
+
 void OplogApplierUtils::processCrudOp(OperationContext* opCtx,
                                       OplogEntry* op,
                                       uint32_t* hash,
@@ -106,6 +134,7 @@ uint32_t OplogApplierUtils::addToWriterVector(
     OplogEntry* op,
     std::vector<std::vector<const OplogEntry*>>* writerVectors,
     CachedCollectionProperties* collPropertiesCache,
+    WriterAssignments* writerAssignments,
     boost::optional<uint32_t> forceWriterId) {
     auto hashedNs = StringMapHasher().hashed_key(op->getNss().ns());
 
@@ -117,8 +146,7 @@ uint32_t OplogApplierUtils::addToWriterVector(
     if (op->isCrudOpType())
         processCrudOp(opCtx, op, &hash, &hashedNs, collPropertiesCache);
 
-    const uint32_t numWriters = writerVectors->size();
-    auto writerId = (forceWriterId ? *forceWriterId : hash) % numWriters;
+    auto writerId = writerAssignments->getWriterId(hash, *writerVectors, forceWriterId);
     auto& writer = (*writerVectors)[writerId];
     if (writer.empty()) {
         writer.reserve(8);  // Skip a few growth rounds
@@ -148,13 +176,14 @@ void OplogApplierUtils::addDerivedOps(OperationContext* opCtx,
                                       std::vector<OplogEntry>* derivedOps,
                                       std::vector<std::vector<const OplogEntry*>>* writerVectors,
                                       CachedCollectionProperties* collPropertiesCache,
+                                      WriterAssignments* writerAssignments,
                                       bool serial) {
     boost::optional<uint32_t>
         serialWriterId;  // Used to determine which writer vector to assign serial ops.
 
     for (auto&& op : *derivedOps) {
-        auto writerId =
-            addToWriterVector(opCtx, &op, writerVectors, collPropertiesCache, serialWriterId);
+        auto writerId = addToWriterVector(
+            opCtx, &op, writerVectors, collPropertiesCache, writerAssignments, serialWriterId);
         if (serial && !serialWriterId) {
             serialWriterId.emplace(writerId);
         }
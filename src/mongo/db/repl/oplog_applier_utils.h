@@ -30,6 +30,7 @@
 #pragma once
 
 #include "mongo/db/repl/insert_group.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 class CollatorInterface;
@@ -58,6 +59,29 @@ private:
     StringMap<CollectionProperties> _cache;
 };
 
+/**
+ * Remembers which writer each conflict key of a batch was assigned to. A conflict key is the hash
+ * of an op's namespace and, unless the collection is capped, of its _id. All the ops of a batch
+ * with the same key go to the same writer, so that they are applied in order. The first op with a
+ * new key goes to the writer with the fewest ops so far rather than to a writer fixed by the hash,
+ * so that a few hot documents don't pile unrelated ops onto their writers. Hash collisions only
+ * make two keys share a writer. Writers are only consistent within a batch, so each batch needs
+ * its own instance.
+ */
+class WriterAssignments {
+public:
+    /**
+     * Returns the writer for an op with the conflict key 'hash', assigning one if this is the first
+     * op with that key. A forced writer is used as is, and becomes the key's writer if it has none.
+     */
+    uint32_t getWriterId(uint32_t hash,
+                         const std::vector<std::vector<const OplogEntry*>>& writerVectors,
+                         boost::optional<uint32_t> forceWriterId);
+
+private:
+    stdx::unordered_map<uint32_t, uint32_t> _writerIdByHash;
+};
+
 /**
  * This class contains some static methods common to ordinary oplog application and oplog
  * application as part of tenant migration.
@@ -91,16 +115,18 @@ public:
                                       OplogEntry* op,
                                       std::vector<std::vector<const OplogEntry*>>* writerVectors,
                                       CachedCollectionProperties* collPropertiesCache,
+                                      WriterAssignments* writerAssignments,
                                       boost::optional<uint32_t> forceWriterId = boost::none);
     /**
      * Adds a set of derivedOps to writerVectors.
-     * If `serial` is true, assign all derived operations to the writer vector corresponding to the
-     * hash of the first operation in `derivedOps`.
+     * If `serial` is true, assign all derived operations to the writer vector that the first
+     * operation in `derivedOps` is assigned to.
      */
     static void addDerivedOps(OperationContext* opCtx,
                               std::vector<OplogEntry>* derivedOps,
                               std::vector<std::vector<const OplogEntry*>>* writerVectors,
                               CachedCollectionProperties* collPropertiesCache,
+                              WriterAssignments* writerAssignments,
                               bool serial);
 
     /**
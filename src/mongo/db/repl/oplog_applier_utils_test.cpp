@@ -0,0 +1,99 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/oplog_applier_utils.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+using WriterVectors = std::vector<std::vector<const OplogEntry*>>;
+
+/**
+ * Adds an op for the conflict key 'hash' to the writer that 'writerAssignments' picks for it, and
+ * returns that writer.
+ */
+uint32_t assign(WriterAssignments* writerAssignments,
+                WriterVectors* writerVectors,
+                uint32_t hash,
+                boost::optional<uint32_t> forceWriterId = boost::none) {
+    auto writerId = writerAssignments->getWriterId(hash, *writerVectors, forceWriterId);
+    (*writerVectors)[writerId].push_back(nullptr);
+    return writerId;
+}
+
+TEST(WriterAssignmentsTest, OpsWithTheSameKeyShareAWriter) {
+    WriterAssignments writerAssignments;
+    WriterVectors writerVectors(4);
+
+    auto writerId = assign(&writerAssignments, &writerVectors, 7);
+    for (uint32_t hash = 0; hash < 20; ++hash) {
+        assign(&writerAssignments, &writerVectors, hash);
+    }
+    ASSERT_EQ(writerId, assign(&writerAssignments, &writerVectors, 7));
+}
+
+TEST(WriterAssignmentsTest, NewKeysAvoidTheWriterOfAHotKey) {
+    WriterAssignments writerAssignments;
+    WriterVectors writerVectors(4);
+
+    // Plain hash partitioning would send every one of these keys to the hot key's writer.
+    auto hotWriterId = assign(&writerAssignments, &writerVectors, 0);
+    for (int i = 0; i < 10; ++i) {
+        assign(&writerAssignments, &writerVectors, 0);
+    }
+    for (uint32_t hash = 4; hash <= 12; hash += 4) {
+        ASSERT_NE(hotWriterId, assign(&writerAssignments, &writerVectors, hash));
+    }
+    ASSERT_EQ(11U, writerVectors[hotWriterId].size());
+}
+
+TEST(WriterAssignmentsTest, TiesGoToTheWriterOfTheHash) {
+    WriterAssignments writerAssignments;
+    WriterVectors writerVectors(4);
+
+    ASSERT_EQ(2U, assign(&writerAssignments, &writerVectors, 6));
+    ASSERT_EQ(1U, assign(&writerAssignments, &writerVectors, 5));
+}
+
+TEST(WriterAssignmentsTest, ForcedWriterBecomesTheWriterOfANewKey) {
+    WriterAssignments writerAssignments;
+    WriterVectors writerVectors(4);
+
+    ASSERT_EQ(3U, assign(&writerAssignments, &writerVectors, 0, 3U));
+    ASSERT_EQ(3U, assign(&writerAssignments, &writerVectors, 0));
+}
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
@@ -90,6 +90,10 @@ public:
 
     /**
      * Pushes operations in the iterator range [begin, end) into the oplog buffer without blocking.
+     *
+     * Operations fetched from a sync source share ownership of the network reply they arrived in,
+     * so a whole batch is a single allocation. Buffers that hold operations in memory should keep
+     * these references rather than copying the operations.
      */
     virtual void push(OperationContext* opCtx,
                       Batch::const_iterator begin,
@@ -190,6 +194,11 @@ public:
         size.increment(std::size_t(value.objsize()));
     }
 
+    void increment(std::size_t numOps, std::size_t numBytes) {
+        count.increment(numOps);
+        size.increment(numBytes);
+    }
+
     void decrement(const Value& value) {
         count.decrement(1);
         size.decrement(std::size_t(value.objsize()));
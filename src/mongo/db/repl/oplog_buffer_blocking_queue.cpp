@@ -29,6 +29,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <iterator>
+
 #include "mongo/db/repl/oplog_buffer_blocking_queue.h"
 
 namespace mongo {
@@ -69,9 +71,11 @@ void OplogBufferBlockingQueue::push(OperationContext*,
     _notEmptyCv.notify_one();
 
     if (_counters) {
+        std::size_t size = 0;
         for (auto i = begin; i != end; ++i) {
-            _counters->increment(*i);
+            size += getDocumentSize(*i);
         }
+        _counters->increment(std::distance(begin, end), size);
     }
 }
 
@@ -589,6 +589,9 @@ StatusWith<OplogFetcher::Documents> OplogFetcher::_getNextBatch() {
             _cursor->more();
         }
 
+        // The documents are moved out of the cursor and keep sharing ownership of the reply they
+        // arrived in, so the batch does not copy any of them.
+        batch.reserve(_cursor->objsLeftInBatch());
         while (_cursor->moreInCurrentBatch()) {
             batch.emplace_back(_cursor->nextSafe());
         }
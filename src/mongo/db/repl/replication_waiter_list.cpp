@@ -0,0 +1,131 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/replication_waiter_list.h"
+
+#include <tuple>
+
+namespace mongo {
+namespace repl {
+
+namespace {
+
+ReplicationWaiterList::GroupKey makeGroupKey(const ReplicationWaiter& waiter) {
+    ReplicationWaiterList::GroupKey key;
+    if (const auto& wc = waiter.writeConcern) {
+        key.syncMode = wc->syncMode;
+        key.wNumNodes = wc->wNumNodes;
+        key.wMode = wc->wMode;
+        key.checkCondition = wc->checkCondition;
+    }
+    return key;
+}
+
+}  // namespace
+
+bool ReplicationWaiterList::GroupKey::operator<(const GroupKey& other) const {
+    return std::tie(syncMode, wNumNodes, wMode, checkCondition) <
+        std::tie(other.syncMode, other.wNumNodes, other.wMode, other.checkCondition);
+}
+
+ReplicationWaiterList::~ReplicationWaiterList() {
+    // Waiters can outlive the list, so they must not keep pointing into it.
+    for (auto& [key, group] : _groups) {
+        for (auto& [opTime, waiter] : group) {
+            waiter->_list = nullptr;
+        }
+    }
+}
+
+void ReplicationWaiterList::add_inlock(const OpTime& opTime, SharedWaiterHandle waiter) {
+    invariant(!waiter->_list);
+    auto groupIt = _groups.try_emplace(makeGroupKey(*waiter)).first;
+    auto& group = groupIt->second;
+    auto* waiterPtr = waiter.get();
+    waiterPtr->_position = group.emplace(opTime, std::move(waiter));
+    waiterPtr->_group = groupIt;
+    waiterPtr->_list = this;
+    ++_size;
+}
+
+SharedSemiFuture<void> ReplicationWaiterList::add_inlock(const OpTime& opTime,
+                                                         boost::optional<WriteConcernOptions> wc) {
+    auto pf = makePromiseFuture<void>();
+    add_inlock(opTime, std::make_shared<ReplicationWaiter>(std::move(pf.promise), std::move(wc)));
+    return std::move(pf.future);
+}
+
+bool ReplicationWaiterList::remove_inlock(const SharedWaiterHandle& waiter) {
+    if (waiter->_list != this) {
+        return false;
+    }
+    auto groupIt = waiter->_group;
+    _erase_inlock(groupIt->second, waiter->_position);
+    if (groupIt->second.empty()) {
+        _groups.erase(groupIt);
+    }
+    return true;
+}
+
+void ReplicationWaiterList::setValueAll_inlock() {
+    auto groups = std::move(_groups);
+    _groups.clear();
+    _size = 0;
+    for (auto& [key, group] : groups) {
+        for (auto& [opTime, waiter] : group) {
+            waiter->_list = nullptr;
+            waiter->promise.emplaceValue();
+        }
+    }
+}
+
+void ReplicationWaiterList::setErrorAll_inlock(Status status) {
+    invariant(!status.isOK());
+    auto groups = std::move(_groups);
+    _groups.clear();
+    _size = 0;
+    for (auto& [key, group] : groups) {
+        for (auto& [opTime, waiter] : group) {
+            waiter->_list = nullptr;
+            waiter->promise.setError(status);
+        }
+    }
+}
+
+ReplicationWaiterList::WaitersByOpTime::iterator ReplicationWaiterList::_erase_inlock(
+    WaitersByOpTime& group, WaitersByOpTime::iterator it) {
+    it->second->_list = nullptr;
+    --_size;
+    return group.erase(it);
+}
+
+}  // namespace repl
+}  // namespace mongo
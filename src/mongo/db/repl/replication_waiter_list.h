@@ -0,0 +1,186 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "mongo/db/repl/optime.h"
+#include "mongo/db/write_concern_options.h"
+#include "mongo/util/future.h"
+
+namespace mongo {
+namespace repl {
+
+struct ReplicationWaiter;
+
+/**
+ * The waiters of the replication coordinator for an opTime to be reached, either locally or under
+ * a write concern. All functions must be called with the replication coordinator mutex held.
+ *
+ * Waiters are grouped by the parts of their write concern that decide whether an opTime satisfies
+ * it, and ordered by opTime within a group. This lets setValueWhile_inlock stop at the first
+ * waiter in each group that is not yet satisfied instead of checking every waiter.
+ */
+class ReplicationWaiterList {
+public:
+    using SharedWaiterHandle = std::shared_ptr<ReplicationWaiter>;
+
+    /**
+     * The parts of a write concern that decide whether it is satisfied at an opTime. Waiters
+     * without a write concern all share the default key.
+     */
+    struct GroupKey {
+        WriteConcernOptions::SyncMode syncMode = WriteConcernOptions::SyncMode::UNSET;
+        int wNumNodes = 0;
+        std::string wMode;
+        WriteConcernOptions::CheckCondition checkCondition =
+            WriteConcernOptions::CheckCondition::OpTime;
+
+        bool operator<(const GroupKey& other) const;
+    };
+
+    using WaitersByOpTime = std::multimap<OpTime, SharedWaiterHandle>;
+    using WaiterGroups = std::map<GroupKey, WaitersByOpTime>;
+
+    ReplicationWaiterList() = default;
+    ~ReplicationWaiterList();
+
+    ReplicationWaiterList(const ReplicationWaiterList&) = delete;
+    ReplicationWaiterList& operator=(const ReplicationWaiterList&) = delete;
+
+    // Adds waiter into the list. A waiter can be in at most one list at a time.
+    void add_inlock(const OpTime& opTime, SharedWaiterHandle waiter);
+    // Adds a waiter into the list and returns the future of the waiter's promise.
+    SharedSemiFuture<void> add_inlock(const OpTime& opTime,
+                                      boost::optional<WriteConcernOptions> w = boost::none);
+    // Returns whether waiter is found and removed. Takes constant time.
+    bool remove_inlock(const SharedWaiterHandle& waiter);
+    // Signals all waiters whose opTime is <= the given opTime (if any) that satisfy the
+    // condition in func. Checks every such waiter.
+    template <typename Func>
+    void setValueIf_inlock(Func&& func, boost::optional<OpTime> opTime = boost::none);
+    // Like setValueIf_inlock, but func must be monotonic in opTime within a group: if a waiter does
+    // not satisfy it, no waiter with the same write concern and a later opTime does either. Stops
+    // checking a group at its first waiter that does not satisfy func.
+    template <typename Func>
+    void setValueWhile_inlock(Func&& func, boost::optional<OpTime> opTime = boost::none);
+    // Signals all waiters from the list and fulfills promises with OK status.
+    void setValueAll_inlock();
+    // Signals all waiters from the list and fulfills promises with Error status.
+    void setErrorAll_inlock(Status status);
+    // Returns the number of waiters in the list.
+    std::size_t size_inlock() const {
+        return _size;
+    }
+
+private:
+    /**
+     * Signals the waiters of each group whose opTime is <= the given opTime (if any) that satisfy
+     * func, and stops checking a group at its first unsatisfied waiter if 'stopAtFirstUnsatisfied'.
+     */
+    template <typename Func>
+    void _setValue_inlock(Func&& func,
+                          const boost::optional<OpTime>& opTime,
+                          bool stopAtFirstUnsatisfied);
+
+    // Removes the waiter at 'it' from 'group' and returns the position after it. Leaves 'group'
+    // in place even when it becomes empty.
+    WaitersByOpTime::iterator _erase_inlock(WaitersByOpTime& group, WaitersByOpTime::iterator it);
+
+    WaiterGroups _groups;
+    std::size_t _size = 0;
+};
+
+/**
+ * A waiter for an opTime to be reached, and for the write concern to be satisfied if one is given.
+ */
+struct ReplicationWaiter {
+    explicit ReplicationWaiter(Promise<void> p,
+                               boost::optional<WriteConcernOptions> w = boost::none)
+        : promise(std::move(p)), writeConcern(std::move(w)) {}
+
+    Promise<void> promise;
+    boost::optional<WriteConcernOptions> writeConcern;
+
+private:
+    friend class ReplicationWaiterList;
+
+    // The list, group and position of this waiter while it is in a ReplicationWaiterList.
+    ReplicationWaiterList* _list = nullptr;
+    ReplicationWaiterList::WaiterGroups::iterator _group;
+    ReplicationWaiterList::WaitersByOpTime::iterator _position;
+};
+
+template <typename Func>
+void ReplicationWaiterList::setValueIf_inlock(Func&& func, boost::optional<OpTime> opTime) {
+    _setValue_inlock(std::forward<Func>(func), opTime, false /* stopAtFirstUnsatisfied */);
+}
+
+template <typename Func>
+void ReplicationWaiterList::setValueWhile_inlock(Func&& func, boost::optional<OpTime> opTime) {
+    _setValue_inlock(std::forward<Func>(func), opTime, true /* stopAtFirstUnsatisfied */);
+}
+
+template <typename Func>
+void ReplicationWaiterList::_setValue_inlock(Func&& func,
+                                             const boost::optional<OpTime>& opTime,
+                                             bool stopAtFirstUnsatisfied) {
+    for (auto groupIt = _groups.begin(); groupIt != _groups.end();) {
+        auto& group = groupIt->second;
+        for (auto it = group.begin(); it != group.end() && (!opTime || it->first <= *opTime);) {
+            // Keep the waiter alive while its promise is fulfilled, since erasing it from the
+            // group may drop the last reference.
+            auto waiter = it->second;
+            try {
+                if (func(it->first, waiter)) {
+                    it = _erase_inlock(group, it);
+                    waiter->promise.emplaceValue();
+                } else if (stopAtFirstUnsatisfied) {
+                    break;
+                } else {
+                    ++it;
+                }
+            } catch (const DBException& e) {
+                it = _erase_inlock(group, it);
+                waiter->promise.setError(e.toStatus());
+            }
+        }
+        if (group.empty()) {
+            groupIt = _groups.erase(groupIt);
+        } else {
+            ++groupIt;
+        }
+    }
+}
+
+}  // namespace repl
+}  // namespace mongo
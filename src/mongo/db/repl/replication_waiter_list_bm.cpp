@@ -0,0 +1,132 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "mongo/db/repl/replication_waiter_list.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+using SharedWaiterHandle = ReplicationWaiterList::SharedWaiterHandle;
+
+const WriteConcernOptions kWMajority(WriteConcernOptions::kMajority,
+                                     WriteConcernOptions::SyncMode::JOURNAL,
+                                     0);
+
+OpTime makeOpTime(int64_t i) {
+    return OpTime(Timestamp(i, 1), 1);
+}
+
+/**
+ * Adds 'state.range(0)' w:majority waiters, one per opTime, and then advances the majority point
+ * 'state.range(1)' opTimes at a time, signaling the satisfied waiters after each advance the way
+ * the replication coordinator does on updatePosition.
+ */
+template <bool kStopAtFirstUnsatisfied>
+void runAdvanceMajority(benchmark::State& state) {
+    const auto numWaiters = state.range(0);
+    const auto opTimesPerAdvance = state.range(1);
+    for (auto keepRunning : state) {
+        state.PauseTiming();
+        ReplicationWaiterList list;
+        std::vector<SharedSemiFuture<void>> futures;
+        futures.reserve(numWaiters);
+        for (int64_t i = 1; i <= numWaiters; ++i) {
+            futures.push_back(list.add_inlock(makeOpTime(i), kWMajority));
+        }
+        state.ResumeTiming();
+
+        for (int64_t majority = 0; majority < numWaiters;) {
+            majority = std::min(majority + opTimesPerAdvance, numWaiters);
+            auto isDone = [majorityOpTime = makeOpTime(majority)](
+                              const OpTime& opTime, const SharedWaiterHandle&) {
+                return opTime <= majorityOpTime;
+            };
+            if (kStopAtFirstUnsatisfied) {
+                list.setValueWhile_inlock(isDone);
+            } else {
+                list.setValueIf_inlock(isDone);
+            }
+        }
+        invariant(list.size_inlock() == 0);
+    }
+    state.SetItemsProcessed(state.iterations() * numWaiters);
+}
+
+void BM_AdvanceMajorityCheckingEveryWaiter(benchmark::State& state) {
+    runAdvanceMajority<false>(state);
+}
+
+void BM_AdvanceMajorityStoppingAtFirstUnsatisfied(benchmark::State& state) {
+    runAdvanceMajority<true>(state);
+}
+
+/**
+ * Adds 'state.range(0)' waiters and removes them in the order they were added, as waiters that
+ * time out or are interrupted remove themselves.
+ */
+void BM_AddAndRemove(benchmark::State& state) {
+    const auto numWaiters = state.range(0);
+    std::vector<SharedWaiterHandle> waiters;
+    waiters.reserve(numWaiters);
+    for (int64_t i = 0; i < numWaiters; ++i) {
+        auto pf = makePromiseFuture<void>();
+        waiters.push_back(std::make_shared<ReplicationWaiter>(std::move(pf.promise), kWMajority));
+    }
+    for (auto keepRunning : state) {
+        ReplicationWaiterList list;
+        for (int64_t i = 0; i < numWaiters; ++i) {
+            list.add_inlock(makeOpTime(i + 1), waiters[i]);
+        }
+        for (const auto& waiter : waiters) {
+            benchmark::DoNotOptimize(list.remove_inlock(waiter));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numWaiters);
+}
+
+BENCHMARK(BM_AdvanceMajorityCheckingEveryWaiter)
+    ->Args({1000, 10})
+    ->Args({20000, 100})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AdvanceMajorityStoppingAtFirstUnsatisfied)
+    ->Args({1000, 10})
+    ->Args({20000, 100})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AddAndRemove)->Arg(1000)->Arg(20000);
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,169 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/db/repl/replication_waiter_list.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+using SharedWaiterHandle = ReplicationWaiterList::SharedWaiterHandle;
+
+OpTime makeOpTime(unsigned int secs) {
+    return OpTime(Timestamp(secs, 1), 1);
+}
+
+const WriteConcernOptions kW2(2, WriteConcernOptions::SyncMode::NONE, 0);
+const WriteConcernOptions kWMajority(WriteConcernOptions::kMajority,
+                                     WriteConcernOptions::SyncMode::JOURNAL,
+                                     0);
+
+TEST(ReplicationWaiterListTest, RemoveTakesTheWaiterOutOfTheList) {
+    ReplicationWaiterList list;
+    std::vector<SharedWaiterHandle> waiters;
+    for (unsigned int i = 1; i <= 3; ++i) {
+        auto pf = makePromiseFuture<void>();
+        waiters.push_back(std::make_shared<ReplicationWaiter>(std::move(pf.promise), kW2));
+        list.add_inlock(makeOpTime(i), waiters.back());
+    }
+    ASSERT_EQ(3U, list.size_inlock());
+
+    ASSERT_TRUE(list.remove_inlock(waiters[1]));
+    ASSERT_FALSE(list.remove_inlock(waiters[1]));
+    ASSERT_EQ(2U, list.size_inlock());
+
+    // A removed waiter can be added again, to this or another list.
+    ReplicationWaiterList otherList;
+    otherList.add_inlock(makeOpTime(2), waiters[1]);
+    ASSERT_FALSE(list.remove_inlock(waiters[1]));
+    ASSERT_TRUE(otherList.remove_inlock(waiters[1]));
+
+    list.setValueAll_inlock();
+    ASSERT_EQ(0U, list.size_inlock());
+    ASSERT_FALSE(list.remove_inlock(waiters[0]));
+}
+
+TEST(ReplicationWaiterListTest, SetValueWhileStopsAtTheFirstUnsatisfiedWaiterOfEachWriteConcern) {
+    ReplicationWaiterList list;
+    std::vector<SharedSemiFuture<void>> w2Futures;
+    std::vector<SharedSemiFuture<void>> majorityFutures;
+    for (unsigned int i = 1; i <= 5; ++i) {
+        w2Futures.push_back(list.add_inlock(makeOpTime(i), kW2));
+        majorityFutures.push_back(list.add_inlock(makeOpTime(i), kWMajority));
+    }
+
+    // w:2 is satisfied up to the third opTime and w:majority up to the first.
+    int checks = 0;
+    list.setValueWhile_inlock([&](const OpTime& opTime, const SharedWaiterHandle& waiter) {
+        ++checks;
+        auto lastSatisfied = waiter->writeConcern->wMode.empty() ? makeOpTime(3) : makeOpTime(1);
+        return opTime <= lastSatisfied;
+    });
+
+    ASSERT_EQ(6, checks);
+    ASSERT_EQ(6U, list.size_inlock());
+    for (unsigned int i = 0; i < 5; ++i) {
+        ASSERT_EQ(i < 3, w2Futures[i].isReady());
+        ASSERT_EQ(i < 1, majorityFutures[i].isReady());
+    }
+}
+
+TEST(ReplicationWaiterListTest, SetValueWhileOnlyChecksWaitersUpToTheGivenOpTime) {
+    ReplicationWaiterList list;
+    std::vector<SharedSemiFuture<void>> futures;
+    for (unsigned int i = 1; i <= 3; ++i) {
+        futures.push_back(list.add_inlock(makeOpTime(i)));
+    }
+
+    int checks = 0;
+    list.setValueWhile_inlock(
+        [&](const OpTime&, const SharedWaiterHandle&) {
+            ++checks;
+            return true;
+        },
+        makeOpTime(2));
+
+    ASSERT_EQ(2, checks);
+    ASSERT_TRUE(futures[0].isReady());
+    ASSERT_TRUE(futures[1].isReady());
+    ASSERT_FALSE(futures[2].isReady());
+}
+
+TEST(ReplicationWaiterListTest, SetValueIfChecksEveryWaiter) {
+    ReplicationWaiterList list;
+    std::vector<SharedSemiFuture<void>> futures;
+    for (unsigned int i = 1; i <= 3; ++i) {
+        futures.push_back(list.add_inlock(makeOpTime(i), kW2));
+    }
+
+    list.setValueIf_inlock([&](const OpTime& opTime, const SharedWaiterHandle&) {
+        return opTime == makeOpTime(3);
+    });
+
+    ASSERT_FALSE(futures[0].isReady());
+    ASSERT_FALSE(futures[1].isReady());
+    ASSERT_TRUE(futures[2].isReady());
+    ASSERT_EQ(2U, list.size_inlock());
+}
+
+TEST(ReplicationWaiterListTest, ThrowingConditionFailsOnlyThatWaiter) {
+    ReplicationWaiterList list;
+    auto failing = list.add_inlock(makeOpTime(1), kW2);
+    auto satisfied = list.add_inlock(makeOpTime(2), kW2);
+
+    list.setValueWhile_inlock([&](const OpTime& opTime, const SharedWaiterHandle&) {
+        uassert(ErrorCodes::UnknownReplWriteConcern, "unknown", opTime != makeOpTime(1));
+        return true;
+    });
+
+    ASSERT_EQ(ErrorCodes::UnknownReplWriteConcern, failing.getNoThrow());
+    ASSERT_OK(satisfied.getNoThrow());
+    ASSERT_EQ(0U, list.size_inlock());
+}
+
+TEST(ReplicationWaiterListTest, SetErrorAllFailsEveryWaiter) {
+    ReplicationWaiterList list;
+    auto w2 = list.add_inlock(makeOpTime(1), kW2);
+    auto majority = list.add_inlock(makeOpTime(1), kWMajority);
+
+    list.setErrorAll_inlock({ErrorCodes::PrimarySteppedDown, "stepped down"});
+
+    ASSERT_EQ(ErrorCodes::PrimarySteppedDown, w2.getNoThrow());
+    ASSERT_EQ(ErrorCodes::PrimarySteppedDown, majority.getNoThrow());
+    ASSERT_EQ(0U, list.size_inlock());
+}
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
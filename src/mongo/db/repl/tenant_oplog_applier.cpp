@@ -509,6 +509,7 @@ std::vector<std::vector<const OplogEntry*>> TenantOplogApplier::_fillWriterVecto
     OperationContext* opCtx, TenantOplogBatch* batch) {
     std::vector<std::vector<const OplogEntry*>> writerVectors(_writerPool->getStats().numThreads);
     CachedCollectionProperties collPropertiesCache;
+    WriterAssignments writerAssignments;
 
     for (auto&& op : batch->ops) {
         // If the operation's optime is before or the same as the beginApplyingAfterOpTime we don't
@@ -532,11 +533,12 @@ std::vector<std::vector<const OplogEntry*>> TenantOplogApplier::_fillWriterVecto
                                              &batch->expansions[op.expansionsEntry],
                                              &writerVectors,
                                              &collPropertiesCache,
+                                             &writerAssignments,
                                              false /* serial */);
         } else {
             // Add a single op to the writer vectors.
             OplogApplierUtils::addToWriterVector(
-                opCtx, &op.entry, &writerVectors, &collPropertiesCache);
+                opCtx, &op.entry, &writerVectors, &collPropertiesCache, &writerAssignments);
         }
     }
     return writerVectors;
@@ -383,6 +383,7 @@ std::vector<std::vector<const repl::OplogEntry*>> ReshardingOplogApplier::_fillW
     std::vector<std::vector<const repl::OplogEntry*>> writerVectors(
         _writerPool->getStats().numThreads);
     repl::CachedCollectionProperties collPropertiesCache;
+    repl::WriterAssignments writerAssignments;
 
     LogicalSessionIdMap<RetryableOpsList> sessionTracker;
 
@@ -398,7 +399,7 @@ std::vector<std::vector<const repl::OplogEntry*>> ReshardingOplogApplier::_fillW
             continue;
 
         repl::OplogApplierUtils::addToWriterVector(
-            opCtx, &op, &writerVectors, &collPropertiesCache);
+            opCtx, &op, &writerVectors, &collPropertiesCache, &writerAssignments);
 
         if (auto sessionId = op.getSessionId()) {
             auto& retryableOpList = sessionTracker[*sessionId];
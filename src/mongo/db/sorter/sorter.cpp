@@ -52,6 +52,11 @@
 #include <snappy.h>
 #include <vector>
 
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #include "mongo/base/string_data.h"
 #include "mongo/config.h"
 #include "mongo/db/jsobj.h"
@@ -60,6 +65,7 @@
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/overflow_arithmetic.h"
+#include "mongo/platform/posix_fadvise.h"
 #include "mongo/s/is_mongos.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/destructor_guard.h"
@@ -193,6 +199,14 @@ public:
         Settings;
     typedef std::pair<Key, Value> Data;
 
+    // The number of file handles an open FileIterator holds: one to read its range and, where
+    // supported, one to give the kernel read ahead advice.
+#if defined(POSIX_FADV_WILLNEED)
+    static constexpr size_t kNumFileHandles = 2;
+#else
+    static constexpr size_t kNumFileHandles = 1;
+#endif
+
     FileIterator(const std::string& fileFullPath,
                  std::streampos fileStartOffset,
                  std::streampos fileEndOffset,
@@ -209,6 +223,10 @@ public:
                 boost::filesystem::file_size(_fileFullPath) != 0);
     }
 
+    ~FileIterator() {
+        closeReadAhead();
+    }
+
     void openSource() {
         _file.open(_fileFullPath.c_str(), std::ios::in | std::ios::binary);
         uassert(16814,
@@ -221,9 +239,11 @@ public:
                               << "' in file \"" << _fileFullPath
                               << "\": " << myErrnoWithDescription(),
                 _file.good());
+        openReadAhead();
     }
 
     void closeSource() {
+        closeReadAhead();
         _file.close();
         uassert(50969,
                 str::stream() << "error closing file \"" << _fileFullPath
@@ -292,6 +312,8 @@ private:
      * read, then _done is set to true and the function returns immediately.
      */
     void fillBufferFromDisk() {
+        readAhead();
+
         int32_t rawSize;
         read(&rawSize, sizeof(rawSize));
         if (_done)
@@ -343,6 +365,50 @@ private:
         _bufferReader.reset(new BufReader(_buffer.get(), uncompressedSize));
     }
 
+    void openReadAhead() {
+#if defined(POSIX_FADV_WILLNEED)
+        closeReadAhead();
+        // Read ahead is best effort, so failing to open the file again is not an error.
+        _readAheadFd = ::open(_fileFullPath.c_str(), O_RDONLY | O_CLOEXEC);
+        _readAheadEndOffset = _fileStartOffset;
+#endif
+    }
+
+    void closeReadAhead() {
+#if defined(POSIX_FADV_WILLNEED)
+        if (_readAheadFd >= 0) {
+            ::close(_readAheadFd);
+            _readAheadFd = -1;
+        }
+#endif
+    }
+
+    /**
+     * Asks the kernel to start reading the blocks following the current file offset, so that they
+     * are already cached by the time this range's buffer runs dry again. The merge reads from many
+     * ranges in turn and would otherwise wait for a synchronous read for every block.
+     */
+    void readAhead() {
+#if defined(POSIX_FADV_WILLNEED)
+        if (_readAheadFd < 0)
+            return;
+
+        const std::streamoff offset = _file.tellg();
+        if (offset < 0 || offset + kReadAheadBytes / 2 < _readAheadEndOffset)
+            return;
+
+        const std::streamoff start = std::max(offset, _readAheadEndOffset);
+        const std::streamoff end =
+            std::min(offset + kReadAheadBytes, std::streamoff(_fileEndOffset));
+        if (start >= end)
+            return;
+
+        // Intentionally ignoring the return value, the advice only affects performance.
+        posix_fadvise(_readAheadFd, start, end - start, POSIX_FADV_WILLNEED);
+        _readAheadEndOffset = end;
+#endif
+    }
+
     /**
      * Attempts to read data from disk. Sets _done to true when file offset reaches _fileEndOffset.
      *
@@ -381,6 +447,15 @@ private:
     std::streampos _fileEndOffset;    // File offset at which the sorted data range ends.
     std::ifstream _file;
 
+#if defined(POSIX_FADV_WILLNEED)
+    // Number of bytes past the current offset that readAhead() asks the kernel to prefetch.
+    static constexpr std::streamoff kReadAheadBytes = 1024 * 1024;
+
+    // Separate descriptor of _fileFullPath, only used to give read ahead advice.
+    int _readAheadFd = -1;
+    std::streamoff _readAheadEndOffset = 0;  // End of the range advised so far.
+#endif
+
     // Checksum value that is updated with each read of a data object from disk. We can compare
     // this value with _originalChecksum to check for data corruption if and only if the
     // FileIterator is exhausted.
@@ -396,6 +471,11 @@ private:
  * Merge-sorts results from 0 or more FileIterators, all of which should be iterating over sorted
  * ranges within the same file. This class is given the data source file name upon construction and
  * is responsible for deleting the data source file upon destruction.
+ *
+ * The inputs are merged with a tournament tree of losers: every internal node remembers the loser
+ * of the match played there and the overall winner is kept at the root. Advancing the winner only
+ * replays the matches on the path from its leaf to the root, which costs one comparison per level
+ * instead of the two per level needed to sift down a binary heap.
  */
 template <typename Key, typename Value, typename Comparator>
 class MergeIterator : public SortIteratorInterface<Key, Value> {
@@ -409,39 +489,37 @@ public:
         : _opts(opts),
           _remaining(opts.limit ? opts.limit : std::numeric_limits<unsigned long long>::max()),
           _first(true),
-          _greater(comp) {
+          _comp(comp) {
         for (size_t i = 0; i < iters.size(); i++) {
             iters[i]->openSource();
             if (iters[i]->more()) {
-                _heap.push_back(std::make_shared<Stream>(i, iters[i]->next(), iters[i]));
+                _streams.push_back(std::make_shared<Stream>(i, iters[i]->next(), iters[i]));
             } else {
                 iters[i]->closeSource();
             }
         }
 
-        if (_heap.empty()) {
+        if (_streams.empty()) {
             _remaining = 0;
             return;
         }
 
-        std::make_heap(_heap.begin(), _heap.end(), _greater);
-        std::pop_heap(_heap.begin(), _heap.end(), _greater);
-        _current = _heap.back();
-        _heap.pop_back();
+        _numActiveStreams = _streams.size();
+        _tree.resize(_streams.size());
+        _tree[0] = _playMatches(1);
     }
 
     ~MergeIterator() {
         // Clear the remaining Stream objects to close the file handles. Some systems will error
         // closing the file if any file handles are still open.
-        _current.reset();
-        _heap.clear();
+        _streams.clear();
     }
 
     void openSource() {}
     void closeSource() {}
 
     bool more() {
-        if (_remaining > 0 && (_first || !_heap.empty() || _current->more()))
+        if (_remaining > 0 && (_first || _numActiveStreams > 1 || _streams[_tree[0]]->more()))
             return true;
 
         _remaining = 0;
@@ -455,21 +533,19 @@ public:
 
         if (_first) {
             _first = false;
-            return _current->current();
+            return _streams[_tree[0]]->current();
         }
 
-        if (!_current->advance()) {
-            verify(!_heap.empty());
-            std::pop_heap(_heap.begin(), _heap.end(), _greater);
-            _current = _heap.back();
-            _heap.pop_back();
-        } else if (!_heap.empty() && _greater(_current, _heap.front())) {
-            std::pop_heap(_heap.begin(), _heap.end(), _greater);
-            std::swap(_current, _heap.back());
-            std::push_heap(_heap.begin(), _heap.end(), _greater);
+        auto& winner = _streams[_tree[0]];
+        if (!winner->advance()) {
+            // Releasing the Stream closes its source. An exhausted stream loses every match.
+            winner.reset();
+            _numActiveStreams--;
+            verify(_numActiveStreams > 0);
         }
+        _replayMatches();
 
-        return _current->current();
+        return _streams[_tree[0]]->current();
     }
 
 
@@ -511,30 +587,66 @@ private:
         std::shared_ptr<Input> _rest;
     };
 
-    class STLComparator {  // uses greater rather than less-than to maintain a MinHeap
-    public:
-        explicit STLComparator(const Comparator& comp) : _comp(comp) {}
-        bool operator()(unowned_ptr<const Stream> lhs, unowned_ptr<const Stream> rhs) const {
-            // first compare data
-            dassertCompIsSane(_comp, lhs->current(), rhs->current());
-            int ret = _comp(lhs->current(), rhs->current());
-            if (ret)
-                return ret > 0;
-
-            // then compare fileNums to ensure stability
-            return lhs->fileNum > rhs->fileNum;
+    /**
+     * Returns true if the stream at index 'lhs' wins against the stream at index 'rhs'.
+     */
+    bool _wins(size_t lhs, size_t rhs) const {
+        const auto& lhsStream = _streams[lhs];
+        const auto& rhsStream = _streams[rhs];
+        if (!lhsStream || !rhsStream)
+            return lhsStream != nullptr;
+
+        // first compare data
+        dassertCompIsSane(_comp, lhsStream->current(), rhsStream->current());
+        int ret = _comp(lhsStream->current(), rhsStream->current());
+        if (ret)
+            return ret < 0;
+
+        // then compare fileNums to ensure stability
+        return lhsStream->fileNum < rhsStream->fileNum;
+    }
+
+    /**
+     * Plays the matches of the subtree rooted at 'node', storing the loser of each match in its
+     * node, and returns the index of the winning stream. Nodes [1, n) are internal, [n, 2n) are the
+     * leaves for the n streams, so that every internal node has exactly two children.
+     */
+    size_t _playMatches(size_t node) {
+        if (node >= _tree.size())
+            return node - _tree.size();
+
+        size_t left = _playMatches(2 * node);
+        size_t right = _playMatches(2 * node + 1);
+        if (_wins(left, right)) {
+            _tree[node] = right;
+            return left;
         }
+        _tree[node] = left;
+        return right;
+    }
 
-    private:
-        const Comparator _comp;
-    };
+    /**
+     * Replays the matches on the path from the leaf of the previous winner to the root after its
+     * stream advanced.
+     */
+    void _replayMatches() {
+        size_t winner = _tree[0];
+        for (size_t node = (winner + _tree.size()) / 2; node > 0; node /= 2) {
+            if (_wins(_tree[node], winner))
+                std::swap(_tree[node], winner);
+        }
+        _tree[0] = winner;
+    }
 
     SortOptions _opts;
     unsigned long long _remaining;
     bool _first;
-    std::shared_ptr<Stream> _current;
-    std::vector<std::shared_ptr<Stream>> _heap;  // MinHeap
-    STLComparator _greater;                      // named so calls make sense
+    const Comparator _comp;
+    std::vector<std::shared_ptr<Stream>> _streams;  // Null once exhausted.
+    size_t _numActiveStreams = 0;
+    // _tree[0] is the index of the winning stream, _tree[i] for i > 0 the loser of the match
+    // played at internal node i.
+    std::vector<size_t> _tree;
 };
 
 template <typename Key, typename Value, typename Comparator>
@@ -551,6 +663,7 @@ public:
                   const Settings& settings = Settings())
         : Sorter<Key, Value>(opts), _comp(comp), _settings(settings) {
         invariant(opts.limit == 0);
+        invariant(opts.maxIteratorsToMerge >= 2);
     }
 
     NoLimitSorter(const std::string& fileName,
@@ -563,6 +676,7 @@ public:
           _settings(settings),
           _nextSortedFileWriterOffset(!ranges.empty() ? ranges.back().getEndOffset() : 0) {
         invariant(opts.extSortAllowed);
+        invariant(opts.maxIteratorsToMerge >= 2);
 
         this->_numSpills += ranges.size();
         std::transform(ranges.begin(),
@@ -618,7 +732,7 @@ public:
         }
 
         spill();
-        return Iterator::merge(this->_iters, this->_opts, _comp);
+        return Iterator::merge(mergeSpillsIfNeeded(), this->_opts, _comp);
     }
 
 private:
@@ -640,6 +754,65 @@ private:
         this->_numSorted += _data.size();
     }
 
+    /**
+     * The maximum number of spilled ranges merged at once, such that their file handles stay
+     * within maxIteratorsToMerge. At least two ranges are merged at once.
+     */
+    size_t maxRangesToMerge() const {
+        return std::max<size_t>(
+            this->_opts.maxIteratorsToMerge / sorter::FileIterator<Key, Value>::kNumFileHandles, 2);
+    }
+
+    /**
+     * Returns the ranges for the final merge, after merging the spilled ranges in passes until no
+     * more than maxRangesToMerge() are left. Every pass reads and writes all the spilled data once,
+     * so this is only done when the final merge starts rather than on every spill. The spilled
+     * ranges are kept in _iters, as persistDataForShutdown() reports them.
+     */
+    std::vector<std::shared_ptr<Iterator>> mergeSpillsIfNeeded() {
+        auto iters = this->_iters;
+        while (iters.size() > maxRangesToMerge()) {
+            iters = mergeSpills(iters);
+            this->_numMergePasses++;
+        }
+        return iters;
+    }
+
+    /**
+     * Merges consecutive groups of at most maxRangesToMerge() ranges into one range each, appended
+     * to the same file. Merging consecutive ranges keeps the sort stable.
+     */
+    std::vector<std::shared_ptr<Iterator>> mergeSpills(
+        const std::vector<std::shared_ptr<Iterator>>& iters) {
+        const size_t maxRanges = maxRangesToMerge();
+        std::vector<std::shared_ptr<Iterator>> mergedIters;
+        for (auto groupBegin = iters.begin(); groupBegin != iters.end();) {
+            auto groupEnd = groupBegin + std::min<size_t>(maxRanges, iters.end() - groupBegin);
+            if (groupEnd - groupBegin == 1) {
+                mergedIters.push_back(*groupBegin);
+                groupBegin = groupEnd;
+                continue;
+            }
+
+            SortedFileWriter<Key, Value> writer(
+                this->_opts, this->_fileFullPath, _nextSortedFileWriterOffset, _settings);
+            {
+                std::unique_ptr<Iterator> mergeIter(Iterator::merge(
+                    std::vector<std::shared_ptr<Iterator>>(groupBegin, groupEnd),
+                    this->_opts,
+                    _comp));
+                while (mergeIter->more()) {
+                    auto data = mergeIter->next();
+                    writer.addAlreadySorted(data.first, data.second);
+                }
+            }
+            mergedIters.push_back(std::shared_ptr<Iterator>(writer.done()));
+            _nextSortedFileWriterOffset = writer.getFileEndOffset();
+            groupBegin = groupEnd;
+        }
+        return mergedIters;
+    }
+
     void spill() {
         this->_numSpills++;
         if (_data.empty())
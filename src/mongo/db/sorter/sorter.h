@@ -108,7 +108,19 @@ struct SortOptions {
     // extSortAllowed is true.
     std::string tempDir;
 
-    SortOptions() : limit(0), maxMemoryUsageBytes(64 * 1024 * 1024), extSortAllowed(false) {}
+    // Bounds the number of spilled ranges merged at once. Every range being merged holds a block of
+    // data in memory and one or two file handles, the second one for read ahead, and the file
+    // handles of all ranges merged at once stay within this limit. When more ranges are spilled
+    // they are first merged into fewer, larger ranges. Only applies to sorts without a limit.
+    size_t maxIteratorsToMerge;
+
+    static constexpr size_t kDefaultMaxIteratorsToMerge = 256;
+
+    SortOptions()
+        : limit(0),
+          maxMemoryUsageBytes(64 * 1024 * 1024),
+          extSortAllowed(false),
+          maxIteratorsToMerge(kDefaultMaxIteratorsToMerge) {}
 
     // Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
 
@@ -131,6 +143,11 @@ struct SortOptions {
         tempDir = newTempDir;
         return *this;
     }
+
+    SortOptions& MaxIteratorsToMerge(size_t newMaxIteratorsToMerge) {
+        maxIteratorsToMerge = newMaxIteratorsToMerge;
+        return *this;
+    }
 };
 
 /**
@@ -266,6 +283,10 @@ public:
         return _numSorted;
     }
 
+    size_t numMergePasses() const {
+        return _numMergePasses;
+    }
+
     PersistedState persistDataForShutdown();
 
 protected:
@@ -276,6 +297,9 @@ protected:
     size_t _numSpills = 0;  // Keeps track of the number of times data was spilled to disk.
     size_t _numSorted = 0;  // Keeps track of the number of keys sorted.
 
+    // The number of passes merging spilled ranges into fewer ranges before the final merge.
+    size_t _numMergePasses = 0;
+
     // Whether the files written by this Sorter should be kept on destruction.
     bool _shouldKeepFilesOnDestruction = false;
 
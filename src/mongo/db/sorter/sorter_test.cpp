@@ -359,6 +359,26 @@ public:
                 mergeIterators(iterators, ASC, SortOptions().Limit(10)),
                 std::make_shared<LimitIterator>(10, std::make_shared<IntIterator>(0, 20, 1)));
         }
+
+        {  // test that equal keys are returned in input order with an odd number of inputs
+            std::shared_ptr<IWIterator> iterators[5];
+            for (int i = 0; i < 5; i++) {
+                std::vector<IWPair> vec;
+                for (int key = 0; key < 3; key++)
+                    vec.push_back(IWPair(key, i));
+                iterators[i] = std::make_shared<InMemIterator<IntWrapper, IntWrapper>>(vec);
+            }
+
+            std::vector<IWPair> expected;
+            for (int key = 0; key < 3; key++) {
+                for (int i = 0; i < 5; i++)
+                    expected.push_back(IWPair(key, i));
+            }
+
+            ASSERT_ITERATORS_EQUIVALENT(
+                mergeIterators(iterators, ASC),
+                std::make_shared<InMemIterator<IntWrapper, IntWrapper>>(expected));
+        }
     }
 };
 
@@ -389,6 +409,7 @@ public:
                 addData(sorter);
                 ASSERT_ITERATORS_EQUIVALENT(done(sorter), correct());
                 ASSERT_EQ(numAdded(), sorter->numSorted());
+                ASSERT_EQ(mergesInSeveralPasses(), sorter->numMergePasses() > 1);
                 if (assertRanges) {
                     assertRangeInfo(sorter, opts);
                 }
@@ -398,6 +419,7 @@ public:
                 addData(sorter);
                 ASSERT_ITERATORS_EQUIVALENT(done(sorter), correctReverse());
                 ASSERT_EQ(numAdded(), sorter->numSorted());
+                ASSERT_EQ(mergesInSeveralPasses(), sorter->numMergePasses() > 1);
                 if (assertRanges) {
                     assertRangeInfo(sorter, opts);
                 }
@@ -487,6 +509,11 @@ public:
         return 0;
     }
 
+    // Whether done() merges the spilled ranges in more than one pass before the final merge.
+    virtual bool mergesInSeveralPasses() const {
+        return false;
+    }
+
     // It is safe to ignore / overwrite any part of options
     virtual SortOptions adjustSortOptions(SortOptions opts) {
         return opts;
@@ -620,6 +647,15 @@ public:
     PseudoRandom _random;
 };
 
+// Spills enough ranges to need several passes to merge them.
+class LotsOfDataLittleMemoryMultiPassMerge : public LotsOfDataLittleMemory</*Random=*/true> {
+    SortOptions adjustSortOptions(SortOptions opts) override {
+        return LotsOfDataLittleMemory::adjustSortOptions(opts).MaxIteratorsToMerge(4);
+    }
+    bool mergesInSeveralPasses() const override {
+        return true;
+    }
+};
 
 template <long long Limit, bool Random = true>
 class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
@@ -667,6 +703,7 @@ public:
         add<SorterTests::Dupes>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/false>>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/true>>();
+        add<SorterTests::LotsOfDataLittleMemoryMultiPassMerge>();
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/false>>();     // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/true>>();      // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/false>>();   // fits in mem
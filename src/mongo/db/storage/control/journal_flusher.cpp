@@ -33,10 +33,14 @@
 
 #include "mongo/db/storage/control/journal_flusher.h"
 
+#include "mongo/base/counter.h"
 #include "mongo/db/client.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/stats/timer_stats.h"
 #include "mongo/db/storage/recovery_unit.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/future.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
@@ -50,6 +54,16 @@ const auto getJournalFlusher = ServiceContext::declareDecoration<std::unique_ptr
 
 MONGO_FAIL_POINT_DEFINE(pauseJournalFlusherThread);
 
+// Number and time of each flushing round, periodic or requested.
+TimerStats flushRoundStats;
+ServerStatusMetricField<TimerStats> displayFlushRounds("journalFlusher.rounds", &flushRoundStats);
+
+// Number of flush requests served by the flushing rounds. Divided by the number of rounds this
+// gives the average group commit batch size.
+Counter64 flushRequestsBatched;
+ServerStatusMetricField<Counter64> displayFlushRequestsBatched("journalFlusher.batchedRequests",
+                                                               &flushRequestsBatched);
+
 }  // namespace
 
 JournalFlusher* JournalFlusher::get(ServiceContext* serviceCtx) {
@@ -100,8 +114,13 @@ void JournalFlusher::run() {
                 _uniqueCtx->get()->setShouldParticipateInFlowControl(false);
             });
 
+            TimerHolder roundTimer(&flushRoundStats);
             _uniqueCtx->get()->recoveryUnit()->waitUntilDurable(_uniqueCtx->get());
 
+            // Record the round before its waiters can observe the metrics.
+            roundTimer.recordMillis();
+            flushRequestsBatched.increment(_currentSharedPromiseWaiters);
+
             // Signal the waiters that a round completed.
             _currentSharedPromise->emplaceValue();
         } catch (const AssertionException& e) {
@@ -135,6 +154,8 @@ void JournalFlusher::run() {
             });
         }
 
+        _waitForCommitDelay(lk);
+
         if (_needToPause) {
             _state = States::Paused;
             _stateChangeCV.notify_all();
@@ -163,6 +184,7 @@ void JournalFlusher::run() {
         // Take the next promise as current and reset the next promise.
         _currentSharedPromise =
             std::exchange(_nextSharedPromise, std::make_unique<SharedPromise<void>>());
+        _currentSharedPromiseWaiters = std::exchange(_nextSharedPromiseWaiters, 0);
     }
 }
 
@@ -183,6 +205,7 @@ void JournalFlusher::pause() {
     {
         stdx::unique_lock<Latch> lk(_stateMutex);
         _needToPause = true;
+        _flushJournalNowCV.notify_one();
         _stateChangeCV.wait(lk,
                             [&] { return _state == States::Paused || _state == States::ShutDown; });
     }
@@ -229,17 +252,36 @@ void JournalFlusher::interruptJournalFlusherForReplStateChange() {
     }
 }
 
+SharedSemiFuture<void> JournalFlusher::requestJournalFlush() {
+    stdx::lock_guard<Latch> lk(_stateMutex);
+    if (!_flushJournalNow) {
+        _flushJournalNow = true;
+        _flushJournalNowCV.notify_one();
+    }
+    ++_nextSharedPromiseWaiters;
+    return _nextSharedPromise->getFuture();
+}
+
 void JournalFlusher::_waitForJournalFlushNoRetry() {
-    auto myFuture = [&]() {
-        stdx::unique_lock<Latch> lk(_stateMutex);
-        if (!_flushJournalNow) {
-            _flushJournalNow = true;
-            _flushJournalNowCV.notify_one();
-        }
-        return _nextSharedPromise->getFuture();
-    }();
     // Throws on error if the flusher round is interrupted or the flusher thread is shutdown.
-    myFuture.get();
+    requestJournalFlush().get();
+}
+
+void JournalFlusher::_waitForCommitDelay(stdx::unique_lock<Latch>& lk) {
+    if (!_flushJournalNow || _needToPause || _shuttingDown) {
+        return;
+    }
+
+    auto commitDelay = Microseconds(gJournalFlusherCommitDelayMicros.load());
+    if (commitDelay <= Microseconds(0)) {
+        return;
+    }
+
+    // Requests arriving while the lock is released below attach to _nextSharedPromise and are
+    // served by the upcoming round.
+    MONGO_IDLE_THREAD_BLOCK;
+    _flushJournalNowCV.wait_for(
+        lk, commitDelay.toSystemDuration(), [&] { return _needToPause || _shuttingDown; });
 }
 
 }  // namespace mongo
@@ -115,6 +115,18 @@ public:
      */
     void waitForJournalFlush();
 
+    /**
+     * Signals an immediate journal flush and returns a future that is readied once a flush round
+     * that started after this call completes. All requests made before the flusher thread picks up
+     * the next round, including those made during the 'journalFlusherCommitDelayMicros' window,
+     * share a single flush.
+     *
+     * Unlike waitForJournalFlush(), the returned future is set with an
+     * InterruptedDueToReplStateChange error if the round is interrupted by a replication state
+     * change, and with the shutdown reason if the flusher thread is stopped.
+     */
+    SharedSemiFuture<void> requestJournalFlush();
+
     /**
      * Interrupts the journal flusher thread via its operation context with an
      * InterruptedDueToReplStateChange error.
@@ -137,6 +149,13 @@ private:
      */
     void _waitForJournalFlushNoRetry();
 
+    /**
+     * Holds the flusher thread for up to 'journalFlusherCommitDelayMicros' after an immediate flush
+     * was requested, so that further requests join the same round. Returns early on pause or
+     * shutdown.
+     */
+    void _waitForCommitDelay(stdx::unique_lock<Latch>& lk);
+
     // Serializes setting/resetting _uniqueCtx and marking _uniqueCtx killed.
     mutable Mutex _opCtxMutex = MONGO_MAKE_LATCH("JournalFlusherOpCtxMutex");
 
@@ -170,6 +189,11 @@ private:
     std::unique_ptr<SharedPromise<void>> _nextSharedPromise =
         std::make_unique<SharedPromise<void>>();
 
+    // Number of callers waiting on _nextSharedPromise and _currentSharedPromise, respectively.
+    // Reported as the batch size of a flushing round.
+    size_t _nextSharedPromiseWaiters = 0;
+    size_t _currentSharedPromiseWaiters = 0;
+
     // Controls whether to ignore the 'storageGlobalParams.journalCommitIntervalMs' setting. If set,
     // data flushes will only be executed upon explicit request, no longer periodically in addition
     // to upon request.
@@ -0,0 +1,148 @@
+/**
+ *    Copyright (C) 2026-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/commands/server_status_internal.h"
+#include "mongo/db/service_context_d_test_fixture.h"
+#include "mongo/db/storage/control/journal_flusher.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * The journal flusher of the fixture does not flush periodically, so every round is requested by
+ * the test.
+ */
+class JournalFlusherTest : public ServiceContextMongoDTest {
+public:
+    void setUp() override {
+        ServiceContextMongoDTest::setUp();
+        _commitDelayMicros = gJournalFlusherCommitDelayMicros.load();
+
+        // Let the round run by the flusher thread when it starts complete.
+        journalFlusher()->waitForJournalFlush();
+    }
+
+    void tearDown() override {
+        gJournalFlusherCommitDelayMicros.store(_commitDelayMicros);
+        ServiceContextMongoDTest::tearDown();
+    }
+
+    JournalFlusher* journalFlusher() {
+        return JournalFlusher::get(getServiceContext());
+    }
+
+    /**
+     * Returns the 'journalFlusher' section of the serverStatus metrics.
+     */
+    static BSONObj getMetrics() {
+        BSONObjBuilder builder;
+        MetricTree::theMetricTree->appendTo(builder);
+        return builder.obj()["metrics"]["journalFlusher"].Obj().getOwned();
+    }
+
+    static long long getNumRounds(const BSONObj& metrics) {
+        return metrics["rounds"]["num"].numberLong();
+    }
+
+    static long long getNumBatchedRequests(const BSONObj& metrics) {
+        return metrics["batchedRequests"].numberLong();
+    }
+
+private:
+    int _commitDelayMicros = 0;
+};
+
+TEST_F(JournalFlusherTest, RequestedFlushIsReadiedByTheNextRound) {
+    const auto before = getMetrics();
+    journalFlusher()->requestJournalFlush().get();
+
+    const auto after = getMetrics();
+    ASSERT_EQ(getNumRounds(before) + 1, getNumRounds(after));
+    ASSERT_EQ(getNumBatchedRequests(before) + 1, getNumBatchedRequests(after));
+}
+
+TEST_F(JournalFlusherTest, RequestsMadeWhilePausedShareARound) {
+    const auto before = getMetrics();
+    journalFlusher()->pause();
+
+    std::vector<SharedSemiFuture<void>> futures;
+    for (int i = 0; i < 5; ++i) {
+        futures.push_back(journalFlusher()->requestJournalFlush());
+    }
+    for (const auto& future : futures) {
+        ASSERT_FALSE(future.isReady());
+    }
+
+    journalFlusher()->resume();
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    const auto after = getMetrics();
+    ASSERT_EQ(getNumRounds(before) + 1, getNumRounds(after));
+    ASSERT_EQ(getNumBatchedRequests(before) + 5, getNumBatchedRequests(after));
+}
+
+TEST_F(JournalFlusherTest, CommitDelayHoldsTheRoundForLaterRequests) {
+    // Far longer than the test thread takes to make the second request.
+    const Milliseconds commitDelay{1000};
+    gJournalFlusherCommitDelayMicros.store(durationCount<Microseconds>(commitDelay));
+
+    const auto before = getMetrics();
+    Timer timer;
+    auto first = journalFlusher()->requestJournalFlush();
+    auto second = journalFlusher()->requestJournalFlush();
+    first.get();
+    second.get();
+    ASSERT_GTE(Milliseconds(timer.millis()), commitDelay);
+
+    const auto after = getMetrics();
+    ASSERT_EQ(getNumRounds(before) + 1, getNumRounds(after));
+    ASSERT_EQ(getNumBatchedRequests(before) + 2, getNumBatchedRequests(after));
+}
+
+TEST_F(JournalFlusherTest, PauseCutsTheCommitDelayShort) {
+    gJournalFlusherCommitDelayMicros.store(durationCount<Microseconds>(Minutes(10)));
+
+    auto future = journalFlusher()->requestJournalFlush();
+    journalFlusher()->pause();
+    ASSERT_FALSE(future.isReady());
+
+    // The round starts once the flusher resumes, without waiting for the rest of the delay.
+    journalFlusher()->resume();
+    future.get();
+}
+
+}  // namespace
+}  // namespace mongo
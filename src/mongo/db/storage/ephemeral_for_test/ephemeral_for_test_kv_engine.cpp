@@ -116,13 +116,16 @@ std::unique_ptr<mongo::RecordStore> KVEngine::getRecordStore(OperationContext* u
 }
 
 bool KVEngine::trySwapMaster(StringStore& newMaster, uint64_t version) {
+    invariant(!newMaster.hasBranch());
+    // Copy the head node before taking the lock, every committing thread serializes on it.
+    auto newMasterPtr = std::make_shared<StringStore>(newMaster);
+
     stdx::lock_guard<Latch> lock(_masterLock);
-    invariant(!newMaster.hasBranch() && !_master->hasBranch());
+    invariant(!_master->hasBranch());
     if (_masterVersion != version)
         return false;
     // TODO SERVER-48314: replace _masterVersion with a Timestamp of transaction.
     Timestamp commitTimestamp(_masterVersion++, 0);
-    auto newMasterPtr = std::make_shared<StringStore>(newMaster);
     _availableHistory[commitTimestamp] = newMasterPtr;
     _master = newMasterPtr;
     _cleanHistory(lock);
@@ -189,18 +192,24 @@ Status KVEngine::dropIdent(mongo::RecoveryUnit* ru,
 }
 
 std::pair<uint64_t, std::shared_ptr<StringStore>> KVEngine::getMasterInfo(
-    boost::optional<Timestamp> timestamp) {
+    boost::optional<Timestamp> timestamp, bool cleanUnusedHistory) {
     stdx::lock_guard<Latch> lock(_masterLock);
-    if (timestamp && !timestamp->isNull()) {
-        if (timestamp < _getOldestTimestamp(lock)) {
-            uasserted(ErrorCodes::SnapshotTooOld,
-                      str::stream() << "Read timestamp " << timestamp->toString()
-                                    << " is older than the oldest available timestamp.");
+    // The returned tree is referenced before history is cleaned, so it is never removed here.
+    auto masterInfo = [&]() -> std::pair<uint64_t, std::shared_ptr<StringStore>> {
+        if (timestamp && !timestamp->isNull()) {
+            if (timestamp < _getOldestTimestamp(lock)) {
+                uasserted(ErrorCodes::SnapshotTooOld,
+                          str::stream() << "Read timestamp " << timestamp->toString()
+                                        << " is older than the oldest available timestamp.");
+            }
+            auto it = _availableHistory.lower_bound(timestamp.get());
+            return std::make_pair(it->first.asULL(), it->second);
         }
-        auto it = _availableHistory.lower_bound(timestamp.get());
-        return std::make_pair(it->first.asULL(), it->second);
-    }
-    return std::make_pair(_masterVersion, _master);
+        return std::make_pair(_masterVersion, _master);
+    }();
+    if (cleanUnusedHistory)
+        _cleanHistory(lock);
+    return masterInfo;
 }
 
 void KVEngine::cleanHistory() {
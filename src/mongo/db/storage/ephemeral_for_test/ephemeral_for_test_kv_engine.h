@@ -156,10 +156,11 @@ public:
     /**
      * Returns a pair of the current version and a shared_ptr of tree of the master at the provided
      * timestamp. Null timestamps will return the latest master and timestamps before oldest
-     * timestamp will throw SnapshotTooOld exception.
+     * timestamp will throw SnapshotTooOld exception. If 'cleanUnusedHistory' is set, history that
+     * is no longer referenced is cleaned up under the same lock, see cleanHistory().
      */
     std::pair<uint64_t, std::shared_ptr<StringStore>> getMasterInfo(
-        boost::optional<Timestamp> timestamp = boost::none);
+        boost::optional<Timestamp> timestamp = boost::none, bool cleanUnusedHistory = false);
 
     /**
      * Returns true and swaps _master to newMaster if the version passed in is the same as the
@@ -40,6 +40,7 @@
 #include <vector>
 
 #include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/new.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
@@ -52,18 +53,77 @@ class merge_conflict_exception : std::exception {
     }
 };
 
-struct Metrics {
-    AtomicWord<int64_t> totalMemory{0};
-    AtomicWord<int32_t> totalNodes{0};
-    AtomicWord<int32_t> totalChildren{0};
-
+/**
+ * Memory and node counters shared by all trees. Every node copy updates them, so the counters are
+ * striped over cache line sized slots to keep threads modifying trees concurrently from contending
+ * on a single cache line. Each thread updates the slot it was assigned on first use and readers
+ * sum all slots.
+ */
+class Metrics {
+public:
     void addMemory(size_t size) {
-        totalMemory.fetchAndAdd(size);
+        _slot().totalMemory.fetchAndAdd(size);
     }
 
     void subtractMemory(size_t size) {
-        totalMemory.fetchAndSubtract(size);
+        _slot().totalMemory.fetchAndSubtract(size);
+    }
+
+    void addNodes(int32_t count) {
+        _slot().totalNodes.fetchAndAdd(count);
+    }
+
+    void subtractNodes(int32_t count) {
+        _slot().totalNodes.fetchAndSubtract(count);
+    }
+
+    void addChildren(int32_t count) {
+        _slot().totalChildren.fetchAndAdd(count);
+    }
+
+    void subtractChildren(int32_t count) {
+        _slot().totalChildren.fetchAndSubtract(count);
     }
+
+    int64_t totalMemory() const {
+        int64_t total = 0;
+        for (const auto& slot : _slots)
+            total += slot.totalMemory.load();
+        return total;
+    }
+
+    int32_t totalNodes() const {
+        int32_t total = 0;
+        for (const auto& slot : _slots)
+            total += slot.totalNodes.load();
+        return total;
+    }
+
+    int32_t totalChildren() const {
+        int32_t total = 0;
+        for (const auto& slot : _slots)
+            total += slot.totalChildren.load();
+        return total;
+    }
+
+private:
+    static constexpr size_t kNumSlots = 16;
+
+    // Counts may go negative in a single slot when nodes are released by another thread than the
+    // one that created them, only the sum over all slots is meaningful.
+    struct alignas(stdx::hardware_destructive_interference_size) Slot {
+        AtomicWord<int64_t> totalMemory{0};
+        AtomicWord<int32_t> totalNodes{0};
+        AtomicWord<int32_t> totalChildren{0};
+    };
+
+    Slot& _slot() {
+        static AtomicWord<size_t> nextSlot{0};
+        thread_local const size_t slot = nextSlot.fetchAndAdd(1) % kNumSlots;
+        return _slots[slot];
+    }
+
+    std::array<Slot, kNumSlots> _slots;
 };
 enum class NodeType : uint8_t { LEAF, NODE4, NODE16, NODE48, NODE256 };
 
@@ -529,16 +589,16 @@ public:
 
     // Metrics
     static int64_t totalMemory() {
-        return _metrics.totalMemory.load();
+        return _metrics.totalMemory();
     }
 
     static int32_t totalNodes() {
-        return _metrics.totalNodes.load();
+        return _metrics.totalNodes();
     }
 
     static float averageChildren() {
-        auto totalNodes = _metrics.totalNodes.load();
-        return totalNodes ? _metrics.totalChildren.load() / static_cast<float>(totalNodes) : 0;
+        auto totalNodes = _metrics.totalNodes();
+        return totalNodes ? _metrics.totalChildren() / static_cast<float>(totalNodes) : 0;
     }
 
     // Modifiers
@@ -946,9 +1006,8 @@ private:
         }
 
         void addNodeMemory(difference_type offset = 0) {
-            _metrics.totalMemory.fetchAndAdd(sizeof(Node) + _trieKey.capacity() * sizeof(uint8_t) +
-                                             offset);
-            _metrics.totalNodes.fetchAndAdd(1);
+            _metrics.addMemory(sizeof(Node) + _trieKey.capacity() * sizeof(uint8_t) + offset);
+            _metrics.addNodes(1);
         }
 
         void subtractNodeMemory() {
@@ -956,8 +1015,8 @@ private:
             if (_data) {
                 memUsage += _data->first.capacity() + _data->second.capacity();
             }
-            _metrics.totalMemory.fetchAndSubtract(memUsage);
-            _metrics.totalNodes.fetchAndSubtract(1);
+            _metrics.subtractMemory(memUsage);
+            _metrics.subtractNodes(1);
         }
     };
 
@@ -1020,13 +1079,13 @@ private:
 
         ~Node4() {
             _metrics.subtractMemory(sizeof(Node4) - sizeof(Node));
-            _metrics.totalChildren.fetchAndSubtract(_children.size());
+            _metrics.subtractChildren(_children.size());
         }
 
     private:
         void addNodeMemory() {
-            _metrics.totalMemory.fetchAndAdd(sizeof(Node4) - sizeof(Node));
-            _metrics.totalChildren.fetchAndAdd(_children.size());
+            _metrics.addMemory(sizeof(Node4) - sizeof(Node));
+            _metrics.addChildren(_children.size());
         }
 
         // The first bytes of each child's key is stored in a sorted order.
@@ -1086,13 +1145,13 @@ private:
 
         ~Node16() {
             _metrics.subtractMemory(sizeof(Node16) - sizeof(Node));
-            _metrics.totalChildren.fetchAndSubtract(_children.size());
+            _metrics.subtractChildren(_children.size());
         }
 
     private:
         void addNodeMemory() {
-            _metrics.totalMemory.fetchAndAdd(sizeof(Node16) - sizeof(Node));
-            _metrics.totalChildren.fetchAndAdd(_children.size());
+            _metrics.addMemory(sizeof(Node16) - sizeof(Node));
+            _metrics.addChildren(_children.size());
         }
 
         // _childKey is sorted ascendingly.
@@ -1151,13 +1210,13 @@ private:
 
         ~Node48() {
             _metrics.subtractMemory(sizeof(Node48) - sizeof(Node));
-            _metrics.totalChildren.fetchAndSubtract(_children.size());
+            _metrics.subtractChildren(_children.size());
         }
 
     private:
         void addNodeMemory() {
-            _metrics.totalMemory.fetchAndAdd(sizeof(Node48) - sizeof(Node));
-            _metrics.totalChildren.fetchAndAdd(_children.size());
+            _metrics.addMemory(sizeof(Node48) - sizeof(Node));
+            _metrics.addChildren(_children.size());
         }
 
         // A lookup table for child pointers. It has values from 0 to 48, where 0
@@ -1234,13 +1293,13 @@ private:
 
         ~Node256() {
             _metrics.subtractMemory(sizeof(Node256) - sizeof(Node));
-            _metrics.totalChildren.fetchAndSubtract(_children.size());
+            _metrics.subtractChildren(_children.size());
         }
 
     private:
         void addNodeMemory() {
-            _metrics.totalMemory.fetchAndAdd(sizeof(Node256) - sizeof(Node));
-            _metrics.totalChildren.fetchAndAdd(_children.size());
+            _metrics.addMemory(sizeof(Node256) - sizeof(Node));
+            _metrics.addChildren(_children.size());
         }
 
         std::array<node_ptr, 256> _children;
@@ -1306,7 +1365,7 @@ private:
 
     private:
         void addNodeMemory() {
-            _metrics.totalMemory.fetchAndAdd(sizeof(Head) - sizeof(Node256));
+            _metrics.addMemory(sizeof(Head) - sizeof(Node256));
         }
 
         size_type _count = 0;
@@ -32,6 +32,7 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_radix_store.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -114,9 +115,9 @@ public:
     }
 
     void debug(StringStore& store) const {
-        std::cout << "Memory: " << store._metrics.totalMemory.load() << std::endl
-                  << "Nodes: " << store._metrics.totalNodes.load() << std::endl
-                  << "Children: " << store._metrics.totalChildren.load() << std::endl;
+        std::cout << "Memory: " << store._metrics.totalMemory() << std::endl
+                  << "Nodes: " << store._metrics.totalNodes() << std::endl
+                  << "Children: " << store._metrics.totalChildren() << std::endl;
     }
 
 protected:
@@ -3062,5 +3063,33 @@ TEST_F(RadixStoreTest, MergeCompressTest) {
     ASSERT_EQ(thisStore.size(), 2);
 }
 
+TEST_F(RadixStoreTest, MetricsWithNodesReleasedOnOtherThread) {
+    auto nodesBefore = StringStore::totalNodes();
+    auto memoryBefore = StringStore::totalMemory();
+
+    // Build the tree on several threads, so that its nodes are accounted in different slots of the
+    // metrics, and release it on this one.
+    {
+        std::vector<stdx::thread> threads;
+        std::vector<StringStore> stores(4);
+        for (size_t i = 0; i < stores.size(); ++i) {
+            threads.emplace_back([&, i] {
+                for (int j = 0; j < 100; ++j) {
+                    auto key = std::to_string(i) + "key" + std::to_string(j);
+                    stores[i].insert(value_type(key, "v"));
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        ASSERT_GT(StringStore::totalNodes(), nodesBefore);
+        ASSERT_GT(StringStore::totalMemory(), memoryBefore);
+    }
+
+    ASSERT_EQ(StringStore::totalNodes(), nodesBefore);
+    ASSERT_EQ(StringStore::totalMemory(), memoryBefore);
+}
+
 }  // namespace ephemeral_for_test
 }  // namespace mongo
@@ -132,13 +132,13 @@ bool RecoveryUnit::forkIfNeeded() {
             break;
     }
     // Update the copies of the trees when not in a WUOW so cursors can retrieve the latest data.
-    auto masterInfo = _KVEngine->getMasterInfo(readFrom);
+    // Release _mergeBase first and let getMasterInfo() clean the history in case it was holding a
+    // shared_ptr to an older tree, this takes the master lock only once per fork.
+    _mergeBase = nullptr;
+    auto masterInfo = _KVEngine->getMasterInfo(readFrom, /*cleanUnusedHistory=*/true);
     _mergeBase = masterInfo.second;
     _workingCopy = *masterInfo.second;
     invariant(_mergeBase);
-
-    // Call cleanHistory in case _mergeBase was holding a shared_ptr to an older tree.
-    _KVEngine->cleanHistory();
     _forked = true;
     return true;
 }
@@ -570,6 +570,27 @@ public:
     void resetToKey(const BSONObj& obj,
                     Ordering ord,
                     Discriminator discriminator = Discriminator::kInclusive);
+
+    /**
+     * Resets to the state of 'prefix', which must not have finished appending BSON elements, so
+     * that keys sharing their leading elements can be built without encoding those elements again.
+     * Equivalent to but faster than appending the elements that were appended to 'prefix'.
+     */
+    template <class T>
+    void resetFromPrefix(const BuilderBase<T>& prefix) {
+        invariant(version == prefix.version);
+        invariant(prefix._state == BuildState::kEmpty ||
+                  prefix._state == BuildState::kAppendingBSONElements);
+        _reinstantiateBufferIfNeeded();
+        resetFromBuffer(prefix.getBuffer(), prefix.getSize());
+        _typeBits = prefix._typeBits;
+
+        _elemCount = prefix._elemCount;
+        _ordering = prefix._ordering;
+        _discriminator = prefix._discriminator;
+        _state = prefix._state;
+    }
+
     void resetFromBuffer(const void* buffer, size_t size) {
         _buffer().reset();
         memcpy(_buffer().skip(size), buffer, size);
@@ -618,6 +639,9 @@ public:
     const Version version;
 
 protected:
+    template <class T>
+    friend class BuilderBase;
+
     void _appendAllElementsForIndexing(const BSONObj& obj, Discriminator discriminator);
 
     void _appendBool(bool val, bool invert);
@@ -207,6 +207,40 @@ void BM_KeyStringStackBuilderCopy(benchmark::State& state, BsonValueType bsonTyp
     state.SetItemsProcessed(state.iterations() * kSampleSize);
 }
 
+void BM_KeyStringPooledBuilderWithSharedPrefix(benchmark::State& state,
+                                               BsonValueType bsonType,
+                                               bool reusePrefix) {
+    // The KeyString version does not matter for this test.
+    const auto version = KeyString::Version::V1;
+    const BsonsAndKeyStrings bsonsAndKeyStrings = generateBsonsAndKeyStrings(bsonType, version);
+
+    // Leading elements shared by every key, as for the keys of a compound index generated from the
+    // elements of an array in the last indexed field.
+    const BSONObj prefixObj = BSON("" << std::string(kStrLenMultiplier, 'x') << "" << 1.5);
+    KeyString::Builder prefix(version, ALL_ASCENDING);
+    for (auto&& elem : prefixObj) {
+        prefix.appendBSONElement(elem);
+    }
+
+    SharedBufferFragmentBuilder allocator(KeyString::HeapBuilder::kHeapAllocatorDefaultBytes);
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        for (size_t i = 0; i < kSampleSize; i++) {
+            KeyString::PooledBuilder builder(allocator, version, ALL_ASCENDING);
+            if (reusePrefix) {
+                builder.resetFromPrefix(prefix);
+            } else {
+                for (auto&& elem : prefixObj) {
+                    builder.appendBSONElement(elem);
+                }
+            }
+            builder.appendBSONElement(bsonsAndKeyStrings.bsons[i].firstElement());
+            benchmark::DoNotOptimize(builder.release());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kSampleSize);
+}
+
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Int, INT);
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Double, DOUBLE);
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Decimal, DECIMAL);
@@ -245,5 +279,10 @@ BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_String, KeyString::Version::V1, STRING)
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_Array, KeyString::Version::V0, ARRAY);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Array, KeyString::Version::V1, ARRAY);
 
+BENCHMARK_CAPTURE(BM_KeyStringPooledBuilderWithSharedPrefix, Int, INT, false);
+BENCHMARK_CAPTURE(BM_KeyStringPooledBuilderWithSharedPrefix, Int_ReusePrefix, INT, true);
+BENCHMARK_CAPTURE(BM_KeyStringPooledBuilderWithSharedPrefix, String, STRING, false);
+BENCHMARK_CAPTURE(BM_KeyStringPooledBuilderWithSharedPrefix, String_ReusePrefix, STRING, true);
+
 }  // namespace
 }  // namespace mongo
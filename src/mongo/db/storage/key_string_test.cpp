@@ -407,6 +407,32 @@ TEST_F(KeyStringBuilderTest, ActualBytesDouble) {
     ASSERT_EQUALS(hexFlipped, hexblob::encode(ks.getBuffer(), ks.getSize()));
 }
 
+TEST_F(KeyStringBuilderTest, ResetFromPrefix) {
+    // Descending second field and a double so that the prefix has type bits and inverted bytes.
+    const Ordering ord = Ordering::make(BSON("a" << 1 << "b" << -1 << "c" << 1));
+    KeyString::Builder prefix(version, ord);
+    prefix.appendBSONElement(BSON("" << 2.0).firstElement());
+    prefix.appendBSONElement(BSON(""
+                                  << "str")
+                                 .firstElement());
+
+    SharedBufferFragmentBuilder allocator(KeyString::HeapBuilder::kHeapAllocatorDefaultBytes);
+    for (auto&& last : {BSON("" << 1), BSON("" << 2.5), BSON("" << BSONNULL)}) {
+        KeyString::PooledBuilder ks(allocator, version, ord);
+        ks.resetFromPrefix(prefix);
+        ks.appendBSONElement(last.firstElement());
+        ks.appendRecordId(RecordId(7));
+        auto value = ks.release();
+
+        const BSONObj key = BSON("" << 2.0 << ""
+                                    << "str"
+                                    << "" << last.firstElement());
+        KeyString::HeapBuilder expected(version, key, ord, RecordId(7));
+        ASSERT(expected.release() == value);
+        ASSERT(key.binaryEqual(KeyString::toBson(value, ord)));
+    }
+}
+
 TEST_F(KeyStringBuilderTest, AllTypesSimple) {
     ROUNDTRIP(version, BSON("" << 5.5));
     ROUNDTRIP(version,
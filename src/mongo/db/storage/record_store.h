@@ -30,6 +30,9 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <cstring>
+#include <memory>
+#include <vector>
 
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/mutable/damage_vector.h"
@@ -60,6 +63,95 @@ struct Record {
     RecordData data;
 };
 
+/**
+ * Records read ahead of their consumer by RecordCursor::nextBatch(). The data of the records is
+ * copied into blocks owned by the batch, so it remains valid until the batch is cleared, even if
+ * the cursor that read it moves, is saved or is destroyed. The blocks are reused after clear().
+ */
+class RecordBatch {
+public:
+    size_t size() const {
+        return _records.size();
+    }
+
+    bool empty() const {
+        return _records.empty();
+    }
+
+    /**
+     * The total size of the data of the records in the batch, in bytes.
+     */
+    size_t dataSize() const {
+        return _dataSize;
+    }
+
+    const Record& operator[](size_t i) const {
+        return _records[i];
+    }
+
+    Record& operator[](size_t i) {
+        return _records[i];
+    }
+
+    /**
+     * Appends a record. Its data is copied into the batch unless 'data' owns its memory.
+     */
+    void append(const RecordId& id, const RecordData& data) {
+        _dataSize += data.size();
+        if (data.isOwned() || static_cast<size_t>(data.size()) > kBlockSize / 4) {
+            _records.push_back({id, data.getOwned()});
+            return;
+        }
+
+        const size_t size = data.size();
+        if (_blocks.empty()) {
+            _blocks.push_back(std::make_unique<char[]>(kBlockSize));
+        } else if (_blockOffset + size > kBlockSize) {
+            if (++_currentBlock == _blocks.size()) {
+                _blocks.push_back(std::make_unique<char[]>(kBlockSize));
+            }
+            _blockOffset = 0;
+        }
+
+        char* dest = _blocks[_currentBlock].get() + _blockOffset;
+        std::memcpy(dest, data.data(), size);
+        _blockOffset += size;
+        _records.push_back({id, RecordData(dest, data.size())});
+    }
+
+    /**
+     * Removes the records from position 'n' on. The data of the remaining records stays valid.
+     */
+    void truncate(size_t n) {
+        for (size_t i = n; i < _records.size(); ++i) {
+            _dataSize -= _records[i].data.size();
+        }
+        _records.resize(n);
+    }
+
+    /**
+     * Removes all records. The data of the removed records is no longer valid.
+     */
+    void clear() {
+        _records.clear();
+        _dataSize = 0;
+        _currentBlock = 0;
+        _blockOffset = 0;
+    }
+
+private:
+    // Records of at most a quarter of this size are copied into blocks of this size, larger
+    // records are copied into buffers of their own.
+    static constexpr size_t kBlockSize = 64 * 1024;
+
+    std::vector<Record> _records;
+    size_t _dataSize = 0;
+
+    std::vector<std::unique_ptr<char[]>> _blocks;
+    size_t _currentBlock = 0;
+    size_t _blockOffset = 0;
+};
+
 /**
  * Retrieves Records from a RecordStore.
  *
@@ -111,6 +203,29 @@ public:
      */
     virtual boost::optional<Record> next() = 0;
 
+    /**
+     * Moves forward up to 'maxRecords' times and appends the records to 'batch', stopping early
+     * once the data appended to 'batch' reaches 'maxBytes'. Returns true if the cursor reached
+     * EOF, in which case later calls behave like next() at EOF.
+     *
+     * The cursor is left positioned on the last appended record, so that save() and restore()
+     * continue after it. If an exception is thrown, the records appended before it remain in
+     * 'batch' and the cursor is positioned on the last of them.
+     *
+     * Storage engines may override this to read a batch of records with less overhead per record
+     * than repeated calls to next().
+     */
+    virtual bool nextBatch(RecordBatch* batch, size_t maxRecords, size_t maxBytes) {
+        for (size_t i = 0; i < maxRecords && batch->dataSize() < maxBytes; ++i) {
+            auto record = next();
+            if (!record) {
+                return true;
+            }
+            batch->append(record->id, record->data);
+        }
+        return false;
+    }
+
     //
     // Saving and restoring state
     //
@@ -188,6 +303,28 @@ public:
     }
 };
 
+/**
+ * Appends records to an empty RecordStore outside of any storage transaction. See
+ * RecordStore::makeBulkBuilder().
+ */
+class RecordStoreBulkBuilder {
+public:
+    virtual ~RecordStoreBulkBuilder() {}
+
+    /**
+     * Appends a copy of the record described by 'data' and 'len' and returns its RecordId. The
+     * record is not part of the caller's WriteUnitOfWork and is not removed if it rolls back.
+     */
+    virtual StatusWith<RecordId> addRecord(const char* data, int len) = 0;
+
+    /**
+     * Finishes the load, after which the appended records are visible to other cursors on the
+     * RecordStore. No records may be added afterwards. Destroying the builder without calling
+     * commit() also finishes the load.
+     */
+    virtual void commit() = 0;
+};
+
 /**
  * An abstraction used for storing documents in a collection or entries in an index.
  *
@@ -328,6 +465,19 @@ public:
         return inOutRecords.front().id;
     }
 
+    /**
+     * Returns a builder that appends records to this RecordStore without a storage transaction per
+     * record, or nullptr if this RecordStore does not support bulk loading or is not empty.
+     *
+     * Records appended through the builder cannot be rolled back, so this is only suitable for
+     * loading a collection that is dropped if the load fails, as initial sync does. The
+     * RecordStore must not be read or written by other operations until the builder has been
+     * committed or destroyed. Must not be called in a WriteUnitOfWork.
+     */
+    virtual std::unique_ptr<RecordStoreBulkBuilder> makeBulkBuilder(OperationContext* opCtx) {
+        return nullptr;
+    }
+
     /**
      * Updates the record with id 'recordId', replacing its contents with those described by
      * 'data' and 'len'.
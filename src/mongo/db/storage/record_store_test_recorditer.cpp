@@ -32,6 +32,7 @@
 #include "mongo/db/storage/record_store_test_harness.h"
 
 #include <algorithm>
+#include <limits>
 
 #include "mongo/bson/util/builder.h"
 #include "mongo/db/record_id.h"
@@ -387,6 +388,62 @@ TEST(RecordStoreTestHarness, RecordIteratorSaveRestore) {
     }
 }
 
+// Insert multiple records and read them back in batches, saving and restoring the cursor between
+// batches. Each batch holds at most the requested number of records, and the cursor continues from
+// the last record of the previous batch.
+TEST(RecordStoreTestHarness, NextBatchSaveRestore) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    const int nToInsert = 10;
+    RecordId locs[nToInsert];
+    std::string datas[nToInsert];
+    for (int i = 0; i < nToInsert; i++) {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            StringBuilder sb;
+            sb << "record " << i;
+            string data = sb.str();
+
+            WriteUnitOfWork uow(opCtx.get());
+            StatusWith<RecordId> res =
+                rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp());
+            ASSERT_OK(res.getStatus());
+            locs[i] = res.getValue();
+            datas[i] = data;
+            uow.commit();
+        }
+    }
+
+    std::sort(locs, locs + nToInsert);  // inserted records may not be in RecordId order
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        auto cursor = rs->getCursor(opCtx.get());
+
+        const size_t batchSize = 3;
+        RecordBatch batch;
+        int nRead = 0;
+        bool eof = false;
+        while (!eof) {
+            batch.clear();
+            eof = cursor->nextBatch(&batch, batchSize, std::numeric_limits<size_t>::max());
+            ASSERT_LTE(batch.size(), batchSize);
+            ASSERT(eof || batch.size() == batchSize);
+
+            cursor->save();
+            cursor->restore();
+
+            // The batch remains readable after the cursor has been saved and restored.
+            for (size_t i = 0; i < batch.size(); i++, nRead++) {
+                ASSERT_EQUALS(locs[nRead], batch[i].id);
+                ASSERT_EQUALS(datas[nRead], batch[i].data.data());
+            }
+        }
+        ASSERT_EQUALS(nToInsert, nRead);
+        ASSERT(!cursor->next());
+    }
+}
+
 // Insert two records, and iterate a cursor to EOF. Seek the same cursor to the first and ensure
 // that next() returns the second record.
 TEST(RecordStoreTestHarness, SeekAfterEofAndContinue) {
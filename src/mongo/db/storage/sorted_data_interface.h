@@ -30,6 +30,7 @@
 #include <boost/optional/optional.hpp>
 #include <boost/optional/optional_io.hpp>
 #include <memory>
+#include <vector>
 
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
@@ -260,6 +261,28 @@ public:
         virtual boost::optional<IndexKeyEntry> next(RequestedInfo parts = kKeyAndLoc) = 0;
         virtual boost::optional<KeyStringEntry> nextKeyString() = 0;
 
+        /**
+         * Moves forward up to 'maxEntries' times and appends the entries to 'out'. The keys of the
+         * appended entries are owned, so they remain valid after the cursor moves. Returns true if
+         * the cursor reached the end of the index or its end position.
+         *
+         * The cursor is left positioned on the last appended entry, so that save() and restore()
+         * continue after it.
+         */
+        virtual bool nextBatch(std::vector<IndexKeyEntry>* out,
+                               size_t maxEntries,
+                               RequestedInfo parts = kKeyAndLoc) {
+            for (size_t i = 0; i < maxEntries; ++i) {
+                auto entry = next(parts);
+                if (!entry) {
+                    return true;
+                }
+                entry->key = entry->key.getOwned();
+                out->push_back(std::move(*entry));
+            }
+            return false;
+        }
+
         //
         // Seeking
         //
@@ -1582,6 +1582,101 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
     return Status::OK();
 }
 
+/**
+ * Appends records to a newly created table through a WiredTiger bulk cursor. Bulk cursors bypass
+ * transactions and can only append keys in increasing order, which RecordIds from _nextId()
+ * satisfy.
+ */
+class WiredTigerRecordStore::BulkBuilder final : public RecordStoreBulkBuilder {
+public:
+    BulkBuilder(WiredTigerRecordStore* rs,
+                OperationContext* opCtx,
+                UniqueWiredTigerSession session,
+                WT_CURSOR* cursor)
+        : _rs(rs), _opCtx(opCtx), _session(std::move(session)), _cursor(cursor) {}
+
+    ~BulkBuilder() {
+        _close();
+    }
+
+    StatusWith<RecordId> addRecord(const char* data, int len) override {
+        invariant(_cursor);
+        const RecordId id = _rs->_nextId(_opCtx);
+        _rs->setKey(_cursor, id);
+        WiredTigerItem value(data, len);
+        _cursor->set_value(_cursor, value.Get());
+
+        // The cursor belongs to its own session, so this does not modify the transaction of
+        // '_opCtx'.
+        int ret = WT_OP_CHECK(_cursor->insert(_cursor));
+        if (ret)
+            return wtRCToStatus(ret, "WiredTigerRecordStore::BulkBuilder::addRecord");
+
+        auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
+        metricsCollector.incrementOneDocWritten(value.size);
+
+        ++_numRecords;
+        _dataSize += len;
+        return id;
+    }
+
+    void commit() override {
+        _close();
+    }
+
+private:
+    void _close() {
+        if (!_cursor)
+            return;
+
+        invariantWTOK(_cursor->close(_cursor));
+        _cursor = nullptr;
+
+        // There is nothing to roll back, so apply the size adjustments outside of any transaction.
+        _rs->_changeNumRecords(nullptr, _numRecords);
+        _rs->_increaseDataSize(nullptr, _dataSize);
+    }
+
+    WiredTigerRecordStore* const _rs;
+    OperationContext* const _opCtx;
+    UniqueWiredTigerSession const _session;
+    WT_CURSOR* _cursor;
+    int64_t _numRecords = 0;
+    int64_t _dataSize = 0;
+};
+
+std::unique_ptr<RecordStoreBulkBuilder> WiredTigerRecordStore::makeBulkBuilder(
+    OperationContext* opCtx) {
+    invariant(!opCtx->lockState()->inAWriteUnitOfWork());
+    if (_isCapped || _isOplog)
+        return nullptr;
+
+    // Bulk cursors can only append, and the table cannot be read while one is open, so find the
+    // largest existing RecordId first.
+    _initNextIdIfNeeded(opCtx);
+
+    // Open cursors can cause bulk open_cursor to fail with EBUSY.
+    WiredTigerRecoveryUnit::get(opCtx)->getSession()->closeAllCursors(_uri);
+
+    // Use a different session to ensure we don't hijack an existing transaction, and fail quickly
+    // rather than wait for a checkpoint to complete.
+    auto session = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->getSession();
+    WT_SESSION* wtSession = session->getSession();
+    WT_CURSOR* cursor;
+    int ret = wtSession->open_cursor(
+        wtSession, _uri.c_str(), nullptr, "bulk,checkpoint_wait=false", &cursor);
+    if (ret) {
+        LOGV2_DEBUG(5130002,
+                    1,
+                    "Failed to create WiredTiger bulk cursor for record store",
+                    "uri"_attr = _uri,
+                    "error"_attr = wiredtiger_strerror(ret));
+        return nullptr;
+    }
+
+    return std::make_unique<BulkBuilder>(this, opCtx, std::move(session), cursor);
+}
+
 bool WiredTigerRecordStore::isOpHidden_forTest(const RecordId& id) const {
     invariant(id.repr() > 0);
     invariant(_kvEngine->getOplogManager()->isRunning());
@@ -2042,7 +2137,8 @@ void WiredTigerRecordStore::_changeNumRecords(OperationContext* opCtx, int64_t d
         return;
     }
 
-    opCtx->recoveryUnit()->registerChange(std::make_unique<NumRecordsChange>(this, diff));
+    if (opCtx)
+        opCtx->recoveryUnit()->registerChange(std::make_unique<NumRecordsChange>(this, diff));
     if (_sizeInfo->numRecords.fetchAndAdd(diff) < 0)
         _sizeInfo->numRecords.store(std::max(diff, int64_t(0)));
 }
@@ -2238,8 +2334,47 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
     // options we pass when we explicitly start transactions in the RecoveryUnit.
     WiredTigerRecoveryUnit::get(_opCtx)->getSession();
 
+    RecordId id;
+    WT_ITEM value;
+    if (!_advance(_cursor->get(), &id, &value)) {
+        return {};
+    }
+
+    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
+    metricsCollector.incrementOneDocRead(value.size);
+
+    _lastReturnedId = id;
+    return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
+}
+
+bool WiredTigerRecordStoreCursorBase::nextBatch(RecordBatch* batch,
+                                                size_t maxRecords,
+                                                size_t maxBytes) {
+    invariant(_hasRestored);
+    if (_eof)
+        return true;
+
+    // See next().
+    WiredTigerRecoveryUnit::get(_opCtx)->getSession();
+
     WT_CURSOR* c = _cursor->get();
+    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
+    for (size_t i = 0; i < maxRecords && batch->dataSize() < maxBytes; ++i) {
+        RecordId id;
+        WT_ITEM value;
+        if (!_advance(c, &id, &value)) {
+            return true;
+        }
 
+        metricsCollector.incrementOneDocRead(value.size);
+
+        _lastReturnedId = id;
+        batch->append(id, {static_cast<const char*>(value.data), static_cast<int>(value.size)});
+    }
+    return false;
+}
+
+bool WiredTigerRecordStoreCursorBase::_advance(WT_CURSOR* c, RecordId* idOut, WT_ITEM* value) {
     RecordId id;
     if (!_skipNextAdvance) {
         // Nothing after the next line can throw WCEs.
@@ -2249,12 +2384,12 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
             _opCtx, [&] { return _forward ? c->next(c) : c->prev(c); });
         if (advanceRet == WT_NOTFOUND) {
             _eof = true;
-            return {};
+            return false;
         }
         invariantWTOK(advanceRet);
         if (hasWrongPrefix(c, &id)) {
             _eof = true;
-            return {};
+            return false;
         }
     }
 
@@ -2265,7 +2400,7 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
 
     if (_forward && _oplogVisibleTs && id.repr() > *_oplogVisibleTs) {
         _eof = true;
-        return {};
+        return false;
     }
 
     if (_forward && _lastReturnedId >= id) {
@@ -2284,14 +2419,10 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
         throw WriteConflictException();
     }
 
-    WT_ITEM value;
-    invariantWTOK(c->get_value(c, &value));
-
-    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
-    metricsCollector.incrementOneDocRead(value.size);
+    invariantWTOK(c->get_value(c, value));
 
-    _lastReturnedId = id;
-    return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
+    *idOut = id;
+    return true;
 }
 
 boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordId& id) {
@@ -149,6 +149,13 @@ public:
                                  std::vector<Record>* records,
                                  const std::vector<Timestamp>& timestamps);
 
+    /**
+     * Appends records through a WiredTiger bulk cursor, which is only supported for newly created
+     * tables. Returns nullptr for capped collections and the oplog, or if the bulk cursor cannot be
+     * opened.
+     */
+    std::unique_ptr<RecordStoreBulkBuilder> makeBulkBuilder(OperationContext* opCtx) override;
+
     virtual Status updateRecord(OperationContext* opCtx,
                                 const RecordId& recordId,
                                 const char* data,
@@ -286,6 +293,7 @@ protected:
 
 private:
     class RandomCursor;
+    class BulkBuilder;
 
     class NumRecordsChange;
     class DataSizeChange;
@@ -335,6 +343,8 @@ private:
      *      of zero and will discard all cached size metadata. This assumption is incorrect if there
      *      are pending writes to this ident as part of the recovery process, and so we must
      *      always adjust size metadata for these idents.
+     *
+     * If 'opCtx' is null, the adjustment is not rolled back with any storage transaction.
      */
     void _changeNumRecords(OperationContext* opCtx, int64_t diff);
     void _increaseDataSize(OperationContext* opCtx, int64_t amount);
@@ -448,6 +458,12 @@ public:
 
     boost::optional<Record> next();
 
+    /**
+     * Reads the records with a single lookup of the session and of the resource consumption
+     * metrics, copying each value into 'batch' straight from the WT_CURSOR.
+     */
+    bool nextBatch(RecordBatch* batch, size_t maxRecords, size_t maxBytes);
+
     boost::optional<Record> seekExact(const RecordId& id);
 
     void save();
@@ -491,6 +507,12 @@ protected:
 private:
     bool isVisible(const RecordId& id);
 
+    /**
+     * Advances 'c' to the next visible record and returns its id and value through 'idOut' and
+     * 'value'. Returns false, and sets '_eof', if there is no such record.
+     */
+    bool _advance(WT_CURSOR* c, RecordId* idOut, WT_ITEM* value);
+
     /**
      * This value is used for visibility calculations on what oplog entries can be returned to a
      * client. This value *must* be initialized/updated *before* a WiredTiger snapshot is
@@ -374,6 +374,44 @@ TEST(WiredTigerRecordStoreTest, AppendCustomStatsMetadata) {
     ASSERT_EQUALS(creationStringElement.type(), String);
 }
 
+TEST(WiredTigerRecordStoreTest, BulkBuilderAppendsToEmptyRecordStore) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    auto bulkBuilder = rs->makeBulkBuilder(opCtx.get());
+    ASSERT(bulkBuilder);
+
+    const int nToInsert = 10;
+    RecordId ids[nToInsert];
+    for (int i = 0; i < nToInsert; i++) {
+        auto res = bulkBuilder->addRecord("a", 2);
+        ASSERT_OK(res.getStatus());
+        ids[i] = res.getValue();
+        if (i > 0) {
+            ASSERT_LT(ids[i - 1], ids[i]);
+        }
+    }
+    bulkBuilder->commit();
+    bulkBuilder.reset();
+
+    ASSERT_EQUALS(nToInsert, rs->numRecords(opCtx.get()));
+    ASSERT_EQUALS(nToInsert * 2, rs->dataSize(opCtx.get()));
+
+    auto cursor = rs->getCursor(opCtx.get());
+    for (int i = 0; i < nToInsert; i++) {
+        auto record = cursor->next();
+        ASSERT(record);
+        ASSERT_EQUALS(ids[i], record->id);
+        ASSERT_EQUALS(std::string("a"), record->data.data());
+    }
+    ASSERT(!cursor->next());
+    cursor.reset();
+
+    // Bulk cursors can only be opened on newly created tables.
+    ASSERT_FALSE(rs->makeBulkBuilder(opCtx.get()));
+}
+
 TEST(WiredTigerRecordStoreTest, CappedCursorYieldFirst) {
     unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
     unique_ptr<RecordStore> rs(harnessHelper->newCappedRecordStore("a.b", 10000, 50));
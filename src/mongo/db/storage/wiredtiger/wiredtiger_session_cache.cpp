@@ -35,6 +35,10 @@
 
 #include <memory>
 
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
 #include "mongo/base/error_codes.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/global_settings.h"
@@ -45,6 +49,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -197,11 +202,25 @@ uint64_t WiredTigerSession::genTableId() {
 
 // -----------------------
 
+namespace {
+
+// Bounds the number of session cache shards on machines with many CPUs.
+const size_t kMaxSessionCacheShards = 64;
+
+size_t getNumSessionCacheShards() {
+    return std::max<size_t>(1,
+                            std::min<size_t>(ProcessInfo::getNumCores(), kMaxSessionCacheShards));
+}
+
+}  // namespace
+
 WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
     : _engine(engine),
       _conn(engine->getConnection()),
       _clockSource(_engine->getClockSource()),
       _shuttingDown(0),
+      _numShards(getNumSessionCacheShards()),
+      _shards(std::make_unique<SessionCacheShard[]>(_numShards)),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource* cs)
@@ -209,6 +228,8 @@ WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource*
       _conn(conn),
       _clockSource(cs),
       _shuttingDown(0),
+      _numShards(getNumSessionCacheShards()),
+      _shards(std::make_unique<SessionCacheShard[]>(_numShards)),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::~WiredTigerSessionCache() {
@@ -373,26 +394,48 @@ void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
 }
 
 
-void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
+WiredTigerSessionCache::SessionCacheShard& WiredTigerSessionCache::_getHomeShard() const {
+#if defined(__linux__)
+    const int cpu = sched_getcpu();
+    if (cpu >= 0) {
+        return _shards[static_cast<size_t>(cpu) % _numShards];
     }
+#endif
+    // Without a way to find the current CPU, spread the threads over the shards.
+    static AtomicWord<size_t> nextShard{0};
+    thread_local const size_t threadShard = nextShard.fetchAndAdd(1);
+    return _shards[threadShard % _numShards];
+}
+
+template <typename Fn>
+void WiredTigerSessionCache::_forEachCachedSession(Fn&& fn) {
+    for (size_t i = 0; i < _numShards; ++i) {
+        auto& shard = _shards[i];
+        stdx::lock_guard<Latch> lock(shard.mutex);
+        for (auto session : shard.sessions) {
+            fn(session);
+        }
+    }
+}
+
+void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
+    _forEachCachedSession([&](WiredTigerSession* session) { session->closeAllCursors(uri); });
 }
 
 void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
-    }
+    _forEachCachedSession(
+        [&](WiredTigerSession* session) { session->closeCursorsForQueuedDrops(_engine); });
 }
 
 size_t WiredTigerSessionCache::getIdleSessionsCount() {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    return _sessions.size();
+    size_t count = 0;
+    for (size_t i = 0; i < _numShards; ++i) {
+        count += _shards[i].size.load();
+    }
+    return count;
 }
 
 void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
@@ -402,34 +445,48 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
     }
 
     auto cutoffTime = _clockSource->now() - Milliseconds(idleTimeMillis);
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        // Discard all sessions that became idle before the cutoff time
-        for (auto it = _sessions.begin(); it != _sessions.end();) {
-            auto session = *it;
-            invariant(session->getIdleExpireTime() != Date_t::min());
-            if (session->getIdleExpireTime() < cutoffTime) {
-                it = _sessions.erase(it);
-                delete (session);
-            } else {
-                ++it;
+    for (size_t i = 0; i < _numShards; ++i) {
+        auto& shard = _shards[i];
+        SessionCache expired;
+        {
+            stdx::lock_guard<Latch> lock(shard.mutex);
+            // Discard all sessions that became idle before the cutoff time
+            for (auto it = shard.sessions.begin(); it != shard.sessions.end();) {
+                auto session = *it;
+                invariant(session->getIdleExpireTime() != Date_t::min());
+                if (session->getIdleExpireTime() < cutoffTime) {
+                    it = shard.sessions.erase(it);
+                    expired.push_back(session);
+                } else {
+                    ++it;
+                }
             }
+            shard.size.store(shard.sessions.size());
+        }
+
+        // Close the sessions outside of the lock so that other threads can use the shard.
+        for (auto session : expired) {
+            delete session;
         }
     }
 }
 
 void WiredTigerSessionCache::closeAll() {
     // Increment the epoch as we are now closing all sessions with this epoch.
-    SessionCache swap;
+    _epoch.fetchAndAdd(1);
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
-    }
+    for (size_t i = 0; i < _numShards; ++i) {
+        auto& shard = _shards[i];
+        SessionCache swap;
+        {
+            stdx::lock_guard<Latch> lock(shard.mutex);
+            shard.sessions.swap(swap);
+            shard.size.store(0);
+        }
 
-    for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
-        delete (*i);
+        for (SessionCache::iterator it = swap.begin(); it != swap.end(); it++) {
+            delete (*it);
+        }
     }
 }
 
@@ -442,13 +499,22 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        if (!_sessions.empty()) {
+    // Look for an idle session in the shard of the current CPU first, then in the other shards,
+    // so that sessions released on other CPUs are reused before new ones are opened.
+    const size_t homeShard = &_getHomeShard() - _shards.get();
+    for (size_t i = 0; i < _numShards; ++i) {
+        auto& shard = _shards[(homeShard + i) % _numShards];
+        if (shard.size.load() == 0) {
+            continue;
+        }
+
+        stdx::lock_guard<Latch> lock(shard.mutex);
+        if (!shard.sessions.empty()) {
             // Get the most recently used session so that if we discard sessions, we're
             // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
+            WiredTigerSession* cachedSession = shard.sessions.back();
+            shard.sessions.pop_back();
+            shard.size.store(shard.sessions.size());
             // Reset the idle time
             cachedSession->setIdleExpireTime(Date_t::min());
             return UniqueWiredTigerSession(cachedSession);
@@ -510,10 +576,12 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     session->setIdleExpireTime(_clockSource->now());
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<Latch> lock(_cacheLock);
+        auto& shard = _getHomeShard();
+        stdx::lock_guard<Latch> lock(shard.mutex);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            shard.sessions.push_back(session);
+            shard.size.store(shard.sessions.size());
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
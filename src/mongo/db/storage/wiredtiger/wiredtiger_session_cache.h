@@ -38,6 +38,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/new.h"
 #include "mongo/util/concurrency/spin_lock.h"
 
 namespace mongo {
@@ -206,6 +207,9 @@ private:
 /**
  *  This cache implements a shared pool of WiredTiger sessions with the goal to amortize the
  *  cost of session creation and destruction over multiple uses.
+ *
+ *  Idle sessions are kept in one shard per CPU, so that threads running on different CPUs do not
+ *  contend on a single lock when they get and release sessions.
  */
 class WiredTigerSessionCache {
 public:
@@ -376,11 +380,27 @@ private:
     AtomicWord<unsigned> _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    Mutex _cacheLock = MONGO_MAKE_LATCH("WiredTigerSessionCache::_cacheLock");
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
 
-    // Bumped when all open sessions need to be closed
+    /**
+     * A partition of the idle sessions. Each shard is aligned to its own cache line so that
+     * threads using different shards do not share cache lines.
+     */
+    struct alignas(stdx::hardware_destructive_interference_size) SessionCacheShard {
+        Mutex mutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::SessionCacheShard::mutex");
+        SessionCache sessions;
+
+        // The number of sessions in 'sessions', so that empty shards can be skipped without
+        // taking their lock. Only modified while holding 'mutex'.
+        AtomicWord<size_t> size{0};
+    };
+
+    const size_t _numShards;
+    std::unique_ptr<SessionCacheShard[]> _shards;
+
+    // Bumped when all open sessions need to be closed. A session of an older epoch is never
+    // returned to the cache. closeAll() bumps the epoch before emptying the shards, so a session
+    // returned to a shard after checking the epoch under the shard's lock is always closed.
     AtomicWord<unsigned long long> _epoch;  // atomic so we can check it outside of the lock
 
     // Bumped when all open cursors need to be closed
@@ -415,6 +435,18 @@ private:
      * session and releasing it, the session is directly released. This method is thread safe.
      */
     void releaseSession(WiredTigerSession* session);
+
+    /**
+     * Returns the shard of the CPU the calling thread runs on, which it releases sessions to and
+     * first takes sessions from.
+     */
+    SessionCacheShard& _getHomeShard() const;
+
+    /**
+     * Calls 'fn' with every session cached in every shard, while holding the lock of the shard.
+     */
+    template <typename Fn>
+    void _forEachCachedSession(Fn&& fn);
 };
 
 /**
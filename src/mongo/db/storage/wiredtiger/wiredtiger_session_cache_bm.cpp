@@ -0,0 +1,91 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/util/clock_source_mock.h"
+#include "mongo/util/processinfo.h"
+
+namespace mongo {
+namespace {
+
+class WiredTigerSessionCacheHelper {
+public:
+    WiredTigerSessionCacheHelper() : _dbpath("wt_session_cache_bm") {
+        int ret = wiredtiger_open(_dbpath.path().c_str(), nullptr, "create", &_conn);
+        invariant(wtRCToStatus(ret).isOK());
+        _sessionCache = std::make_unique<WiredTigerSessionCache>(_conn, &_clockSource);
+    }
+
+    ~WiredTigerSessionCacheHelper() {
+        _sessionCache.reset();
+        _conn->close(_conn, nullptr);
+    }
+
+    WiredTigerSessionCache* getSessionCache() {
+        return _sessionCache.get();
+    }
+
+private:
+    unittest::TempDir _dbpath;
+    ClockSourceMock _clockSource;
+    WT_CONNECTION* _conn = nullptr;
+    std::unique_ptr<WiredTigerSessionCache> _sessionCache;
+};
+
+/**
+ * Benchmark getting a session from the cache and releasing it back, as every storage transaction
+ * does. All threads share one session cache, so that the benchmark measures the contention
+ * between threads getting and releasing sessions concurrently.
+ */
+void BM_GetAndReleaseSession(benchmark::State& state) {
+    static std::unique_ptr<WiredTigerSessionCacheHelper> helper;
+    if (state.thread_index == 0) {
+        helper = std::make_unique<WiredTigerSessionCacheHelper>();
+    }
+
+    for (auto keepRunning : state) {
+        UniqueWiredTigerSession session = helper->getSessionCache()->getSession();
+        benchmark::DoNotOptimize(session.get());
+    }
+
+    if (state.thread_index == 0) {
+        helper.reset();
+    }
+}
+
+BENCHMARK(BM_GetAndReleaseSession)->ThreadRange(1, ProcessInfo::getNumAvailableCores());
+
+}  // namespace
+}  // namespace mongo
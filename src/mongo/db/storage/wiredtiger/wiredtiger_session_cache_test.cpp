@@ -29,12 +29,15 @@
 
 #include "mongo/platform/basic.h"
 
+#include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "mongo/base/string_data.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/system_clock_source.h"
@@ -113,4 +116,88 @@ TEST(WiredTigerSessionCacheTest, CheckSessionCacheCleanup) {
     ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
 }
 
+TEST(WiredTigerSessionCacheTest, ConcurrentlyReleasedSessionsAreReused) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    const size_t numThreads = 8;
+    std::vector<stdx::thread> threads;
+    for (size_t i = 0; i < numThreads; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < 1000; ++j) {
+                UniqueWiredTigerSession session = sessionCache->getSession();
+                ASSERT(session->getSession());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Every released session is cached. A thread may miss a session that is being released to
+    // another shard and open a new one, so the number of cached sessions is not bounded by the
+    // number of threads.
+    ASSERT_GTE(sessionCache->getIdleSessionsCount(), 1U);
+
+    // Sessions cached by other threads are reused before new ones are opened.
+    const auto numIdle = sessionCache->getIdleSessionsCount();
+    {
+        std::vector<UniqueWiredTigerSession> sessions;
+        for (size_t i = 0; i < numIdle; ++i) {
+            sessions.push_back(sessionCache->getSession());
+        }
+        ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), numIdle);
+}
+
+TEST(WiredTigerSessionCacheTest, SessionsReleasedByAnotherThreadAreReused) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    // Release sessions on another thread, which may run on another CPU and thus cache them in
+    // another shard.
+    const size_t numSessions = 4;
+    std::set<WT_SESSION*> released;
+    stdx::thread([&] {
+        std::vector<UniqueWiredTigerSession> sessions;
+        for (size_t i = 0; i < numSessions; ++i) {
+            sessions.push_back(sessionCache->getSession());
+            released.insert(sessions.back()->getSession());
+        }
+    }).join();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), numSessions);
+
+    // Each of the sessions is handed out again rather than a new one being opened.
+    std::vector<UniqueWiredTigerSession> sessions;
+    for (size_t i = 0; i < numSessions; ++i) {
+        sessions.push_back(sessionCache->getSession());
+        ASSERT_EQUALS(released.erase(sessions.back()->getSession()), 1U);
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+}
+
+TEST(WiredTigerSessionCacheTest, SessionsOfPreviousEpochAreNotCached) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    UniqueWiredTigerSession heldSession = sessionCache->getSession();
+    {
+        UniqueWiredTigerSession session = sessionCache->getSession();
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 1U);
+
+    // Closing all sessions empties the cache, and a session acquired before is closed when it is
+    // released rather than cached.
+    sessionCache->closeAll();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+    heldSession.reset();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+
+    {
+        UniqueWiredTigerSession session = sessionCache->getSession();
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 1U);
+}
+
 }  // namespace mongo
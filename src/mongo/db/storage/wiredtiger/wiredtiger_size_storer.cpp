@@ -31,6 +31,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <vector>
 #include <wiredtiger.h>
 
 #include "mongo/bson/bsonobj.h"
@@ -73,9 +74,12 @@ void WiredTigerSizeStorer::store(StringData uri, std::shared_ptr<SizeInfo> sizeI
     if (sizeInfo->_dirty.load() || _readOnly)
         return;
 
+    auto hashedUri = StringMapHasher().hashed_key(uri);
+    auto& shard = _getShard(hashedUri);
+
     // Ordering is important: as the entry may be flushed concurrently, set the dirty flag last.
-    stdx::lock_guard<Latch> lk(_bufferMutex);
-    auto& entry = _buffer[uri];
+    stdx::lock_guard<Latch> lk(shard.mutex);
+    auto& entry = shard.buffer[hashedUri];
     // During rollback it is possible to get a new SizeInfo. In that case clear the dirty flag,
     // so the SizeInfo can be destructed without triggering the dirty check invariant.
     if (entry && entry.get() != sizeInfo.get())
@@ -96,12 +100,16 @@ void WiredTigerSizeStorer::store(StringData uri, std::shared_ptr<SizeInfo> sizeI
 std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(StringData uri) const {
     {
         // Check if we can satisfy the read from the buffer.
-        stdx::lock_guard<Latch> bufferLock(_bufferMutex);
-        Buffer::const_iterator it = _buffer.find(uri);
-        if (it != _buffer.end())
+        auto hashedUri = StringMapHasher().hashed_key(uri);
+        auto& shard = _getShard(hashedUri);
+        stdx::lock_guard<Latch> bufferLock(shard.mutex);
+        Buffer::const_iterator it = shard.buffer.find(hashedUri);
+        if (it != shard.buffer.end())
             return it->second;
     }
 
+    // Flushes hold the cursor from before taking entries out of a shard until they are committed,
+    // so an entry missing from the buffer is either absent or already visible in the table.
     stdx::lock_guard<Latch> cursorLock(_cursorMutex);
     // Intentionally ignoring return value.
     ON_BLOCK_EXIT([&] { _cursor->reset(_cursor); });
@@ -131,31 +139,75 @@ std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(Strin
 }
 
 void WiredTigerSizeStorer::flush(bool syncToDisk) {
-    Buffer buffer;
-    {
-        stdx::lock_guard<Latch> bufferLock(_bufferMutex);
-        _buffer.swap(buffer);
+    Timer t;
+    size_t numFlushed = 0;
+    if (syncToDisk) {
+        // Write all shards in one transaction, so the journal is only synced once.
+        numFlushed = _flushShards(0, kNumBufferShards, syncToDisk);
+    } else {
+        for (size_t i = 0; i < kNumBufferShards; ++i) {
+            {
+                stdx::lock_guard<Latch> bufferLock(_bufferShards[i].mutex);
+                if (_bufferShards[i].buffer.empty())
+                    continue;
+            }
+            numFlushed += _flushShards(i, i + 1, syncToDisk);
+        }
     }
 
-    if (buffer.empty())
+    if (numFlushed == 0)
         return;  // Nothing to do.
 
-    Timer t;
+    auto micros = t.micros();
+    LOGV2_DEBUG(22426,
+                2,
+                "WiredTigerSizeStorer flush of {numEntries} entries took {micros} µs",
+                "micros"_attr = micros,
+                "numEntries"_attr = numFlushed);
+}
+
+WiredTigerSizeStorer::BufferShard& WiredTigerSizeStorer::_getShard(
+    const StringMapHashedKey& hashedUri) const {
+    // Use the high bits of the hash, the low bits select the slot within the shard's hash table.
+    constexpr size_t kShardBits = 4;
+    static_assert(kNumBufferShards == size_t(1) << kShardBits);
+    return _bufferShards[hashedUri.hash() >> (sizeof(size_t) * 8 - kShardBits)];
+}
+
+size_t WiredTigerSizeStorer::_flushShards(size_t begin, size_t end, bool syncToDisk) {
+    // Hold the cursor before taking entries out of the buffer, see load().
     stdx::lock_guard<Latch> cursorLock(_cursorMutex);
-    {
-        // On failure, place entries back into the map, unless a newer value already exists.
-        ON_BLOCK_EXIT([this, &buffer]() {
-            this->_cursor->reset(this->_cursor);
-            if (!buffer.empty()) {
-                stdx::lock_guard<Latch> bufferLock(this->_bufferMutex);
-                for (auto& it : buffer)
-                    this->_buffer.try_emplace(it.first, it.second);
-            }
-        });
 
-        WT_SESSION* session = _session.getSession();
-        WiredTigerBeginTxnBlock txnOpen(session, syncToDisk ? "sync=true" : nullptr);
+    std::vector<std::pair<size_t, Buffer>> buffers;
+    for (size_t i = begin; i < end; ++i) {
+        Buffer buffer;
+        {
+            stdx::lock_guard<Latch> bufferLock(_bufferShards[i].mutex);
+            _bufferShards[i].buffer.swap(buffer);
+        }
+        if (!buffer.empty())
+            buffers.emplace_back(i, std::move(buffer));
+    }
+
+    if (buffers.empty())
+        return 0;
+
+    // On failure, place entries back into their shards, unless a newer value already exists.
+    ON_BLOCK_EXIT([this, &buffers]() {
+        this->_cursor->reset(this->_cursor);
+        for (auto& [shardIndex, buffer] : buffers) {
+            auto& shard = this->_bufferShards[shardIndex];
+            stdx::lock_guard<Latch> bufferLock(shard.mutex);
+            for (auto& it : buffer)
+                shard.buffer.try_emplace(it.first, it.second);
+        }
+    });
 
+    WT_SESSION* session = _session.getSession();
+    WiredTigerBeginTxnBlock txnOpen(session, syncToDisk ? "sync=true" : nullptr);
+
+    size_t numFlushed = 0;
+    for (auto& [shardIndex, buffer] : buffers) {
         for (auto it = buffer.begin(); it != buffer.end(); ++it) {
 
             // Ordering is important here: when the store method checks if the SizeInfo
@@ -177,13 +229,13 @@ void WiredTigerSizeStorer::flush(bool syncToDisk) {
             _cursor->set_key(_cursor, key.Get());
             _cursor->set_value(_cursor, value.Get());
             invariantWTOK(_cursor->insert(_cursor));
+            ++numFlushed;
         }
-        txnOpen.done();
-        invariantWTOK(session->commit_transaction(session, nullptr));
-        buffer.clear();
     }
+    txnOpen.done();
+    invariantWTOK(session->commit_transaction(session, nullptr));
+    buffers.clear();
 
-    auto micros = t.micros();
-    LOGV2_DEBUG(22426, 2, "WiredTigerSizeStorer flush took {micros} µs", "micros"_attr = micros);
+    return numFlushed;
 }
 }  // namespace mongo
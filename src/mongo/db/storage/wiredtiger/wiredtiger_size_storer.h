@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 
 #include <wiredtiger.h>
@@ -51,6 +52,10 @@ namespace mongo {
  * in size updates to be lost, so size information is only approximate. Reads use the buffer for
  * pending stores, or otherwise read directly from the WiredTiger table using a dedicated session
  * and cursor.
+ *
+ * The buffer is split into shards keyed by URI hash, so that stores for different collections
+ * rarely contend on the same mutex, and so that periodic flushes can write back one shard at a
+ * time instead of holding the cursor for the whole buffer.
  */
 class WiredTigerSizeStorer {
 public:
@@ -90,21 +95,36 @@ public:
     std::shared_ptr<SizeInfo> load(StringData uri) const;
 
     /**
-     * Writes all changes to the underlying table.
+     * Writes all changes to the underlying table. Unless 'syncToDisk' is set, each shard of the
+     * buffer is written in its own transaction and the cursor is released in between.
      */
     void flush(bool syncToDisk);
 
 private:
+    using Buffer = StringMap<std::shared_ptr<SizeInfo>>;
+
+    static constexpr size_t kNumBufferShards = 16;
+
+    struct BufferShard {
+        // Guards buffer. Acquire *after* _cursorMutex.
+        mutable Mutex mutex = MONGO_MAKE_LATCH("WiredTigerSizeStorer::BufferShard::mutex");
+        Buffer buffer;
+    };
+
+    BufferShard& _getShard(const StringMapHashedKey& hashedUri) const;
+
+    /**
+     * Writes the buffered entries of shards [begin, end) to the table in a single transaction.
+     * Returns the number of entries written.
+     */
+    size_t _flushShards(size_t begin, size_t end, bool syncToDisk);
+
     const WiredTigerSession _session;
     const bool _readOnly;
-    // Guards _cursor. Acquire *before* _bufferMutex.
+    // Guards _cursor. Acquire *before* any BufferShard::mutex.
     mutable Mutex _cursorMutex = MONGO_MAKE_LATCH("WiredTigerSessionStorer::_cursorMutex");
     WT_CURSOR* _cursor;  // pointer is const after constructor
 
-    using Buffer = StringMap<std::shared_ptr<SizeInfo>>;
-
-    mutable Mutex _bufferMutex =
-        MONGO_MAKE_LATCH("WiredTigerSessionStorer::_bufferMutex");  // Guards _buffer
-    Buffer _buffer;
+    mutable std::array<BufferShard, kNumBufferShards> _bufferShards;
 };
 }  // namespace mongo
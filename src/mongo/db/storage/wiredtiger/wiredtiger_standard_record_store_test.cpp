@@ -33,6 +33,7 @@
 #include <sstream>
 #include <string>
 #include <time.h>
+#include <vector>
 
 #include "mongo/base/checked_cast.h"
 #include "mongo/base/init.h"
@@ -298,6 +299,37 @@ TEST(WiredTigerRecordStoreTest, SizeStorer1) {
     rs.reset(nullptr);  // this has to be deleted before ss
 }
 
+TEST(WiredTigerRecordStoreTest, SizeStorerFlushesAllShards) {
+    WiredTigerHarnessHelper harnessHelper;
+    std::string storageUri = WiredTigerKVEngine::kTableUriPrefix + "sizeStorer";
+    const bool readOnly = false;
+    const int N = 100;
+
+    {
+        WiredTigerSizeStorer ss(harnessHelper.conn(), storageUri, readOnly);
+        std::vector<std::shared_ptr<WiredTigerSizeStorer::SizeInfo>> infos;
+        for (int i = 0; i < N; i++) {
+            infos.push_back(std::make_shared<WiredTigerSizeStorer::SizeInfo>(i, i * 10));
+            ss.store("table:coll" + std::to_string(i), infos.back());
+        }
+        ss.flush(false);
+
+        // Stores after a flush are written back by the next one.
+        for (int i = 0; i < N; i += 2) {
+            infos[i]->numRecords.store(i + 1);
+            ss.store("table:coll" + std::to_string(i), infos[i]);
+        }
+        ss.flush(true);
+    }
+
+    WiredTigerSizeStorer ss(harnessHelper.conn(), storageUri, readOnly);
+    for (int i = 0; i < N; i++) {
+        auto info = ss.load("table:coll" + std::to_string(i));
+        ASSERT_EQUALS(i % 2 == 0 ? i + 1 : i, info->numRecords.load());
+        ASSERT_EQUALS(i * 10, info->dataSize.load());
+    }
+}
+
 class SizeStorerUpdateTest : public mongo::unittest::Test {
 private:
     virtual void setUp() {
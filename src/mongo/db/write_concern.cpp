@@ -273,6 +273,26 @@ void waitForNoOplogHolesIfNeeded(OperationContext* opCtx) {
     }
 }
 
+/**
+ * Waits for a journal flush round which starts after this call, like
+ * JournalFlusher::waitForJournalFlush(), but can be interrupted through 'opCtx', e.g. by maxTimeMS
+ * while the flusher holds the round open for 'journalFlusherCommitDelayMicros'.
+ *
+ * Can throw on opCtx interruption.
+ */
+void waitForJournalFlushOrInterrupt(OperationContext* opCtx) {
+    while (true) {
+        try {
+            JournalFlusher::get(opCtx)->requestJournalFlush().get(opCtx);
+            return;
+        } catch (const ExceptionFor<ErrorCodes::InterruptedDueToReplStateChange>&) {
+            // Rethrow if this operation was interrupted rather than the flusher round, otherwise
+            // retry with the next round.
+            opCtx->checkForInterrupt();
+        }
+    }
+}
+
 Status waitForWriteConcern(OperationContext* opCtx,
                            const OpTime& replOpTime,
                            const WriteConcernOptions& writeConcern,
@@ -314,13 +334,13 @@ Status waitForWriteConcern(OperationContext* opCtx,
                     result->fsyncFiles = 1;
                 } else {
                     // We only need to commit the journal if we're durable
-                    JournalFlusher::get(opCtx)->waitForJournalFlush();
+                    waitForJournalFlushOrInterrupt(opCtx);
                 }
                 break;
             }
             case WriteConcernOptions::SyncMode::JOURNAL:
                 waitForNoOplogHolesIfNeeded(opCtx);
-                JournalFlusher::get(opCtx)->waitForJournalFlush();
+                waitForJournalFlushOrInterrupt(opCtx);
                 break;
         }
     } catch (const DBException& ex) {
@@ -47,10 +47,12 @@
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/plan_executor_factory.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 
 namespace query_stage_collection_scan {
 
@@ -84,6 +86,10 @@ public:
         _client.remove(nss.ns(), obj);
     }
 
+    void update(const BSONObj& predicate, const BSONObj& update) {
+        _client.update(nss.ns(), predicate, update);
+    }
+
     int countResults(CollectionScanParams::Direction direction, const BSONObj& filterObj) {
         AutoGetCollectionForReadCommand collection(&_opCtx, nss);
 
@@ -354,6 +360,60 @@ TEST_F(QueryStageCollectionScanTest, QueryStageCollscanDeleteUpcomingObjectBackw
     ASSERT_EQUALS(numObj(), count);
 }
 
+// Yield while records read ahead from the cursor have not been returned yet, then update one of
+// them and delete another. The scan must return the updated document and skip the deleted one.
+TEST_F(QueryStageCollectionScanTest, QueryStageCollscanYieldWithRecordsReadAhead) {
+    const auto maxReadAhead = internalQueryCollectionScanReadAheadMaxRecords.load();
+    internalQueryCollectionScanReadAheadMaxRecords.store(16);
+    ON_BLOCK_EXIT([&] { internalQueryCollectionScanReadAheadMaxRecords.store(maxReadAhead); });
+
+    dbtests::WriteContextForTests ctx(&_opCtx, nss.ns());
+    const CollectionPtr& coll = ctx.getCollection();
+
+    vector<RecordId> recordIds;
+    getRecordIds(coll, CollectionScanParams::FORWARD, &recordIds);
+
+    CollectionScanParams params;
+    params.direction = CollectionScanParams::FORWARD;
+    params.tailable = false;
+
+    WorkingSet ws;
+    unique_ptr<PlanStage> scan(new CollectionScan(_expCtx.get(), coll, params, &ws, nullptr));
+
+    // The batches of 1, 2, 4 and 8 records leave 5 records read ahead after the first 10.
+    size_t count = 0;
+    while (count < 10) {
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        if (PlanStage::ADVANCED == scan->work(&id)) {
+            ASSERT_EQUALS(recordIds[count], ws.get(id)->recordId);
+            ++count;
+        }
+    }
+
+    scan->saveState();
+    const auto updatedDoc = coll->docFor(&_opCtx, recordIds[11]).value();
+    update(updatedDoc, BSON("$set" << BSON("updated" << true)));
+    remove(coll->docFor(&_opCtx, recordIds[12]).value());
+    scan->restoreState(&coll);
+
+    vector<RecordId> expectedIds(recordIds.begin() + count, recordIds.end());
+    expectedIds.erase(expectedIds.begin() + 2);
+    vector<RecordId> returnedIds;
+    while (!scan->isEOF()) {
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        if (PlanStage::ADVANCED == scan->work(&id)) {
+            WorkingSetMember* member = ws.get(id);
+            returnedIds.push_back(member->recordId);
+            ASSERT_BSONOBJ_EQ(coll->docFor(&_opCtx, member->recordId).value(),
+                              member->doc.value().toBson());
+            if (member->recordId == recordIds[11]) {
+                ASSERT_TRUE(member->doc.value()["updated"].getBool());
+            }
+        }
+    }
+    ASSERT(expectedIds == returnedIds);
+}
+
 // Verify that successfully seeking to the resumeAfterRecordId returns PlanStage::NEED_TIME and
 // that we can complete the collection scan afterwards.
 TEST_F(QueryStageCollectionScanTest, QueryTestCollscanResumeAfterRecordIdSeekSuccess) {